@@ -0,0 +1,131 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "defines.hpp"
+#include "reader.hpp"
+#include "writer.hpp"
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <unordered_set>
+
+namespace nioc::chronicle
+{
+
+/// @brief Takes in the records a BridgeSender on another host streams over TCP, receiving each
+/// straight into a reservation on a local Writer's channel.
+///
+/// Example:
+///
+///     auto writer = nioc::chronicle::Writer{"/data/run42-mirror"};
+///     auto receiver = nioc::chronicle::BridgeReceiver{writer, 7400};
+///     receiver.accept(channelId);
+///     while(const auto entry = receiver.next(std::chrono::milliseconds{100}))
+///     {
+///       process(entry->mChannelId, entry->mCrate.span());
+///     }
+///
+/// The receiver listens on a TCP port of one address, loopback unless given another, and serves one
+/// BridgeSender at a time; a sender that hangs up is replaced by the next to connect. Each record's
+/// bytes are read from the socket into the channel's roll, where they are committed under the
+/// record's own channel id, so the local chronicle mirrors the forwarded channels and the yielded
+/// Crates view them in place.
+/// Records of channels not accepted are read and dropped. A sender whose header has another
+/// version (see BridgeFrame), that announces a record larger than the receiver's limit, or that
+/// stalls midway through a record for kReceiveTimeout is hung up on.
+///
+/// Not copyable or movable. Not thread-safe.
+///
+/// @see BridgeSender, BridgeFrame
+class BridgeReceiver
+{
+public:
+  /// The address listened on by default: loopback, so only senders on the same host reach it.
+  static constexpr auto kDefaultAddress = std::string_view{"127.0.0.1"};
+
+  /// Default byte size of the largest record accepted.
+  static constexpr auto kDefaultMaxRecordSize = std::uint64_t{64ULL << 20U};
+
+  /// Longest a connected sender may leave a read waiting before it is hung up on.
+  static constexpr auto kReceiveTimeout = std::chrono::seconds{5};
+
+  /// @brief Listen on TCP port @p port of @p address for a BridgeSender, recording what it sends
+  /// into @p writer.
+  ///
+  /// @param port The port to listen on; zero picks a free one (see port()).
+  ///
+  /// @param address The IPv4 address to listen on; "0.0.0.0" listens on every interface.
+  ///
+  /// @param maxRecordSize Byte size of the largest record accepted; a sender announcing a larger
+  /// one is hung up on before anything is reserved for it.
+  ///
+  /// @throws std::invalid_argument If @p address is not an IPv4 address.
+  ///
+  /// @throws std::runtime_error If the port cannot be listened on.
+  explicit BridgeReceiver(
+      Writer& writer,
+      std::uint16_t port = 0U,
+      std::string_view address = kDefaultAddress,
+      std::uint64_t maxRecordSize = kDefaultMaxRecordSize);
+
+  BridgeReceiver(const BridgeReceiver&) = delete;
+
+  BridgeReceiver(BridgeReceiver&&) noexcept = delete;
+
+  /// @brief Hang up on the sender, if one is connected, and stop listening.
+  ~BridgeReceiver();
+
+  BridgeReceiver& operator=(const BridgeReceiver&) = delete;
+
+  BridgeReceiver& operator=(BridgeReceiver&&) noexcept = delete;
+
+  /// @brief Record and yield the records of channel @p channelId from now on.
+  void accept(ChannelId channelId);
+
+  /// @brief The next record, waiting up to @p timeout for a sender to connect and send one.
+  ///
+  /// @return The record, committed on the local Writer, or empty if none came in time.
+  ///
+  /// @throws std::runtime_error If a record does not fit in a roll, or the local timeline is full;
+  /// the connection is then dropped, as the stream can no longer be followed.
+  [[nodiscard]] std::optional<Entry> next(std::chrono::nanoseconds timeout);
+
+  /// The TCP port the receiver listens on.
+  [[nodiscard]] std::uint16_t port() const noexcept;
+
+  /// Whether a sender is connected.
+  [[nodiscard]] bool connected() const noexcept;
+
+private:
+  /// The Writer received records are committed to.
+  Writer& mWriter;
+
+  /// The listening socket.
+  const int mListener;
+
+  /// The TCP port mListener is bound to.
+  const std::uint16_t mPort;
+
+  /// Byte size of the largest record accepted.
+  const std::uint64_t mMaxRecordSize;
+
+  /// The connection to the current sender, or negative without one.
+  int mConnection{-1};
+
+  /// The channels accept() was called for.
+  std::unordered_set<ChannelId> mAccepted;
+
+  /// @brief Read one record off the connection: the committed record, or empty if it was dropped
+  /// or the sender hung up.
+  [[nodiscard]] std::optional<Entry> receive();
+
+  /// @brief Close the connection to the current sender.
+  void hangUp() noexcept;
+};
+
+} // namespace nioc::chronicle
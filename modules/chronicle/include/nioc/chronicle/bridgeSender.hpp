@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "defines.hpp"
+#include "writer.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace nioc::chronicle
+{
+
+/// @brief Streams the records a Writer commits on chosen channels to a BridgeReceiver on another
+/// host, sending each straight from its roll's file to the socket.
+///
+/// Example:
+///
+///     auto writer = nioc::chronicle::Writer{"/data/run42"};
+///     auto sender = nioc::chronicle::BridgeSender{writer, "rig-b.local", 7400};
+///     sender.forward(channelId); // before the channel's first write
+///
+/// Each committed record of a forwarded channel is queued on the committing thread as its
+/// TimelineEntry, along with its roll's file, held open. The sender's thread then writes a
+/// BridgeFrame header and has the kernel `sendfile` the record's bytes from the roll's page cache
+/// to the TCP socket: the payload is never copied through user space, nor serialized again. A roll
+/// sealed, compressed, or removed meanwhile stays readable through the open file.
+///
+/// The queue holds up to kMaxQueuedRecords records; while the link cannot keep up, records beyond
+/// that are dropped, counted, and logged as the sender closes. A send that stalls for kSendTimeout
+/// fails the connection, and once the connection fails, nothing more is sent.
+///
+/// Not copyable or movable. forward() is wiring-time; everything else runs on the sender's thread
+/// or the committing threads. Destroy the sender only once nothing writes to its channels.
+///
+/// @see BridgeReceiver, BridgeFrame, Broker
+class BridgeSender
+{
+public:
+  /// Most records waiting to be sent at once.
+  static constexpr auto kMaxQueuedRecords = std::size_t{1} << 16U;
+
+  /// Longest one send may stall, the receiver not reading, before the connection counts as failed.
+  static constexpr auto kSendTimeout = std::chrono::seconds{5};
+
+  /// Longest the destructor spends sending what is still queued; the rest is dropped.
+  static constexpr auto kDrainTimeout = std::chrono::seconds{5};
+
+  /// @brief Connect to the BridgeReceiver listening on @p host at @p port, forwarding records
+  /// committed to @p writer.
+  ///
+  /// @throws std::runtime_error If @p host cannot be resolved or connected to.
+  BridgeSender(Writer& writer, const std::string& host, std::uint16_t port);
+
+  BridgeSender(const BridgeSender&) = delete;
+
+  BridgeSender(BridgeSender&&) noexcept = delete;
+
+  /// @brief Send the records still queued, for up to kDrainTimeout (plus one kSendTimeout should a
+  /// send be stalled as it passes), then close the connection.
+  ~BridgeSender();
+
+  BridgeSender& operator=(const BridgeSender&) = delete;
+
+  BridgeSender& operator=(BridgeSender&&) noexcept = delete;
+
+  /// @brief Forward the records of channel @p channelId from now on.
+  ///
+  /// Call at wiring time, before the channel's first write (see Channel::observe). Forwarding a
+  /// channel twice has no effect.
+  ///
+  /// @throws std::logic_error If the channel's rolls are written directly (see Writeback), so its
+  /// records are not in their files yet to be sent from.
+  void forward(ChannelId channelId);
+
+private:
+  /// A roll's file, open read-only for as long as records of it wait to be sent.
+  struct RollFile;
+
+  /// One record waiting to be sent.
+  struct Pending
+  {
+    /// Locates the record in its roll.
+    TimelineEntry mEntry;
+
+    /// The record's roll.
+    std::shared_ptr<const RollFile> mRoll;
+  };
+
+  /// The Writer whose channels are forwarded.
+  Writer& mWriter;
+
+  /// The connected TCP socket.
+  const int mSocket;
+
+  /// The channels forward() was called for.
+  std::unordered_set<ChannelId> mForwarded;
+
+  /// Guards everything below it but the thread, touched by the committing threads and the sender's.
+  std::mutex mMutex;
+
+  /// The sender's thread waits on it for records to send, or until it is asked to stop.
+  std::condition_variable_any mCondition;
+
+  /// The records waiting to be sent, in commit order.
+  std::deque<Pending> mQueue;
+
+  /// Per forwarded channel, the roll its latest queued record lies in.
+  std::unordered_map<ChannelId, std::shared_ptr<const RollFile>> mRolls;
+
+  /// Records dropped because the queue was full, their roll could not be opened, or the drain ran
+  /// out of time.
+  std::uint64_t mDropped{0ULL};
+
+  /// Set once the connection has failed; records are no longer queued.
+  bool mFailed{false};
+
+  /// Sends the queued records. Declared last so it is stopped and joined before anything it touches
+  /// is destroyed.
+  std::jthread mThread;
+
+  /// @brief Sender thread loop: send queued records until @p stopToken is signalled and the queue
+  /// is empty or kDrainTimeout has passed since, or the connection fails.
+  void send(const std::stop_token& stopToken);
+
+  /// @brief Commit observer of each forwarded channel: queue @p entry to be sent.
+  void enqueue(const Channel& channel, const TimelineEntry& entry) noexcept;
+};
+
+} // namespace nioc::chronicle
@@ -0,0 +1,182 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "defines.hpp"
+#include "writer.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <stop_token>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace nioc::chronicle
+{
+
+/// @brief Shares the records a Writer commits on chosen channels with Subscribers in other
+/// processes, without copying a byte of them.
+///
+/// Example:
+///
+///     auto writer = nioc::chronicle::Writer{"/data/run42"};
+///     auto broker = nioc::chronicle::Broker{writer, "/run/nioc/run42.sock"};
+///     broker.share(channelId); // before the channel's first write
+///
+///     // In another process:
+///     auto subscriber = nioc::chronicle::Subscriber{"/run/nioc/run42.sock"};
+///     subscriber.subscribe(channelId);
+///
+/// The Broker listens on a Unix seqpacket socket. For each record committed on a shared channel, it
+/// sends every Subscriber of that channel one notice, the record's TimelineEntry. The first notice
+/// of each roll also carries a read-only descriptor of the roll's file (SCM_RIGHTS), which the
+/// Subscriber maps; from then on a notice is all it takes for the Subscriber to read the record in
+/// place from the page cache both processes share.
+///
+/// The committing thread only puts the entry in the channel's inbox, a lock-free ring of
+/// kInboxCapacity entries, and rings the Broker's thread awake unless it is ringing already. That
+/// thread drains the inboxes and sends each Subscriber its notices in batches, one system call per
+/// batch, opening each roll once for all of them.
+///
+/// Nothing blocks the committing thread: notices that do not fit a full inbox are dropped, and a
+/// Subscriber whose socket buffer is full misses the notices that do not fit it; the Broker counts
+/// both and logs them. Subscribers see only records committed after their subscription reached the
+/// Broker. A roll removed by retention stays readable to a Subscriber that still maps it, but one
+/// removed before the Broker's thread passes it on is not passed on.
+///
+/// Not copyable or movable. share() is wiring-time; everything else runs on the Broker's thread or
+/// the committing threads. Destroy the Broker only once nothing writes to its shared channels.
+///
+/// @see Subscriber, Channel::observe
+class Broker
+{
+public:
+  /// Most rolls per channel a Subscriber keeps mapped, the Broker assuming the same: it sends a
+  /// roll's descriptor again once the Subscriber has had to drop it.
+  static constexpr auto kOpenRollsPerChannel = std::size_t{4};
+
+  /// Most notices each shared channel's inbox holds for the Broker's thread; a power of two.
+  static constexpr auto kInboxCapacity = std::size_t{1} << 12U;
+
+  /// @brief Listen for Subscribers on the Unix socket at @p socketPath, sharing records committed
+  /// to @p writer.
+  ///
+  /// A file already at @p socketPath, such as a socket left behind by a Broker that crashed, is
+  /// replaced.
+  ///
+  /// @throws std::invalid_argument If @p socketPath is too long for a Unix socket.
+  ///
+  /// @throws std::runtime_error If the socket cannot be created, bound, or listened on.
+  Broker(Writer& writer, std::filesystem::path socketPath);
+
+  Broker(const Broker&) = delete;
+
+  Broker(Broker&&) noexcept = delete;
+
+  /// @brief Hang up on every Subscriber, then remove the socket. Notices still in the inboxes are
+  /// dropped.
+  ~Broker();
+
+  Broker& operator=(const Broker&) = delete;
+
+  Broker& operator=(Broker&&) noexcept = delete;
+
+  /// @brief Offer the records of channel @p channelId to Subscribers.
+  ///
+  /// Call at wiring time, before the channel's first write (see Channel::observe). Sharing a
+  /// channel twice has no effect.
+  ///
+  /// @throws std::logic_error If the channel's rolls are written directly (see Writeback), so its
+  /// records are not in their files yet for Subscribers to map.
+  void share(ChannelId channelId);
+
+  /// The Unix socket Subscribers connect to.
+  [[nodiscard]] const std::filesystem::path& path() const noexcept;
+
+private:
+  /// One connected Subscriber.
+  struct Client
+  {
+    /// The connected socket, non-blocking.
+    int mSocket;
+
+    /// The channels it subscribed to.
+    std::unordered_set<ChannelId> mChannels;
+
+    /// Per channel, the rolls whose descriptor it was sent and still maps, oldest first.
+    std::unordered_map<ChannelId, std::deque<std::uint64_t>> mRollsSent;
+
+    /// Notices that did not fit its socket buffer.
+    std::uint64_t mDropped{0ULL};
+  };
+
+  /// A shared channel's notices on their way to the Broker's thread.
+  struct Inbox;
+
+  /// The Writer whose channels are shared.
+  Writer& mWriter;
+
+  /// The Unix socket Subscribers connect to, returned by path().
+  const std::filesystem::path mSocketPath;
+
+  /// The listening socket.
+  const int mListener;
+
+  /// An eventfd the committing threads ring to wake the Broker's thread.
+  const int mDoorbell;
+
+  /// Set from the first ring until the Broker's thread answers, so rings in between cost nothing.
+  std::atomic<bool> mRung{false};
+
+  /// The channels share() was called for.
+  std::unordered_set<ChannelId> mShared;
+
+  /// The inboxes of the shared channels, owned here.
+  std::vector<std::unique_ptr<Inbox>> mInboxes;
+
+  /// The newest inbox, linked to the older ones, for the Broker's thread to walk while share()
+  /// adds more.
+  std::atomic<Inbox*> mNewestInbox{nullptr};
+
+  /// The connected Subscribers. Touched only by the Broker's thread.
+  std::vector<Client> mClients;
+
+  /// Accepts Subscribers, reads their subscriptions, and sends their notices. Declared last so it
+  /// is stopped and joined before anything it touches is destroyed.
+  std::jthread mThread;
+
+  /// @brief Broker thread loop: accept Subscribers, take in their subscriptions, hang up on those
+  /// that left, and deliver the notices rung in, until @p stopToken is signalled.
+  void serve(const std::stop_token& stopToken);
+
+  /// @brief Commit observer of each shared channel: put @p entry in @p inbox and ring the Broker's
+  /// thread.
+  void notify(Inbox& inbox, const TimelineEntry& entry) noexcept;
+
+  /// @brief Wake the Broker's thread.
+  void ring() const noexcept;
+
+  /// @brief Drain every inbox, sending each notice to the Subscribers of its channel. @p notices
+  /// is scratch space, kInboxCapacity entries reserved.
+  void deliver(std::vector<TimelineEntry>& notices) noexcept;
+
+  /// @brief Send @p client the notices of @p run, all in the same roll of @p inbox's channel.
+  void deliver(Client& client, Inbox& inbox, std::span<TimelineEntry> run) noexcept;
+
+  /// @brief Read the subscriptions @p client sent; false once it has hung up.
+  static bool readSubscriptions(Client& client) noexcept;
+
+  /// @brief Close @p client's socket, logging the notices it missed.
+  static void hangUp(const Client& client) noexcept;
+};
+
+} // namespace nioc::chronicle
@@ -8,17 +8,180 @@
 #include "crate.hpp"
 #include "defines.hpp"
 #include "reservation.hpp"
+#include "timeline.hpp"
+#include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
+#include <exception>
 #include <filesystem>
+#include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <nioc/containers/mmapArray.hpp>
 #include <nioc/containers/tape.hpp>
+#include <optional>
 #include <span>
+#include <thread>
+#include <vector>
 
 namespace nioc::chronicle
 {
 
+/// @brief One roll of a Channel while it is open for writing, shared by the reservations that
+/// write into it.
+///
+/// Sealing a roll trims its file, so it must not start while a reservation still writes into the
+/// roll. Every reservation enters the lease for as long as it is open; sealing closes the lease to
+/// newcomers, then waits for the ones inside to leave. Entering and leaving are lock-free.
+///
+/// Under WriteMode::Direct, the lease also tells the channel which of the roll's bytes are settled,
+/// written by reservations that have all left and never to be written again, so it can write them
+/// through to the roll's file while the roll is still active.
+///
+/// @see Channel, Reservation
+class RollLease
+{
+public:
+  /// A roll: one memory-mapped data file, appended to through a Tape.
+  using Roll = containers::Tape<containers::MmapArray<std::byte>>;
+
+  /// @brief Lease @p roll, the roll @p rollId of its channel, to reservations.
+  RollLease(std::shared_ptr<Roll> roll, std::uint64_t rollId) noexcept;
+
+  RollLease(const RollLease&) = delete;
+
+  RollLease(RollLease&&) noexcept = delete;
+
+  ~RollLease() = default;
+
+  RollLease& operator=(const RollLease&) = delete;
+
+  RollLease& operator=(RollLease&&) noexcept = delete;
+
+  /// @brief The leased roll.
+  [[nodiscard]] const std::shared_ptr<Roll>& roll() const noexcept;
+
+  /// @brief Id of the leased roll within its channel.
+  [[nodiscard]] std::uint64_t rollId() const noexcept;
+
+  /// @brief Register one more reservation writing into the roll.
+  ///
+  /// @return False, registering nothing, once close() has been called.
+  [[nodiscard]] bool enter() noexcept;
+
+  /// @brief Unregister a reservation that entered, waking close() if it was the last one.
+  void leave() noexcept;
+
+  /// @brief Turn away further reservations, then wait until every one that entered has left.
+  void close() noexcept;
+
+  /// @brief The roll's size, if no reservation was inside the lease while it was read: every byte
+  /// before it is then settled, as later reservations only claim past it. Null otherwise.
+  ///
+  /// Settled bytes are final only while no lane carves from the roll, whose chunks are claimed
+  /// ahead of the reservations carved from them.
+  [[nodiscard]] std::optional<std::uint64_t> settledSize() const noexcept;
+
+  /// @brief Bytes at the start of the roll already written through to its file for good.
+  ///
+  /// Read and changed only under the channel's mWriteThroughMutex.
+  [[nodiscard]] std::uint64_t writtenThrough() const noexcept;
+
+  /// @brief Record that the roll's first @p size bytes are written through to its file for good.
+  void markWrittenThrough(std::uint64_t size) noexcept;
+
+private:
+  /// Set in mWriters once close() is called. The reservations inside count in the bits below it.
+  static constexpr auto kClosed = std::uint64_t{1ULL} << 31U;
+
+  /// Added to mWriters by each leave(), which counts them in the bits above kClosed, so a reader
+  /// of mWriters notices a reservation that came and went.
+  static constexpr auto kLeft = std::uint64_t{1ULL} << 32U;
+
+  /// The bits of mWriters that count the reservations inside.
+  static constexpr auto kInside = kClosed - 1ULL;
+
+  /// The leased roll.
+  std::shared_ptr<Roll> mRoll;
+
+  /// Id of the leased roll within its channel.
+  std::uint64_t mRollId;
+
+  /// Reservations inside the lease, plus kClosed once it is closed, plus kLeft per one that left.
+  std::atomic<std::uint64_t> mWriters{0ULL};
+
+  /// See writtenThrough().
+  std::uint64_t mWrittenThrough{0ULL};
+};
+
+/// @brief One producing thread's share of a multi-producer Channel's active roll: a chunk of the
+/// roll that only its thread carves reservations from.
+///
+/// A lane outlives its thread: once the thread exits, the channel hands the lane, chunk and all,
+/// to the next thread that starts writing.
+///
+/// @see Channel
+struct ChannelLane
+{
+  /// The thread that carves from the lane; nothing else touches mChunk and mCarved.
+  std::atomic<std::thread::id> mThread;
+
+  /// Set as mThread exits, so the channel may hand the lane to another thread.
+  std::atomic<bool> mVacant{false};
+
+  /// The lease the lane's chunk lies in, so the lane notices a rollover. Weak, so a lane whose
+  /// thread stopped writing does not keep a sealed roll mapped.
+  std::weak_ptr<RollLease> mLease;
+
+  /// The chunk claimed from mLease's roll for this lane alone.
+  std::span<std::byte> mChunk;
+
+  /// Bytes of mChunk carved into reservations so far.
+  std::size_t mCarved{0};
+};
+
+/// @brief Where the bytes a Channel reserved went: into records, back to the roll for reuse, or
+/// nowhere, left in its rolls as slack.
+///
+/// Every reserved byte ends up committed, reclaimed, stranded, or abandoned; lane slack comes on
+/// top. Counts are cumulative over the channel's life, and compact() rewrites a closed chronicle
+/// without the slack.
+///
+/// @see Channel::usage
+struct ChannelUsage
+{
+  /// Bytes handed out by reserve(), each reservation rounded up to a word.
+  std::uint64_t mReservedBytes{0ULL};
+
+  /// Bytes of committed records.
+  std::uint64_t mCommittedBytes{0ULL};
+
+  /// Reserved bytes handed back for later reservations: unused tails trimmed at commit or by
+  /// Reservation::modify, and dropped reservations that were still the latest claim.
+  std::uint64_t mReclaimedBytes{0ULL};
+
+  /// Reserved bytes left behind committed records: word padding, and unused tails that a later
+  /// claim kept from being handed back.
+  std::uint64_t mStrandedBytes{0ULL};
+
+  /// Bytes of reservations dropped, or outgrown by Reservation::modify, that a later claim kept
+  /// from being handed back: holes in the middle of a roll.
+  std::uint64_t mAbandonedBytes{0ULL};
+
+  /// Bytes of lane chunks that their thread left uncarved when it moved on to a fresh chunk or roll
+  /// (see ChannelLane).
+  std::uint64_t mLaneSlackBytes{0ULL};
+
+  /// @brief Bytes written into rolls that hold no record.
+  [[nodiscard]] std::uint64_t wastedBytes() const noexcept
+  {
+    return mStrandedBytes + mAbandonedBytes + mLaneSlackBytes;
+  }
+};
+
 /// @brief An append-only byte log for a single stream of data, a.k.a. a Channel: stores each
 /// record's bytes and indexes it on a shared timeline.
 ///
@@ -27,38 +190,133 @@ namespace nioc::chronicle
 /// each committed record on a timeline shared with readers. Write a record in one call with
 /// write(), or in stages: reserve() space, fill the returned span, then commit.
 ///
-/// Not copyable and not movable: pass it by reference, never by value. Not thread-safe; serialize
-/// all access to a given Channel yourself. A Writer creates and owns its Channels; do not construct
-/// one standalone.
+/// A roll's file starts small and grows in place, at least doubling, as records fill it, up to the
+/// roll capacity, whose address space is reserved from the start; so records never move, and an
+/// idle channel holds a small file rather than a full roll's worth.
+///
+/// Rolling over stays off the writing thread's critical path. While a roll is active, a helper
+/// thread creates and sizes the next one as a spare, so rollover swaps in the ready spare; the
+/// full roll is trimmed and released on another helper. The writing thread never waits for a spare:
+/// a record larger than the roll capacity, or a rollover that finds the spare not yet ready, opens
+/// its roll inline, and the spare waits for the next rollover. An unused spare is deleted when the
+/// channel closes.
+///
+/// The channel accounts for every byte it reserves, so the slack its rolls carry shows in usage().
 ///
-/// @see Reservation, Crate, Writer
+/// Under containers::WriteMode::Direct, rolls are staged in memory and written to their files with
+/// direct I/O (see Writeback): the settled bytes of the active roll as the Writer paces them, the
+/// rest as the seal helper seals the roll. The channel keeps its durable marks, the timeline length
+/// up to which its records' bytes are on disk, next to its rolls, so recover() can cut the timeline
+/// of a crashed Writer back to records that survived it.
+///
+/// Rolls staged in memory are pooled. Once a roll is sealed, or under WriteMode::Memory once it is
+/// full, it waits in the pool until no Reservation or Crate holds it any longer. Then the next
+/// spare is made of it rather than of fresh memory: emptied, and under WriteMode::Direct pointed at
+/// the new roll's file, which starts small however far the roll grew. Its pages are already mapped
+/// and faulted in, so a busy channel does not map, fault in, and unmap a roll's worth of memory on
+/// every rollover. The pool keeps a bounded number and size of idle rolls and frees the rest, so
+/// the channel's memory stays within the rolls its consumers hold, the pool, and the active and
+/// spare rolls.
+///
+/// Under a Retention policy, sealing a roll also deletes the oldest sealed rolls beyond its limits,
+/// and so does expire() for the age limit, so the channel keeps a window of its most recent rolls.
+/// The channel tracks where on the timeline its oldest roll on disk begins (see keptFrom), so its
+/// Writer can discard the timeline entries before every channel's window, and the channel the
+/// entry index positions before them.
+///
+/// A channel kept in memory (see MemoryWriter) writes its rolls to in-memory files under
+/// containers::WriteMode::Memory and its records to no timeline. It seals nothing: a full roll
+/// goes straight to the pool, so a stream of records published and let go cycles through a few
+/// rolls.
+///
+/// Any number of threads may reserve and write at once. A channel written by a single thread
+/// claims each reservation straight from the active roll, as it always has. Once a second thread
+/// reserves, the channel turns multi-producer for good: each producing thread then carves its
+/// reservations from a lane, a chunk of the active roll claimed for that thread alone. Claims on
+/// the roll stay lock-free and rare, and a commit can always hand the unused tail of its
+/// reservation back to the lane, since nothing else claims from it. What a lane has not carved by
+/// the time its thread moves to a fresh chunk is handed back to the roll when no other lane has
+/// claimed past it; the rest, at most a lane's chunk per thread and roll, is the only slack left.
+/// Rolling over takes a mutex, once per roll, and sealing a roll waits until no reservation still
+/// writes into it (see RollLease).
+///
+/// Not copyable and not movable: pass it by reference, never by value. A Reservation must be
+/// committed or dropped before its Channel is destroyed. A Writer or MemoryWriter creates and owns
+/// its Channels; do not construct one standalone.
+///
+/// @see Reservation, Crate, Timeline, Writer, MemoryWriter
 class Channel
 {
 public:
+  /// Called with the timeline entry of each record the channel commits, on the committing thread.
+  using CommitObserver = std::function<void(const TimelineEntry&)>;
+
   /// @brief Bind a channel to its on-disk roll directory and a shared timeline.
   ///
-  /// No directory or file is touched here; the directory is created on the first reserve().
+  /// No directory or file is touched here; the directory is created on the first reserve(). From
+  /// then on, unless the timeline is sharded, each commit appends its timeline position to the
+  /// channel's entry index, which the channel puts in place as it closes (see buildChannelIndices).
   ///
   /// @param channelId Identity stamped onto every record written through this channel.
   ///
   /// @param channelDir Directory that holds this channel's rolls. Copied and stored.
   ///
-  /// @param rollCapacity Bytes each new roll is sized to. A record larger than this grows its own
-  /// roll to fit.
+  /// @param rollCapacity Bytes each roll grows to before the channel rolls over. A roll's file
+  /// starts smaller and grows as records fill it. A record larger than this gets a roll of its own.
   ///
   /// @param timeline Shared record index. Must outlive this channel; each commit appends to
   /// it.
+  ///
+  /// @param retention How many sealed rolls to keep; keeps all of them by default.
+  ///
+  /// @param compression Whether to compress each roll once it is sealed; off by default.
+  ///
+  /// @param writeback How the rolls' bytes reach their files, and how many idle rolls to keep for
+  /// reuse under WriteMode::Direct. Under paced writeback the helper sealing a roll also flushes
+  /// it to disk; otherwise sync() flushes the rolls sealed since it last ran. Mapped, unpaced
+  /// rolls by default.
+  ///
+  /// @param mapPolicy How the rolls are mapped; lazily by default.
   Channel(
       ChannelId channelId,
       std::filesystem::path channelDir,
       std::size_t rollCapacity,
-      containers::Tape<containers::MmapArray<TimelineEntry>>& timeline);
+      Timeline& timeline,
+      Retention retention = {},
+      Compression compression = {},
+      const Writeback& writeback = {},
+      containers::MapPolicy mapPolicy = {});
+
+  /// @brief Bind a channel kept in memory, whose rolls never reach a disk and whose records go on
+  /// no timeline.
+  ///
+  /// @param channelId Identity stamped onto every record written through this channel.
+  ///
+  /// @param rollCapacity Bytes each roll grows to before the channel moves on to another. A record
+  /// larger than this gets a roll of its own.
+  ///
+  /// @param mapPolicy How the rolls are mapped; lazily by default.
+  ///
+  /// @param pooledRolls Most idle rolls to keep for reuse.
+  ///
+  /// @param pooledBytes Most bytes the idle rolls kept for reuse may hold between them.
+  Channel(
+      ChannelId channelId,
+      std::size_t rollCapacity,
+      containers::MapPolicy mapPolicy = {},
+      std::size_t pooledRolls = kDefaultPooledRolls,
+      std::uint64_t pooledBytes = kDefaultPooledBytes);
 
   Channel(const Channel&) = delete;
 
   Channel(Channel&&) noexcept = delete;
 
-  /// @brief Seal the active roll, trimming its data file down to the bytes actually written.
+  /// @brief Seal the active roll on the seal helper as a full one is sealed, writing it through
+  /// under WriteMode::Direct, trimming its data file down to the bytes actually written and
+  /// compressing it if so configured; meanwhile put the entry index in place and delete the unused
+  /// spare roll, then wait for the seal. Logs the bytes the channel wasted, if any (see usage()),
+  /// and a failure to seal. A channel kept in memory only lets go of its rolls; crates still
+  /// holding one keep it mapped.
   ~Channel();
 
   Channel& operator=(const Channel&) = delete;
@@ -68,13 +326,24 @@ public:
   /// @brief This channel's identity, as supplied at construction.
   [[nodiscard]] ChannelId id() const noexcept;
 
+  /// @brief How the channel's rolls reach their files, as supplied at construction.
+  [[nodiscard]] containers::WriteMode writeMode() const noexcept;
+
+  /// @brief Number of lanes the channel keeps for its producing threads: at most one per thread
+  /// writing at once, since a thread that exits leaves its lane to the next one.
+  [[nodiscard]] std::size_t laneCount() const;
+
+  /// @brief Where the bytes reserved so far went. Safe to call alongside the writing threads; the
+  /// counts are read one at a time, so they may be mutually off by the reservations in flight.
+  [[nodiscard]] ChannelUsage usage() const noexcept;
+
   /// @brief Reserve a writable byte span for one record, to be filled and then committed.
   ///
   /// Rounds @p size up to a word boundary and carves that many bytes from the active roll, opening
   /// a fresh roll first when the current one cannot fit. The returned Reservation borrows space in
   /// the channel: fill its span(), then commit it to publish the record, or drop it to release the
-  /// space. Each outstanding reservation keeps its roll alive. Creates the channel directory on its
-  /// first call.
+  /// space. Each outstanding reservation keeps its roll alive, and open for writing. Creates the
+  /// channel directory on its first call. Thread-safe.
   ///
   /// @param size Minimum writable bytes needed. The returned span may be larger after rounding.
   [[nodiscard]] Reservation reserve(std::size_t size);
@@ -82,37 +351,268 @@ public:
   /// @brief Append @p data as a single record and return a Crate viewing the stored bytes.
   ///
   /// Shorthand for reserve(), copy into the span, then commit. The returned Crate keeps the
-  /// underlying roll alive for as long as it lives.
+  /// underlying roll alive for as long as it lives. Thread-safe.
   ///
   /// @throws std::runtime_error If the shared timeline is full.
   Crate write(std::span<const std::byte> data);
 
+  /// @brief Call @p observer with the timeline entry of every record committed from now on.
+  ///
+  /// The observer runs on each committing thread, possibly on several at once, once the record is
+  /// on the timeline but before its roll can be sealed, so the roll's file is still at rollPath()
+  /// while it runs. It must not throw. Call at wiring time, before the channel's first write:
+  /// registering is not synchronized against concurrent commits.
+  void observe(CommitObserver observer);
+
+  /// @brief Path of the roll @p rollId of this channel, whether or not it exists (yet or still).
+  [[nodiscard]] std::filesystem::path rollPath(std::uint64_t rollId) const;
+
+  /// @brief Start writing back the active roll's bytes claimed since the previous call, at most
+  /// @p budget of them, without waiting for the I/O.
+  ///
+  /// Safe to call from one thread alongside the writing threads. Under WriteMode::Direct, whose
+  /// rolls leave no dirty pages, writes the active roll's bytes through instead, from the first not
+  /// yet settled on its file, and waits for them; once that covers the roll and every earlier roll
+  /// is sealed, flushes the roll and advances the durable marks. Does nothing under
+  /// WriteMode::Memory. A failure is logged, and left to the seal.
+  ///
+  /// @param budget Most bytes to start writing back.
+  ///
+  /// @return The number of bytes whose writeback was started, or that were written through.
+  std::uint64_t startWriteback(std::uint64_t budget) noexcept;
+
+  /// @brief Make every record committed so far durable on disk: waits for the last full roll's
+  /// seal, flushes the rolls sealed since the previous call unless their seals did, then flushes
+  /// the active roll, writing it through first under WriteMode::Direct and then advancing the
+  /// durable marks.
+  ///
+  /// Safe to call alongside the writing threads; records committed meanwhile may or may not be
+  /// covered.
+  ///
+  /// @throws std::runtime_error If a roll cannot be flushed, or a seal failed since the previous
+  /// call, leaving records of its roll short of the disk. A failed seal is reported once.
+  void sync();
+
+  /// @brief Delete the sealed rolls older than the retention's age limit now, rather than at the
+  /// next seal, so a channel that has gone quiet ages out too. A Writer's pacing thread calls it.
+  ///
+  /// Safe to call from one thread alongside the writing threads. A failure is logged.
+  void expire() noexcept;
+
+  /// @brief The timeline length as the oldest roll still on disk opened: every record the channel
+  /// keeps lies at this position or later. The largest position if no roll is open yet, or if no
+  /// retention limit applies and so no roll is tracked.
+  [[nodiscard]] std::uint64_t keptFrom() const;
+
+  /// @brief Free the leading whole pages of the entry index whose positions all lie below
+  /// @p position, once the timeline has discarded the entries before it. They read as zero, which
+  /// sorts ahead of every kept position.
+  ///
+  /// Safe to call from one thread alongside the writing threads. A failure is logged.
+  void discardIndex(std::uint64_t position) noexcept;
+
 private:
   friend class Reservation;
 
+  using Roll = RollLease::Roll;
+
+  /// Most bytes a producer thread claims from the roll for its lane at a time: large enough that
+  /// claims on the shared roll are rare, small enough that an abandoned chunk wastes little.
+  static constexpr auto kLaneCapacity = std::size_t{64ULL * 1024ULL};
+
+  /// Most positions a channel's entry index reserves address space for, 2 GiB worth. A channel
+  /// that commits more leaves no index, and readers scan the timeline for its records instead.
+  static constexpr auto kMaxIndexedRecords = std::size_t{1ULL << 28U};
+
+  /// Timeline positions of the records a channel commits, in a file that grows as they do.
+  using PositionTape = containers::Tape<containers::MmapArray<std::uint64_t>>;
+
   const ChannelId mChannelId;
   const std::filesystem::path mChannelDir;
   const std::size_t mRollCapacity;
-  containers::Tape<containers::MmapArray<TimelineEntry>>& mTimeline;
-  std::shared_ptr<containers::Tape<containers::MmapArray<std::byte>>> mActiveRoll;
-  std::uint64_t mActiveRollId{0ULL};
+
+  /// The shared timeline each commit appends to, or null for a channel kept in memory.
+  Timeline* const mTimeline;
+
+  /// Timeline positions of this channel's committed records, appended as each commits, at the
+  /// entry index's path with kTemporaryFileSuffix until the channel closes. Null until the first
+  /// roll opens, and for good on a sharded timeline or in memory.
+  std::unique_ptr<PositionTape> mIndex;
+
+  /// Set once a position failed to reach mIndex, so the channel leaves no index behind.
+  std::atomic<bool> mIndexIncomplete{false};
+
+  /// The lease on the active roll, or null until the first roll opens.
+  std::shared_ptr<RollLease> mActiveRoll;
+
+  /// Id of the active roll, published once mActiveRoll changes so producers notice a rollover
+  /// without taking mRollMutex.
+  std::atomic<std::uint64_t> mActiveRollId{0ULL};
+
+  /// Tells this channel's lanes apart from those of every other channel, in a thread's lane cache.
+  const std::uint64_t mSerial;
+
+  /// The first thread to reserve on the channel.
+  std::atomic<std::thread::id> mOwner;
+
+  /// Whether a thread other than mOwner has reserved, so every producer now uses a lane.
+  std::atomic<bool> mMultiProducer{false};
+
+  /// The lease mOwner reserves in while the channel is single-producer. Only that thread touches
+  /// it. Weak, like a lane's, so an idle producer does not keep a sealed roll mapped.
+  std::weak_ptr<RollLease> mOwnerLease;
+
+  /// Every lane handed out, owned here so they last as long as the channel, and shared with the
+  /// lane cache of the thread writing through each.
+  std::vector<std::shared_ptr<ChannelLane>> mLanes;
+
+  /// One sealed roll still on disk, as the retention policy tracks it.
+  struct SealedRoll
+  {
+    std::uint64_t mRollId{0ULL};
+
+    /// Bytes written into the roll, which is its size once sealed.
+    std::uint64_t mSize{0ULL};
+
+    /// When the roll was sealed, which is shortly after its last record.
+    std::chrono::system_clock::time_point mSealedAt;
+  };
+
+  /// Which sealed rolls to delete.
+  const Retention mRetention;
+
+  /// Whether and how the seal helper compresses each sealed roll.
+  const Compression mCompression;
+
+  /// How every roll of the channel is opened.
+  const containers::WriteMode mWriteMode;
+
+  /// How every roll of the channel is mapped.
+  const containers::MapPolicy mMapPolicy;
+
+  /// Most idle rolls mRollPool keeps; it frees any more it finds.
+  const std::size_t mPooledRolls;
+
+  /// Most bytes the idle rolls in mRollPool hold between them; it frees the rolls past it.
+  const std::uint64_t mPooledBytes;
+
+  /// Whether each seal flushes its roll; otherwise the roll waits in mUnsyncedRolls for sync().
+  const bool mSyncOnSeal;
+
+  /// The counts behind usage(), each updated on its own by the reserving and committing threads.
+  std::atomic<std::uint64_t> mReservedBytes{0ULL};
+  std::atomic<std::uint64_t> mCommittedBytes{0ULL};
+  std::atomic<std::uint64_t> mReclaimedBytes{0ULL};
+  std::atomic<std::uint64_t> mStrandedBytes{0ULL};
+  std::atomic<std::uint64_t> mAbandonedBytes{0ULL};
+  std::atomic<std::uint64_t> mLaneSlackBytes{0ULL};
+
+  /// Called with each committed record's timeline entry, in registration order.
+  std::vector<CommitObserver> mObservers;
+
+  /// Guards mSealedRolls, mSealedBytes, and mRollStarts, which the seal helpers and expire() trim.
+  mutable std::mutex mRetentionMutex;
+
+  /// The sealed rolls still on disk, oldest first. Tracked only under a retention limit.
+  std::deque<SealedRoll> mSealedRolls;
+
+  /// Total size of mSealedRolls.
+  std::uint64_t mSealedBytes{0ULL};
+
+  /// The timeline length as each roll still on disk opened, oldest roll first, sealed or not.
+  /// Tracked only under a retention limit.
+  std::deque<std::uint64_t> mRollStarts;
+
+  /// Leading slots of mIndex that discardIndex() found below the discarded positions.
+  std::size_t mIndexDiscarded{0};
+
+  /// Slots of mIndex claimed as discardIndex() last ran; it scans only these.
+  std::size_t mIndexClaimed{0};
+
+  /// The next roll, able to grow to mRollCapacity, being prepared by a helper thread at
+  /// kSpareRollFileName until a rollover takes it. Invalid until the first roll opens.
+  std::future<std::shared_ptr<Roll>> mSpareRoll;
+
+  /// The helper sealing the last full roll; it waits for the seal before it first. Invalid until
+  /// the first rollover. Shared so sync() can wait on it from another thread. Never throws: a
+  /// failure is kept in mSealFailure.
+  std::shared_future<void> mSealedRoll;
+
+  /// Guards mUnsyncedRolls and mSealFailure, set by the seal helpers and taken by sync().
+  std::mutex mSealMutex;
+
+  /// The rolls sealed without a flush, as mSyncOnSeal is off, and not flushed since.
+  std::vector<std::uint64_t> mUnsyncedRolls;
+
+  /// The first failure of a seal not yet reported by sync(), or null.
+  std::exception_ptr mSealFailure;
+
+  /// Bytes of the active roll whose writeback startWriteback() has already started.
+  std::uint64_t mWrittenBack{0ULL};
+
+  /// Under WriteMode::Direct, one per timeline shard: the length before which every entry of this
+  /// channel has its record's bytes on disk, at kDurableMarksFileName. Null until the first roll
+  /// opens, and for good under any other write mode. Set under mRollMutex, written under
+  /// mWriteThroughMutex.
+  std::unique_ptr<containers::MmapArray<std::uint64_t>> mDurableMarks;
+
+  /// The timeline's committed lengths as last scanned for the durable marks, one per shard.
+  std::vector<std::uint64_t> mDurableScan;
+
+  /// The rolls staged in memory that the channel is done with, each reused as a spare once nothing
+  /// else holds it. Empty under WriteMode::Mapped.
+  std::vector<std::shared_ptr<Roll>> mRollPool;
+
+  /// Guards the roll handover in openNewRoll(): mActiveRoll, mSpareRoll, mSealedRoll,
+  /// mWrittenBack, and mRollPool are read and changed only under it, and so is mLanes.
+  mutable std::mutex mRollMutex;
+
+  /// Serializes writing the rolls through to their files and sealing them, under WriteMode::Direct,
+  /// with the durable marks and mDurableScan. Taken before mRollMutex, never under it.
+  std::mutex mWriteThroughMutex;
 
   /// @brief Return the unused tail of @p reservation's span to the active roll, keeping only its
   /// first @p usedSize bytes.
   ///
-  /// Only the roll's most recent claim can shrink; if the roll declines (e.g. another reservation
-  /// has since claimed space past this one), the span stays at full size and a warning is logged
-  /// rather than throwing. Called when a Reservation is dropped (@p usedSize 0, releasing all) and
-  /// internally by modify() to shrink in place.
+  /// Only the most recent claim on the roll, or carve from a lane, can shrink; if it declines (see
+  /// reclaim), the span stays at full size and a warning is logged rather than throwing. Called
+  /// when a Reservation is dropped (@p usedSize 0, releasing all) and internally by modify() to
+  /// shrink in place.
   ///
   /// @param reservation The reservation whose span is being trimmed.
   ///
   /// @param usedSize Bytes to keep from the span's front; 0 (the default) releases all of it.
-  void rewind(const Reservation& reservation, std::size_t usedSize = 0);
+  ///
+  /// @return Whether the tail was returned.
+  bool rewind(const Reservation& reservation, std::size_t usedSize = 0);
+
+  /// @brief Return the unused tail of @p reservation's span to where it was carved from, keeping
+  /// its first @p keptSize bytes.
+  ///
+  /// Declines, returning false, when something was claimed or carved after the reservation, or
+  /// when its lane belongs to another thread than the calling one.
+  ///
+  /// @return Whether the tail was returned.
+  [[nodiscard]] bool reclaim(const Reservation& reservation, std::size_t keptSize) noexcept;
+
+  /// @brief Account for @p reservation, about to be committed with @p committedSize bytes published
+  /// and the first @p keptSize bytes of its span kept in the roll.
+  void accountCommit(
+      const Reservation& reservation,
+      std::size_t keptSize,
+      std::size_t committedSize) noexcept;
+
+  /// @brief Account for @p reservation, about to be dropped with the first @p keptSize bytes of its
+  /// span left in the roll: none if they were handed back, all of them otherwise.
+  void accountDrop(const Reservation& reservation, std::size_t keptSize) noexcept;
+
+  /// @brief Account for the uncarved tail of @p lane's chunk, which its thread is leaving behind.
+  void accountLaneSlack(const ChannelLane& lane) noexcept;
 
   /// @brief Resize @p reservation to @p newSize bytes, updating it in place.
   ///
-  /// Shrinks within the existing span when @p newSize fits (via rewind); otherwise releases the old
+  /// Shrinks within the existing span when @p newSize fits (via rewind), narrowing the span to the
+  /// word-rounded @p newSize when the tail is handed back; otherwise releases the old
   /// span and reseats @p reservation onto a fresh reservation of @p newSize, which may open a new
   /// roll. The handle is rebound either way, so any span() taken earlier is invalidated.
   ///
@@ -123,21 +623,129 @@ private:
   /// @see rewind, reserve
   void modify(Reservation& reservation, std::size_t newSize);
 
-  /// @brief Seal the active roll and install a fresh one to append into.
+  /// @brief Seal the roll @p full and install a fresh one to append into, unless another producer
+  /// already has.
+  ///
+  /// Hands the current roll to a helper that shrinks it to its written bytes, then bumps the roll
+  /// id and installs the spare. When @p minCapacity exceeds the roll capacity the spare is
+  /// discarded and a roll of @p minCapacity bytes is opened inline, so an oversized record still
+  /// fits in a roll of its own; when the spare is not ready yet, the roll opens inline too, from a
+  /// pooled roll if one is free. Either way, preparation of the next spare starts before returning,
+  /// unless one is still under way.
   ///
-  /// Shrinks the current roll to its written bytes and bumps the roll id before allocating the
-  /// replacement, which is sized to the larger of the channel's roll capacity and @p minCapacity so
-  /// an oversized record still fits in a roll of its own.
+  /// @param full The lease on the roll found full, or null to only open the first roll if need be.
   ///
   /// @param minCapacity Smallest byte capacity the new roll must have.
-  void openNewRoll(std::size_t minCapacity);
+  ///
+  /// @return The lease on the active roll.
+  std::shared_ptr<RollLease> openNewRoll(const RollLease* full, std::size_t minCapacity);
+
+  /// @brief The calling thread's lane, or null while the channel is single-producer and the calling
+  /// thread is its producer. A thread new to the channel takes over a lane another thread left as
+  /// it exited, if there is one.
+  ChannelLane* laneOfThisThread();
+
+  /// @brief Carve @p size bytes from @p lane's chunk, claiming a fresh chunk from @p lease's roll,
+  /// the one the lane is in, when the current one runs out.
+  ///
+  /// @return The carved bytes, or an empty span when the roll is full.
+  [[nodiscard]] std::span<std::byte> carve(
+      ChannelLane& lane,
+      const RollLease& lease,
+      std::size_t size);
+
+  /// @brief Take the spare roll, or return null if none is being prepared or its preparation
+  /// failed.
+  ///
+  /// @param helper Receives the preparing helper's future once the spare is taken. Letting go of
+  /// it joins the helper's thread, so a caller holding mRollMutex lets go only once unlocked.
+  ///
+  /// @param wait Whether to wait for a spare still being prepared; if not, returns null and leaves
+  /// it to the next call.
+  [[nodiscard]] std::shared_ptr<Roll> takeSpareRoll(
+      std::shared_future<std::shared_ptr<Roll>>& helper,
+      bool wait = true) noexcept;
+
+  /// @brief Unless one is being prepared already, start preparing a spare roll on a helper thread,
+  /// from a pooled roll if one is free.
+  void prepareSpareRoll();
+
+  /// @brief Take a roll from mRollPool that nothing else holds, emptied for reuse, or return null
+  /// if there is none. Frees idle rolls beyond mPooledRolls or mPooledBytes on the way.
+  [[nodiscard]] std::shared_ptr<Roll> takePooledRoll();
+
+  /// @brief Put @p roll in mRollPool, or free it if it alone exceeds mPooledBytes or the pool keeps
+  /// no rolls. Called under mRollMutex.
+  void poolRoll(std::shared_ptr<Roll> roll);
+
+  /// @brief On a helper thread, after the previous roll's seal, seal @p lease's roll (see seal).
+  /// A failure is logged and kept for sync() to report.
+  void sealInBackground(std::shared_ptr<RollLease> lease, bool closing = false);
 
-  /// @brief Record @p entry on the shared timeline, indexing one committed record.
+  /// @brief Wait until no reservation writes into @p lease's roll, write it through under
+  /// WriteMode::Direct, shrink it to its written bytes, flush it to disk if mSyncOnSeal, compress
+  /// it if so configured, retire it, and pool it under WriteMode::Direct.
+  ///
+  /// @param closing Whether @p lease holds the last roll, sealed as the channel closes: it stays
+  /// on top of the retention budget, as the active roll does, and is not pooled.
+  void seal(std::shared_ptr<RollLease> lease, bool closing);
+
+  /// @brief Flush the rolls in mUnsyncedRolls, then rethrow a seal failure sync() has not reported
+  /// yet.
+  void syncSealedRolls();
+
+  /// @brief Compress the sealed roll @p rollId if so configured. A failure is logged, and leaves
+  /// the roll uncompressed.
+  void compress(std::uint64_t rollId) const noexcept;
+
+  /// @brief Record that the roll @p rollId of @p size bytes was sealed, then delete the oldest
+  /// sealed rolls until the retention limits hold. Called by the seal helpers, one at a time.
+  void retire(std::uint64_t rollId, std::uint64_t size);
+
+  /// @brief Delete the oldest sealed rolls until the retention limits hold at @p now. Called under
+  /// mRetentionMutex.
+  void prune(std::chrono::system_clock::time_point now);
+
+  /// @brief Record @p entry on the shared timeline, indexing one committed record, with the
+  /// checksum of @p record if the timeline keeps checksums, then tell the observers. A channel kept
+  /// in memory only tells the observers.
   ///
   /// @param entry Timeline entry locating the just-committed record.
   ///
+  /// @param record The just-committed record's bytes.
+  ///
   /// @throws std::runtime_error If the shared timeline is at capacity.
-  void append(const TimelineEntry& entry);
+  void append(const TimelineEntry& entry, std::span<const std::byte> record);
+
+  /// @brief Start the entry index at the first roll, unless the timeline is sharded: its positions
+  /// count along the order its shards merge into, known only once the Writer closes.
+  void openIndex();
+
+  /// @brief Append @p position to the entry index; if it does not fit, give the index up.
+  void indexPosition(std::uint64_t position) noexcept;
+
+  /// @brief Put the entry index in place, its positions sorted, as lanes may commit out of order;
+  /// or, if it was given up, remove it so readers scan the timeline. Logs a failure.
+  void closeIndex() noexcept;
+
+  /// @brief Start the durable marks at the first roll, all zero, under WriteMode::Direct.
+  void openDurableMarks();
+
+  /// @brief Scan the timeline for the entries committed since the last scan. Their records' bytes
+  /// are all in the staged rolls by now. Called under mWriteThroughMutex.
+  ///
+  /// @return The committed length of each shard.
+  std::vector<std::uint64_t> scanDurable();
+
+  /// @brief Raise @p marks to @p committed and flush them, once every record committed within
+  /// @p committed is on disk. Called under mWriteThroughMutex.
+  static void advanceDurableMarks(
+      containers::MmapArray<std::uint64_t>& marks,
+      std::span<const std::uint64_t> committed);
+
+  /// @brief Write the active roll's unsettled bytes through, at most @p budget of them, and advance
+  /// the durable marks if that covers every committed record (see startWriteback).
+  std::uint64_t writeThroughActive(std::uint64_t budget) noexcept;
 };
 
 } // namespace nioc::chronicle
@@ -0,0 +1,42 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <filesystem>
+
+namespace nioc::chronicle
+{
+
+/// @brief Write the per-channel entry index of the chronicle rooted at @p logRoot.
+///
+/// Makes one pass over the timeline and writes, into each channel's directory, an `index.nioc`
+/// holding the timeline positions of that channel's records as ascending std::uint64_t values. A
+/// Reader opened on a set of channels merges these lists and visits only the selected records, so
+/// pulling one topic out of a busy log costs time proportional to that topic alone. A sharded
+/// timeline's positions count along the order a Reader merges its shards into.
+///
+/// A Writer's channels index their records as they commit, and a Writer on a sharded timeline
+/// calls this as it closes, so logs it records are indexed already. Call it directly to index a
+/// chronicle recorded before indices existed; it rewrites any index already present, and drops
+/// those a Writer left unfinished.
+///
+/// Example:
+///
+///     nioc::chronicle::buildChannelIndices("/data/run42");
+///     nioc::chronicle::Reader reader{"/data/run42", {imuChannelId}};
+///
+/// Must not run while a Writer is still recording into @p logRoot.
+///
+/// @param logRoot Chronicle root directory.
+///
+/// @throws std::invalid_argument If @p logRoot does not exist or is not a directory.
+///
+/// @throws std::runtime_error If an index file cannot be created, sized, or mapped.
+///
+/// @see Reader, Writer
+void buildChannelIndices(const std::filesystem::path& logRoot);
+
+} // namespace nioc::chronicle
@@ -0,0 +1,34 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace nioc::chronicle
+{
+
+/// @brief The CRC-32C (Castagnoli) checksum of @p bytes, as a Writer records it for each record.
+///
+/// Uses the CPU's CRC32C instructions where it has them (SSE4.2 on x86-64, checked at run time;
+/// the CRC extension on AArch64, when the build targets it) and a table otherwise; all agree.
+///
+/// Example:
+///
+///     const auto checksum = crc32c(record);
+///     const auto same = crc32c(second, crc32c(first)); // of first and second back to back
+///
+/// @param bytes The bytes to checksum.
+///
+/// @param previous The checksum of the bytes preceding @p bytes, to continue it; zero to start.
+///
+/// @return The checksum of the bytes so far.
+[[nodiscard]] std::uint32_t crc32c(
+    std::span<const std::byte> bytes,
+    std::uint32_t previous = 0U) noexcept;
+
+} // namespace nioc::chronicle
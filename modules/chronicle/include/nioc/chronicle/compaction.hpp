@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+
+namespace nioc::chronicle
+{
+
+/// @brief Rewrite the rolls of the chronicle rooted at @p logRoot densely, dropping the slack its
+/// reservations left behind, and re-point the timeline at the moved records.
+///
+/// Records sit in their rolls where they were reserved, so a roll also holds every byte a
+/// reservation claimed but did not commit: tails stranded behind a later claim, reservations
+/// dropped uncommitted, and the unused end of each producer lane's chunk (see ChannelUsage). This
+/// copies each roll's committed records, in offset order and word aligned, into a fresh roll, then
+/// updates the timeline entries that moved. Then:
+///
+/// - a channel any roll of which shrinks has all its rolls moved to fresh roll ids past its newest,
+///   in the same order: those that shrink are written densely, the rest linked;
+/// - rolls no committed record references are deleted;
+/// - compressed rolls, and rolls that would not shrink, keep their bytes as they are;
+/// - the time index, checksums, and channel indices, which refer to timeline positions and record
+///   bytes rather than to rolls, stay valid as they are.
+///
+/// The new rolls are synced, and the re-pointed timeline is written beside the original and synced,
+/// before the timeline is renamed into place; that rename is the commit. Only once the directory is
+/// synced are the original rolls deleted. Interrupted before, the chronicle still reads as it did,
+/// if littered with `.tmp` files and unreferenced rolls that the next compaction deletes; after,
+/// it reads compacted, the originals being merely unreferenced. A sharded timeline commits shard by
+/// shard, each shard's records located in either the original or the new rolls.
+///
+/// Example:
+///
+///     nioc::chronicle::recover("/data/run42"); // if its Writer crashed
+///     const auto saved = nioc::chronicle::compact("/data/run42");
+///
+/// Must not run while a Writer is still recording into @p logRoot, nor while a Reader has it open.
+/// A crashed chronicle must be recovered first.
+///
+/// @param logRoot Chronicle root directory.
+///
+/// @return The number of bytes the rolls shrank by.
+///
+/// @throws std::invalid_argument If @p logRoot does not exist or is not a directory.
+///
+/// @throws std::runtime_error If a file cannot be mapped or created, or a roll is shorter than the
+/// records the timeline places in it, or the chronicle was recorded in an older or foreign layout
+/// (see ChronicleFormat).
+///
+/// @throws std::filesystem::filesystem_error If a file cannot be renamed or deleted.
+///
+/// @see recover, Channel::usage
+std::uint64_t compact(const std::filesystem::path& logRoot);
+
+} // namespace nioc::chronicle
@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "crate.hpp"
+#include "defines.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <nioc/containers/mmapConstArray.hpp>
+#include <vector>
+
+namespace nioc::chronicle
+{
+
+/// @brief Read side of a sealed roll that was compressed into independently decodable blocks.
+///
+/// The file holds a small header, a table of each block's file offset, then the blocks: the roll's
+/// bytes cut into runs of the block size, each deflated on its own with zlib, or stored as is when
+/// deflating does not shrink it. A read decodes only the blocks its byte range overlaps, so a
+/// record costs one block's decode, not the roll's. The last block decoded is kept, so neighbouring
+/// records share it.
+///
+/// Example:
+///
+///     auto roll = CompressedRoll{channelDir / "roll00000000000000000003.nioc.z"};
+///     const auto crate = roll.read(entry.mOffset, entry.mSize);
+///
+/// Not thread-safe; a Reader keeps its own. Not copyable or assignable; move-constructible.
+///
+/// @see compressRoll, Compression, Reader
+class CompressedRoll
+{
+public:
+  /// @brief Map the compressed roll at @p path and validate its header and block table.
+  ///
+  /// @throws std::runtime_error If the file cannot be mapped, or is not a compressed roll.
+  explicit CompressedRoll(const std::filesystem::path& path);
+
+  /// @brief Byte size of the roll before compression.
+  [[nodiscard]] std::uint64_t size() const noexcept;
+
+  /// @brief The roll's bytes `[offset, offset + size)`, decoded.
+  ///
+  /// A range within one block shares that block's decoded buffer; one spanning blocks is copied
+  /// into a buffer of its own.
+  ///
+  /// @throws std::out_of_range If the range runs past size().
+  ///
+  /// @throws std::runtime_error If a block fails to decode.
+  [[nodiscard]] Crate read(std::uint64_t offset, std::uint64_t size);
+
+  /// @brief Pass @p advice on to the compressed blocks holding the roll's bytes
+  /// `[offset, offset + size)`.
+  void advise(std::uint64_t offset, std::uint64_t size, containers::Advice advice) const noexcept;
+
+private:
+  /// A decoded block, shared with the Crates that view it.
+  using Block = std::vector<std::byte>;
+
+  /// The mapped compressed file.
+  containers::MmapConstArray<std::byte> mFile;
+
+  /// Byte size of the roll before compression.
+  std::uint64_t mSize{0ULL};
+
+  /// Bytes per block before compression; the last block may be shorter.
+  std::uint64_t mBlockSize{0ULL};
+
+  /// Number of blocks.
+  std::uint64_t mBlockCount{0ULL};
+
+  /// Index of the block in mLastBlock.
+  std::uint64_t mLastBlockIndex{0ULL};
+
+  /// The last block decoded, or null before the first read.
+  std::shared_ptr<const Block> mLastBlock;
+
+  /// @brief File offset of the start of block @p index; of the file's end for mBlockCount.
+  [[nodiscard]] std::uint64_t blockOffset(std::uint64_t index) const noexcept;
+
+  /// @brief Decode block @p index, or return it from mLastBlock.
+  [[nodiscard]] std::shared_ptr<const Block> decodeBlock(std::uint64_t index);
+};
+
+/// @brief Compress the sealed roll at @p rollPath into the block format CompressedRoll reads, then
+/// delete the original.
+///
+/// Writes `<rollPath>.z` under a temporary name, flushes it, and renames it into place before the
+/// original is deleted, so a crash leaves one of the two whole. Mappings of the original stay
+/// valid.
+///
+/// @param rollPath A sealed roll. Must not be written to again.
+///
+/// @param compression Block size and level; the block size must be non-zero.
+///
+/// @return The compressed roll's path.
+///
+/// @throws std::invalid_argument If the block size is zero.
+///
+/// @throws std::runtime_error If the roll cannot be read, or the compressed file written.
+///
+/// @see CompressedRoll
+std::filesystem::path compressRoll(
+    const std::filesystem::path& rollPath,
+    const Compression& compression);
+
+} // namespace nioc::chronicle
@@ -5,7 +5,10 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <nioc/containers/mmapRegion.hpp>
 #include <string_view>
 
 namespace nioc::chronicle
@@ -29,6 +32,8 @@ struct ChannelId
 
 /// @brief A value type that pinpoints one logged record: its channel, the data file (roll) holding
 /// the bytes, and the record's half-open byte range `[mOffset, mOffset + mSize)` within that roll.
+///
+/// The commit marker is written last, so a slot whose marker is zero holds no record.
 struct TimelineEntry
 {
   /// The channel that owns the record.
@@ -42,8 +47,201 @@ struct TimelineEntry
 
   /// Length of the record in bytes.
   std::uint64_t mSize{0ULL};
+
+  /// Nonzero once the entry is committed. Written last, after the fields above, so a slot a crash
+  /// left unwritten or half-written reads as uncommitted whatever channel it was for.
+  std::uint64_t mCommitted{0ULL};
+};
+
+/// @brief A TimelineEntry as a sharded timeline records it: stamped with the instant its record was
+/// committed, which orders it among the entries of the other shards.
+///
+/// @see Timeline
+struct StampedEntry
+{
+  /// Nanoseconds since the system clock's epoch at which the record was committed.
+  std::int64_t mTimestamp{0LL};
+
+  /// The record's location. Its commit marker is written last, after the stamp.
+  TimelineEntry mEntry;
+};
+
+/// @brief A value type that samples the timeline: the instant one record was committed, paired with
+/// that record's position on the timeline.
+///
+/// Samples are written every Nth timeline entry, so a sequence of them is ordered by both fields
+/// and can be binary-searched by time.
+///
+/// @see Timeline, Reader::seek
+struct TimeIndexEntry
+{
+  /// Nanoseconds since the system clock's epoch at which the sampled record was committed.
+  std::int64_t mTimestamp{0LL};
+
+  /// Position of the sampled record on the timeline.
+  std::uint64_t mEntryInTimeline{0ULL};
 };
 
+/// Identifies a chronicle's `format.nioc`: the bytes "niocchrn" read as a little-endian word.
+inline constexpr auto kChronicleMagic = std::uint64_t{0x6e726863636f696eULL};
+
+/// The on-disk layout a Writer records. Version 1 had 32-byte timeline entries with no commit
+/// marker, and wrote no `format.nioc`; version 2 added TimelineEntry::mCommitted.
+inline constexpr auto kChronicleFormatVersion = std::uint32_t{2U};
+
+/// @brief The layout of `format.nioc`, which a Writer records at a chronicle's root so readers
+/// can refuse a layout they were not built for rather than misread its entries.
+///
+/// @see Reader, recover
+struct ChronicleFormat
+{
+  /// Always kChronicleMagic; anything else is not a chronicle's format file.
+  std::uint64_t mMagic{kChronicleMagic};
+
+  /// The layout version, kChronicleFormatVersion for this build.
+  std::uint32_t mVersion{kChronicleFormatVersion};
+
+  /// The size of a TimelineEntry in bytes.
+  std::uint32_t mEntrySize{sizeof(TimelineEntry)};
+};
+
+/// @brief How much of each channel's recent data a Writer keeps: a flight-recorder bound on disk
+/// use.
+///
+/// A channel enforces it each time it seals a full roll, deleting its oldest sealed rolls until
+/// both limits hold, and a Writer's pacing thread checks the age limit every pass, so a channel
+/// that has gone quiet ages out too. A zero limit is no limit, so the default keeps everything.
+/// Deleting a roll frees its disk space once the last mapping of it closes; Crates still viewing it
+/// stay valid.
+///
+/// The pacing thread then discards the timeline entries, checksums, and time-index samples before
+/// the oldest record any channel keeps, and the channels' entry index positions before it, freeing
+/// their disk space while every later position keeps its meaning (see Timeline::discard). So a
+/// flight recorder's disk use stays flat but for the files' lengths, which still grow; the
+/// timeline's capacity still bounds how many records it takes in all. A sharded timeline keeps its
+/// entries.
+///
+/// @see Writer, Channel
+struct Retention
+{
+  /// Most bytes of sealed rolls a channel keeps. The active roll comes on top, so a channel's disk
+  /// use stays under this plus one roll capacity.
+  std::uint64_t mMaxBytes{0ULL};
+
+  /// Longest a sealed roll is kept after its last record, as checked at each rollover and on each
+  /// pass of the Writer's pacing thread.
+  std::chrono::nanoseconds mMaxAge{0};
+};
+
+/// @brief Whether a Writer compresses each roll once it is sealed, and how.
+///
+/// A sealed roll is never written again, so a helper thread can compress it into independently
+/// decodable blocks (see compressRoll) while recording goes on; a Reader then decodes only the
+/// blocks a record overlaps. Worth it for compressible payloads such as point clouds and raw
+/// images read back from slow storage. Records stay uncompressed while their roll is active, so
+/// the live zero-copy path is untouched.
+///
+/// @see Writer, CompressedRoll
+struct Compression
+{
+  /// Bytes per independently decodable block. Larger blocks compress better; smaller ones cost less
+  /// to decode per record. Zero disables compression.
+  std::uint64_t mBlockSize{0ULL};
+
+  /// zlib compression level, from 1 (fastest) to 9 (smallest).
+  int mLevel{1};
+};
+
+/// Default number of idle rolls a channel keeps for reuse (see Writeback::mPooledRolls).
+inline constexpr auto kDefaultPooledRolls = std::size_t{2};
+
+/// Default number of staged bytes a channel's idle rolls may hold between them (see
+/// Writeback::mPooledBytes): a few rolls staged at kDefaultStagingBytes.
+inline constexpr auto kDefaultPooledBytes = std::uint64_t{1ULL << 30U};
+
+/// Default number of bytes a channel stages per roll under WriteMode::Direct (see
+/// Writeback::mStagingBytes).
+inline constexpr auto kDefaultStagingBytes = std::uint64_t{256ULL << 20U};
+
+/// @brief How a Writer paces the writeback of its mapped files to disk.
+///
+/// Dirty pages of a mapped roll otherwise sit in the page cache until the kernel flushes them in a
+/// burst, stalling whichever writer faults next. With a non-zero interval a background thread
+/// instead starts the writeback of freshly written bytes every interval, so the disk sees a steady
+/// stream. Pacing only starts I/O; Writer::checkpoint() is what makes data durable. With pacing on,
+/// the helper that seals a full roll also flushes it, so a checkpoint finds little left to flush;
+/// with it off, seals leave that to the next checkpoint and stay off the disk's critical path.
+///
+/// Rolls may bypass the page cache altogether under containers::WriteMode::Direct: each roll is
+/// then staged in memory and written to its file with direct I/O. Large sequential writes to fast
+/// storage go out faster and steadier that way, and a Reader reads the result as usual. Pacing
+/// then writes each active roll's fresh bytes through, as a rate like the writeback it paces
+/// otherwise, and the helper that seals a roll writes the rest. Nothing can tail such a chronicle,
+/// since a roll's bytes reach its file only as they are written through. Each channel records how
+/// far its records are on disk, so recover() cuts the timeline of a crashed Writer back to records
+/// whose bytes survived. A channel stages at most mStagingBytes per roll, rolling over sooner than
+/// the roll capacity if need be. Once a sealed roll's crates let go of it, its staging memory
+/// stages a later roll of the channel, so a busy channel maps and faults in its staging memory once
+/// instead of for every roll, within a bound on the bytes kept idle. Mapped rolls are never reused:
+/// their pages are the recording itself.
+///
+/// How the rolls and the timeline are mapped is set apart from their writeback, per channel (see
+/// WriterOptions::mRollPolicy).
+///
+/// @see Writer
+struct Writeback
+{
+  /// Time between two pacing passes. Zero disables pacing.
+  std::chrono::nanoseconds mInterval{0};
+
+  /// Most roll bytes whose writeback a pass starts, as a rate. Zero is no limit.
+  std::uint64_t mBytesPerSecond{0ULL};
+
+  /// How roll bytes reach their files: mapped by default, or staged and written directly.
+  containers::WriteMode mMode{containers::WriteMode::Mapped};
+
+  /// Most sealed rolls each channel keeps staged for reuse under WriteMode::Direct. Zero stages
+  /// every roll in fresh memory.
+  std::size_t mPooledRolls{kDefaultPooledRolls};
+
+  /// Most staged bytes each channel's pooled rolls hold between them. A roll staged larger than
+  /// this is freed as it is sealed, so idle memory per channel stays within it whatever the roll
+  /// capacity.
+  std::uint64_t mPooledBytes{kDefaultPooledBytes};
+
+  /// Most bytes each channel stages per roll under WriteMode::Direct: its rolls hold no more than
+  /// this or the roll capacity, whichever is smaller. Zero is no limit.
+  std::uint64_t mStagingBytes{kDefaultStagingBytes};
+};
+
+/// The version of the BridgeFrame layout a BridgeSender writes and a BridgeReceiver reads.
+inline constexpr auto kBridgeFrameVersion = std::uint32_t{1U};
+
+/// @brief The header a BridgeSender streams before each record it forwards over TCP; the record's
+/// @ref mSize bytes follow it.
+///
+/// On the wire the header is these 24 bytes in this order, every field little-endian whatever the
+/// hosts' byte order, so a bridge joins hosts of any endianness. A receiver hangs up on a header
+/// of any version but its own.
+///
+/// @see BridgeSender, BridgeReceiver
+struct BridgeFrame
+{
+  /// The layout version, kBridgeFrameVersion.
+  std::uint32_t mVersion{kBridgeFrameVersion};
+
+  /// Zero; aligns the fields after it.
+  std::uint32_t mReserved{0U};
+
+  /// The channel the record was committed on.
+  ChannelId mChannelId;
+
+  /// Number of record bytes that follow the header.
+  std::uint64_t mSize{0ULL};
+};
+
+static_assert(sizeof(BridgeFrame) == 24U, "A BridgeFrame travels as 24 bytes, unpadded.");
+
 /// @brief Compute the channel id for a topic of a given message type.
 ///
 /// Example:
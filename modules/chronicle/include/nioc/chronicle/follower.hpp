@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "compressedRoll.hpp"
+#include "defines.hpp"
+#include "reader.hpp"
+#include "timeline.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <nioc/containers/mmapConstArray.hpp>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace nioc::chronicle
+{
+
+/// @brief Tails a chronicle while a Writer, in this or another process, is still recording it,
+/// yielding each record shortly after it is committed.
+///
+/// Example:
+///
+///     nioc::chronicle::Follower follower{"/data/run42"};
+///     while(const auto entry = follower.next(std::chrono::milliseconds{100}))
+///     {
+///       process(entry->mChannelId, entry->mCrate.span());
+///     }
+///     // next() came back empty: a quiet interval, or follower.finished()
+///
+/// The Writer must have been given a doorbell interval (see Writer). Its doorbell thread publishes
+/// how far the timeline is committed in `doorbell.nioc` and wakes the Followers sleeping on it; the
+/// Follower reads no timeline entry past that, so it never sees a slot a producer has claimed but
+/// not yet filled, nor a page the Writer trims away as it closes. A record thus reaches the
+/// Follower within about one doorbell interval of its commit, in timeline order; a sharded timeline
+/// is merged by stamp as it goes, as the Reader merges it.
+///
+/// The Follower only reads the chronicle's files, so it may run as another user than the Writer.
+/// A Follower opened after the Writer closed replays the whole chronicle, then finishes. Records
+/// whose roll retention removed before the Follower reached them are skipped. A Follower of a
+/// Writer that crashed never sees the chronicle close; its next() just keeps timing out.
+///
+/// Not copyable or movable. Not thread-safe.
+///
+/// @see Writer, Reader, Doorbell
+class Follower
+{
+public:
+  /// @brief Start following the chronicle rooted at @p logRoot from its first record.
+  ///
+  /// @throws std::invalid_argument If @p logRoot is not a directory, or its Writer rings no
+  /// doorbell.
+  ///
+  /// @throws std::runtime_error If a file of the chronicle cannot be mapped, or the chronicle was
+  /// recorded in an older or foreign layout (see ChronicleFormat).
+  explicit Follower(std::filesystem::path logRoot);
+
+  Follower(const Follower&) = delete;
+
+  Follower(Follower&&) noexcept = delete;
+
+  ~Follower() = default;
+
+  Follower& operator=(const Follower&) = delete;
+
+  Follower& operator=(Follower&&) noexcept = delete;
+
+  /// @brief The next record, waiting up to @p timeout for one to be committed.
+  ///
+  /// @return The record, or empty if none was committed in time or the chronicle is finished (see
+  /// finished()).
+  ///
+  /// @throws std::runtime_error If the roll of a record cannot be read.
+  [[nodiscard]] std::optional<Entry> next(std::chrono::nanoseconds timeout);
+
+  /// @brief Skip every record committed so far, so next() yields only later ones.
+  ///
+  /// @throws std::runtime_error If the timeline has grown and cannot be remapped.
+  void skipToEnd();
+
+  /// @brief Whether the Writer has closed the chronicle and next() has yielded its last record.
+  [[nodiscard]] bool finished() const noexcept;
+
+  /// This chronicle's root directory.
+  [[nodiscard]] const std::filesystem::path& path() const noexcept;
+
+private:
+  /// A memory-mapped timeline file.
+  using TimelineFile = containers::MmapConstArray<TimelineEntry>;
+
+  /// A memory-mapped shard of a sharded timeline.
+  using ShardFile = containers::MmapConstArray<StampedEntry>;
+
+  /// A memory-mapped data roll.
+  using Roll = containers::MmapConstArray<std::byte>;
+
+  /// One roll being read: mapped as written, or, once it has been compressed, decoded block by
+  /// block. Neither if retention removed it.
+  struct OpenRoll
+  {
+    std::shared_ptr<const Roll> mRoll;
+    std::unique_ptr<CompressedRoll> mCompressed;
+  };
+
+  /// The chronicle's root directory, returned by path().
+  const std::filesystem::path mLogRoot;
+
+  /// The Writer's doorbell, mapped read-only.
+  containers::MmapConstArray<Doorbell> mDoorbell;
+
+  /// The timeline as last mapped, or null on a sharded timeline or one with nothing recorded.
+  std::unique_ptr<const TimelineFile> mTimelineFile;
+
+  /// The shards as last mapped; empty if the timeline is not sharded.
+  std::vector<std::unique_ptr<const ShardFile>> mShardFiles;
+
+  /// The position of the next entry to yield, per shard; one if the timeline is not sharded.
+  std::vector<std::uint64_t> mNext;
+
+  /// The stamp each shard's last yielded entry was merged by, so each shard stays in its own order.
+  std::vector<std::int64_t> mFloors;
+
+  /// The rolls being read, per channel; at most two each, as a channel moves from one to the next.
+  std::unordered_map<ChannelId, std::map<std::uint64_t, OpenRoll>> mRolls;
+
+  /// Set once next() has found the chronicle closed and drained.
+  bool mFinished{false};
+
+  /// @brief The next published entry in timeline order, advancing past it; null if there is none.
+  [[nodiscard]] const TimelineEntry* nextPublished() noexcept;
+
+  /// @brief Remap each timeline file the Writer has committed entries past the end of.
+  void followGrowth();
+
+  /// @brief Number of entries of @p shard that are published and mapped.
+  [[nodiscard]] std::uint64_t publishedLength(std::size_t shard) const noexcept;
+
+  /// @brief The record @p entry locates, or empty if its roll is gone.
+  [[nodiscard]] std::optional<Entry> load(const TimelineEntry& entry);
+
+  /// @brief The roll @p rollId of @p channelId, opening it if it is not open and closing the
+  /// channel's roll furthest from it.
+  OpenRoll& acquireRoll(ChannelId channelId, std::uint64_t rollId);
+};
+
+} // namespace nioc::chronicle
@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "channel.hpp"
+#include "crate.hpp"
+#include "defines.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <nioc/common/locked.hpp>
+#include <nioc/containers/mmapRegion.hpp>
+#include <span>
+#include <unordered_map>
+
+namespace nioc::chronicle
+{
+
+/// @brief Hands out channels kept in memory, for a run that publishes zero-copy but records
+/// nothing.
+///
+/// Where a Writer stores every record on disk and stamps it on a timeline, a MemoryWriter's
+/// channels write their rolls to in-memory files and index nothing, so nothing reaches a disk and
+/// no Reader can replay them. Reserving, committing, and the Crates handed out work as they do on
+/// a Writer's channels: consumers read the records in place, in the rolls they were written into.
+/// Each channel pools a roll once no Crate or Reservation holds it any longer, so a run whose
+/// consumers let go of what they read keeps a few rolls per channel whatever its length.
+///
+/// Example:
+///
+///     nioc::chronicle::MemoryWriter writer{};
+///     const auto crate = writer.write(nioc::chronicle::makeChannelId(typeId, "/imu"), payload);
+///
+/// Not copyable or movable.
+///
+/// @see Channel, Writer
+class MemoryWriter
+{
+public:
+  /// Default byte size each roll grows to. Small next to a Writer's, since a channel holds its
+  /// rolls in memory and reuses them rather than filling a disk.
+  static constexpr auto kDefaultRollCapacity = std::size_t{64ULL * 1024ULL * 1024ULL};
+
+  /// @brief Create a writer with no channels yet. Touches no file.
+  ///
+  /// @param rollCapacity Byte size each channel's rolls grow to.
+  ///
+  /// @param mapPolicy How every channel's rolls are mapped; lazily by default.
+  ///
+  /// @param pooledRolls Most idle rolls each channel keeps for reuse; it frees the rest.
+  ///
+  /// @param pooledBytes Most bytes each channel's idle rolls kept for reuse hold between them.
+  explicit MemoryWriter(
+      std::size_t rollCapacity = kDefaultRollCapacity,
+      containers::MapPolicy mapPolicy = {},
+      std::size_t pooledRolls = kDefaultPooledRolls,
+      std::uint64_t pooledBytes = kDefaultPooledBytes);
+
+  MemoryWriter(const MemoryWriter&) = delete;
+
+  MemoryWriter(MemoryWriter&&) noexcept = delete;
+
+  ~MemoryWriter() = default;
+
+  MemoryWriter& operator=(const MemoryWriter&) = delete;
+
+  MemoryWriter& operator=(MemoryWriter&&) noexcept = delete;
+
+  /// @brief Return the channel for @p channelId, creating it on first use.
+  ///
+  /// Thread-safe, and the returned reference stays valid for the writer's lifetime (see
+  /// Writer::channel).
+  [[nodiscard]] Channel& channel(ChannelId channelId);
+
+  /// @brief Append @p data as one record on @p channelId and return a handle to the stored bytes.
+  ///
+  /// Convenience wrapper over channel(channelId).write(data). The returned Crate keeps its roll
+  /// from being reused for as long as it lives. Thread-safe.
+  Crate write(ChannelId channelId, std::span<const std::byte> data);
+
+private:
+  /// Maps each channel's id to the heap-owned Channel, so references handed out stay valid.
+  using ChannelMap = std::unordered_map<ChannelId, std::unique_ptr<Channel>>;
+
+  /// Byte size each channel's rolls grow to.
+  const std::size_t mRollCapacity;
+
+  /// How every channel's rolls are mapped.
+  const containers::MapPolicy mMapPolicy;
+
+  /// Most idle rolls each channel keeps for reuse.
+  const std::size_t mPooledRolls;
+
+  /// Most bytes each channel's idle rolls hold between them.
+  const std::uint64_t mPooledBytes;
+
+  /// The channel registry, guarded so concurrent channel() and write() calls serialize on it.
+  common::Locked<ChannelMap> mLockedChannelMap;
+};
+
+} // namespace nioc::chronicle
@@ -0,0 +1,80 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "reader.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <vector>
+
+namespace nioc::chronicle
+{
+
+/// @brief The instant a record was taken at, in nanoseconds, as read off the record itself on the
+/// clock of the process that recorded it.
+///
+/// Handed the record's first kMergeKeyBytes bytes only, or the whole record if it is shorter.
+///
+/// @see merge
+using MergeKey = std::function<std::int64_t(const Entry&)>;
+
+/// Most bytes off a record's front a MergeKey is handed: room for any header an instant is read
+/// from, so a merge never reads, nor decompresses, the rest of a record.
+inline constexpr auto kMergeKeyBytes = std::uint64_t{4096ULL};
+
+/// @brief Merge the chronicles rooted at @p sources into one new chronicle at @p destination, its
+/// records ordered by the instant @p key reads off each.
+///
+/// Each source keeps its own order; the timelines are merged k ways, taking next whichever source's
+/// head record is earliest. @p key reads each record's head once (see kMergeKeyBytes), so only the
+/// first page or so of each record is touched, and decoded from a compressed roll. The payloads
+/// are not copied: each roll is hard linked into the destination, reflinked where the filesystem
+/// refuses hard links, and copied only as a last resort, such as across filesystems. So a merge of
+/// sources on the destination's filesystem writes little beyond the new timeline.
+///
+/// The keys of different sources come from clocks that need not agree, so each source's are first
+/// aligned to the wall clock. The time index a Writer samples pairs records with the wall-clock
+/// instant each was committed at; the median gap between those instants and the keys of the
+/// sampled records is taken as the source's clock offset. The merged chronicle is then:
+///
+/// - a single timeline, with a time index over the aligned keys, so Reader::seek lands by them;
+/// - each channel the union of that channel's records across sources, its rolls renumbered source
+///   after source;
+/// - checksummed if every source is, with a checksum for every record it merges;
+/// - indexed (see buildChannelIndices).
+///
+/// Records whose bytes a Retention policy deleted are left out. A source without a time index is
+/// taken to key on the wall clock already.
+///
+/// Example:
+///
+///     nioc::chronicle::merge({"/data/hostA", "/data/hostB"}, "/data/merged", arrivalTime);
+///
+/// The sources are left as they are, but share their rolls' files with the destination: they must
+/// be closed cleanly or recovered first, and must not be trimmed afterwards.
+///
+/// @param sources Chronicle root directories.
+///
+/// @param destination Directory to create the merged chronicle in; must be absent or empty.
+///
+/// @param key Reads the instant a record was taken at; called once per record, and on records of
+/// every source's channels.
+///
+/// @throws std::invalid_argument If a source does not exist or is not a directory, or
+/// @p destination holds anything.
+///
+/// @throws std::runtime_error If a file cannot be mapped or created.
+///
+/// @throws std::filesystem::filesystem_error If a roll can be neither linked nor copied.
+///
+/// @see Reader, recover, buildChannelIndices
+void merge(
+    const std::vector<std::filesystem::path>& sources,
+    const std::filesystem::path& destination,
+    const MergeKey& key);
+
+} // namespace nioc::chronicle
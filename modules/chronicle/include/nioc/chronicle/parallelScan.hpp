@@ -0,0 +1,148 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "defines.hpp"
+#include "reader.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <ranges>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace nioc::chronicle
+{
+
+/// @brief Scans a chronicle on several threads at once: splits its records into contiguous shards,
+/// hands each shard to a worker, and merges the workers' results in timeline order.
+///
+/// Each worker opens its own Reader, so workers share no roll cache and take no lock; a shard is a
+/// random-access range of Entry whose payloads are views straight into the mapped rolls. Shards are
+/// contiguous and numbered in timeline order, and reduce() merges their results from the first
+/// shard to the last, so an order-sensitive merge (concatenation, first/last seen) sees the
+/// results in the order a single-threaded pass would have produced them.
+///
+/// Example:
+///
+///     const auto scan = nioc::chronicle::ParallelScan{"/data/run42"};
+///     const auto bytes = scan.reduce<std::uint64_t>(
+///         [](ParallelScan::Shard shard)
+///         {
+///           auto sum = std::uint64_t{0};
+///           for(const auto& entry: shard) { sum += entry.mCrate.span().size(); }
+///           return sum;
+///         },
+///         std::plus{});
+///
+/// The scan itself is immutable and may run any number of times; each run spawns and joins its own
+/// workers. Opened on a channel set, it shards only those channels' records (see Reader).
+///
+/// @see Reader, Reader::Entries
+class ParallelScan
+{
+public:
+  /// One worker's contiguous share of the records, in timeline order. It borrows the worker's
+  /// Reader, so it is valid only during the call it is passed to; each Entry read from it keeps its
+  /// roll mapped and may outlive it.
+  using Shard = std::ranges::subrange<Reader::Entries::Iterator>;
+
+  /// @brief Prepare to scan every record of the chronicle rooted at @p logRoot.
+  ///
+  /// @param logRoot Path to the chronicle's root directory; must name an existing directory.
+  ///
+  /// @param workerCount Most workers a run spawns. Zero means one per hardware thread. A run never
+  /// spawns more workers than there are records.
+  ///
+  /// @throws std::invalid_argument If @p logRoot does not exist or is not a directory.
+  explicit ParallelScan(std::filesystem::path logRoot, std::size_t workerCount = 0);
+
+  /// @brief Prepare to scan only the records of @p channelIds.
+  ///
+  /// @param logRoot Path to the chronicle's root directory; must name an existing directory.
+  ///
+  /// @param channelIds The channels to scan.
+  ///
+  /// @param workerCount As for the overload above.
+  ///
+  /// @throws std::invalid_argument If @p logRoot does not exist or is not a directory.
+  ParallelScan(
+      std::filesystem::path logRoot,
+      std::unordered_set<ChannelId> channelIds,
+      std::size_t workerCount = 0);
+
+  /// @brief Number of records the scan covers.
+  [[nodiscard]] std::uint64_t size() const noexcept;
+
+  /// @brief Number of shards, and so of workers, each run uses.
+  [[nodiscard]] std::size_t shardCount() const noexcept;
+
+  /// @brief Position, among the records the scan covers, of the first record of shard
+  /// @p shardIndex; that of shard shardCount() is size().
+  ///
+  /// Lets a visitor write each record's result straight to its place in a dense output.
+  [[nodiscard]] std::uint64_t shardBegin(std::size_t shardIndex) const noexcept;
+
+  /// @brief Call @p visit once per shard, each on its own worker thread, and return once all have
+  /// finished.
+  ///
+  /// @param visit Called as `visit(shardIndex, shard)`. Runs concurrently with itself, so anything
+  /// it shares across shards must be synchronized by the caller.
+  ///
+  /// @throws Whatever a worker's @p visit threw first in shard order, after every worker has
+  /// finished.
+  void forEachShard(const std::function<void(std::size_t, Shard)>& visit) const;
+
+  /// @brief Map every shard to a partial result in parallel, then fold the partials in timeline
+  /// order.
+  ///
+  /// @tparam Result The result type; must be movable.
+  ///
+  /// @param map Called as `map(shard)` on a worker thread and returns that shard's Result.
+  ///
+  /// @param merge Called as `merge(std::move(accumulated), std::move(partial))` on the calling
+  /// thread, once per shard from first to last, and returns the new accumulated Result.
+  ///
+  /// @param initial The value folding starts from, returned as-is when there are no records.
+  ///
+  /// @throws Whatever @p map or @p merge threw; see forEachShard.
+  template<typename Result, typename Map, typename Merge>
+  [[nodiscard]] Result reduce(Map map, Merge merge, Result initial = Result{}) const
+  {
+    auto partials = std::vector<std::optional<Result>>(shardCount());
+    forEachShard([&map, &partials](const std::size_t shardIndex, Shard shard)
+                 { partials.at(shardIndex).emplace(map(std::move(shard))); });
+
+    for(auto& partial: partials)
+    {
+      initial = merge(std::move(initial), std::move(*partial));
+    }
+    return initial;
+  }
+
+private:
+  /// The chronicle's root directory.
+  const std::filesystem::path mLogRoot;
+
+  /// The channels to scan, or empty to scan every channel.
+  const std::optional<std::unordered_set<ChannelId>> mChannelIds;
+
+  /// Number of records covered, counted once at construction.
+  std::uint64_t mRecordCount{0ULL};
+
+  /// Number of shards each run splits the records into.
+  std::size_t mShardCount{0ULL};
+
+  ParallelScan(
+      std::filesystem::path logRoot,
+      std::optional<std::unordered_set<ChannelId>> channelIds,
+      std::size_t workerCount);
+};
+
+} // namespace nioc::chronicle
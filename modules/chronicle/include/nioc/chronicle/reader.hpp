@@ -5,16 +5,25 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include "compressedRoll.hpp"
 #include "crate.hpp"
 #include "defines.hpp"
+#include <chrono>
+#include <compare>
 #include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <iterator>
+#include <map>
 #include <memory>
 #include <nioc/containers/mmapConstArray.hpp>
+#include <nioc/containers/mmapWindowedConstArray.hpp>
 #include <optional>
+#include <ranges>
+#include <span>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace nioc::chronicle
 {
@@ -28,11 +37,45 @@ struct Entry
   /// The channel this record was logged on.
   ChannelId mChannelId;
 
-  /// The record's payload bytes. The crate holds its backing roll alive, so these bytes stay valid
-  /// even after the iterator advances past this entry or the Reader is destroyed.
+  /// The record's payload bytes. The crate holds its backing roll, or the window of it, alive, so
+  /// these bytes stay valid even after the iterator advances past this entry or the Reader is
+  /// destroyed.
   Crate mCrate;
 };
 
+/// @brief How far a Reader prefetches roll bytes ahead of its replay cursor.
+///
+/// Prefetching asks the kernel to start reading upcoming records' bytes in the background, so the
+/// replaying thread finds them resident instead of stalling on a major page fault per page. The
+/// rolls the cursor has left are released again, which keeps a long replay's footprint flat.
+///
+/// @see Reader::setReadAhead
+struct ReadAhead
+{
+  /// Most records ahead of the cursor to prefetch. Zero disables read-ahead.
+  std::uint64_t mEntryCount{0ULL};
+
+  /// Most payload bytes prefetched but not yet replayed. A single record larger than this is still
+  /// prefetched on its own.
+  std::size_t mWindowBytes{0ULL};
+};
+
+/// @brief How a Reader maps rolls: whole, or a window at a time.
+///
+/// A roll mapped whole stays mapped for as long as an Entry holds it, and costs page tables over
+/// its full length. Mapped a window at a time, a roll costs only the windows its records lie in,
+/// so the memory a replay maps stays bounded however large the rolls and the log grow.
+///
+/// @see Reader::setRollWindows, containers::MmapWindowedRegion
+struct RollWindows
+{
+  /// Bytes each window of a roll maps. Zero maps rolls whole.
+  std::size_t mWindowBytes{0ULL};
+
+  /// Most windows kept mapped per open roll, beyond those live entries hold.
+  std::size_t mWindowCount{containers::MmapWindowedRegion::kDefaultWindowCount};
+};
+
 /// @brief A single-pass input range over a chronicle log directory that yields its records in
 /// recorded timeline order.
 ///
@@ -44,11 +87,51 @@ struct Entry
 ///       process(entry.mChannelId, entry.mCrate.span());
 ///     }
 ///
-/// Iterate the reader exactly once, with a range-based for loop or begin()/end(). The pass is
-/// destructive and cannot be restarted: construct a fresh Reader to replay again. Non-copyable and
-/// non-movable; pin it in place (on the stack or behind a pointer). Not thread-safe.
+/// Iterate the reader with a range-based for loop or begin()/end(). The pass is destructive: begin()
+/// resumes from wherever the previous pass stopped. Call seek() to reposition the pass at a recorded
+/// instant, including back to the start. Non-copyable and non-movable; pin it in place (on the
+/// stack or behind a pointer). Not thread-safe.
+///
+/// For scrubbing back and forth, entries() offers a random-access view over the same timeline that
+/// leaves the replay cursor alone.
+///
+/// A sequential replay over a log larger than memory should enable read-ahead with setReadAhead().
+/// To also bound the memory the replay maps, have it map rolls a window at a time with
+/// setRollWindows(): at most two rolls stay open per channel, each with a bounded number of
+/// windows, plus whatever windows live entries still hold.
+///
+/// A chronicle whose Writer crashed was never trimmed. The Reader finds the last committed timeline
+/// entry by binary search as it opens, so it replays exactly the records committed before the
+/// crash, skipping any slot the crash left half-written. recover() also trims the files for good.
+///
+/// Rolls a Writer compressed as it sealed them (see Compression) replay transparently: the Reader
+/// decodes only the blocks each record overlaps, and read-ahead prefetches the compressed bytes.
+///
+/// A chronicle recorded under a Retention policy has lost its oldest rolls. The replay cursor skips
+/// the records they held, so it replays the surviving window; entries() and at() still count every
+/// record, and yield an expired one with an empty crate.
+///
+/// A chronicle recorded with checksums (see Writer) carries a CRC-32C per record. verify() checks
+/// every record in parallel; setChecksumVerification() makes the replay cursor check each record it
+/// yields and skip the corrupt ones.
+///
+/// A chronicle whose timeline was split into shards (see Timeline) replays the same way, in the
+/// order the shards merge into by their entries' commit stamps. The Reader maps that order from
+/// the file its Writer, or recover(), wrote, so opening costs no merge and Readers of one chronicle
+/// share the order through the page cache. A crashed chronicle not yet recovered has no such file;
+/// the Reader then merges the shards itself as it opens, at a cost linear in the record count and
+/// 8 bytes of memory per record. seek() lands on the first record the merge ordered at or after its
+/// target, stepping from the nearest sample over fewer records than the stride.
+///
+/// Opened on a set of channels, the Reader replays only their records, still in timeline order:
 ///
-/// @see Entry, Iterator
+///     nioc::chronicle::Reader reader{"/path/to/log", {imuChannelId}};
+///
+/// It merges the channels' entry indices (see buildChannelIndices) rather than filtering the whole
+/// timeline, so the cost follows the selected channels' record count. Every member then works over
+/// the selection: entries() and at() index it, and seek() lands within it.
+///
+/// @see Entry, Iterator, seek, entries, buildChannelIndices, recover
 class Reader
 {
 public:
@@ -58,8 +141,27 @@ public:
   /// chronicle whose timeline file is missing or empty replays as an empty range.
   ///
   /// @throws std::invalid_argument If @p logRoot does not exist or is not a directory.
+  ///
+  /// @throws std::runtime_error If the chronicle was recorded in an older or foreign layout (see
+  /// ChronicleFormat).
   explicit Reader(std::filesystem::path logRoot);
 
+  /// @brief Open the chronicle rooted at @p logRoot to replay only the records of @p channelIds.
+  ///
+  /// Reads each selected channel's entry index. A chronicle recorded without indices is still
+  /// readable: the Reader then scans the timeline once, here, and logs a warning. A channel that
+  /// was never written selects nothing.
+  ///
+  /// @param logRoot Path to the chronicle's root directory; must name an existing directory.
+  ///
+  /// @param channelIds The channels to replay.
+  ///
+  /// @throws std::invalid_argument If @p logRoot does not exist or is not a directory.
+  ///
+  /// @throws std::runtime_error If an index file exists but cannot be mapped, or the chronicle was
+  /// recorded in an older or foreign layout (see ChronicleFormat).
+  Reader(std::filesystem::path logRoot, const std::unordered_set<ChannelId>& channelIds);
+
   Reader(const Reader&) = delete;
 
   Reader(Reader&&) noexcept = delete;
@@ -134,14 +236,227 @@ public:
   /// @brief The end sentinel for the replay range.
   [[nodiscard]] static std::default_sentinel_t end() noexcept;
 
+  /// @brief Reposition replay near @p instant and return an iterator at the first record there.
+  ///
+  /// Binary-searches the chronicle's sparse time index, so the cost is logarithmic in the log's
+  /// length and no record is decoded. The iterator lands at or before the first record committed
+  /// at or after @p instant, overshooting backwards by less than the index stride the Writer
+  /// sampled with; step forward from there to refine. An instant past the last record yields end().
+  /// A sharded chronicle searches the samples of its merged order the same way, then steps forward
+  /// over the stamped entries to land exactly on the first record the shards merged at or after
+  /// @p instant. A chronicle without a time index (recorded before it existed) seeks to its
+  /// first record. A Reader opened on a channel set lands on the first selected record from that
+  /// point on.
+  ///
+  /// Example:
+  ///
+  ///     for(auto it = reader.seek(incidentTime); it != reader.end(); ++it) { ... }
+  ///
+  /// @param instant Wall-clock instant to seek to, as recorded by the Writer at each commit.
+  ///
+  /// @see Timeline
+  [[nodiscard]] Iterator seek(std::chrono::system_clock::time_point instant);
+
+  /// Read-ahead suited to replaying a log front to back: a few hundred records, at most 64 MiB.
+  static constexpr auto kDefaultReadAhead =
+      ReadAhead{.mEntryCount = 256ULL, .mWindowBytes = 64ULL * 1024ULL * 1024ULL};
+
+  /// @brief Prefetch roll bytes ahead of the replay cursor as @p readAhead describes.
+  ///
+  /// Applies from the next record the cursor reads. Only the replay cursor (begin(), seek())
+  /// prefetches; entries() and at() do not. Off by default.
+  ///
+  /// @param readAhead How far ahead to prefetch; a zero entry count turns read-ahead off.
+  void setReadAhead(const ReadAhead& readAhead) noexcept;
+
+  /// Windows suited to replaying rolls larger than memory: four windows of 64 MiB per roll.
+  static constexpr auto kDefaultRollWindows = RollWindows{
+      .mWindowBytes = containers::MmapWindowedRegion::kDefaultWindowSize,
+      .mWindowCount = containers::MmapWindowedRegion::kDefaultWindowCount};
+
+  /// @brief Map rolls a window at a time as @p rollWindows describes, rather than whole.
+  ///
+  /// Applies to rolls opened from the next record read, by the replay cursor, entries(), at(), and
+  /// verify() alike; rolls live entries already hold stay mapped whole. Compressed rolls are
+  /// decoded block by block either way. Off by default.
+  ///
+  /// @param rollWindows How to map rolls; a zero window size maps them whole.
+  void setRollWindows(const RollWindows& rollWindows) noexcept;
+
+  /// @brief Whether the chronicle was recorded with a checksum per record.
+  [[nodiscard]] bool hasChecksums() const noexcept;
+
+  /// @brief Check each record the replay cursor reads against its checksum, logging and skipping
+  /// those that do not match.
+  ///
+  /// Only the replay cursor (begin(), seek()) checks; entries() and at() do not. Off by default,
+  /// and without effect on a chronicle recorded without checksums.
+  ///
+  /// @param enabled Whether to check.
+  void setChecksumVerification(bool enabled) noexcept;
+
+  /// @brief Check every record this Reader replays against its checksum.
+  ///
+  /// Splits the records into one contiguous shard per worker thread, each of which maps the rolls
+  /// on its own, so the pass runs at the combined bandwidth of the disk and the cores. Records
+  /// whose bytes are lost (see the class notes) are not checked. Leaves the replay cursor alone.
+  ///
+  /// @param workerCount Number of worker threads; zero picks one per hardware thread.
+  ///
+  /// @return The timeline positions of the corrupt records, ascending; empty if all match.
+  ///
+  /// @throws std::runtime_error If the chronicle was recorded without checksums, or a roll cannot
+  /// be read.
+  [[nodiscard]] std::vector<std::uint64_t> verify(std::size_t workerCount = 0) const;
+
+  /// @brief A random-access, bidirectional view over every record the parent Reader replays.
+  ///
+  /// Models std::ranges::random_access_range, so it indexes, reverses, and slices with the standard
+  /// views:
+  ///
+  ///     auto entries = reader.entries();
+  ///     const auto middle = entries[entries.size() / 2];
+  ///     for(const auto& entry: entries | std::views::reverse) { ... }
+  ///
+  /// The timeline is a fixed-stride array, so moving an iterator is pointer arithmetic. Rolls stay
+  /// lazy: a record's roll is mapped only when that record is dereferenced, and is shared with the
+  /// replay cursor through the Reader's roll cache. Dereferencing yields a fresh Entry by value,
+  /// which keeps its roll mapped for as long as it lives.
+  ///
+  /// Cheap to copy; borrows the Reader, which must outlive the view and its iterators. Independent
+  /// of begin() and seek(): neither moves the other. Not thread-safe, like the Reader itself.
+  ///
+  /// @see Reader::entries, Reader::at
+  class Entries: public std::ranges::view_interface<Entries>
+  {
+  public:
+    /// @brief A random-access iterator over the records the parent Reader replays.
+    class Iterator
+    {
+    public:
+      using iterator_concept = std::random_access_iterator_tag;
+      using iterator_category = std::input_iterator_tag;
+      using value_type = Entry;
+      using difference_type = std::ptrdiff_t;
+
+      /// @brief Construct a singular iterator, fit only for assignment.
+      Iterator() = default;
+
+      /// @brief The record at the current position, mapping its roll on demand.
+      ///
+      /// Undefined behavior unless the position lies within the timeline.
+      [[nodiscard]] Entry operator*() const;
+
+      /// @brief The record @p offset positions away, mapping its roll on demand.
+      [[nodiscard]] Entry operator[](difference_type offset) const;
+
+      Iterator& operator++() noexcept;
+
+      Iterator operator++(int) noexcept;
+
+      Iterator& operator--() noexcept;
+
+      Iterator operator--(int) noexcept;
+
+      Iterator& operator+=(difference_type offset) noexcept;
+
+      Iterator& operator-=(difference_type offset) noexcept;
+
+      friend Iterator operator+(Iterator iterator, difference_type offset) noexcept;
+
+      friend Iterator operator+(difference_type offset, Iterator iterator) noexcept;
+
+      friend Iterator operator-(Iterator iterator, difference_type offset) noexcept;
+
+      friend difference_type operator-(
+          const Iterator& lhs,
+          const Iterator& rhs) noexcept;
+
+      /// Iterators over the same Reader compare by position.
+      [[nodiscard]] bool operator==(const Iterator&) const noexcept = default;
+
+      /// Iterators over the same Reader order by position.
+      [[nodiscard]] std::strong_ordering operator<=>(const Iterator&) const noexcept = default;
+
+    private:
+      friend class Entries;
+
+      Iterator(Reader& reader, difference_type position) noexcept;
+
+      Reader* mReader{nullptr};
+      difference_type mPosition{0};
+    };
+
+    /// @brief Construct an empty view over no Reader, whose begin() equals its end().
+    Entries() = default;
+
+    /// @brief Iterator at the first record.
+    [[nodiscard]] Iterator begin() const noexcept;
+
+    /// @brief Iterator one past the last record.
+    [[nodiscard]] Iterator end() const noexcept;
+
+  private:
+    friend class Reader;
+
+    explicit Entries(Reader& reader) noexcept;
+
+    Reader* mReader{nullptr};
+  };
+
+  /// @brief A random-access view over every record this Reader replays.
+  ///
+  /// @see Entries
+  [[nodiscard]] Entries entries() noexcept;
+
+  /// @brief The record at @p index among those this Reader replays, mapping its roll on demand.
+  ///
+  /// Does not move the replay cursor.
+  ///
+  /// @param index Position of the record, counted from the first one replayed.
+  ///
+  /// @throws std::out_of_range If @p index is not less than the number of records.
+  [[nodiscard]] Entry at(std::uint64_t index);
+
+  /// @brief The first @p length bytes of the record at @p index among those this Reader replays,
+  /// or the whole record if it is shorter.
+  ///
+  /// Reads no more of the record than that: of a compressed roll, only the blocks the head
+  /// overlaps are decoded. Does not move the replay cursor.
+  ///
+  /// @param index Position of the record, counted from the first one replayed.
+  ///
+  /// @param length Most bytes to read off the record's front.
+  ///
+  /// @throws std::out_of_range If @p index is not less than the number of records.
+  [[nodiscard]] Entry head(std::uint64_t index, std::uint64_t length);
+
 private:
   /// The memory-mapped timeline: the ordered list of records to replay, one TimelineEntry each,
   /// naming the channel, roll, and offset where every record's bytes live.
   using TimelineFile = containers::MmapConstArray<TimelineEntry>;
 
+  /// The memory-mapped sparse time index: every Nth timeline record's position and commit instant.
+  using TimeIndexFile = containers::MmapConstArray<TimeIndexEntry>;
+
+  /// A channel's memory-mapped entry index: the timeline positions of its records, ascending.
+  using ChannelIndexFile = containers::MmapConstArray<std::uint64_t>;
+
+  /// The memory-mapped checksums: one CRC-32C per timeline record, at the record's position.
+  using ChecksumFile = containers::MmapConstArray<std::uint32_t>;
+
+  /// One memory-mapped shard of a sharded timeline: its entries, stamped, in claim order.
+  using ShardFile = containers::MmapConstArray<StampedEntry>;
+
+  /// The memory-mapped merged order of a sharded timeline: one shard position per entry.
+  using MergedOrderFile = containers::MmapConstArray<std::uint64_t>;
+
   /// A roll: one memory-mapped chunk of a channel's payload bytes, addressed by byte offset.
   using Roll = containers::MmapConstArray<std::byte>;
 
+  /// A roll mapped a window at a time.
+  using WindowedRoll = containers::MmapWindowedConstArray<std::byte>;
+
   /// The set of currently mapped rolls for one channel, keyed by roll id. Each value is a weak
   /// reference, so a roll stays mapped only while some live Entry still holds it.
   using RollCache = std::unordered_map<std::uint64_t, std::weak_ptr<const Roll>>;
@@ -149,16 +464,160 @@ private:
   /// The chronicle's root directory, captured at construction.
   const std::filesystem::path mLogRoot;
 
-  /// The mapped timeline driving replay, or empty if the chronicle has no timeline file.
+  /// The mapped timeline driving replay, or empty if the chronicle has no timeline file or is
+  /// sharded.
   std::unique_ptr<const TimelineFile> mTimelineFile;
 
-  /// The index of the next timeline record to read; the replay cursor into mTimelineFile.
-  std::uint64_t mEntryInTimeline{0ULL};
+  /// The mapped time index consulted by seek(), or empty if the chronicle has none. On a sharded
+  /// chronicle, it samples the merged order.
+  std::unique_ptr<const TimeIndexFile> mTimeIndexFile;
+
+  /// Timeline entries up to the last committed one. Short of the file's size only when the writer
+  /// crashed before trimming it.
+  std::uint64_t mTimelineLength{0ULL};
+
+  /// Time-index samples that were written and sample a position below mTimelineLength.
+  std::uint64_t mTimeIndexLength{0ULL};
+
+  /// Leading timeline entries its Writer discarded under a Retention policy. They read as zero,
+  /// and so as lost records.
+  std::uint64_t mDiscarded{0ULL};
+
+  /// Whether the chronicle was recorded with checksums, even if it holds no record.
+  bool mHasChecksums{false};
+
+  /// The mapped checksums, or empty if the chronicle holds none or is sharded.
+  std::unique_ptr<const ChecksumFile> mChecksumFile;
+
+  /// The mapped shards of a sharded timeline, null where a shard holds nothing; empty otherwise.
+  std::vector<std::unique_ptr<const ShardFile>> mShardFiles;
+
+  /// The mapped checksums of each shard, null where a shard has none.
+  std::vector<std::unique_ptr<const ChecksumFile>> mShardChecksumFiles;
+
+  /// The merged order of a sharded timeline as its Writer wrote it, or empty if the Reader merged
+  /// the shards itself.
+  std::unique_ptr<const MergedOrderFile> mMergedOrderFile;
+
+  /// The merged order of a sharded timeline, when the Reader merged the shards itself.
+  std::vector<std::uint64_t> mOwnMergedOrder;
+
+  /// Every stride-th merge key of mOwnMergedOrder, which seek() searches in place of a time index.
+  std::vector<TimeIndexEntry> mOwnMergedSamples;
+
+  /// A sharded timeline's committed entries merged into one order, as shard positions, from
+  /// mMergedOrderFile or mOwnMergedOrder. A timeline position on a sharded chronicle is an index
+  /// into it.
+  std::span<const std::uint64_t> mMergedOrder;
+
+  /// Ascending timeline positions of the selected channels' records, or empty if the Reader
+  /// replays every channel.
+  std::optional<std::vector<std::uint64_t>> mSelection;
+
+  /// The index of the next record to read; the replay cursor. Counts selected records when
+  /// mSelection is set, timeline records otherwise.
+  std::uint64_t mNextRecord{0ULL};
+
+  /// Whether the replay cursor checks each record against its checksum.
+  bool mVerifyChecksums{false};
 
   /// The cache of mapped rolls, partitioned by channel, that keeps recently used rolls mapped so
   /// successive records on the same channel reuse one mapping.
   std::unordered_map<ChannelId, RollCache> mRollCache;
 
+  /// The roll a channel is prefetching into, held mapped until the cursor reaches it.
+  struct PrefetchedRoll
+  {
+    /// Id of the roll within its channel.
+    std::uint64_t mRollId{0ULL};
+
+    /// The mapped roll, or null if the roll is compressed or mapped a window at a time.
+    std::shared_ptr<const Roll> mRoll;
+
+    /// Byte offset up to which the kernel has been asked to read the roll in.
+    std::uint64_t mAdvisedEnd{0ULL};
+  };
+
+  /// How far ahead of the replay cursor to prefetch.
+  ReadAhead mReadAhead;
+
+  /// One past the last record prefetched; counts like mNextRecord.
+  std::uint64_t mPrefetchedUntil{0ULL};
+
+  /// Payload bytes of the records prefetched but not yet replayed.
+  std::uint64_t mPrefetchedBytes{0ULL};
+
+  /// The roll each channel is prefetching into.
+  std::unordered_map<ChannelId, PrefetchedRoll> mPrefetchedRolls;
+
+  /// The roll the replay cursor last read on each channel; released once the cursor moves past it.
+  std::unordered_map<ChannelId, std::uint64_t> mReplayedRolls;
+
+  /// The compressed rolls open on each channel, keyed by roll id: at most two, so the one the
+  /// cursor reads and the one read-ahead has moved on to can both stay open.
+  std::unordered_map<ChannelId, std::map<std::uint64_t, std::unique_ptr<CompressedRoll>>>
+      mCompressedRolls;
+
+  /// How rolls are mapped.
+  RollWindows mRollWindows;
+
+  /// The rolls open a window at a time on each channel, keyed by roll id: at most two, like
+  /// mCompressedRolls.
+  std::unordered_map<ChannelId, std::map<std::uint64_t, std::unique_ptr<WindowedRoll>>>
+      mWindowedRolls;
+
+  /// Each channel's oldest roll still on disk, found on the channel's first record. Retention
+  /// deletes rolls oldest first, so every earlier roll of the channel has expired.
+  std::unordered_map<ChannelId, std::uint64_t> mFirstSurvivingRolls;
+
+  /// @brief Open the chronicle rooted at @p logRoot, mapping its timeline only if @p mapTimeline.
+  ///
+  /// Without the timeline, the Reader only maps rolls, for entries another Reader looks up.
+  Reader(std::filesystem::path logRoot, bool mapTimeline);
+
+  /// @brief Timeline positions of every record of @p channelIds, ascending.
+  ///
+  /// Merges the channels' entry indices, falling back to one timeline scan if any is missing.
+  [[nodiscard]] std::vector<std::uint64_t> selectRecords(
+      const std::unordered_set<ChannelId>& channelIds) const;
+
+  /// @brief Number of records replayed; zero when the chronicle has no timeline file.
+  [[nodiscard]] std::uint64_t recordCount() const noexcept;
+
+  /// @brief The timeline position of the replayed record at @p index. Unchecked; @p index must be
+  /// less than recordCount().
+  [[nodiscard]] std::uint64_t timelinePosition(std::uint64_t index) const noexcept;
+
+  /// @brief The timeline entry at timeline @p position, on a sharded timeline too. Unchecked;
+  /// @p position must be less than mTimelineLength.
+  [[nodiscard]] const TimelineEntry& entryAt(std::uint64_t position) const noexcept;
+
+  /// @brief The timeline entry of the replayed record at @p index. Unchecked; @p index must be less
+  /// than recordCount().
+  [[nodiscard]] const TimelineEntry& timelineEntry(std::uint64_t index) const noexcept;
+
+  /// @brief Load the replayed record at @p index, with an empty crate if its bytes are lost (see
+  /// isLost). Unchecked; @p index must be less than recordCount().
+  [[nodiscard]] Entry loadEntry(std::uint64_t index);
+
+  /// @brief Load the record @p entry locates, with an empty crate if its bytes are lost.
+  [[nodiscard]] Entry loadEntry(const TimelineEntry& entry);
+
+  /// @brief Whether @p entry's bytes are gone: a crash left its slot uncommitted, or retention has
+  /// deleted the roll holding them.
+  [[nodiscard]] bool isLost(const TimelineEntry& entry);
+
+  /// @brief Whether @p crate holds the bytes that were checksummed for the record at timeline
+  /// @p position. True when there is no checksum to compare against.
+  [[nodiscard]] bool matchesChecksum(std::uint64_t position, const Crate& crate) const noexcept;
+
+  /// @brief Account for the cursor replaying record @p index: release the roll it left behind on
+  /// that channel, then prefetch ahead until the record count or byte window is reached.
+  void readAhead(std::uint64_t index);
+
+  /// @brief Forget every prefetch, after the cursor jumped.
+  void resetReadAhead() noexcept;
+
   /// @brief Read the record at the current cursor and advance the cursor by one.
   ///
   /// Called by the Iterator on construction and on each increment.
@@ -175,6 +634,28 @@ private:
   ///
   /// @return A shared owner of the mapped roll, kept alive by every Entry that references it.
   std::shared_ptr<const Roll> acquireRoll(ChannelId channelId, std::uint64_t rollId);
+
+  /// @brief Return the given roll if it is stored compressed, opening it if need be and recording
+  /// it in mCompressedRolls; return null if it is stored as written.
+  ///
+  /// @param channelId The channel whose roll is needed.
+  ///
+  /// @param rollId The id of the roll within that channel.
+  ///
+  /// @return The compressed roll, valid until the next call, or null.
+  CompressedRoll* acquireCompressedRoll(ChannelId channelId, std::uint64_t rollId);
+
+  /// @brief Return the given roll opened a window at a time, opening it if need be and recording it
+  /// in mWindowedRolls; return null if rolls are mapped whole or this one already is.
+  ///
+  /// @param channelId The channel whose roll is needed.
+  ///
+  /// @param rollId The id of the roll within that channel.
+  ///
+  /// @return The windowed roll, valid until the next call, or null.
+  ///
+  /// @throws std::runtime_error If the roll cannot be opened.
+  WindowedRoll* acquireWindowedRoll(ChannelId channelId, std::uint64_t rollId);
 };
 
 } // namespace nioc::chronicle
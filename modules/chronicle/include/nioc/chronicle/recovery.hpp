@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <filesystem>
+
+namespace nioc::chronicle
+{
+
+/// @brief Bring the chronicle rooted at @p logRoot, left behind by a crashed Writer, to the state a
+/// clean close would have left it in.
+///
+/// A Writer trims its files as it closes. One that crashed leaves the timeline and time index at
+/// their full, mostly empty capacity, and each channel's active roll and spare roll untrimmed.
+/// Every timeline entry carries a commit marker (see TimelineEntry), so this finds the last
+/// committed entry by binary search, then:
+///
+/// - trims the timeline after that entry, and the time index after its last sample within it;
+///   sooner, before the first entry whose record was written directly and had not reached disk,
+///   as its channel's durable marks tell (see Writeback);
+/// - trims the checksums, if recorded, to the timeline;
+/// - of a sharded timeline, trims each shard and its checksums likewise, then writes the merged
+///   order and its time index a clean close would have written;
+/// - trims each channel's two newest referenced rolls after their last committed record;
+/// - deletes each channel's rolls that no committed record references, and its spare roll;
+/// - deletes half-written compressed rolls, and originals whose compressed roll is in place;
+/// - writes the channel entry indices (see buildChannelIndices).
+///
+/// Finding the rolls to trim walks the timeline back from its tail only until every channel's two
+/// newest rolls are settled. A chronicle that closed cleanly is left as it is, but for its indices
+/// being rewritten, so recovering twice is harmless.
+///
+/// Example:
+///
+///     nioc::chronicle::recover("/data/run42");
+///     nioc::chronicle::Reader reader{"/data/run42"};
+///
+/// A Reader replays a crashed chronicle correctly without this, unless its rolls were written
+/// directly: a crash can leave entries behind whose records never reached disk, which only this
+/// cuts. Recovering also spares every later Reader the tail search and reclaims the untrimmed disk
+/// space. Must not run while a Writer is
+/// still recording into @p logRoot, nor while a Reader has it open.
+///
+/// @param logRoot Chronicle root directory.
+///
+/// @throws std::invalid_argument If @p logRoot does not exist or is not a directory.
+///
+/// @throws std::filesystem::filesystem_error If a file cannot be trimmed or deleted.
+///
+/// @throws std::runtime_error If a file cannot be mapped, an index file cannot be written, or the
+/// chronicle was recorded in an older or foreign layout (see ChronicleFormat), which it leaves
+/// untouched.
+///
+/// @see Reader, Writer, buildChannelIndices
+void recover(const std::filesystem::path& logRoot);
+
+} // namespace nioc::chronicle
@@ -6,10 +6,7 @@
 #pragma once
 
 #include <cstddef>
-#include <cstdint>
 #include <memory>
-#include <nioc/containers/mmapArray.hpp>
-#include <nioc/containers/tape.hpp>
 #include <span>
 
 namespace nioc::chronicle
@@ -17,6 +14,8 @@ namespace nioc::chronicle
 
 class Channel;
 class Crate;
+class RollLease;
+struct ChannelLane;
 
 /// @brief A move-only, single-use write handle to a byte slot inside a channel's active roll (the
 /// memory-mapped data file the channel currently appends records to).
@@ -30,8 +29,9 @@ class Crate;
 ///     std::memcpy(res.span().data(), payload, payloadSize);
 ///     Crate crate = std::move(res).commit(payloadSize); // publishes the record
 ///
-/// Exactly one live Reservation ever refers to a given slot, so no locking is needed. A
-/// moved-from handle owns nothing and must not be used.
+/// Exactly one live Reservation ever refers to a given slot, so no locking is needed. While it
+/// lives, the handle holds its roll open for writing, so the channel seals the roll only once the
+/// handle is committed or dropped. A moved-from handle owns nothing and must not be used.
 ///
 /// @see Channel, Crate
 class Reservation
@@ -65,8 +65,9 @@ public:
   /// @brief Resizes the slot to hold @p newSize usable bytes.
   ///
   /// Shrinking (or no change) keeps the slot's start and contents, returning the freed tail to the
-  /// roll; span() still reports the old, larger extent, so treat only the first @p newSize bytes as
-  /// yours. Growing throws away the old slot and claims a fresh one, possibly on a new roll, losing
+  /// roll and narrowing span() to @p newSize rounded up to a word; when a later claim keeps the tail
+  /// from being returned, span() still reports the old, larger extent, so treat only the first
+  /// @p newSize bytes as yours. Growing throws away the old slot and claims a fresh one, possibly on a new roll, losing
   /// any bytes already written. Always re-read span() afterward.
   void modify(std::size_t newSize);
 
@@ -89,27 +90,28 @@ private:
   /// @param channel The owning channel, used to abandon or commit the slot later. Must outlive
   /// this handle.
   ///
-  /// @param rollPtr The roll that backs the slot. Shared so the bytes stay alive even if the
-  /// channel rolls over to a new roll.
+  /// @param lease The lease on the roll that backs the slot, which the slot has already entered.
+  /// Shared so the bytes stay alive even if the channel rolls over to a new roll.
   ///
-  /// @param rollId Identifies which roll the slot lives on, so a later commit or modify can tell
-  /// whether the active roll has since changed.
+  /// @param lane The channel's lane the slot was carved from, or null if it was claimed from the
+  /// roll directly.
   ///
   /// @param span The writable bytes of the slot, already rounded up to a machine word.
   Reservation(
       Channel& channel,
-      std::shared_ptr<containers::Tape<containers::MmapArray<std::byte>>> rollPtr,
-      std::uint64_t rollId,
+      std::shared_ptr<RollLease> lease,
+      ChannelLane* lane,
       std::span<std::byte> span);
 
   /// The owning channel. Null once the handle has been moved-from.
   Channel* mChannelPtr;
 
-  /// The roll backing the slot, kept alive for this handle's lifetime.
-  std::shared_ptr<containers::Tape<containers::MmapArray<std::byte>>> mRollPtr;
+  /// The lease on the roll backing the slot, held and entered for this handle's lifetime. Null
+  /// once the handle has been moved-from or committed.
+  std::shared_ptr<RollLease> mLease;
 
-  /// Identifies the roll the slot lives on, so commit and modify can detect a roll-over.
-  std::uint64_t mRollId{0ULL};
+  /// The channel's lane the slot was carved from, or null if it was claimed from the roll.
+  ChannelLane* mLane{nullptr};
 
   /// The writable bytes of the slot. Empty once the handle has been moved-from.
   std::span<std::byte> mSpan;
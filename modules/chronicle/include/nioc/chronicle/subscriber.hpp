@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "defines.hpp"
+#include "reader.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <nioc/containers/mmapConstArray.hpp>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+namespace nioc::chronicle
+{
+
+/// @brief Receives the records a Broker shares, in another process, reading each in place from the
+/// roll the Writer wrote it into.
+///
+/// Example:
+///
+///     nioc::chronicle::Subscriber subscriber{"/run/nioc/run42.sock"};
+///     subscriber.subscribe(channelId);
+///     while(const auto entry = subscriber.next(std::chrono::milliseconds{100}))
+///     {
+///       process(entry->mChannelId, entry->mCrate.span());
+///     }
+///     // next() came back empty: a quiet interval, or subscriber.closed()
+///
+/// The Broker sends a notice per record and, with the first notice of each roll, the roll's file
+/// descriptor, which the Subscriber maps read-only. A record's Crate points into that mapping and
+/// keeps it alive, so no byte is copied between the processes, and a Crate stays valid however long
+/// it is held. At most Broker::kOpenRollsPerChannel rolls per channel are mapped at once besides
+/// those Crates still hold.
+///
+/// Records arrive in the order they were committed on each channel; records of different channels
+/// may arrive in either order. A Subscriber that falls behind by more than its socket buffer holds
+/// misses records (see Broker).
+///
+/// Not copyable or movable. Not thread-safe.
+///
+/// @see Broker, Follower
+class Subscriber
+{
+public:
+  /// @brief Connect to the Broker listening on the Unix socket at @p socketPath.
+  ///
+  /// @throws std::invalid_argument If @p socketPath is too long for a Unix socket.
+  ///
+  /// @throws std::runtime_error If no Broker listens there.
+  explicit Subscriber(std::filesystem::path socketPath);
+
+  Subscriber(const Subscriber&) = delete;
+
+  Subscriber(Subscriber&&) noexcept = delete;
+
+  /// @brief Hang up on the Broker. Crates already yielded stay valid.
+  ~Subscriber();
+
+  Subscriber& operator=(const Subscriber&) = delete;
+
+  Subscriber& operator=(Subscriber&&) noexcept = delete;
+
+  /// @brief Ask for the records committed on @p channelId from now on. The channel must be shared
+  /// by the Broker to yield any; subscribing twice has no effect.
+  ///
+  /// @throws std::runtime_error If the Broker cannot be reached.
+  void subscribe(ChannelId channelId);
+
+  /// @brief The next record, waiting up to @p timeout for one to be committed.
+  ///
+  /// @return The record, or empty if none came in time or the Broker hung up (see closed()).
+  ///
+  /// @throws std::runtime_error If a notice is malformed or its roll cannot be mapped.
+  [[nodiscard]] std::optional<Entry> next(std::chrono::nanoseconds timeout);
+
+  /// @brief Whether the Broker hung up; next() yields nothing more.
+  [[nodiscard]] bool closed() const noexcept;
+
+  /// The Unix socket of the Broker.
+  [[nodiscard]] const std::filesystem::path& path() const noexcept;
+
+private:
+  /// A roll mapped through the descriptor the Broker sent.
+  using Roll = containers::MmapConstArray<std::byte>;
+
+  /// The Unix socket of the Broker, returned by path().
+  const std::filesystem::path mSocketPath;
+
+  /// The socket connected to the Broker.
+  const int mSocket;
+
+  /// The mapped rolls per channel, by roll id, oldest received first.
+  std::unordered_map<ChannelId, std::deque<std::pair<std::uint64_t, std::shared_ptr<const Roll>>>>
+      mRolls;
+
+  /// Set once the Broker has hung up.
+  bool mClosed{false};
+
+  /// @brief Take in one pending notice without waiting: the record it announces, or empty if no
+  /// notice was pending, the Broker hung up, or the record's roll was never received.
+  [[nodiscard]] std::optional<Entry> receive();
+
+  /// @brief Map roll @p rollId of @p channelId through @p fileDescriptor, taking ownership of it,
+  /// and unmap the channel's oldest roll if that makes one too many.
+  void adopt(ChannelId channelId, std::uint64_t rollId, int fileDescriptor);
+};
+
+} // namespace nioc::chronicle
@@ -0,0 +1,284 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "defines.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <nioc/containers/mmapArray.hpp>
+#include <nioc/containers/tape.hpp>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace nioc::chronicle
+{
+
+/// @brief The write side of a chronicle's record index: the global, append-only list of
+/// TimelineEntry shared by every Channel, plus a sparse time index sampled from it.
+///
+/// Every committed record appends one entry to `timeline.nioc`, so the file carries the global
+/// write order across channels. Every @p timeIndexStride-th entry is additionally sampled into
+/// `timeIndex.nioc` as a TimeIndexEntry stamped with the system-clock instant of its commit. The
+/// samples are few and ordered by position, so a Reader binary-searches them to jump to an instant
+/// without decoding a single record.
+///
+/// With checksums on, `checksums.nioc` holds one CRC-32C per entry, at the entry's position, over
+/// the record's bytes. Readers verify records against it (see Reader::verify).
+///
+/// The files start sized for kInitialCapacity entries and grow in place, at least doubling, as
+/// entries fill them, up to the capacity, whose address space is reserved from the start. So a
+/// generous capacity costs address space, not file length, and no entry ever moves.
+///
+/// Each entry's commit marker is written last, so after a crash the committed entries form a prefix
+/// of the file, but for a few holes left by producers caught mid-append. A Reader or recover()
+/// finds its end by binary search.
+///
+/// Example:
+///
+///     auto timeline = Timeline{logRoot, capacity};
+///     const auto position = timeline.append(entry); // entry's index on the timeline
+///     timeline.shrink_to_fit();                     // trim both files before closing
+///
+/// append() is thread-safe: concurrent channels claim disjoint slots without a lock. Samples are
+/// taken as their entry is written, so under concurrent producers neighbouring samples may be skewed
+/// by the time a commit takes. Not copyable or movable. A Writer creates and owns the timeline of
+/// its chronicle.
+///
+/// Every append claims its slot on the one shared cursor, whose cache line bounces between the
+/// cores of many producers. Split into shards, the timeline instead keeps one file per shard,
+/// `timeline-<shard>.nioc`, with its own cursor, and an append claims on the shard of the core it
+/// runs on; when that shard is full, it moves on to the next. Each shard entry is a StampedEntry
+/// carrying its commit instant, which the shards merge by, so a sharded timeline keeps no time
+/// index as it records. Its Writer merges the shards once as it closes, writing the merged order to
+/// `mergedOrder.nioc` and sampling it into `timeIndex.nioc`, so Readers map the order rather than
+/// merge it again. Checksums are kept per shard too, in `checksums-<shard>.nioc`.
+///
+/// @see Channel, Writer, Reader::seek
+class Timeline
+{
+public:
+  /// Default number of timeline entries per time-index sample. One 16-byte sample per 1024 entries
+  /// keeps the index under 0.05% of the timeline while bounding a seek's overshoot to 1023 entries.
+  static constexpr auto kDefaultTimeIndexStride = std::uint64_t{1024ULL};
+
+  /// Most shards a timeline splits into.
+  static constexpr auto kMaxShards = std::size_t{256};
+
+  /// Entries the files are first sized for, shared between the shards of a sharded timeline.
+  static constexpr auto kInitialCapacity = std::size_t{1ULL << 20U};
+
+  /// @brief Create the timeline and its time index under @p logRoot, able to grow to @p capacity
+  /// entries.
+  ///
+  /// Creates or truncates `timeline.nioc` and `timeIndex.nioc` in @p logRoot, or with more than one
+  /// shard, the shard files instead.
+  ///
+  /// @param logRoot Directory that holds the two files. Created if missing.
+  ///
+  /// @param capacity Maximum number of entries the timeline accepts. Must be non-zero.
+  ///
+  /// @param timeIndexStride Entries per time-index sample. Must be non-zero.
+  ///
+  /// @param checksums Whether to also keep `checksums.nioc`, one checksum per entry.
+  ///
+  /// @param shards Number of shards to split the timeline into, each sized for an even share of
+  /// @p capacity. One keeps the single shared file.
+  ///
+  /// @param mapPolicy How to map the files; lazily by default.
+  ///
+  /// @throws std::invalid_argument If @p timeIndexStride is zero, or @p shards is zero or more than
+  /// kMaxShards.
+  ///
+  /// @throws std::runtime_error If a file cannot be created, sized, or mapped.
+  Timeline(
+      const std::filesystem::path& logRoot,
+      std::size_t capacity,
+      std::uint64_t timeIndexStride = kDefaultTimeIndexStride,
+      bool checksums = false,
+      std::size_t shards = 1,
+      containers::MapPolicy mapPolicy = {});
+
+  Timeline(const Timeline&) = delete;
+
+  Timeline(Timeline&&) noexcept = delete;
+
+  ~Timeline() = default;
+
+  Timeline& operator=(const Timeline&) = delete;
+
+  Timeline& operator=(Timeline&&) noexcept = delete;
+
+  /// @brief Number of entries appended so far, over every shard.
+  [[nodiscard]] std::size_t size() const noexcept;
+
+  /// @brief Maximum number of entries the timeline accepts, over every shard.
+  [[nodiscard]] std::size_t capacity() const noexcept;
+
+  /// @brief Number of shards the timeline is split into; one if it is not split.
+  [[nodiscard]] std::size_t shardCount() const noexcept;
+
+  /// @brief Whether append() records a checksum with each entry.
+  [[nodiscard]] bool hasChecksums() const noexcept;
+
+  /// @brief Entries per time-index sample.
+  [[nodiscard]] std::uint64_t timeIndexStride() const noexcept;
+
+  /// @brief Record @p entry at the next free position, sampling it into the time index when the
+  /// position falls on the stride.
+  ///
+  /// Thread-safe.
+  ///
+  /// @param entry Timeline entry locating one just-committed record.
+  ///
+  /// @param checksum The record's CRC-32C; ignored unless hasChecksums().
+  ///
+  /// @return The position @p entry was written at; within its shard, on a sharded timeline.
+  ///
+  /// @throws std::runtime_error If the timeline is at capacity, or every shard is.
+  std::uint64_t append(const TimelineEntry& entry, std::uint32_t checksum = 0U);
+
+  /// @brief Advance each of @p lengths over the entries committed since: on return, entries
+  /// `[0, lengths[shard])` of each shard are all committed, and the next one is not yet.
+  ///
+  /// Safe alongside append(), but not alongside itself. A producer caught between its claim and its
+  /// commit holds the length back until it commits. A length short of the entries discard() has
+  /// discarded skips over them, as they read as never committed.
+  ///
+  /// @param lengths One length per shard, as the previous call left them, or zeros at first.
+  void scanCommitted(std::span<std::uint64_t> lengths) noexcept;
+
+  /// @brief Trim the files down to the entries and samples actually written, and clamp each sample
+  /// to the latest before it so a seek can binary-search them.
+  ///
+  /// NOT thread-safe: call it with no concurrent append(). Typically the last call before the
+  /// timeline is destroyed.
+  void shrink_to_fit() noexcept;
+
+  /// @brief Start writing back the entries appended since the previous call, without waiting.
+  ///
+  /// Safe alongside append(), but not alongside itself: call it from one pacing thread.
+  void startWriteback() noexcept;
+
+  /// @brief Discard the first @p count entries, their checksums, and their samples, freeing the
+  /// disk space and the pages they take up, as a Writer does once a Retention policy has deleted
+  /// every record they locate.
+  ///
+  /// The count is recorded in `discarded.nioc` first, then the whole pages the discarded entries
+  /// fill are freed and read as zero, as holes a crash left would, so their positions keep their
+  /// meaning and Readers skip them as lost. The files keep their length, as does the capacity an
+  /// append may claim. A count no larger than the last one is ignored, as is every call on a
+  /// sharded timeline, whose entries are kept.
+  ///
+  /// Safe alongside append(), but not alongside itself or shrink_to_fit().
+  ///
+  /// @throws std::runtime_error If the count cannot be recorded.
+  void discard(std::uint64_t count);
+
+  /// @brief Make every entry appended so far, its checksum, and the time index durable on disk.
+  ///
+  /// Flushes the checksums before the entries they cover, and the time index after them. Safe
+  /// alongside append(); entries appended meanwhile may or may not be covered, and may reach the
+  /// disk without their checksums.
+  ///
+  /// @throws std::runtime_error If a file cannot be flushed.
+  void sync() const;
+
+private:
+  /// One shard of a sharded timeline. Each sits on cache lines of its own, so producers on
+  /// different shards never touch a common line.
+  struct alignas(64) Shard
+  {
+    /// @brief Create the files of shard @p index under @p logRoot, sized for @p initialCapacity
+    /// entries, able to grow to @p capacity, and mapped under @p mapPolicy.
+    Shard(
+        const std::filesystem::path& logRoot,
+        std::size_t index,
+        std::size_t initialCapacity,
+        std::size_t capacity,
+        bool checksums,
+        const containers::MapPolicy& mapPolicy);
+
+    /// The shard's entries, in the order they were claimed.
+    containers::Tape<containers::MmapArray<StampedEntry>> mEntries;
+
+    /// One CRC-32C per entry, at the entry's position in the shard, or empty without checksums.
+    std::optional<containers::MmapArray<std::uint32_t>> mChecksums;
+
+    /// Entries whose writeback startWriteback() has already started.
+    std::uint64_t mWrittenBack{0ULL};
+  };
+
+  /// Directory that holds the files.
+  const std::filesystem::path mLogRoot;
+
+  /// Entries per time-index sample.
+  const std::uint64_t mTimeIndexStride;
+
+  /// The global record index, one TimelineEntry per committed record in write order. Empty on a
+  /// sharded timeline.
+  std::optional<containers::Tape<containers::MmapArray<TimelineEntry>>> mEntries;
+
+  /// The sparse time index. Sample `n` describes entry `n * mTimeIndexStride`; it is written in
+  /// place rather than appended, so samples stay in position order however producers interleave.
+  /// Empty on a sharded timeline.
+  std::optional<containers::MmapArray<TimeIndexEntry>> mTimeIndex;
+
+  /// The latest stamp sampled into the time index; each new sample is at least this late.
+  std::atomic<std::int64_t> mLatestSample{std::numeric_limits<std::int64_t>::min()};
+
+  /// One CRC-32C per entry, at the entry's position, or empty without checksums or when sharded.
+  std::optional<containers::MmapArray<std::uint32_t>> mChecksums;
+
+  /// Entries whose writeback startWriteback() has already started.
+  std::uint64_t mWrittenBack{0ULL};
+
+  /// Leading entries discard() has discarded. Read by scanCommitted() on other threads.
+  std::atomic<std::uint64_t> mDiscarded{0ULL};
+
+  /// The count of discarded entries, as `discarded.nioc` records it. Empty until the first
+  /// discard().
+  std::optional<containers::MmapArray<std::uint64_t>> mDiscardedFile;
+
+  /// The shards, or empty if the timeline is not split.
+  std::vector<std::unique_ptr<Shard>> mShards;
+
+  /// Serializes growing the checksums and the time index as the entries outgrow them; writes that
+  /// fit never take it.
+  std::mutex mGrowthMutex;
+
+  /// @brief Append @p entry to the shard of the calling core, or the next one with room.
+  std::uint64_t appendToShard(const TimelineEntry& entry, std::uint32_t checksum);
+};
+
+/// @brief The layout of `doorbell.nioc`, through which a recording Writer tells its Followers,
+/// possibly in other processes, how much of the timeline is committed.
+///
+/// The Writer publishes each shard's committed length, then bumps @ref mSequence, a futex word the
+/// Followers sleep on. Followers only ever read the file, so they need no write access to the
+/// chronicle.
+///
+/// @see Writer, Follower
+struct Doorbell
+{
+  /// Bumped each time the Writer publishes.
+  std::uint32_t mSequence{0U};
+
+  /// Non-zero once the Writer has published its final lengths and closed the chronicle.
+  std::uint32_t mClosed{0U};
+
+  /// Number of leading entries committed in each shard. A timeline that is not sharded counts as
+  /// shard 0.
+  std::array<std::uint64_t, Timeline::kMaxShards> mCommitted{};
+};
+
+} // namespace nioc::chronicle
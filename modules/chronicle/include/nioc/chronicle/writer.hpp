@@ -8,25 +8,125 @@
 #include "channel.hpp"
 #include "crate.hpp"
 #include "defines.hpp"
+#include "timeline.hpp"
+#include <array>
+#include <chrono>
+#include <condition_variable>
 #include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <memory>
+#include <mutex>
 #include <nioc/common/locked.hpp>
 #include <nioc/containers/mmapArray.hpp>
-#include <nioc/containers/tape.hpp>
+#include <nioc/containers/mmapRegion.hpp>
+#include <optional>
 #include <span>
+#include <stop_token>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 namespace nioc::chronicle
 {
 
+/// @brief How a Writer records its chronicle, set field by field with designated initializers.
+///
+/// Every field has a default, so a Writer needs only the ones it changes:
+///
+///     nioc::chronicle::Writer writer{
+///         "/data/run42",
+///         {.mRollCapacity = 1ULL << 30U, .mChecksums = true}};
+///
+/// @see Writer
+struct WriterOptions
+{
+  /// Default byte size each data roll grows to. A roll starts small and grows in place as records
+  /// fill it; a channel seals the roll and opens a fresh one once it reaches this size, and a
+  /// single record larger than this grows its roll to fit.
+  static constexpr auto kDefaultRollCapacity = std::size_t{10ULL * 1024ULL * 1024ULL * 1024ULL};
+
+  /// @brief Default byte size the timeline file grows to.
+  ///
+  /// Caps the total number of records across all channels: the usable entry count is this value
+  /// divided by sizeof(TimelineEntry), or by sizeof(StampedEntry) when sharded. The file starts at
+  /// Timeline::kInitialCapacity entries and grows as records fill it, so the cap costs reserved
+  /// address space rather than disk.
+  static constexpr auto kDefaultTimelineCapacity =
+      std::size_t{4ULL * 1024ULL * 1024ULL * 1024ULL * 1024ULL};
+
+  /// Byte size each channel's data roll grows to.
+  std::size_t mRollCapacity{kDefaultRollCapacity};
+
+  /// Byte size the timeline file grows to; bounds the total record count (see
+  /// kDefaultTimelineCapacity).
+  std::size_t mTimelineCapacity{kDefaultTimelineCapacity};
+
+  /// Timeline entries per time-index sample; smaller strides make Reader::seek land closer to its
+  /// target at the cost of a larger index.
+  std::uint64_t mTimeIndexStride{Timeline::kDefaultTimeIndexStride};
+
+  /// How much of each channel's data to keep on disk. The default keeps everything; a bounded
+  /// policy turns the chronicle into a flight recorder whose Reader replays only the surviving
+  /// window. It runs the pacing thread, once a second unless @ref mWriteback paces more often, to
+  /// age rolls out and discard the index entries of deleted records.
+  Retention mRetention{};
+
+  /// How to pace the writeback of written bytes to disk, and whether to bypass the page cache for
+  /// the rolls. The default maps them and leaves the writeback to the kernel.
+  Writeback mWriteback{};
+
+  /// Whether to compress each roll once it is sealed; off by default.
+  Compression mCompression{};
+
+  /// Whether to record a CRC-32C of each record in `checksums.nioc`, so a Reader can detect
+  /// corrupted records (see Reader::verify); off by default.
+  bool mChecksums{false};
+
+  /// Number of shards to split the timeline into, which share @ref mTimelineCapacity between them.
+  /// About one per core that publishes suits many producers; the default of one keeps a single
+  /// timeline file and time index.
+  std::size_t mTimelineShards{1};
+
+  /// How often to publish the committed timeline to Followers. The default of zero creates no
+  /// doorbell, and Followers cannot tail the chronicle.
+  std::chrono::nanoseconds mDoorbellInterval{0};
+
+  /// @brief How each channel's rolls are mapped, including the bytes they grow by, unless
+  /// @ref mChannelPolicies names the channel.
+  ///
+  /// Mapped lazily by default, so every page a writer first touches faults. A busy channel can
+  /// have its rolls mapped under a policy that faults the pages in up front, backs them with huge
+  /// pages, or locks them, at the cost of memory committed early; a quiet one is best left lazy.
+  containers::MapPolicy mRollPolicy{};
+
+  /// How the rolls of the channels named here are mapped, in place of @ref mRollPolicy.
+  std::unordered_map<ChannelId, containers::MapPolicy> mChannelPolicies{};
+
+  /// How the timeline, its shards, its checksums, and its time index are mapped. Every record
+  /// stamps the timeline, so it is often worth faulting in even when few channels' rolls are.
+  containers::MapPolicy mTimelinePolicy{};
+};
+
 /// @brief Records a multi-channel log to a directory on disk, where readers can later replay every
 /// channel in write order.
 ///
-/// A chronicle is a root directory holding one shared timeline file plus one subdirectory of
-/// memory-mapped data rolls per channel. Each write copies the payload into a channel's roll and
-/// stamps the timeline with that record's location, so the global write order is preserved across
-/// channels. Channels are created on demand and owned by the Writer for its whole lifetime.
+/// A chronicle is a root directory holding one shared timeline file, a sparse time index sampled
+/// from it, plus one subdirectory of memory-mapped data rolls per channel. Each write copies the
+/// payload into a channel's roll and stamps the timeline with that record's location, so the global
+/// write order is preserved across channels. Channels are created on demand and owned by the Writer
+/// for its whole lifetime. On close, each channel directory also receives an entry index of its
+/// records' timeline positions.
+///
+/// Many producers committing at once contend on the timeline's one cursor. A Writer given more
+/// than one timeline shard splits the timeline instead (see Timeline), so commits on different
+/// cores claim on different cache lines and their cost stays flat as producers are added. A Reader
+/// merges the shards back into one order transparently.
+///
+/// A Writer given a doorbell interval also lets Followers tail the chronicle while it is recorded,
+/// from this or other processes. Every interval, a doorbell thread finds how far the timeline is
+/// committed, publishes that in `doorbell.nioc`, and wakes the Followers waiting on it, so a
+/// record reaches them within about one interval of its commit and write() pays nothing for it.
 ///
 /// Example:
 ///
@@ -36,28 +136,26 @@ namespace nioc::chronicle
 ///
 /// Use one Writer per chronicle directory. Not copyable or movable.
 ///
-/// @see Channel, Reader, makeChannelId
+/// @see Channel, Reader, MemoryWriter, makeChannelId
 class Writer
 {
 public:
-  /// Default byte size of each data roll. A channel seals the active roll and opens a fresh one
-  /// once it fills; a single record larger than this grows its roll to fit.
-  static constexpr auto kDefaultRollCapacity = 10ULL * 1024ULL * 1024ULL * 1024ULL;
+  /// Default byte size each data roll grows to (see WriterOptions::kDefaultRollCapacity).
+  static constexpr auto kDefaultRollCapacity = WriterOptions::kDefaultRollCapacity;
 
-  /// @brief Default byte size of the timeline file.
-  ///
-  /// Caps the total number of records across all channels: the usable entry count is this value
-  /// divided by sizeof(TimelineEntry).
-  static constexpr auto kDefaultTimelineCapacity = 4ULL * 1024ULL * 1024ULL * 1024ULL * 1024ULL;
+  /// Default byte size the timeline file grows to (see WriterOptions::kDefaultTimelineCapacity).
+  static constexpr auto kDefaultTimelineCapacity = WriterOptions::kDefaultTimelineCapacity;
 
   /// @brief Open a new chronicle under @p rootDir, allocating the timeline file immediately.
   ///
+  /// Every option but the two capacities keeps its default (see WriterOptions).
+  ///
   /// @param rootDir Chronicle root. Must name an existing, empty directory.
   ///
-  /// @param rollCapacity Byte size of each channel's data roll.
+  /// @param rollCapacity Byte size each channel's data roll grows to.
   ///
-  /// @param timelineCapacity Byte size of the timeline file; bounds the total record count (see
-  /// kDefaultTimelineCapacity).
+  /// @param timelineCapacity Byte size the timeline file grows to; bounds the total record count
+  /// (see kDefaultTimelineCapacity).
   ///
   /// @throws std::invalid_argument if @p rootDir does not exist, is not a directory, or is not
   /// empty.
@@ -69,11 +167,31 @@ public:
       std::size_t rollCapacity = kDefaultRollCapacity,
       std::size_t timelineCapacity = kDefaultTimelineCapacity);
 
+  /// @brief Open a new chronicle under @p rootDir as @p options set out, allocating the timeline
+  /// file immediately.
+  ///
+  /// @param rootDir Chronicle root. Must name an existing, empty directory.
+  ///
+  /// @param options How to record the chronicle; every field it leaves out keeps its default.
+  ///
+  /// @throws std::invalid_argument if @p rootDir does not exist, is not a directory, or is not
+  /// empty, if the options ask for no timeline shard or more than Timeline::kMaxShards, for a
+  /// writeback that keeps the rolls in memory (see MemoryWriter), or for a doorbell while the
+  /// writeback writes directly.
+  ///
+  /// @throws std::filesystem::filesystem_error if a filesystem status query on @p rootDir fails
+  /// (for example, a permission error).
+  Writer(std::filesystem::path rootDir, const WriterOptions& options);
+
   Writer(const Writer&) = delete;
 
   Writer(Writer&&) noexcept = delete;
 
-  /// Trim the timeline file down to the bytes actually written.
+  /// Stop the writeback pacing and doorbell threads, tell Followers the chronicle is closed, trim
+  /// the timeline and time index files down to the bytes actually written, then close the channels,
+  /// each putting its entry index in place. A sharded timeline is merged first, and its channels
+  /// indexed along the merged order (see buildChannelIndices). A failure to index is logged, not
+  /// thrown.
   ~Writer();
 
   Writer& operator=(const Writer&) = delete;
@@ -83,8 +201,8 @@ public:
   /// @brief Return the channel for @p channelId, creating it on first use.
   ///
   /// Thread-safe: serialized against concurrent channel() and write() calls on this Writer. The
-  /// returned reference stays valid for the Writer's lifetime. The Channel itself is not
-  /// synchronized, so do not write to a single channel from multiple threads at once.
+  /// returned reference stays valid for the Writer's lifetime, and any number of threads may write
+  /// through it at once (see Channel).
   [[nodiscard]] Channel& channel(ChannelId channelId);
 
   /// @brief Append @p data as one record on @p channelId and return a handle to the stored bytes.
@@ -92,12 +210,23 @@ public:
   /// Convenience wrapper over channel(channelId).write(data). The returned Crate keeps its backing
   /// roll mapped for as long as it lives.
   ///
-  /// Thread-safe with respect to other channels, but two threads must not write the same channel
-  /// concurrently (see channel()).
+  /// Thread-safe, including many threads writing the same channel.
   ///
   /// @throws std::runtime_error if the timeline is full.
   Crate write(ChannelId channelId, std::span<const std::byte> data);
 
+  /// @brief Make every record committed before the call durable on disk, with its timeline entry.
+  ///
+  /// Flushes each channel's rolls first and the timeline last, so the entries of those records
+  /// point at bytes on disk. Records committed while it runs get no such promise: an entry may
+  /// reach the disk ahead of its record's bytes, which with checksums on fails Reader::verify.
+  /// Blocks until the flushes complete.
+  ///
+  /// Thread-safe, including alongside write().
+  ///
+  /// @throws std::runtime_error If a file cannot be flushed.
+  void checkpoint();
+
   /// This chronicle's root directory.
   [[nodiscard]] const std::filesystem::path& path() const noexcept;
 
@@ -112,13 +241,82 @@ private:
   /// Byte size used when opening each channel's data roll.
   const std::size_t mRollCapacity;
 
-  /// The shared timeline: one growable, memory-mapped array of TimelineEntry that records every
-  /// channel's writes in global write order.
-  containers::Tape<containers::MmapArray<TimelineEntry>> mTimeline;
+  /// How often the pacing thread enforces the retention policy when it paces no writeback.
+  static constexpr auto kRetentionInterval = std::chrono::seconds{1};
+
+  /// The retention policy every channel applies to its own rolls.
+  const Retention mRetention;
+
+  /// The writeback pacing policy mWritebackThread follows.
+  const Writeback mWriteback;
+
+  /// Whether and how every channel compresses its sealed rolls.
+  const Compression mCompression;
+
+  /// How the rolls of a channel mChannelPolicies does not name are mapped.
+  const containers::MapPolicy mRollPolicy;
+
+  /// How the rolls of particular channels are mapped.
+  const std::unordered_map<ChannelId, containers::MapPolicy> mChannelPolicies;
+
+  /// The shared timeline: records every channel's writes in global write order and samples them
+  /// into the time index, or stamps them into its shards.
+  Timeline mTimeline;
 
   /// The channel registry guarded by a mutex, so concurrent channel() and write() calls serialize
   /// on it. The guarded ChannelMap owns every Channel for the Writer's lifetime.
   common::Locked<ChannelMap> mLockedChannelMap;
+
+  /// Pairs with mWritebackCondition so the pacing thread sleeps between passes.
+  std::mutex mWritebackMutex;
+
+  /// The pacing thread waits on it for one interval, or until it is asked to stop.
+  std::condition_variable_any mWritebackCondition;
+
+  /// How often mDoorbellThread publishes the committed timeline; zero without a doorbell.
+  const std::chrono::nanoseconds mDoorbellInterval;
+
+  /// The mapped `doorbell.nioc`, holding one Doorbell, or empty without a doorbell.
+  std::optional<containers::MmapArray<Doorbell>> mDoorbell;
+
+  /// The committed length of each timeline shard as last published; touched only by the doorbell
+  /// thread, then by the destructor once it is joined.
+  std::array<std::uint64_t, Timeline::kMaxShards> mPublished{};
+
+  /// Pairs with mDoorbellCondition so the doorbell thread sleeps between passes.
+  std::mutex mDoorbellMutex;
+
+  /// The doorbell thread waits on it for one interval, or until it is asked to stop.
+  std::condition_variable_any mDoorbellCondition;
+
+  /// Paces writeback while mWriteback has a non-zero interval, and enforces mRetention if it limits
+  /// anything. Declared after everything it touches so it is stopped and joined before the channels
+  /// and the timeline are destroyed.
+  std::jthread mWritebackThread;
+
+  /// Publishes the committed timeline while there is a doorbell. Declared last for the same reason.
+  std::jthread mDoorbellThread;
+
+  /// @brief Pacing thread loop: every interval, start the writeback of each channel's fresh bytes
+  /// within the budget, then of the timeline's, and enforce the retention policy, until
+  /// @p stopToken is signalled.
+  void paceWriteback(const std::stop_token& stopToken);
+
+  /// @brief Have each channel expire its rolls past the age limit, then discard the timeline
+  /// entries and entry index positions before the oldest record any channel keeps. A failure is
+  /// logged.
+  void enforceRetention() noexcept;
+
+  /// @brief Doorbell thread loop: every interval, publish how far the timeline is committed, until
+  /// @p stopToken is signalled.
+  void paceDoorbell(const std::stop_token& stopToken);
+
+  /// @brief Publish the committed length of each shard, and ring the doorbell if any moved on or
+  /// @p closing is set, marking the chronicle closed.
+  void publishCommitted(bool closing) noexcept;
+
+  /// @brief Every channel created so far, collected under the channel map's lock.
+  [[nodiscard]] std::vector<Channel*> channels() const;
 };
 
 } // namespace nioc::chronicle
@@ -0,0 +1,274 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "utils.hpp"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <ctime>
+#include <netinet/in.h>
+#include <nioc/chronicle/bridgeReceiver.hpp>
+#include <nioc/common/exception.hpp>
+#include <nioc/common/utils.hpp>
+#include <nioc/logger/logger.hpp>
+#include <poll.h>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <sys/socket.h>
+#include <system_error>
+#include <unistd.h>
+#include <utility>
+
+namespace nioc::chronicle
+{
+namespace
+{
+
+int listenOn(const std::string_view host, const std::uint16_t port)
+{
+  auto address = ::sockaddr_in{};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(port);
+  if(::inet_pton(AF_INET, std::string{host}.c_str(), &address.sin_addr) != 1)
+  {
+    common::throwException<std::invalid_argument>(
+        "Unable to listen on {}: not an IPv4 address.",
+        host);
+  }
+
+  const auto listener = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if(listener < 0)
+  {
+    common::throwException<std::runtime_error>(
+        "Unable to create a socket to listen on port {}: {}",
+        port,
+        std::generic_category().message(errno));
+  }
+
+  // A receiver restarted right after its predecessor must not wait out the old connection.
+  constexpr auto kReuse = 1;
+  static_cast<void>(::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &kReuse, sizeof(kReuse)));
+
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast): the POSIX socket API.
+  const auto* const generic = reinterpret_cast<const ::sockaddr*>(&address);
+  if(::bind(listener, generic, sizeof(address)) != 0 or ::listen(listener, 1) != 0)
+  {
+    const auto errorNumber = errno;
+    static_cast<void>(::close(listener));
+    common::throwException<std::runtime_error>(
+        "Unable to listen on {}:{}: {}",
+        host,
+        port,
+        std::generic_category().message(errorNumber));
+  }
+  return listener;
+}
+
+std::uint16_t boundPort(const int socket) noexcept
+{
+  auto address = ::sockaddr_in{};
+  auto length = static_cast<::socklen_t>(sizeof(address));
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast): the POSIX socket API.
+  static_cast<void>(::getsockname(socket, reinterpret_cast<::sockaddr*>(&address), &length));
+  return ntohs(address.sin_port);
+}
+
+/// Wait up to @p timeout for @p socket to have something to read; false if nothing came in time.
+bool awaitReadable(const int socket, const std::chrono::nanoseconds timeout)
+{
+  const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+  const auto wait = ::timespec{.tv_sec = seconds.count(), .tv_nsec = (timeout - seconds).count()};
+  auto polled = ::pollfd{.fd = socket, .events = POLLIN, .revents = 0};
+  return ::ppoll(&polled, 1, &wait, nullptr) > 0;
+}
+
+/// Read exactly @p size bytes from @p socket into @p data; false if the peer hung up first, or
+/// stalled past the socket's receive timeout.
+bool receiveAll(const int socket, void* const data, const std::size_t size) noexcept
+{
+  auto* bytes = static_cast<std::byte*>(data);
+  auto remaining = size;
+  while(remaining > 0)
+  {
+    const auto received = ::recv(socket, bytes, remaining, MSG_WAITALL);
+    if(received < 0 and errno == EINTR)
+    {
+      continue;
+    }
+    if(received <= 0)
+    {
+      return false;
+    }
+    bytes += received;
+    remaining -= static_cast<std::size_t>(received);
+  }
+  return true;
+}
+
+/// Read and drop @p size bytes from @p socket; false if the peer hung up or stalled first.
+bool discard(const int socket, std::uint64_t size) noexcept
+{
+  auto scratch = std::array<std::byte, 4096>{};
+  while(size > 0ULL)
+  {
+    const auto chunk = std::min<std::uint64_t>(size, scratch.size());
+    if(not receiveAll(socket, scratch.data(), chunk))
+    {
+      return false;
+    }
+    size -= chunk;
+  }
+  return true;
+}
+
+} // namespace
+
+BridgeReceiver::BridgeReceiver(
+    Writer& writer,
+    const std::uint16_t port,
+    const std::string_view address,
+    const std::uint64_t maxRecordSize):
+  mWriter{writer},
+  mListener{listenOn(address, port)},
+  mPort{boundPort(mListener)},
+  mMaxRecordSize{maxRecordSize}
+{
+}
+
+BridgeReceiver::~BridgeReceiver()
+{
+  hangUp();
+  static_cast<void>(::close(mListener));
+}
+
+void BridgeReceiver::accept(const ChannelId channelId)
+{
+  mAccepted.insert(channelId);
+}
+
+std::optional<Entry> BridgeReceiver::next(const std::chrono::nanoseconds timeout)
+{
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  while(true)
+  {
+    const auto remaining = std::max(
+        std::chrono::nanoseconds::zero(),
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            deadline - std::chrono::steady_clock::now()));
+    if(not awaitReadable(mConnection >= 0 ? mConnection : mListener, remaining))
+    {
+      return std::nullopt;
+    }
+
+    if(mConnection < 0)
+    {
+      mConnection = ::accept4(mListener, nullptr, nullptr, SOCK_CLOEXEC);
+      if(mConnection >= 0)
+      {
+        // A sender that stalls mid-record must not block the receiver for good.
+        setSocketTimeout(mConnection, SO_RCVTIMEO, kReceiveTimeout);
+      }
+      continue;
+    }
+
+    if(auto entry = receive())
+    {
+      return entry;
+    }
+  }
+}
+
+std::uint16_t BridgeReceiver::port() const noexcept
+{
+  return mPort;
+}
+
+bool BridgeReceiver::connected() const noexcept
+{
+  return mConnection >= 0;
+}
+
+std::optional<Entry> BridgeReceiver::receive()
+{
+  auto wire = BridgeFrame{};
+  if(not receiveAll(mConnection, &wire, sizeof(wire)))
+  {
+    hangUp();
+    return std::nullopt;
+  }
+
+  // Past a header it cannot trust, the stream cannot be followed to the next one.
+  const auto frame = toWireOrder(wire);
+  if(frame.mVersion != kBridgeFrameVersion)
+  {
+    logger::error(
+        "The bridge sender speaks version {} of the frame layout, not {}; hanging up.",
+        frame.mVersion,
+        kBridgeFrameVersion);
+    hangUp();
+    return std::nullopt;
+  }
+  if(frame.mSize > mMaxRecordSize)
+  {
+    logger::error(
+        "The bridge sender announced a record of {} bytes on channel {}, past the limit of {}; "
+        "hanging up.",
+        frame.mSize,
+        common::hexString(frame.mChannelId.mValue),
+        mMaxRecordSize);
+    hangUp();
+    return std::nullopt;
+  }
+
+  if(not mAccepted.contains(frame.mChannelId))
+  {
+    if(not discard(mConnection, frame.mSize))
+    {
+      hangUp();
+    }
+    return std::nullopt;
+  }
+
+  // The bytes go from the socket straight into the roll; a record cut short is abandoned with its
+  // reservation. A record that cannot be reserved leaves the stream mid-record, so it ends the
+  // connection too.
+  auto reservation = [this, &frame]
+  {
+    try
+    {
+      return mWriter.channel(frame.mChannelId).reserve(frame.mSize);
+    }
+    catch(...)
+    {
+      hangUp();
+      throw;
+    }
+  }();
+  if(not receiveAll(mConnection, reservation.span().data(), frame.mSize))
+  {
+    logger::warn(
+        "The bridge sender hung up or stalled midway through a record of channel {}.",
+        common::hexString(frame.mChannelId.mValue));
+    hangUp();
+    return std::nullopt;
+  }
+  auto crate = std::move(reservation).commit(frame.mSize);
+  return Entry{.mChannelId = frame.mChannelId, .mCrate = std::move(crate)};
+}
+
+void BridgeReceiver::hangUp() noexcept
+{
+  if(mConnection >= 0)
+  {
+    static_cast<void>(::close(mConnection));
+    mConnection = -1;
+  }
+}
+
+} // namespace nioc::chronicle
@@ -0,0 +1,293 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "utils.hpp"
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <fcntl.h>
+#include <memory>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <nioc/chronicle/bridgeSender.hpp>
+#include <nioc/common/exception.hpp>
+#include <nioc/common/utils.hpp>
+#include <nioc/logger/logger.hpp>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <sys/sendfile.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <system_error>
+#include <unistd.h>
+#include <utility>
+
+namespace nioc::chronicle
+{
+namespace
+{
+
+int connectTo(const std::string& host, const std::uint16_t port)
+{
+  auto hints = ::addrinfo{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  ::addrinfo* found = nullptr;
+  const auto service = std::to_string(port);
+  if(const auto status = ::getaddrinfo(host.c_str(), service.c_str(), &hints, &found); status != 0)
+  {
+    common::throwException<std::runtime_error>(
+        "Unable to resolve {}: {}",
+        host,
+        ::gai_strerror(status));
+  }
+  const auto addresses =
+      std::unique_ptr<::addrinfo, decltype(&::freeaddrinfo)>{found, &::freeaddrinfo};
+
+  auto errorNumber = 0;
+  for(const auto* address = addresses.get(); address != nullptr; address = address->ai_next)
+  {
+    const auto socket =
+        ::socket(address->ai_family, address->ai_socktype | SOCK_CLOEXEC, address->ai_protocol);
+    if(socket < 0)
+    {
+      errorNumber = errno;
+      continue;
+    }
+    if(::connect(socket, address->ai_addr, address->ai_addrlen) == 0)
+    {
+      // Each record goes out as soon as it is queued; batching is the queue's job.
+      constexpr auto kNoDelay = 1;
+      static_cast<void>(
+          ::setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &kNoDelay, sizeof(kNoDelay)));
+      // A receiver that stops reading fails the connection rather than block the sender for good.
+      setSocketTimeout(socket, SO_SNDTIMEO, BridgeSender::kSendTimeout);
+      return socket;
+    }
+    errorNumber = errno;
+    static_cast<void>(::close(socket));
+  }
+
+  common::throwException<std::runtime_error>(
+      "Unable to connect to {}:{}: {}",
+      host,
+      port,
+      std::generic_category().message(errorNumber));
+}
+
+bool sendAll(const int socket, const void* const data, const std::size_t size) noexcept
+{
+  const auto* bytes = static_cast<const std::byte*>(data);
+  auto remaining = size;
+  while(remaining > 0)
+  {
+    // More is coming: the record's bytes follow the header in the same segment where they fit.
+    const auto sent = ::send(socket, bytes, remaining, MSG_NOSIGNAL | MSG_MORE);
+    if(sent < 0 and errno == EINTR)
+    {
+      continue;
+    }
+    if(sent <= 0)
+    {
+      return false;
+    }
+    bytes += sent;
+    remaining -= static_cast<std::size_t>(sent);
+  }
+  return true;
+}
+
+/// Send the frame of @p entry, then have the kernel copy its bytes from @p rollFile to @p socket.
+bool sendRecord(const int socket, const TimelineEntry& entry, const int rollFile) noexcept
+{
+  const auto frame =
+      toWireOrder(BridgeFrame{.mChannelId = entry.mChannelId, .mSize = entry.mSize});
+  if(not sendAll(socket, &frame, sizeof(frame)))
+  {
+    return false;
+  }
+
+  auto offset = static_cast<::off_t>(entry.mOffset);
+  auto remaining = static_cast<std::size_t>(entry.mSize);
+  while(remaining > 0)
+  {
+    const auto sent = ::sendfile(socket, rollFile, &offset, remaining);
+    if(sent < 0 and errno == EINTR)
+    {
+      continue;
+    }
+    if(sent <= 0)
+    {
+      return false;
+    }
+    remaining -= static_cast<std::size_t>(sent);
+  }
+  return true;
+}
+
+} // namespace
+
+struct BridgeSender::RollFile
+{
+  RollFile(const std::uint64_t rollId, const int fileDescriptor) noexcept:
+    mRollId{rollId},
+    mFileDescriptor{fileDescriptor}
+  {
+  }
+
+  RollFile(const RollFile&) = delete;
+
+  RollFile(RollFile&&) noexcept = delete;
+
+  ~RollFile()
+  {
+    static_cast<void>(::close(mFileDescriptor));
+  }
+
+  RollFile& operator=(const RollFile&) = delete;
+
+  RollFile& operator=(RollFile&&) noexcept = delete;
+
+  /// The roll's id within its channel.
+  const std::uint64_t mRollId;
+
+  /// The roll's file, open read-only.
+  const int mFileDescriptor;
+};
+
+BridgeSender::BridgeSender(Writer& writer, const std::string& host, const std::uint16_t port):
+  mWriter{writer},
+  mSocket{connectTo(host, port)},
+  mThread{[this](const std::stop_token& stopToken) { send(stopToken); }}
+{
+}
+
+BridgeSender::~BridgeSender()
+{
+  mThread.request_stop();
+  if(mThread.joinable())
+  {
+    mThread.join();
+  }
+
+  if(mDropped > 0ULL)
+  {
+    logger::warn("The bridge dropped {} records it could not send in time.", mDropped);
+  }
+  static_cast<void>(::close(mSocket));
+}
+
+void BridgeSender::forward(const ChannelId channelId)
+{
+  auto& channel = mWriter.channel(channelId);
+  if(channel.writeMode() == containers::WriteMode::Direct)
+  {
+    common::throwException<std::logic_error>(
+        "Channel {} is written directly; its rolls cannot be sent before they are sealed.",
+        common::hexString(channelId.mValue));
+  }
+
+  if(not mForwarded.insert(channelId).second)
+  {
+    return;
+  }
+
+  channel.observe([this, &channel](const TimelineEntry& entry) { enqueue(channel, entry); });
+}
+
+void BridgeSender::send(const std::stop_token& stopToken)
+{
+  auto batch = std::deque<Pending>{};
+  auto drainDeadline = std::optional<std::chrono::steady_clock::time_point>{};
+  while(true)
+  {
+    {
+      auto lock = std::unique_lock{mMutex};
+
+      // Once stopped, the wait returns at once, so the queue drains before the thread exits.
+      mCondition.wait(lock, stopToken, [this] { return not mQueue.empty(); });
+      if(mQueue.empty())
+      {
+        return;
+      }
+      batch.swap(mQueue);
+    }
+
+    while(not batch.empty())
+    {
+      // Once stopped, the queue drains for kDrainTimeout at most; what is left then is dropped.
+      if(stopToken.stop_requested() and not drainDeadline)
+      {
+        drainDeadline = std::chrono::steady_clock::now() + kDrainTimeout;
+      }
+      if(drainDeadline and std::chrono::steady_clock::now() >= *drainDeadline)
+      {
+        const auto lock = std::scoped_lock{mMutex};
+        mDropped += batch.size() + mQueue.size();
+        mQueue.clear();
+        mRolls.clear();
+        return;
+      }
+
+      const auto& pending = batch.front();
+      if(not sendRecord(mSocket, pending.mEntry, pending.mRoll->mFileDescriptor))
+      {
+        logger::error(
+            "The bridge lost its connection: {}. Nothing more is forwarded.",
+            std::generic_category().message(errno));
+        const auto lock = std::scoped_lock{mMutex};
+        mFailed = true;
+        mQueue.clear();
+        mRolls.clear();
+        return;
+      }
+      batch.pop_front();
+    }
+  }
+}
+
+void BridgeSender::enqueue(const Channel& channel, const TimelineEntry& entry) noexcept
+{
+  {
+    const auto lock = std::scoped_lock{mMutex};
+    if(mFailed)
+    {
+      return;
+    }
+    if(mQueue.size() >= kMaxQueuedRecords)
+    {
+      ++mDropped;
+      return;
+    }
+
+    // The observer runs before the roll can be sealed, so its file is still in place. Held open,
+    // the roll stays readable however long its records wait.
+    auto& roll = mRolls[entry.mChannelId];
+    if(not roll or roll->mRollId != entry.mRollId)
+    {
+      const auto path = channel.rollPath(entry.mRollId);
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg,hicpp-vararg): the POSIX file API.
+      const auto fileDescriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+      if(fileDescriptor < 0)
+      {
+        logger::warn(
+            "Unable to open {} to forward it: {}",
+            path.string(),
+            std::generic_category().message(errno));
+        ++mDropped;
+        return;
+      }
+      roll = std::make_shared<const RollFile>(entry.mRollId, fileDescriptor);
+    }
+    mQueue.push_back(Pending{.mEntry = entry, .mRoll = roll});
+  }
+  mCondition.notify_one();
+}
+
+} // namespace nioc::chronicle
@@ -0,0 +1,520 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "utils.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <fcntl.h>
+#include <iterator>
+#include <nioc/chronicle/broker.hpp>
+#include <nioc/common/exception.hpp>
+#include <nioc/common/utils.hpp>
+#include <nioc/logger/logger.hpp>
+#include <optional>
+#include <poll.h>
+#include <span>
+#include <stdexcept>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <system_error>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace nioc::chronicle
+{
+namespace
+{
+
+/// How long the Broker's thread waits for a Subscriber between checks for a stop request.
+constexpr auto kPollTimeoutMilliseconds = 50;
+
+int listenOn(const std::filesystem::path& path)
+{
+  const auto address = makeSocketAddress(path);
+
+  auto errorCode = std::error_code{};
+  std::filesystem::remove(path, errorCode);
+
+  const auto listener = ::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if(listener < 0)
+  {
+    common::throwException<std::runtime_error>(
+        "Unable to create a socket to listen on {}: {}",
+        path.string(),
+        std::generic_category().message(errno));
+  }
+
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast): the POSIX socket API.
+  const auto* const generic = reinterpret_cast<const ::sockaddr*>(&address);
+  if(::bind(listener, generic, sizeof(address)) != 0 or ::listen(listener, SOMAXCONN) != 0)
+  {
+    const auto errorNumber = errno;
+    static_cast<void>(::close(listener));
+    common::throwException<std::runtime_error>(
+        "Unable to listen on {}: {}",
+        path.string(),
+        std::generic_category().message(errorNumber));
+  }
+  return listener;
+}
+
+int openDoorbell()
+{
+  const auto doorbell = ::eventfd(0U, EFD_NONBLOCK | EFD_CLOEXEC);
+  if(doorbell < 0)
+  {
+    common::throwException<std::runtime_error>(
+        "Unable to create the Broker's doorbell: {}",
+        std::generic_category().message(errno));
+  }
+  return doorbell;
+}
+
+/// Send the notices of @p run to @p socket without blocking, a batch per system call, with
+/// @p fileDescriptor attached to the first unless it is negative. Returns how many were sent; the
+/// rest did not fit the socket buffer, or the peer is gone.
+std::size_t sendNotices(
+    const int socket,
+    const std::span<TimelineEntry> run,
+    const int fileDescriptor) noexcept
+{
+  constexpr auto kBatchSize = std::size_t{64};
+  auto vectors = std::array<::iovec, kBatchSize>{};
+  auto messages = std::array<::mmsghdr, kBatchSize>{};
+  alignas(::cmsghdr) auto control = std::array<char, CMSG_SPACE(sizeof(int))>{};
+
+  auto sentCount = std::size_t{0};
+  while(sentCount < run.size())
+  {
+    const auto batch = run.subspan(sentCount, std::min(kBatchSize, run.size() - sentCount));
+    for(auto index = std::size_t{0}; index < batch.size(); ++index)
+    {
+      // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index): index < kBatchSize.
+      vectors[index] = ::iovec{.iov_base = &batch[index], .iov_len = sizeof(TimelineEntry)};
+      messages[index] = ::mmsghdr{};
+      messages[index].msg_hdr.msg_iov = &vectors[index];
+      messages[index].msg_hdr.msg_iovlen = 1;
+      // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+    }
+
+    if(sentCount == 0 and fileDescriptor >= 0)
+    {
+      auto& message = messages.front().msg_hdr;
+      message.msg_control = control.data();
+      message.msg_controllen = control.size();
+      auto* const header = CMSG_FIRSTHDR(&message);
+      header->cmsg_level = SOL_SOCKET;
+      header->cmsg_type = SCM_RIGHTS;
+      header->cmsg_len = CMSG_LEN(sizeof(int));
+      std::memcpy(CMSG_DATA(header), &fileDescriptor, sizeof(int));
+    }
+
+    const auto sent = ::sendmmsg(
+        socket,
+        messages.data(),
+        static_cast<unsigned int>(batch.size()),
+        MSG_DONTWAIT | MSG_NOSIGNAL);
+    if(sent <= 0)
+    {
+      break;
+    }
+    sentCount += static_cast<std::size_t>(sent);
+    if(static_cast<std::size_t>(sent) < batch.size())
+    {
+      break;
+    }
+  }
+  return sentCount;
+}
+
+} // namespace
+
+struct Broker::Inbox
+{
+  /// One entry of the ring: free for the producer at position p while its sequence is p, filled
+  /// for the consumer once it is p + 1.
+  struct Slot
+  {
+    std::atomic<std::uint64_t> mSequence{0ULL};
+    TimelineEntry mEntry{};
+  };
+
+  Inbox(const Channel& channel, Inbox* const next):
+    mChannel{channel},
+    mNext{next},
+    mSlots(kInboxCapacity)
+  {
+    for(auto position = std::uint64_t{0ULL}; position < kInboxCapacity; ++position)
+    {
+      mSlots[position].mSequence.store(position, std::memory_order_relaxed);
+    }
+  }
+
+  Inbox(const Inbox&) = delete;
+
+  Inbox(Inbox&&) noexcept = delete;
+
+  ~Inbox()
+  {
+    if(mRollFile >= 0)
+    {
+      static_cast<void>(::close(mRollFile));
+    }
+  }
+
+  Inbox& operator=(const Inbox&) = delete;
+
+  Inbox& operator=(Inbox&&) noexcept = delete;
+
+  /// Queue @p entry; false if the ring is full. Safe from any number of committing threads.
+  bool push(const TimelineEntry& entry) noexcept
+  {
+    auto position = mTail.load(std::memory_order_relaxed);
+    while(true)
+    {
+      auto& slot = mSlots[position & (kInboxCapacity - 1U)];
+      const auto sequence = slot.mSequence.load(std::memory_order_acquire);
+      if(sequence == position)
+      {
+        if(mTail.compare_exchange_weak(position, position + 1U, std::memory_order_relaxed))
+        {
+          slot.mEntry = entry;
+          slot.mSequence.store(position + 1U, std::memory_order_release);
+          return true;
+        }
+      }
+      else if(sequence < position)
+      {
+        return false;
+      }
+      else
+      {
+        position = mTail.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// Take the oldest entry, if one is filled in. The Broker's thread only.
+  std::optional<TimelineEntry> pop() noexcept
+  {
+    auto& slot = mSlots[mHead & (kInboxCapacity - 1U)];
+    if(slot.mSequence.load(std::memory_order_acquire) != mHead + 1U)
+    {
+      return std::nullopt;
+    }
+    const auto entry = slot.mEntry;
+    slot.mSequence.store(mHead + kInboxCapacity, std::memory_order_release);
+    ++mHead;
+    return entry;
+  }
+
+  /// The open file of roll @p rollId, replacing the previous one; negative if it cannot be opened.
+  /// The Broker's thread only.
+  int rollFile(const std::uint64_t rollId) noexcept
+  {
+    if(mRollFile >= 0 and mRollFileId == rollId)
+    {
+      return mRollFile;
+    }
+
+    const auto path = mChannel.rollPath(rollId);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg,hicpp-vararg): open is the POSIX file API.
+    const auto fileDescriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if(fileDescriptor < 0)
+    {
+      logger::warn(
+          "Unable to open {} to share it: {}",
+          path.string(),
+          std::generic_category().message(errno));
+      return -1;
+    }
+
+    if(mRollFile >= 0)
+    {
+      static_cast<void>(::close(mRollFile));
+    }
+    mRollFile = fileDescriptor;
+    mRollFileId = rollId;
+    return mRollFile;
+  }
+
+  /// The shared channel.
+  const Channel& mChannel;
+
+  /// The inbox of the channel shared before, or null.
+  Inbox* const mNext;
+
+  /// The ring, kInboxCapacity slots.
+  std::vector<Slot> mSlots;
+
+  /// Position the next push claims. On its own cache line, as the committing threads contend it.
+  alignas(64) std::atomic<std::uint64_t> mTail{0ULL};
+
+  /// Position the next pop takes.
+  alignas(64) std::uint64_t mHead{0ULL};
+
+  /// Notices dropped because the ring was full.
+  std::atomic<std::uint64_t> mDropped{0ULL};
+
+  /// The file of the roll the latest notice with a descriptor was about, or negative.
+  int mRollFile{-1};
+
+  /// The id of the roll mRollFile is of.
+  std::uint64_t mRollFileId{0ULL};
+};
+
+Broker::Broker(Writer& writer, std::filesystem::path socketPath):
+  mWriter{writer},
+  mSocketPath{std::move(socketPath)},
+  mListener{listenOn(mSocketPath)},
+  mDoorbell{openDoorbell()},
+  mThread{[this](const std::stop_token& stopToken) { serve(stopToken); }}
+{
+}
+
+Broker::~Broker()
+{
+  mThread.request_stop();
+  ring();
+  if(mThread.joinable())
+  {
+    mThread.join();
+  }
+
+  for(const auto& client: mClients)
+  {
+    hangUp(client);
+  }
+  for(const auto& inbox: mInboxes)
+  {
+    if(const auto dropped = inbox->mDropped.load(std::memory_order_relaxed); dropped > 0ULL)
+    {
+      logger::warn(
+          "The Broker dropped {} notices of channel {}: its inbox was full.",
+          dropped,
+          common::hexString(inbox->mChannel.id().mValue));
+    }
+  }
+  static_cast<void>(::close(mDoorbell));
+  static_cast<void>(::close(mListener));
+
+  auto errorCode = std::error_code{};
+  std::filesystem::remove(mSocketPath, errorCode);
+}
+
+void Broker::share(const ChannelId channelId)
+{
+  auto& channel = mWriter.channel(channelId);
+  if(channel.writeMode() == containers::WriteMode::Direct)
+  {
+    common::throwException<std::logic_error>(
+        "Channel {} is written directly; its rolls cannot be shared before they are sealed.",
+        common::hexString(channelId.mValue));
+  }
+
+  if(not mShared.insert(channelId).second)
+  {
+    return;
+  }
+
+  auto& inbox = *mInboxes.emplace_back(
+      std::make_unique<Inbox>(channel, mNewestInbox.load(std::memory_order_relaxed)));
+  mNewestInbox.store(&inbox, std::memory_order_release);
+  channel.observe([this, &inbox](const TimelineEntry& entry) { notify(inbox, entry); });
+}
+
+const std::filesystem::path& Broker::path() const noexcept
+{
+  return mSocketPath;
+}
+
+void Broker::serve(const std::stop_token& stopToken)
+{
+  auto polled = std::vector<::pollfd>{};
+  auto notices = std::vector<TimelineEntry>{};
+  notices.reserve(kInboxCapacity);
+  while(not stopToken.stop_requested())
+  {
+    polled.assign(
+        {::pollfd{.fd = mListener, .events = POLLIN, .revents = 0},
+         ::pollfd{.fd = mDoorbell, .events = POLLIN, .revents = 0}});
+    std::ranges::transform(
+        mClients,
+        std::back_inserter(polled),
+        [](const Client& client)
+        { return ::pollfd{.fd = client.mSocket, .events = POLLIN, .revents = 0}; });
+
+    if(::poll(polled.data(), polled.size(), kPollTimeoutMilliseconds) <= 0)
+    {
+      continue;
+    }
+
+    for(auto index = polled.size() - 1; index > 1; --index)
+    {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-avoid-unchecked-container-access): in range.
+      if(polled[index].revents == 0)
+      {
+        continue;
+      }
+      const auto client = std::next(mClients.begin(), static_cast<std::ptrdiff_t>(index - 2));
+      if(not readSubscriptions(*client))
+      {
+        hangUp(*client);
+        mClients.erase(client);
+      }
+    }
+
+    if((polled[1].revents & POLLIN) != 0)
+    {
+      // Answer the ring before draining: the drain sees every notice queued by a thread that found
+      // the bell rung, and a notice queued after this rings again.
+      auto count = std::uint64_t{0ULL};
+      static_cast<void>(::read(mDoorbell, &count, sizeof(count)));
+      static_cast<void>(mRung.exchange(false, std::memory_order_acq_rel));
+      deliver(notices);
+    }
+
+    if((polled.front().revents & POLLIN) == 0)
+    {
+      continue;
+    }
+    while(true)
+    {
+      const auto socket = ::accept4(mListener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+      if(socket < 0)
+      {
+        break;
+      }
+      mClients.push_back(Client{.mSocket = socket, .mChannels = {}, .mRollsSent = {}});
+    }
+  }
+}
+
+void Broker::notify(Inbox& inbox, const TimelineEntry& entry) noexcept
+{
+  if(not inbox.push(entry))
+  {
+    inbox.mDropped.fetch_add(1U, std::memory_order_relaxed);
+    return;
+  }
+  if(not mRung.exchange(true, std::memory_order_acq_rel))
+  {
+    ring();
+  }
+}
+
+void Broker::ring() const noexcept
+{
+  const auto count = std::uint64_t{1ULL};
+  static_cast<void>(::write(mDoorbell, &count, sizeof(count)));
+}
+
+void Broker::deliver(std::vector<TimelineEntry>& notices) noexcept
+{
+  for(auto* inbox = mNewestInbox.load(std::memory_order_acquire); inbox != nullptr;
+      inbox = inbox->mNext)
+  {
+    while(true)
+    {
+      notices.clear();
+      while(notices.size() < kInboxCapacity)
+      {
+        const auto entry = inbox->pop();
+        if(not entry)
+        {
+          break;
+        }
+        notices.push_back(*entry);
+      }
+      if(notices.empty())
+      {
+        break;
+      }
+
+      // In runs of one roll, so each roll is opened once for every Subscriber.
+      for(auto begin = notices.begin(); begin != notices.end();)
+      {
+        const auto rollId = begin->mRollId;
+        const auto end = std::find_if(
+            begin,
+            notices.end(),
+            [rollId](const TimelineEntry& entry) { return entry.mRollId != rollId; });
+        for(auto& client: mClients)
+        {
+          if(client.mChannels.contains(inbox->mChannel.id()))
+          {
+            deliver(client, *inbox, std::span{begin, end});
+          }
+        }
+        begin = end;
+      }
+    }
+  }
+}
+
+void Broker::deliver(Client& client, Inbox& inbox, const std::span<TimelineEntry> run) noexcept
+{
+  auto& sent = client.mRollsSent[inbox.mChannel.id()];
+  const auto rollId = run.front().mRollId;
+  const auto needsRoll = std::ranges::find(sent, rollId) == sent.end();
+  const auto fileDescriptor = needsRoll ? inbox.rollFile(rollId) : -1;
+  if(needsRoll and fileDescriptor < 0)
+  {
+    client.mDropped += run.size();
+    return;
+  }
+
+  const auto sentCount = sendNotices(client.mSocket, run, fileDescriptor);
+  client.mDropped += run.size() - sentCount;
+
+  // The Subscriber drops its oldest roll of the channel as it maps one too many; so does this.
+  if(needsRoll and sentCount > 0U)
+  {
+    sent.push_back(rollId);
+    if(sent.size() > kOpenRollsPerChannel)
+    {
+      sent.pop_front();
+    }
+  }
+}
+
+bool Broker::readSubscriptions(Client& client) noexcept
+{
+  while(true)
+  {
+    auto channelId = ChannelId{};
+    const auto received = ::recv(client.mSocket, &channelId, sizeof(channelId), MSG_DONTWAIT);
+    if(received == static_cast<::ssize_t>(sizeof(channelId)))
+    {
+      client.mChannels.insert(channelId);
+      continue;
+    }
+    if(received > 0)
+    {
+      logger::warn("Ignoring a malformed subscription of {} bytes.", received);
+      continue;
+    }
+    return received < 0 and (errno == EAGAIN or errno == EWOULDBLOCK);
+  }
+}
+
+void Broker::hangUp(const Client& client) noexcept
+{
+  if(client.mDropped > 0ULL)
+  {
+    logger::warn(
+        "A Subscriber missed {} notices: its socket buffer was full.",
+        client.mDropped);
+  }
+  static_cast<void>(::close(client.mSocket));
+}
+
+} // namespace nioc::chronicle
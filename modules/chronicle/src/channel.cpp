@@ -6,38 +6,323 @@
 
 #include "utils.hpp"
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstring>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <nioc/chronicle/channel.hpp>
-#include <nioc/common/exception.hpp>
+#include <nioc/chronicle/checksum.hpp>
+#include <nioc/chronicle/compressedRoll.hpp>
+#include <nioc/common/utils.hpp>
 #include <nioc/logger/logger.hpp>
+#include <optional>
 #include <span>
-#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace nioc::chronicle
 {
+namespace
+{
+
+/// Hand out a serial no other channel of the process has, and none will.
+std::uint64_t nextChannelSerial() noexcept
+{
+  static auto serials = std::atomic<std::uint64_t>{0ULL};
+  return serials.fetch_add(1ULL, std::memory_order_relaxed);
+}
+
+/// Count of channels closed so far in the process, bumped as each lets go of its lanes.
+std::atomic<std::uint64_t>& closedChannels() noexcept
+{
+  static auto closed = std::atomic<std::uint64_t>{0ULL};
+  return closed;
+}
+
+/// @brief The lanes one thread writes through, by the serial of their channel.
+///
+/// Shares each lane with its channel. Once any channel closes, the next lookup drops the lanes no
+/// channel holds any longer, so a thread keeps none for channels long gone. As the thread exits,
+/// it leaves the rest vacant for their channels to hand to other threads.
+class LaneCache
+{
+public:
+  LaneCache() = default;
+
+  LaneCache(const LaneCache&) = delete;
+
+  LaneCache(LaneCache&&) noexcept = delete;
+
+  ~LaneCache()
+  {
+    for(const auto& [serial, lane]: mLanes)
+    {
+      lane->mVacant.store(true, std::memory_order_release);
+    }
+  }
+
+  LaneCache& operator=(const LaneCache&) = delete;
+
+  LaneCache& operator=(LaneCache&&) noexcept = delete;
+
+  /// The lane of the channel with @p serial, or null if the thread has none on it yet.
+  [[nodiscard]] ChannelLane* find(const std::uint64_t serial)
+  {
+    if(const auto closed = closedChannels().load(std::memory_order_acquire); closed != mClosed)
+    {
+      mClosed = closed;
+      std::erase_if(mLanes, [](const auto& entry) { return entry.second.use_count() == 1; });
+    }
+    const auto found = mLanes.find(serial);
+    return found == mLanes.end() ? nullptr : found->second.get();
+  }
+
+  /// Keep @p lane as the thread's lane on the channel with @p serial.
+  void insert(const std::uint64_t serial, std::shared_ptr<ChannelLane> lane)
+  {
+    mLanes.insert_or_assign(serial, std::move(lane));
+  }
+
+private:
+  /// closedChannels() as of the last pruning.
+  std::uint64_t mClosed{0ULL};
+
+  /// The thread's lanes, by channel serial.
+  std::unordered_map<std::uint64_t, std::shared_ptr<ChannelLane>> mLanes;
+};
+
+/// Bytes a roll's file starts at. It grows geometrically into the roll capacity as records fill it,
+/// so a quiet channel keeps a small file, and a busy one grows a handful of times per roll.
+constexpr auto kInitialRollSize = std::size_t{64ULL * 1024ULL * 1024ULL};
+
+/// Create the roll at @p path, able to grow to @p capacity bytes and starting at no fewer than
+/// @p minSize.
+std::shared_ptr<RollLease::Roll> makeRoll(
+    const std::filesystem::path& path,
+    const std::size_t minSize,
+    const std::size_t capacity,
+    const containers::WriteMode writeMode,
+    const containers::MapPolicy& mapPolicy)
+{
+  return std::make_shared<RollLease::Roll>(
+      path,
+      std::max(minSize, std::min(capacity, kInitialRollSize)),
+      writeMode,
+      capacity,
+      mapPolicy);
+}
+
+} // namespace
+
+RollLease::RollLease(std::shared_ptr<Roll> roll, const std::uint64_t rollId) noexcept:
+  mRoll{std::move(roll)},
+  mRollId{rollId}
+{
+}
+
+const std::shared_ptr<RollLease::Roll>& RollLease::roll() const noexcept
+{
+  return mRoll;
+}
+
+std::uint64_t RollLease::rollId() const noexcept
+{
+  return mRollId;
+}
+
+bool RollLease::enter() noexcept
+{
+  if((mWriters.fetch_add(1ULL, std::memory_order_acquire) & kClosed) != 0ULL)
+  {
+    leave();
+    return false;
+  }
+  return true;
+}
+
+void RollLease::leave() noexcept
+{
+  // Release the bytes written under the lease to the closer, which flushes them. Adding one short
+  // of kLeft counts the reservation out and as left in one step.
+  const auto writers = mWriters.fetch_add(kLeft - 1ULL, std::memory_order_release);
+  if((writers & (kClosed | kInside)) == kClosed + 1ULL)
+  {
+    mWriters.notify_all();
+  }
+}
+
+void RollLease::close() noexcept
+{
+  auto writers = mWriters.fetch_or(kClosed, std::memory_order_acquire) | kClosed;
+  while((writers & kInside) != 0ULL)
+  {
+    mWriters.wait(writers, std::memory_order_acquire);
+    writers = mWriters.load(std::memory_order_acquire);
+  }
+}
+
+std::optional<std::uint64_t> RollLease::settledSize() const noexcept
+{
+  // Read like a seqlock: unchanged writers around the size mean no reservation claimed or rewound
+  // the roll in between, and every earlier one has left, its bytes released to this thread.
+  const auto before = mWriters.load(std::memory_order_acquire);
+  if((before & kInside) != 0ULL)
+  {
+    return std::nullopt;
+  }
+  const auto size = mRoll->size();
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if(mWriters.load(std::memory_order_relaxed) != before)
+  {
+    return std::nullopt;
+  }
+  return size;
+}
+
+std::uint64_t RollLease::writtenThrough() const noexcept
+{
+  return mWrittenThrough;
+}
+
+void RollLease::markWrittenThrough(const std::uint64_t size) noexcept
+{
+  mWrittenThrough = size;
+}
 
 Channel::Channel(
     const ChannelId channelId,
     std::filesystem::path channelDir,
     const std::size_t rollCapacity,
-    containers::Tape<containers::MmapArray<TimelineEntry>>& timeline):
+    Timeline& timeline,
+    const Retention retention,
+    const Compression compression,
+    const Writeback& writeback,
+    const containers::MapPolicy mapPolicy):
   mChannelId{channelId},
   mChannelDir{std::move(channelDir)},
   mRollCapacity{rollCapacity},
-  mTimeline{timeline}
+  mTimeline{&timeline},
+  mSerial{nextChannelSerial()},
+  mRetention{retention},
+  mCompression{compression},
+  mWriteMode{writeback.mMode},
+  mMapPolicy{mapPolicy},
+  mPooledRolls{writeback.mPooledRolls},
+  mPooledBytes{writeback.mPooledBytes},
+  mSyncOnSeal{writeback.mInterval > std::chrono::nanoseconds::zero()}
+{
+}
+
+Channel::Channel(
+    const ChannelId channelId,
+    const std::size_t rollCapacity,
+    const containers::MapPolicy mapPolicy,
+    const std::size_t pooledRolls,
+    const std::uint64_t pooledBytes):
+  mChannelId{channelId},
+  mChannelDir{common::hexString(channelId.mValue)}, // Only names the rolls' in-memory files.
+  mRollCapacity{rollCapacity},
+  mTimeline{nullptr},
+  mSerial{nextChannelSerial()},
+  mRetention{},
+  mCompression{},
+  mWriteMode{containers::WriteMode::Memory},
+  mMapPolicy{mapPolicy},
+  mPooledRolls{pooledRolls},
+  mPooledBytes{pooledBytes},
+  mSyncOnSeal{false}
 {
 }
 
 Channel::~Channel()
 {
-  // Trim the active roll to its written bytes, not its full capacity.
-  if(mActiveRoll)
+  // No lane carves again, so what each has left of its chunk is slack for good.
+  for(const auto& lane: mLanes)
+  {
+    accountLaneSlack(*lane);
+  }
+  if(const auto channelUsage = usage(); channelUsage.wastedBytes() > 0ULL)
   {
-    mActiveRoll->shrink_to_fit();
+    logger::info(
+        "Channel {} left {} of the {} bytes it reserved as slack: {} stranded, {} abandoned, {} in "
+        "lanes.",
+        common::hexString(mChannelId.mValue),
+        channelUsage.wastedBytes(),
+        channelUsage.mReservedBytes,
+        channelUsage.mStrandedBytes,
+        channelUsage.mAbandonedBytes,
+        channelUsage.mLaneSlackBytes);
   }
+
+  // The seal helper trims the last roll to its written bytes, as it does every full one, while
+  // this closes the index and clears the spare away.
+  if(mActiveRoll and mWriteMode != containers::WriteMode::Memory)
+  {
+    try
+    {
+      sealInBackground(std::exchange(mActiveRoll, nullptr), true);
+    }
+    catch(const std::exception& exception)
+    {
+      logger::error(
+          "Unable to seal the last roll of channel {}: {}",
+          common::hexString(mChannelId.mValue),
+          exception.what());
+    }
+  }
+
+  closeIndex();
+
+  // The spare never received a record; leave no empty roll behind.
+  auto spareHelper = std::shared_future<std::shared_ptr<Roll>>{};
+  static_cast<void>(takeSpareRoll(spareHelper));
+  if(mWriteMode != containers::WriteMode::Memory)
+  {
+    auto errorCode = std::error_code{};
+    std::filesystem::remove(mChannelDir / kSpareRollFileName, errorCode);
+  }
+
+  if(mSealedRoll.valid())
+  {
+    try
+    {
+      mSealedRoll.wait();
+
+      // Every roll is on disk in full, so the durable marks have nothing left to cut.
+      if(mDurableMarks)
+      {
+        syncSealedRolls();
+        mDurableMarks.reset();
+        auto errorCode = std::error_code{};
+        std::filesystem::remove(mChannelDir / kDurableMarksFileName, errorCode);
+      }
+    }
+    catch(const std::exception& exception)
+    {
+      logger::error(
+          "Unable to get every roll of channel {} to disk; keeping its durable marks: {}",
+          common::hexString(mChannelId.mValue),
+          exception.what());
+    }
+  }
+
+  // Let go of the lanes first, so the threads that wrote through them find them unheld.
+  {
+    const auto lock = std::scoped_lock{mRollMutex};
+    mLanes.clear();
+  }
+  closedChannels().fetch_add(1ULL, std::memory_order_release);
 }
 
 ChannelId Channel::id() const noexcept
@@ -45,18 +330,69 @@ ChannelId Channel::id() const noexcept
   return mChannelId;
 }
 
+containers::WriteMode Channel::writeMode() const noexcept
+{
+  return mWriteMode;
+}
+
+std::size_t Channel::laneCount() const
+{
+  const auto lock = std::scoped_lock{mRollMutex};
+  return mLanes.size();
+}
+
+ChannelUsage Channel::usage() const noexcept
+{
+  return ChannelUsage{
+      .mReservedBytes = mReservedBytes.load(std::memory_order_relaxed),
+      .mCommittedBytes = mCommittedBytes.load(std::memory_order_relaxed),
+      .mReclaimedBytes = mReclaimedBytes.load(std::memory_order_relaxed),
+      .mStrandedBytes = mStrandedBytes.load(std::memory_order_relaxed),
+      .mAbandonedBytes = mAbandonedBytes.load(std::memory_order_relaxed),
+      .mLaneSlackBytes = mLaneSlackBytes.load(std::memory_order_relaxed)};
+}
+
 Reservation Channel::reserve(const std::size_t size)
 {
   const auto reservedSize = roundUpToWord(size);
+  auto* const lane = laneOfThisThread();
+  auto& heldLease = lane ? lane->mLease : mOwnerLease;
+  auto lease = heldLease.lock();
 
-  auto slot = mActiveRoll ? mActiveRoll->claim(reservedSize) : std::span<std::byte>{};
-  if(slot.empty())
+  const auto moveTo = [this, &heldLease, &lease, lane](std::shared_ptr<RollLease> next)
   {
-    openNewRoll(reservedSize);
-    slot = mActiveRoll->claim(reservedSize);
-  }
+    heldLease = next;
+    lease = std::move(next);
+    if(lane)
+    {
+      accountLaneSlack(*lane);
+      lane->mChunk = {};
+      lane->mCarved = 0;
+    }
+  };
 
-  return Reservation{*this, mActiveRoll, mActiveRollId, slot};
+  while(true)
+  {
+    if(not lease or lease->rollId() != mActiveRollId.load(std::memory_order_acquire))
+    {
+      moveTo(openNewRoll(nullptr, reservedSize));
+    }
+
+    if(lease->enter())
+    {
+      const auto slot =
+          lane ? carve(*lane, *lease, reservedSize) : lease->roll()->claim(reservedSize);
+      if(not slot.empty())
+      {
+        mReservedBytes.fetch_add(slot.size(), std::memory_order_relaxed);
+        return Reservation{*this, lease, lane, slot};
+      }
+      lease->leave();
+    }
+
+    // The roll is full, or already sealing behind a rollover this thread has yet to see.
+    moveTo(openNewRoll(lease.get(), reservedSize));
+  }
 }
 
 Crate Channel::write(const std::span<const std::byte> data)
@@ -66,23 +402,75 @@ Crate Channel::write(const std::span<const std::byte> data)
   return std::move(reservation).commit(data.size());
 }
 
-void Channel::rewind(const Reservation& reservation, const std::size_t usedSize)
+bool Channel::rewind(const Reservation& reservation, const std::size_t usedSize)
 {
-  if(not mActiveRoll->rewind(reservation.span(), usedSize))
+  if(not reclaim(reservation, usedSize))
   {
     logger::warn(
         "Unable to rewind a reservation on channel {} from {} bytes to {} bytes.",
-        mChannelId.mValue,
+        common::hexString(mChannelId.mValue),
         reservation.span().size(),
         usedSize);
+    return false;
   }
+  return true;
+}
+
+void Channel::accountCommit(
+    const Reservation& reservation,
+    const std::size_t keptSize,
+    const std::size_t committedSize) noexcept
+{
+  mCommittedBytes.fetch_add(committedSize, std::memory_order_relaxed);
+  mStrandedBytes.fetch_add(keptSize - committedSize, std::memory_order_relaxed);
+  mReclaimedBytes.fetch_add(reservation.span().size() - keptSize, std::memory_order_relaxed);
+}
+
+void Channel::accountDrop(const Reservation& reservation, const std::size_t keptSize) noexcept
+{
+  mAbandonedBytes.fetch_add(keptSize, std::memory_order_relaxed);
+  mReclaimedBytes.fetch_add(reservation.span().size() - keptSize, std::memory_order_relaxed);
+}
+
+void Channel::accountLaneSlack(const ChannelLane& lane) noexcept
+{
+  mLaneSlackBytes.fetch_add(lane.mChunk.size() - lane.mCarved, std::memory_order_relaxed);
+}
+
+bool Channel::reclaim(const Reservation& reservation, const std::size_t keptSize) noexcept
+{
+  const auto span = reservation.span();
+  auto* const lane = reservation.mLane;
+  if(not lane)
+  {
+    return reservation.mLease->roll()->rewind(span, keptSize);
+  }
+
+  // Only the lane's thread carves from it, and only its latest carve can shrink.
+  if(keptSize > span.size() or
+     lane->mThread.load(std::memory_order_relaxed) != std::this_thread::get_id() or
+     lane->mLease.lock() != reservation.mLease or lane->mChunk.empty() or
+     static_cast<std::size_t>(std::distance(lane->mChunk.data(), span.data())) + span.size() !=
+         lane->mCarved)
+  {
+    return false;
+  }
+
+  lane->mCarved -= span.size() - keptSize;
+  return true;
 }
 
 void Channel::modify(Reservation& reservation, const std::size_t newSize)
 {
   if(newSize <= reservation.span().size())
   {
-    rewind(reservation, newSize);
+    // The span stays word-aligned, so the next claim after it does too.
+    const auto keptSize = static_cast<std::size_t>(roundUpToWord(newSize));
+    if(rewind(reservation, keptSize))
+    {
+      mReclaimedBytes.fetch_add(reservation.mSpan.size() - keptSize, std::memory_order_relaxed);
+      reservation.mSpan = reservation.mSpan.first(keptSize);
+    }
   }
   else
   {
@@ -96,29 +484,766 @@ void Channel::modify(Reservation& reservation, const std::size_t newSize)
   }
 }
 
-void Channel::openNewRoll(const std::size_t minCapacity)
+std::shared_ptr<RollLease> Channel::openNewRoll(
+    const RollLease* const full,
+    const std::size_t minCapacity)
 {
-  if(mActiveRoll)
+  // Let go of only once unlocked: releasing the spare's helper joins its thread.
+  auto spareHelper = std::shared_future<std::shared_ptr<Roll>>{};
+  const auto lock = std::scoped_lock{mRollMutex};
+  if(mActiveRoll.get() != full)
+  {
+    return mActiveRoll; // Another producer rolled over first, or the first roll is already open.
+  }
+
+  mWrittenBack = 0ULL;
+  auto rollId = std::uint64_t{0ULL};
+  if(not mActiveRoll)
+  {
+    openIndex();
+    openDurableMarks();
+  }
+  else
   {
-    mActiveRoll->shrink_to_fit();
-    ++mActiveRollId;
+    rollId = mActiveRoll->rollId() + 1ULL;
+    if(mWriteMode == containers::WriteMode::Memory)
+    {
+      // Nothing to seal: the roll waits in the pool until its crates let go of it.
+      poolRoll(std::exchange(mActiveRoll, nullptr)->roll());
+    }
+    else
+    {
+      sealInBackground(std::exchange(mActiveRoll, nullptr));
+    }
   }
 
-  mActiveRoll = std::make_shared<containers::Tape<containers::MmapArray<std::byte>>>(
-      mChannelDir / buildRollName(mActiveRollId),
-      std::max(mRollCapacity, minCapacity));
+  // Waiting for a spare still being prepared would stall the producer, so this roll opens inline,
+  // from a pooled roll if one is free, and the spare is left to the next rollover. The spare grows
+  // to the roll capacity; an oversized record needs a roll of its own.
+  const auto path = mChannelDir / buildRollName(rollId);
+  auto spare = takeSpareRoll(spareHelper, false);
+  if(spare and spare->max_size() < minCapacity)
+  {
+    spare.reset();
+    auto errorCode = std::error_code{};
+    std::filesystem::remove(mChannelDir / kSpareRollFileName, errorCode);
+  }
+  if(spare)
+  {
+    spare->storage().rename(path);
+  }
+  else if(auto pooled = takePooledRoll(); pooled and pooled->max_size() >= minCapacity)
+  {
+    // A pooled roll still names the roll it held, sealed under WriteMode::Direct.
+    if(mWriteMode == containers::WriteMode::Direct)
+    {
+      pooled->storage().restage(path, std::min(mRollCapacity, kInitialRollSize));
+    }
+    else
+    {
+      pooled->storage().rename(path);
+    }
+    spare = std::move(pooled);
+  }
+  else
+  {
+    spare = makeRoll(
+        path,
+        minCapacity,
+        std::max(mRollCapacity, minCapacity),
+        mWriteMode,
+        mMapPolicy);
+  }
+  if(mTimeline and isBounded(mRetention))
+  {
+    // No record commits into the roll before it is published, so none lies before this.
+    const auto retentionLock = std::scoped_lock{mRetentionMutex};
+    mRollStarts.push_back(mTimeline->size());
+  }
+  mActiveRoll = std::make_shared<RollLease>(std::move(spare), rollId);
+  mActiveRollId.store(rollId, std::memory_order_release);
+
+  prepareSpareRoll();
+  return mActiveRoll;
+}
+
+ChannelLane* Channel::laneOfThisThread()
+{
+  const auto self = std::this_thread::get_id();
+  if(not mMultiProducer.load(std::memory_order_acquire))
+  {
+    auto owner = mOwner.load(std::memory_order_relaxed);
+    if(owner == self or
+       (owner == std::thread::id{} and mOwner.compare_exchange_strong(owner, self)))
+    {
+      return nullptr;
+    }
+    mMultiProducer.store(true, std::memory_order_release);
+  }
+
+  // Serials are never reused, so a lane left behind by a destroyed channel is never looked up.
+  thread_local auto lanes = LaneCache{};
+  if(auto* const lane = lanes.find(mSerial))
+  {
+    return lane;
+  }
+
+  auto lane = std::shared_ptr<ChannelLane>{};
+  {
+    const auto lock = std::scoped_lock{mRollMutex};
+    for(const auto& candidate: mLanes)
+    {
+      if(candidate->mVacant.exchange(false, std::memory_order_acquire))
+      {
+        lane = candidate;
+        break;
+      }
+    }
+    if(not lane)
+    {
+      lane = mLanes.emplace_back(std::make_shared<ChannelLane>());
+    }
+    lane->mThread.store(self, std::memory_order_relaxed);
+  }
+  lanes.insert(mSerial, lane);
+  return lane.get();
 }
 
-void Channel::append(const TimelineEntry& entry)
+std::span<std::byte> Channel::carve(
+    ChannelLane& lane,
+    const RollLease& lease,
+    const std::size_t size)
 {
-  const auto slot = mTimeline.claim();
-  if(slot.empty())
+  if(lane.mChunk.size() - lane.mCarved < size)
+  {
+    auto& roll = *lease.roll();
+
+    // Hand the chunk's uncarved tail back to the roll, which works unless another lane has claimed
+    // past it since.
+    if(not lane.mChunk.empty() and not roll.rewind(lane.mChunk, lane.mCarved))
+    {
+      accountLaneSlack(lane);
+    }
+
+    lane.mCarved = 0;
+    lane.mChunk = roll.claim(std::max(size, std::min(kLaneCapacity, mRollCapacity / 16U)));
+    if(lane.mChunk.empty())
+    {
+      lane.mChunk = roll.claim(size); // The roll's last few bytes may still fit this record.
+    }
+    if(lane.mChunk.empty())
+    {
+      return {};
+    }
+  }
+
+  const auto slot = lane.mChunk.subspan(lane.mCarved, size);
+  lane.mCarved += size;
+  return slot;
+}
+
+std::shared_ptr<Channel::Roll> Channel::takeSpareRoll(
+    std::shared_future<std::shared_ptr<Roll>>& helper,
+    const bool wait) noexcept
+{
+  if(not mSpareRoll.valid() or
+     (not wait and mSpareRoll.wait_for(std::chrono::seconds::zero()) != std::future_status::ready))
+  {
+    return nullptr;
+  }
+
+  try
+  {
+    helper = mSpareRoll.share();
+    return helper.get();
+  }
+  catch(const std::exception& exception)
+  {
+    logger::warn(
+        "Unable to prepare a spare roll for channel {}; opening it inline instead: {}",
+        common::hexString(mChannelId.mValue),
+        exception.what());
+    return nullptr;
+  }
+}
+
+void Channel::prepareSpareRoll()
+{
+  if(mSpareRoll.valid())
+  {
+    return;
+  }
+
+  mSpareRoll = std::async(
+      std::launch::async,
+      [path = mChannelDir / kSpareRollFileName,
+       capacity = mRollCapacity,
+       writeMode = mWriteMode,
+       mapPolicy = mMapPolicy,
+       pooled = takePooledRoll()]
+      {
+        if(not pooled)
+        {
+          return makeRoll(path, 0, capacity, writeMode, mapPolicy);
+        }
+        if(writeMode == containers::WriteMode::Direct)
+        {
+          pooled->storage().restage(path, std::min(capacity, kInitialRollSize));
+        }
+        return pooled;
+      });
+}
+
+std::shared_ptr<Channel::Roll> Channel::takePooledRoll()
+{
+  auto pooled = std::shared_ptr<Roll>{};
+  auto idleRolls = std::size_t{0};
+  auto idleBytes = std::uint64_t{0ULL};
+  std::erase_if(
+      mRollPool,
+      [this, &pooled, &idleRolls, &idleBytes](const std::shared_ptr<Roll>& roll)
+      {
+        // Only the pool holds the roll, so no crate reads it and no reservation writes it.
+        if(roll.use_count() != 1L)
+        {
+          return false;
+        }
+        idleBytes += roll->capacity();
+        if(++idleRolls > mPooledRolls or idleBytes > mPooledBytes)
+        {
+          idleBytes -= roll->capacity();
+          return true;
+        }
+        if(not pooled)
+        {
+          pooled = roll;
+          return true;
+        }
+        return false;
+      });
+  if(not pooled)
+  {
+    return nullptr;
+  }
+
+  // Order the reads of the last crate to let go before the writes into the emptied roll.
+  std::atomic_thread_fence(std::memory_order_acquire);
+  pooled->clear();
+  return pooled;
+}
+
+void Channel::poolRoll(std::shared_ptr<Roll> roll)
+{
+  // A roll the pool could never keep is freed now rather than on the next take.
+  if(mPooledRolls > 0U and roll->capacity() <= mPooledBytes)
+  {
+    mRollPool.push_back(std::move(roll));
+  }
+}
+
+void Channel::sealInBackground(std::shared_ptr<RollLease> lease, const bool closing)
+{
+  // Seals run one after another, oldest roll first, so retirement sees the rolls in order. The
+  // producer rolling over never waits: a reservation it still holds on an earlier roll would
+  // otherwise hold up its own rollover.
+  mSealedRoll = std::async(
+                    std::launch::async,
+                    [this, previous = std::move(mSealedRoll), lease = std::move(lease), closing]()
+                        mutable
+                    {
+                      if(previous.valid())
+                      {
+                        previous.wait();
+                        previous = {}; // Keeps the seals from holding on to each other in a chain.
+                      }
+
+                      const auto rollId = lease->rollId();
+                      try
+                      {
+                        seal(std::move(lease), closing);
+                      }
+                      catch(const std::exception& exception)
+                      {
+                        logger::error(
+                            "Unable to seal roll {} of channel {}: {}",
+                            rollId,
+                            common::hexString(mChannelId.mValue),
+                            exception.what());
+                        const auto lock = std::scoped_lock{mSealMutex};
+                        if(not mSealFailure)
+                        {
+                          mSealFailure = std::current_exception();
+                        }
+                      }
+                    })
+                    .share();
+}
+
+void Channel::seal(std::shared_ptr<RollLease> lease, const bool closing)
+{
+  // Outstanding crates may keep the roll mapped past this; otherwise it is unmapped here, or pooled
+  // under WriteMode::Direct.
+  lease->close();
+  const auto rollId = lease->rollId();
+  auto roll = lease->roll();
+  {
+    // Pacing may have written the roll's settled bytes through already.
+    const auto lock = std::scoped_lock{mWriteThroughMutex};
+    const auto writtenThrough = lease->writtenThrough();
+    roll->storage().writeThrough(writtenThrough, roll->size() - writtenThrough);
+    roll->shrink_to_fit();
+    if(mSyncOnSeal)
+    {
+      roll->storage().sync();
+    }
+    lease->markWrittenThrough(roll->size());
+  }
+  const auto size = roll->size();
+  lease.reset();
+
+  // Only the last roll, sealed as the channel closes, can be empty. Compressing flushes the
+  // compressed copy, so only a roll left as it is waits for sync().
+  if(size > 0ULL)
+  {
+    compress(rollId);
+  }
+  if(not mSyncOnSeal and std::filesystem::exists(rollPath(rollId)))
+  {
+    const auto lock = std::scoped_lock{mSealMutex};
+    mUnsyncedRolls.push_back(rollId);
+  }
+  if(closing)
+  {
+    return;
+  }
+  retire(rollId, size);
+
+  // A staged roll's memory is worth keeping; a mapped one's is its file's.
+  if(mWriteMode == containers::WriteMode::Direct)
+  {
+    const auto lock = std::scoped_lock{mRollMutex};
+    poolRoll(std::move(roll));
+  }
+}
+
+void Channel::syncSealedRolls()
+{
+  // Held throughout, so retirement cannot delete a roll from under its flush.
+  const auto lock = std::scoped_lock{mSealMutex};
+  while(not mUnsyncedRolls.empty())
+  {
+    syncPath(rollPath(mUnsyncedRolls.back()));
+    mUnsyncedRolls.pop_back();
+  }
+  if(mSealFailure)
+  {
+    std::rethrow_exception(std::exchange(mSealFailure, nullptr));
+  }
+}
+
+void Channel::compress(const std::uint64_t rollId) const noexcept
+{
+  if(mCompression.mBlockSize == 0ULL)
+  {
+    return;
+  }
+
+  try
+  {
+    static_cast<void>(compressRoll(mChannelDir / buildRollName(rollId), mCompression));
+  }
+  catch(const std::exception& exception)
+  {
+    logger::warn(
+        "Unable to compress roll {} of channel {}; leaving it uncompressed: {}",
+        rollId,
+        common::hexString(mChannelId.mValue),
+        exception.what());
+  }
+}
+
+std::uint64_t Channel::startWriteback(const std::uint64_t budget) noexcept
+{
+  if(mWriteMode == containers::WriteMode::Direct)
+  {
+    return writeThroughActive(budget);
+  }
+  if(mWriteMode != containers::WriteMode::Mapped)
+  {
+    return 0ULL;
+  }
+
+  const auto lock = std::scoped_lock{mRollMutex};
+  if(not mActiveRoll)
+  {
+    return 0ULL;
+  }
+
+  const auto& roll = mActiveRoll->roll();
+  const auto length = std::min<std::uint64_t>(roll->size() - mWrittenBack, budget);
+  roll->storage().startWriteback(mWrittenBack, length);
+  mWrittenBack += length;
+  return length;
+}
+
+void Channel::sync()
+{
+  // The records committed by now are staged in full, and end up in the rolls flushed below.
+  auto committed = std::vector<std::uint64_t>{};
+  if(mWriteMode == containers::WriteMode::Direct)
+  {
+    const auto lock = std::scoped_lock{mWriteThroughMutex};
+    committed = scanDurable();
+  }
+
+  auto lease = std::shared_ptr<RollLease>{};
+  auto sealedRoll = std::shared_future<void>{};
+  {
+    const auto lock = std::scoped_lock{mRollMutex};
+    lease = mActiveRoll;
+    sealedRoll = mSealedRoll;
+  }
+
+  if(sealedRoll.valid())
+  {
+    sealedRoll.wait();
+  }
+  syncSealedRolls();
+
+  if(not lease)
+  {
+    return;
+  }
+
+  // Records still being written may go out half-written; pacing or the seal writes them out again,
+  // from the first byte not settled on the file.
+  const auto lock = std::scoped_lock{mWriteThroughMutex};
+  const auto& roll = lease->roll();
+  const auto writtenThrough = lease->writtenThrough();
+  roll->storage().writeThrough(writtenThrough, roll->size() - writtenThrough);
+  roll->storage().sync();
+  if(mDurableMarks)
+  {
+    advanceDurableMarks(*mDurableMarks, committed);
+  }
+}
+
+void Channel::observe(CommitObserver observer)
+{
+  mObservers.push_back(std::move(observer));
+}
+
+std::filesystem::path Channel::rollPath(const std::uint64_t rollId) const
+{
+  return mChannelDir / buildRollName(rollId);
+}
+
+void Channel::append(const TimelineEntry& entry, const std::span<const std::byte> record)
+{
+  if(mTimeline)
+  {
+    const auto position =
+        mTimeline->append(entry, mTimeline->hasChecksums() ? crc32c(record) : 0U);
+    if(mIndex)
+    {
+      indexPosition(position);
+    }
+  }
+
+  for(const auto& observer: mObservers)
+  {
+    std::invoke(observer, entry);
+  }
+}
+
+void Channel::openIndex()
+{
+  if(mTimeline and mTimeline->shardCount() == 1U)
+  {
+    mIndex = std::make_unique<PositionTape>(
+        std::filesystem::path{mChannelDir / kChannelIndexFileName} += kTemporaryFileSuffix,
+        0U,
+        containers::WriteMode::Mapped,
+        std::min(mTimeline->capacity(), kMaxIndexedRecords));
+  }
+}
+
+void Channel::indexPosition(const std::uint64_t position) noexcept
+{
+  try
+  {
+    if(const auto slot = mIndex->claim(); not slot.empty())
+    {
+      std::atomic_ref{slot.front()}.store(position, std::memory_order_release);
+      return;
+    }
+  }
+  catch(const std::exception& exception)
+  {
+    logger::error(
+        "Unable to grow the index of channel {}: {}",
+        common::hexString(mChannelId.mValue),
+        exception.what());
+  }
+
+  if(not mIndexIncomplete.exchange(true, std::memory_order_relaxed))
+  {
+    logger::warn(
+        "Channel {} gave up its index; readers will scan the timeline for its records.",
+        common::hexString(mChannelId.mValue));
+  }
+}
+
+void Channel::closeIndex() noexcept
+{
+  if(not mIndex)
+  {
+    return;
+  }
+
+  const auto indexPath = mChannelDir / kChannelIndexFileName;
+  const auto copyPath = std::filesystem::path{indexPath} += kTemporaryFileSuffix;
+  try
+  {
+    if(not mIndexIncomplete.load(std::memory_order_relaxed))
+    {
+      mIndex->shrink_to_fit();
+
+      // Discarded positions read as zero, ahead of the rest; sorting them would write their freed
+      // pages back.
+      const auto kept = std::ranges::find_if(
+          *mIndex,
+          [](const std::uint64_t position) { return position != 0ULL; });
+      if(not std::is_sorted(kept, mIndex->end()))
+      {
+        std::sort(kept, mIndex->end());
+      }
+      mIndex->storage().sync();
+      mIndex.reset();
+      std::filesystem::rename(copyPath, indexPath);
+      return;
+    }
+  }
+  catch(const std::exception& exception)
+  {
+    logger::error(
+        "Unable to write the index of channel {}; readers will scan the timeline for its records: "
+        "{}",
+        common::hexString(mChannelId.mValue),
+        exception.what());
+  }
+
+  mIndex.reset();
+  auto errorCode = std::error_code{};
+  std::filesystem::remove(copyPath, errorCode);
+}
+
+void Channel::retire(const std::uint64_t rollId, const std::uint64_t size)
+{
+  if(not isBounded(mRetention))
+  {
+    return;
+  }
+
+  const auto now = std::chrono::system_clock::now();
+  const auto lock = std::scoped_lock{mRetentionMutex};
+  mSealedRolls.push_back(SealedRoll{.mRollId = rollId, .mSize = size, .mSealedAt = now});
+  mSealedBytes += size;
+  prune(now);
+}
+
+void Channel::prune(const std::chrono::system_clock::time_point now)
+{
+  const auto overBudget = [this]()
+  { return mRetention.mMaxBytes != 0ULL and mSealedBytes > mRetention.mMaxBytes; };
+
+  const auto expired = [this, now](const SealedRoll& sealed)
+  {
+    return mRetention.mMaxAge != std::chrono::nanoseconds::zero() and
+           now - sealed.mSealedAt > mRetention.mMaxAge;
+  };
+
+  while(not mSealedRolls.empty() and (overBudget() or expired(mSealedRolls.front())))
+  {
+    const auto& oldest = mSealedRolls.front();
+
+    // Readers and outstanding crates keep their mappings; the space is freed as they let go.
+    const auto rollPath = mChannelDir / buildRollName(oldest.mRollId);
+    auto errorCode = std::error_code{};
+    std::filesystem::remove(std::filesystem::path{rollPath} += kCompressedRollSuffix, errorCode);
+    if(not std::filesystem::remove(rollPath, errorCode) and errorCode)
+    {
+      logger::warn(
+          "Unable to delete expired roll {} of channel {}: {}",
+          oldest.mRollId,
+          common::hexString(mChannelId.mValue),
+          errorCode.message());
+    }
+
+    {
+      const auto lock = std::scoped_lock{mSealMutex};
+      std::erase(mUnsyncedRolls, oldest.mRollId);
+    }
+    mSealedBytes -= oldest.mSize;
+    mSealedRolls.pop_front();
+
+    // Rolls are sealed, and so deleted, in the order they opened.
+    if(not mRollStarts.empty())
+    {
+      mRollStarts.pop_front();
+    }
+  }
+}
+
+void Channel::expire() noexcept
+{
+  if(mRetention.mMaxAge == std::chrono::nanoseconds::zero())
+  {
+    return;
+  }
+
+  try
+  {
+    const auto lock = std::scoped_lock{mRetentionMutex};
+    prune(std::chrono::system_clock::now());
+  }
+  catch(const std::exception& exception)
+  {
+    logger::error(
+        "Unable to expire the rolls of channel {}: {}",
+        common::hexString(mChannelId.mValue),
+        exception.what());
+  }
+}
+
+std::uint64_t Channel::keptFrom() const
+{
+  const auto lock = std::scoped_lock{mRetentionMutex};
+  return mRollStarts.empty() ? std::numeric_limits<std::uint64_t>::max() : mRollStarts.front();
+}
+
+void Channel::discardIndex(const std::uint64_t position) noexcept
+{
+  auto* index = static_cast<PositionTape*>(nullptr);
+  {
+    const auto lock = std::scoped_lock{mRollMutex};
+    index = mIndex.get(); // Set as the first roll opens, and kept until the channel closes.
+  }
+  if(not index)
+  {
+    return;
+  }
+
+  // Lanes commit slightly out of order, so the scan stops at the first position kept. It stops too
+  // at the slots claimed since the previous call, which a producer may not have written yet.
+  const auto slots = std::span{index->data(), index->size()}.first(mIndexClaimed);
+  mIndexClaimed = index->size();
+  const auto discarded = mIndexDiscarded;
+  while(mIndexDiscarded < slots.size())
+  {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-avoid-unchecked-container-access): in the span.
+    if(std::atomic_ref{slots[mIndexDiscarded]}.load(std::memory_order_acquire) >= position)
+    {
+      break;
+    }
+    ++mIndexDiscarded;
+  }
+  if(mIndexDiscarded > discarded)
+  {
+    index->storage().discard(0, mIndexDiscarded);
+  }
+}
+
+void Channel::openDurableMarks()
+{
+  if(mWriteMode == containers::WriteMode::Direct and mTimeline)
+  {
+    mDurableMarks = std::make_unique<containers::MmapArray<std::uint64_t>>(
+        mChannelDir / kDurableMarksFileName,
+        mTimeline->shardCount());
+    mDurableMarks->sync();
+  }
+}
+
+std::vector<std::uint64_t> Channel::scanDurable()
+{
+  mDurableScan.resize(mTimeline->shardCount());
+  mTimeline->scanCommitted(mDurableScan);
+  return mDurableScan;
+}
+
+void Channel::advanceDurableMarks(
+    containers::MmapArray<std::uint64_t>& marks,
+    const std::span<const std::uint64_t> committed)
+{
+  auto shard = std::size_t{0};
+  for(const auto length: committed)
+  {
+    auto& mark = marks.at(shard++);
+    mark = std::max(mark, length);
+  }
+  marks.sync();
+}
+
+std::uint64_t Channel::writeThroughActive(const std::uint64_t budget) noexcept
+{
+  try
+  {
+    const auto lock = std::scoped_lock{mWriteThroughMutex};
+    const auto committed = scanDurable();
+    auto lease = std::shared_ptr<RollLease>{};
+    auto sealedRoll = std::shared_future<void>{};
+    {
+      const auto rollLock = std::scoped_lock{mRollMutex};
+      lease = mActiveRoll;
+      sealedRoll = mSealedRoll;
+    }
+    if(not lease)
+    {
+      return 0ULL;
+    }
+
+    // Unsettled bytes are written through too, so the records committed so far reach the file, but
+    // the next pass or the seal writes them again. A lane's chunk is never settled while active.
+    const auto& roll = *lease->roll();
+    auto settled = lease->settledSize();
+    if(mMultiProducer.load(std::memory_order_acquire))
+    {
+      settled.reset();
+    }
+    const auto writtenThrough = lease->writtenThrough();
+    const auto end = std::max(writtenThrough, settled.value_or(roll.size()));
+    const auto length = std::min(end - writtenThrough, budget);
+    roll.storage().writeThrough(writtenThrough, length);
+    if(settled)
+    {
+      lease->markWrittenThrough(writtenThrough + length);
+    }
+
+    // Every record committed by the scan lies before end, or in a roll sealed before this one.
+    // The sealed rolls must be on disk in full too, which sync() sees to where seals skip it.
+    auto sealed = not sealedRoll.valid() or
+                  sealedRoll.wait_for(std::chrono::seconds::zero()) == std::future_status::ready;
+    if(sealed)
+    {
+      const auto sealLock = std::scoped_lock{mSealMutex};
+      sealed = mUnsyncedRolls.empty() and not mSealFailure;
+    }
+    if(writtenThrough + length == end and sealed)
+    {
+      roll.storage().sync();
+      advanceDurableMarks(*mDurableMarks, committed);
+    }
+    return length;
+  }
+  catch(const std::exception& exception)
   {
-    common::throwException<std::runtime_error>(
-        "Timeline capacity of {} entries is exhausted.",
-        mTimeline.capacity());
+    logger::error(
+        "Unable to write the active roll of channel {} through; leaving it to the seal: {}",
+        common::hexString(mChannelId.mValue),
+        exception.what());
+    return 0ULL;
   }
-  slot.front() = entry;
 }
 
 } // namespace nioc::chronicle
@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "utils.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <nioc/chronicle/channelIndex.hpp>
+#include <nioc/chronicle/defines.hpp>
+#include <nioc/common/filesystem.hpp>
+#include <nioc/common/utils.hpp>
+#include <nioc/containers/mmapArray.hpp>
+#include <nioc/containers/mmapConstArray.hpp>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace nioc::chronicle
+{
+
+void buildChannelIndices(const std::filesystem::path& logRoot)
+{
+  const auto root = common::requireExistingDirectory(logRoot);
+
+  auto positions = std::unordered_map<ChannelId, std::vector<std::uint64_t>>{};
+  if(const auto shardCount = countShards(root); shardCount > 0ULL)
+  {
+    // A sharded timeline's positions count along the order its shards merge into: the one the
+    // Writer persisted, if it covers every committed entry, or else merged here.
+    const auto shards = mapShards<ShardFile>(root, kTimelineShardStem, shardCount);
+    const auto committed = committedShards(shards);
+    auto committedCount = std::size_t{0};
+    for(const auto& shard: committed)
+    {
+      committedCount += shard.size();
+    }
+
+    const auto persisted =
+        mapIfRecorded<containers::MmapConstArray<std::uint64_t>>(root / kMergedOrderFileName);
+    auto mergedHere = std::vector<std::uint64_t>{};
+    auto merged = std::span<const std::uint64_t>{};
+    if(persisted and persisted->size() == committedCount)
+    {
+      merged = {persisted->data(), persisted->size()};
+    }
+    else
+    {
+      mergedHere = mergeShards(committed).mOrder;
+      merged = mergedHere;
+    }
+
+    for(auto position = std::uint64_t{0ULL}; position < merged.size(); ++position)
+    {
+      const auto shardPosition = merged[position];
+      const auto& entry = committed.at(shardOf(shardPosition))[indexInShard(shardPosition)];
+      positions[entry.mEntry.mChannelId].push_back(position);
+    }
+  }
+  else if(const auto timeline =
+              mapIfRecorded<containers::MmapConstArray<TimelineEntry>>(root / kTimelineFileName))
+  {
+    const auto length =
+        committedLength({timeline->data(), timeline->size()}, discardedLength(root));
+    for(auto position = std::uint64_t{0ULL}; position < length; ++position)
+    {
+      if(const auto& entry = (*timeline)[position]; isCommitted(entry))
+      {
+        positions[entry.mChannelId].push_back(position);
+      }
+    }
+  }
+
+  for(const auto& [channelId, channelPositions]: positions)
+  {
+    auto index = containers::MmapArray<std::uint64_t>{
+        root / common::hexString(channelId.mValue) / kChannelIndexFileName,
+        channelPositions.size()};
+    std::ranges::copy(channelPositions, index.begin());
+  }
+
+  // A channel that reserved space but never committed a record still owns a directory. Give it an
+  // empty index so readers can tell "no records" from "not indexed", and drop any index a channel
+  // was still appending to when its Writer stopped.
+  for(const auto& directoryEntry: std::filesystem::directory_iterator{root})
+  {
+    if(not directoryEntry.is_directory())
+    {
+      continue;
+    }
+
+    const auto indexPath = directoryEntry.path() / kChannelIndexFileName;
+    std::filesystem::remove(std::filesystem::path{indexPath} += kTemporaryFileSuffix);
+    if(not std::filesystem::exists(indexPath))
+    {
+      // Empty, with room to grow, as a region cannot map nothing otherwise.
+      static_cast<void>(containers::MmapArray<std::uint64_t>{
+          indexPath,
+          0U,
+          containers::WriteMode::Mapped,
+          1U});
+    }
+  }
+}
+
+} // namespace nioc::chronicle
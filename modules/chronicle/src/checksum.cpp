@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <nioc/chronicle/checksum.hpp>
+#include <span>
+
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#elif defined(__aarch64__) and defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
+namespace nioc::chronicle
+{
+namespace
+{
+
+/// The Castagnoli polynomial, bit-reversed.
+constexpr auto kPolynomial = std::uint32_t{0x82f63b78U};
+
+/// The remainder of every byte value, for the byte-at-a-time fallback.
+constexpr auto kTable = []
+{
+  auto table = std::array<std::uint32_t, 256>{};
+  for(auto value = std::uint32_t{0U}; value < table.size(); ++value)
+  {
+    auto remainder = value;
+    for(auto bit = 0; bit < 8; ++bit)
+    {
+      remainder = (remainder >> 1U) ^ ((remainder & 1U) != 0U ? kPolynomial : 0U);
+    }
+    table.at(value) = remainder;
+  }
+  return table;
+}();
+
+/// Advance the raw (uninverted) @p crc over @p bytes a byte at a time.
+std::uint32_t updateWithTable(std::uint32_t crc, const std::span<const std::byte> bytes) noexcept
+{
+  for(const auto byte: bytes)
+  {
+    crc = (crc >> 8U) ^ kTable.at((crc ^ std::to_integer<std::uint32_t>(byte)) & 0xffU);
+  }
+  return crc;
+}
+
+#if defined(__x86_64__)
+
+/// Advance the raw @p crc over @p bytes eight at a time with the SSE4.2 instruction.
+__attribute__((target("sse4.2"))) std::uint32_t updateWithInstructions(
+    std::uint32_t crc,
+    std::span<const std::byte> bytes) noexcept
+{
+  auto wide = std::uint64_t{crc};
+  for(; bytes.size() >= sizeof(std::uint64_t); bytes = bytes.subspan(sizeof(std::uint64_t)))
+  {
+    auto word = std::uint64_t{0U};
+    std::memcpy(&word, bytes.data(), sizeof(word));
+    wide = _mm_crc32_u64(wide, word);
+  }
+
+  crc = static_cast<std::uint32_t>(wide);
+  for(const auto byte: bytes)
+  {
+    crc = _mm_crc32_u8(crc, std::to_integer<std::uint8_t>(byte));
+  }
+  return crc;
+}
+
+/// Whether this CPU has the SSE4.2 CRC32C instruction.
+const auto kHasInstructions = __builtin_cpu_supports("sse4.2") != 0;
+
+#elif defined(__aarch64__) and defined(__ARM_FEATURE_CRC32)
+
+/// Advance the raw @p crc over @p bytes eight at a time with the ARMv8 CRC instruction.
+std::uint32_t updateWithInstructions(std::uint32_t crc, std::span<const std::byte> bytes) noexcept
+{
+  for(; bytes.size() >= sizeof(std::uint64_t); bytes = bytes.subspan(sizeof(std::uint64_t)))
+  {
+    auto word = std::uint64_t{0U};
+    std::memcpy(&word, bytes.data(), sizeof(word));
+    crc = __crc32cd(crc, word);
+  }
+
+  for(const auto byte: bytes)
+  {
+    crc = __crc32cb(crc, std::to_integer<std::uint8_t>(byte));
+  }
+  return crc;
+}
+
+/// The build targets the CRC extension, so every CPU it runs on has it.
+constexpr auto kHasInstructions = true;
+
+#else
+
+/// No CRC32C instruction to use on this target.
+std::uint32_t updateWithInstructions(const std::uint32_t crc, std::span<const std::byte>) noexcept
+{
+  return crc;
+}
+
+constexpr auto kHasInstructions = false;
+
+#endif
+
+} // namespace
+
+std::uint32_t crc32c(const std::span<const std::byte> bytes, const std::uint32_t previous) noexcept
+{
+  const auto crc = ~previous;
+  return ~(kHasInstructions ? updateWithInstructions(crc, bytes) : updateWithTable(crc, bytes));
+}
+
+} // namespace nioc::chronicle
@@ -0,0 +1,369 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "utils.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <nioc/chronicle/compaction.hpp>
+#include <nioc/chronicle/defines.hpp>
+#include <nioc/common/exception.hpp>
+#include <nioc/common/filesystem.hpp>
+#include <nioc/common/utils.hpp>
+#include <nioc/containers/mmapArray.hpp>
+#include <nioc/containers/mmapConstArray.hpp>
+#include <nioc/logger/logger.hpp>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace nioc::chronicle
+{
+namespace
+{
+
+namespace fs = std::filesystem;
+
+/// The committed records of one channel, as the timeline entries locating them, by roll id.
+using RollRecords = std::map<std::uint64_t, std::vector<TimelineEntry*>>;
+
+/// A timeline file copied beside the original, to be re-pointed and renamed over it.
+template<typename Entry>
+struct TimelineCopy
+{
+  /// The original file.
+  fs::path mPath;
+
+  /// The copy, at mPath with kTemporaryFileSuffix appended.
+  containers::MmapArray<Entry> mEntries;
+};
+
+TimelineEntry& recordOf(TimelineEntry& entry) noexcept
+{
+  return entry;
+}
+
+TimelineEntry& recordOf(StampedEntry& entry) noexcept
+{
+  return entry.mEntry;
+}
+
+/// Copy the timeline file at @p path beside it; empty if nothing was recorded into it. The first
+/// @p discarded entries stay holes in the copy, as they are in the original.
+template<typename Entry>
+std::optional<TimelineCopy<Entry>> copyTimeline(
+    const fs::path& path,
+    const std::uint64_t discarded = 0ULL)
+{
+  const auto original = mapIfRecorded<containers::MmapConstArray<Entry>>(path);
+  if(not original)
+  {
+    return std::nullopt;
+  }
+
+  auto copy =
+      containers::MmapArray<Entry>{fs::path{path} += kTemporaryFileSuffix, original->size()};
+  const auto first = std::min<std::uint64_t>(discarded, original->size());
+  std::ranges::copy(
+      std::span{original->data(), original->size()}.subspan(first),
+      std::span{copy.data(), copy.size()}.subspan(first).begin());
+  return TimelineCopy<Entry>{.mPath = path, .mEntries = std::move(copy)};
+}
+
+/// Add the committed entries of @p copy to @p records, by channel.
+template<typename Entry>
+void collectRecords(
+    TimelineCopy<Entry>& copy,
+    std::unordered_map<ChannelId, RollRecords>& records)
+{
+  for(auto& slot: copy.mEntries)
+  {
+    if(auto& entry = recordOf(slot); isCommitted(entry))
+    {
+      records[entry.mChannelId][entry.mRollId].push_back(&entry);
+    }
+  }
+}
+
+/// The byte size the roll at @p rollPath shrinks to holding only the records @p entries locate, in
+/// offset order and word aligned; empty if the roll is missing, compressed, or would not shrink.
+std::optional<std::uint64_t> compactedSize(
+    const fs::path& rollPath,
+    const std::vector<TimelineEntry*>& entries)
+{
+  if(not fs::exists(rollPath) or fs::exists(fs::path{rollPath} += kCompressedRollSuffix))
+  {
+    return std::nullopt;
+  }
+
+  auto denseSize = std::uint64_t{0ULL};
+  for(const auto* const entry: entries)
+  {
+    denseSize += roundUpToWord(entry->mSize);
+  }
+
+  // A zero-length file cannot be mapped; a roll of empty records only is left for what it is.
+  if(denseSize == 0ULL or denseSize >= fs::file_size(rollPath))
+  {
+    return std::nullopt;
+  }
+  return denseSize;
+}
+
+/// Write the records @p entries locate in the roll at @p rollPath densely into a new roll of
+/// @p denseSize bytes at @p target, synced, and re-point those entries at their new offsets.
+void writeCompactedRoll(
+    const fs::path& rollPath,
+    const fs::path& target,
+    std::vector<TimelineEntry*>& entries,
+    const std::uint64_t denseSize)
+{
+  std::ranges::sort(entries, {}, &TimelineEntry::mOffset);
+  const auto source = containers::MmapConstArray<std::byte>{rollPath};
+  auto dense = containers::MmapArray<std::byte>{target, denseSize};
+  auto offset = std::uint64_t{0ULL};
+  for(auto* const entry: entries)
+  {
+    if(entry->mOffset + entry->mSize > source.size())
+    {
+      common::throwException<std::runtime_error>(
+          "Roll {} holds {} bytes, short of a record ending at {}; recover the chronicle first.",
+          rollPath.string(),
+          source.size(),
+          entry->mOffset + entry->mSize);
+    }
+
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic): offsets checked above.
+    std::memcpy(dense.data() + offset, source.data() + entry->mOffset, entry->mSize);
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    entry->mOffset = offset;
+    offset += roundUpToWord(entry->mSize);
+  }
+  dense.sync();
+}
+
+/// The newest roll id among the files in @p channelDir, compressed or not; empty if it has none.
+std::optional<std::uint64_t> newestRollId(const fs::path& channelDir)
+{
+  auto newest = std::optional<std::uint64_t>{};
+  for(const auto& file: fs::directory_iterator{channelDir})
+  {
+    if(const auto rollId = parseRollName(file.path().filename().string()))
+    {
+      newest = std::max(newest.value_or(*rollId), *rollId);
+    }
+  }
+  return newest;
+}
+
+/// Move the rolls of the channel in @p channelDir that @p rolls references to fresh ids past its
+/// newest roll, keeping their order and spacing: those that shrink are written densely, the rest
+/// linked. The entries are re-pointed and @p rolls re-keyed to match; the originals, still in
+/// place, are added to @p superseded. A channel no roll of which would shrink is left as it is.
+///
+/// @return The bytes saved.
+std::uint64_t moveRolls(
+    const fs::path& channelDir,
+    RollRecords& rolls,
+    std::vector<fs::path>& superseded)
+{
+  auto denseSizes = std::map<std::uint64_t, std::uint64_t>{};
+  for(const auto& [rollId, entries]: rolls)
+  {
+    if(const auto denseSize = compactedSize(channelDir / buildRollName(rollId), entries))
+    {
+      denseSizes.emplace(rollId, *denseSize);
+    }
+  }
+  if(denseSizes.empty())
+  {
+    return 0ULL;
+  }
+
+  const auto shift = newestRollId(channelDir).value_or(0ULL) + 1ULL - rolls.begin()->first;
+  auto saved = std::uint64_t{0ULL};
+  auto moved = RollRecords{};
+  for(auto& [rollId, entries]: rolls)
+  {
+    const auto newRollId = rollId + shift;
+    const auto rollPath = channelDir / buildRollName(rollId);
+    const auto target = channelDir / buildRollName(newRollId);
+    if(const auto found = denseSizes.find(rollId); found != denseSizes.end())
+    {
+      writeCompactedRoll(rollPath, target, entries, found->second);
+      saved += fs::file_size(rollPath) - found->second;
+      superseded.push_back(rollPath);
+    }
+    else if(const auto compressed = fs::path{rollPath} += kCompressedRollSuffix;
+            fs::exists(compressed))
+    {
+      linkRoll(compressed, fs::path{target} += kCompressedRollSuffix);
+      superseded.push_back(compressed);
+    }
+    else if(fs::exists(rollPath))
+    {
+      linkRoll(rollPath, target);
+      superseded.push_back(rollPath);
+    }
+    else
+    {
+      // A missing roll's records are lost wherever they point; they keep their roll id.
+      moved[rollId] = std::move(entries);
+      continue;
+    }
+
+    for(auto* const entry: entries)
+    {
+      entry->mRollId = newRollId;
+    }
+    moved[newRollId] = std::move(entries);
+  }
+  rolls = std::move(moved);
+  syncPath(channelDir);
+  return saved;
+}
+
+/// Delete the rolls in @p channelDir that @p records does not reference, compressed or not,
+/// returning their bytes.
+std::uint64_t deleteUnreferencedRolls(const fs::path& channelDir, const RollRecords* const records)
+{
+  auto saved = std::uint64_t{0ULL};
+  for(const auto& file: fs::directory_iterator{channelDir})
+  {
+    const auto name = file.path().filename().string();
+    const auto rollId = parseRollName(name);
+    if(not rollId or name.ends_with(kTemporaryFileSuffix))
+    {
+      continue;
+    }
+    if(records == nullptr or not records->contains(*rollId))
+    {
+      saved += file.file_size();
+      fs::remove(file.path());
+    }
+  }
+  return saved;
+}
+
+/// Rename the copy of @p copy into place, once synced.
+template<typename Entry>
+void replaceTimeline(TimelineCopy<Entry>& copy)
+{
+  copy.mEntries.sync();
+  fs::rename(fs::path{copy.mPath} += kTemporaryFileSuffix, copy.mPath);
+}
+
+/// Delete the copy of @p copy, left unused.
+template<typename Entry>
+void discardTimeline(const TimelineCopy<Entry>& copy)
+{
+  fs::remove(fs::path{copy.mPath} += kTemporaryFileSuffix);
+}
+
+} // namespace
+
+std::uint64_t compact(const std::filesystem::path& logRoot)
+{
+  const auto root = common::requireExistingDirectory(logRoot);
+  requireFormat(root);
+
+  auto channelDirs = std::unordered_map<ChannelId, fs::path>{};
+  for(const auto& directoryEntry: fs::directory_iterator{root})
+  {
+    if(directoryEntry.is_directory())
+    {
+      try
+      {
+        const auto value =
+            common::fromHexString<std::uint64_t>(directoryEntry.path().filename().string());
+        channelDirs.emplace(ChannelId{value}, directoryEntry.path());
+      }
+      catch(const std::logic_error&)
+      {
+        logger::warn("Skipping {}: not a channel directory.", directoryEntry.path().string());
+      }
+    }
+  }
+
+  // The entries are re-pointed in copies of the timeline, so the original stays intact until every
+  // compacted roll is written.
+  auto records = std::unordered_map<ChannelId, RollRecords>{};
+  const auto shardCount = countShards(root);
+  auto timeline = shardCount > 0ULL ? std::nullopt
+                                    : copyTimeline<TimelineEntry>(
+                                          root / kTimelineFileName,
+                                          discardedLength(root));
+  if(timeline)
+  {
+    collectRecords(*timeline, records);
+  }
+  auto shards = std::vector<TimelineCopy<StampedEntry>>{};
+  for(auto shard = std::uint64_t{0ULL}; shard < shardCount; ++shard)
+  {
+    if(auto copy = copyTimeline<StampedEntry>(root / buildShardName(kTimelineShardStem, shard)))
+    {
+      shards.push_back(std::move(*copy));
+    }
+  }
+  for(auto& shard: shards)
+  {
+    collectRecords(shard, records);
+  }
+
+  // Compacted rolls go under fresh roll ids, so the originals stay intact, and the timeline still
+  // locates every record, until the re-pointed timeline is renamed over it: that rename commits.
+  auto saved = std::uint64_t{0ULL};
+  auto superseded = std::vector<fs::path>{};
+  for(auto& [channelId, rolls]: records)
+  {
+    saved += moveRolls(root / common::hexString(channelId.mValue), rolls, superseded);
+  }
+
+  // Channels that did not move leave their entries as they were, so an unchanged timeline is
+  // dropped. Each shard's rename commits its own entries; until the last, the rest still locate
+  // theirs in the originals.
+  const auto moved = not superseded.empty();
+  const auto settle = [moved](auto& copy)
+  {
+    if(moved)
+    {
+      replaceTimeline(copy);
+    }
+    else
+    {
+      discardTimeline(copy);
+    }
+  };
+  if(timeline)
+  {
+    settle(*timeline);
+  }
+  std::ranges::for_each(shards, settle);
+  if(moved)
+  {
+    syncPath(root);
+  }
+  for(const auto& rollPath: superseded)
+  {
+    fs::remove(rollPath);
+  }
+
+  for(const auto& [channelId, channelDir]: channelDirs)
+  {
+    const auto found = records.find(channelId);
+    saved += deleteUnreferencedRolls(channelDir, found == records.end() ? nullptr : &found->second);
+  }
+
+  logger::info("Compacted {}: the rolls shrank by {} bytes.", root.string(), saved);
+  return saved;
+}
+
+} // namespace nioc::chronicle
@@ -0,0 +1,292 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "utils.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <nioc/chronicle/compressedRoll.hpp>
+#include <nioc/common/exception.hpp>
+#include <nioc/containers/mmapArray.hpp>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <zlib.h>
+
+namespace nioc::chronicle
+{
+namespace
+{
+
+/// Leads every compressed roll: "nioczlb1" read as a little-endian word.
+constexpr auto kMagic = std::uint64_t{0x31626c7a636f696eULL};
+
+/// The fixed-size start of a compressed roll, followed by the block offset table.
+struct Header
+{
+  std::uint64_t mMagic{kMagic};
+
+  /// Byte size of the roll before compression.
+  std::uint64_t mSize{0ULL};
+
+  /// Bytes per block before compression.
+  std::uint64_t mBlockSize{0ULL};
+
+  /// Number of blocks. The offset table that follows has one more entry: the end of the file.
+  std::uint64_t mBlockCount{0ULL};
+};
+
+/// File offset of the offset table's entry for block @p index.
+constexpr std::uint64_t tableSlot(const std::uint64_t index) noexcept
+{
+  return sizeof(Header) + (index * sizeof(std::uint64_t));
+}
+
+/// zlib's view of a byte buffer.
+Bytef* asZlibBytes(std::byte* const bytes) noexcept
+{
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast): zlib takes bytes as Bytef.
+  return reinterpret_cast<Bytef*>(bytes);
+}
+
+/// zlib's view of a read-only byte buffer.
+const Bytef* asZlibBytes(const std::byte* const bytes) noexcept
+{
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast): zlib takes bytes as Bytef.
+  return reinterpret_cast<const Bytef*>(bytes);
+}
+
+} // namespace
+
+CompressedRoll::CompressedRoll(const std::filesystem::path& path): mFile{path}
+{
+  auto header = Header{};
+  if(mFile.size() >= sizeof(Header))
+  {
+    std::memcpy(&header, mFile.data(), sizeof(Header));
+  }
+
+  mSize = header.mSize;
+  mBlockSize = header.mBlockSize;
+  mBlockCount = header.mBlockCount;
+
+  if(header.mMagic != kMagic or mBlockSize == 0ULL or
+     mBlockCount != (mSize + mBlockSize - 1ULL) / mBlockSize or
+     mFile.size() < tableSlot(mBlockCount + 1ULL) or blockOffset(mBlockCount) != mFile.size())
+  {
+    common::throwException<std::runtime_error>("{} is not a compressed roll.", path.string());
+  }
+}
+
+std::uint64_t CompressedRoll::size() const noexcept
+{
+  return mSize;
+}
+
+Crate CompressedRoll::read(const std::uint64_t offset, const std::uint64_t size)
+{
+  if(offset > mSize or size > mSize - offset)
+  {
+    common::throwException<std::out_of_range>(
+        "Bytes [{}, {}) run past the end of a compressed roll of {} bytes.",
+        offset,
+        offset + size,
+        mSize);
+  }
+
+  if(size == 0ULL)
+  {
+    return Crate{};
+  }
+
+  const auto first = offset / mBlockSize;
+  const auto last = (offset + size - 1ULL) / mBlockSize;
+  if(first == last)
+  {
+    auto block = decodeBlock(first);
+    const auto begin = offset - (first * mBlockSize);
+    const auto span = std::span<const std::byte>{*block}.subspan(begin, size);
+    return Crate{std::move(block), span};
+  }
+
+  auto bytes = std::make_shared<Block>();
+  bytes->reserve(size);
+  for(auto index = first; index <= last; ++index)
+  {
+    const auto block = decodeBlock(index);
+    const auto blockStart = index * mBlockSize;
+    const auto begin = std::max(offset, blockStart) - blockStart;
+    const auto end = std::min(offset + size, blockStart + block->size()) - blockStart;
+    const auto part = std::span<const std::byte>{*block}.subspan(begin, end - begin);
+    bytes->insert(bytes->end(), part.begin(), part.end());
+  }
+
+  const auto span = std::span<const std::byte>{*bytes};
+  return Crate{std::move(bytes), span};
+}
+
+void CompressedRoll::advise(
+    const std::uint64_t offset,
+    const std::uint64_t size,
+    const containers::Advice advice) const noexcept
+{
+  if(size == 0ULL or offset >= mSize)
+  {
+    return;
+  }
+
+  const auto first = offset / mBlockSize;
+  const auto last = std::min(mBlockCount - 1ULL, (offset + size - 1ULL) / mBlockSize);
+  const auto begin = blockOffset(first);
+  mFile.advise(begin, blockOffset(last + 1ULL) - begin, advice);
+}
+
+std::uint64_t CompressedRoll::blockOffset(const std::uint64_t index) const noexcept
+{
+  auto offset = std::uint64_t{0ULL};
+  std::memcpy(
+      &offset,
+      std::span{mFile.data(), mFile.size()}.subspan(tableSlot(index)).data(),
+      sizeof(offset));
+  return offset;
+}
+
+std::shared_ptr<const CompressedRoll::Block> CompressedRoll::decodeBlock(const std::uint64_t index)
+{
+  if(mLastBlock and mLastBlockIndex == index)
+  {
+    return mLastBlock;
+  }
+
+  const auto begin = blockOffset(index);
+  const auto end = blockOffset(index + 1ULL);
+  if(begin < tableSlot(mBlockCount + 1ULL) or end < begin or end > mFile.size())
+  {
+    common::throwException<std::runtime_error>(
+        "Block {} of a compressed roll has a corrupt offset.",
+        index);
+  }
+
+  const auto stored = std::span{mFile.data(), mFile.size()}.subspan(begin, end - begin);
+  auto block = std::make_shared<Block>(std::min(mBlockSize, mSize - (index * mBlockSize)));
+  if(stored.size() == block->size())
+  {
+    std::ranges::copy(stored, block->begin()); // Deflating did not shrink it: stored as is.
+  }
+  else
+  {
+    auto decodedSize = static_cast<uLongf>(block->size());
+    const auto status = uncompress(
+        asZlibBytes(block->data()),
+        &decodedSize,
+        asZlibBytes(stored.data()),
+        static_cast<uLong>(stored.size()));
+    if(status != Z_OK or decodedSize != block->size())
+    {
+      common::throwException<std::runtime_error>(
+          "Block {} of a compressed roll failed to decode (zlib status {}).",
+          index,
+          status);
+    }
+  }
+
+  mLastBlockIndex = index;
+  mLastBlock = std::move(block);
+  return mLastBlock;
+}
+
+std::filesystem::path compressRoll(
+    const std::filesystem::path& rollPath,
+    const Compression& compression)
+{
+  if(compression.mBlockSize == 0ULL)
+  {
+    common::throwException<std::invalid_argument>("The compression block size must be non-zero.");
+  }
+
+  const auto compressedPath = std::filesystem::path{rollPath} += kCompressedRollSuffix;
+  const auto temporaryPath = std::filesystem::path{compressedPath} += kTemporaryFileSuffix;
+
+  const auto roll = mapIfRecorded<containers::MmapConstArray<std::byte>>(rollPath);
+  const auto bytes =
+      roll ? std::span{roll->data(), roll->size()} : std::span<const std::byte>{};
+
+  const auto header = Header{
+      .mSize = bytes.size(),
+      .mBlockSize = compression.mBlockSize,
+      .mBlockCount = (bytes.size() + compression.mBlockSize - 1ULL) / compression.mBlockSize};
+
+  // Size the file for the worst case, every block deflating past its own size, then trim it.
+  auto capacity = tableSlot(header.mBlockCount + 1ULL);
+  for(auto index = std::uint64_t{0ULL}; index < header.mBlockCount; ++index)
+  {
+    const auto length = std::min(header.mBlockSize, header.mSize - (index * header.mBlockSize));
+    capacity += compressBound(static_cast<uLong>(length));
+  }
+
+  try
+  {
+    auto file = containers::MmapArray<std::byte>{temporaryPath, capacity};
+    const auto output = std::span{file.data(), file.size()};
+    const auto writeWord = [&output](const std::uint64_t offset, const std::uint64_t value)
+    { std::memcpy(output.subspan(offset).data(), &value, sizeof(value)); };
+
+    auto cursor = tableSlot(header.mBlockCount + 1ULL);
+    for(auto index = std::uint64_t{0ULL}; index < header.mBlockCount; ++index)
+    {
+      writeWord(tableSlot(index), cursor);
+
+      const auto source = bytes.subspan(
+          index * header.mBlockSize,
+          std::min(header.mBlockSize, header.mSize - (index * header.mBlockSize)));
+      const auto target = output.subspan(cursor);
+      auto length = static_cast<uLongf>(target.size());
+      const auto status = compress2(
+          asZlibBytes(target.data()),
+          &length,
+          asZlibBytes(source.data()),
+          static_cast<uLong>(source.size()),
+          compression.mLevel);
+      if(status != Z_OK)
+      {
+        common::throwException<std::runtime_error>(
+            "Unable to compress block {} of {} (zlib status {}).",
+            index,
+            rollPath.string(),
+            status);
+      }
+
+      // A block deflate cannot shrink is stored as is; its stored size tells the two apart.
+      if(length >= source.size())
+      {
+        std::ranges::copy(source, target.begin());
+        length = static_cast<uLongf>(source.size());
+      }
+      cursor += length;
+    }
+    writeWord(tableSlot(header.mBlockCount), cursor);
+    std::memcpy(output.data(), &header, sizeof(header));
+
+    file.resize(cursor);
+    file.sync();
+  }
+  catch(...)
+  {
+    auto errorCode = std::error_code{};
+    std::filesystem::remove(temporaryPath, errorCode);
+    throw;
+  }
+
+  std::filesystem::rename(temporaryPath, compressedPath);
+  std::filesystem::remove(rollPath);
+  return compressedPath;
+}
+
+} // namespace nioc::chronicle
@@ -0,0 +1,274 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "utils.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <nioc/chronicle/follower.hpp>
+#include <nioc/common/exception.hpp>
+#include <nioc/common/filesystem.hpp>
+#include <nioc/common/utils.hpp>
+#include <nioc/logger/logger.hpp>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+namespace nioc::chronicle
+{
+namespace
+{
+
+std::filesystem::path requireDoorbell(const std::filesystem::path& logRoot)
+{
+  // The Writer creates the doorbell empty and sizes it next; one not sized yet is not rung yet.
+  const auto path = logRoot / kDoorbellFileName;
+  auto errorCode = std::error_code{};
+  if(std::filesystem::file_size(path, errorCode) < sizeof(Doorbell) or errorCode)
+  {
+    common::throwException<std::invalid_argument>(
+        "The chronicle {} rings no doorbell: its Writer was given no doorbell interval.",
+        logRoot.string());
+  }
+  return path;
+}
+
+} // namespace
+
+Follower::Follower(std::filesystem::path logRoot):
+  mLogRoot{common::requireExistingDirectory(std::move(logRoot))},
+  mDoorbell{requireDoorbell(mLogRoot)}
+{
+  requireFormat(mLogRoot);
+
+  // The Writer creates the timeline before the doorbell, so both are in place; the timeline is
+  // mapped at its size now and remapped as it grows.
+  if(const auto shardCount = countShards(mLogRoot); shardCount > 0ULL)
+  {
+    mShardFiles = mapShards<ShardFile>(mLogRoot, kTimelineShardStem, shardCount);
+    mNext.resize(shardCount, 0ULL);
+    mFloors.resize(shardCount, 0LL);
+    return;
+  }
+
+  mTimelineFile = mapIfRecorded<TimelineFile>(mLogRoot / kTimelineFileName);
+  mNext.resize(1, 0ULL);
+}
+
+std::optional<Entry> Follower::next(const std::chrono::nanoseconds timeout)
+{
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  const auto& doorbell = mDoorbell[0];
+  while(true)
+  {
+    // The closed flag is read before the lengths: once it is seen, the final lengths are too.
+    const auto sequence = loadAcquire(doorbell.mSequence);
+    const auto closed = loadAcquire(doorbell.mClosed) != 0U;
+
+    followGrowth();
+    while(const auto* const published = nextPublished())
+    {
+      if(auto entry = load(*published))
+      {
+        return entry;
+      }
+    }
+
+    if(closed)
+    {
+      mFinished = true;
+      return std::nullopt;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    if(now >= deadline)
+    {
+      return std::nullopt;
+    }
+    waitForDoorbell(doorbell, sequence, deadline - now);
+  }
+}
+
+void Follower::skipToEnd()
+{
+  followGrowth();
+  for(auto shard = std::size_t{0}; shard < mNext.size(); ++shard)
+  {
+    const auto length = publishedLength(shard);
+    if(not mShardFiles.empty() and length > mNext.at(shard))
+    {
+      mFloors.at(shard) =
+          std::max(mFloors.at(shard), (*mShardFiles.at(shard))[length - 1ULL].mTimestamp);
+    }
+    mNext.at(shard) = std::max(mNext.at(shard), length);
+  }
+}
+
+bool Follower::finished() const noexcept
+{
+  return mFinished;
+}
+
+const std::filesystem::path& Follower::path() const noexcept
+{
+  return mLogRoot;
+}
+
+const TimelineEntry* Follower::nextPublished() noexcept
+{
+  if(mShardFiles.empty())
+  {
+    if(mNext.front() >= publishedLength(0))
+    {
+      return nullptr;
+    }
+    return &(*mTimelineFile)[mNext.front()++];
+  }
+
+  // Merge by stamp as mergeShards does: each shard's head is taken to share its predecessor's
+  // stamp if it was stamped earlier, and equal stamps go to the lower shard.
+  auto chosen = std::optional<std::size_t>{};
+  auto chosenStamp = std::int64_t{0LL};
+  for(auto shard = std::size_t{0}; shard < mShardFiles.size(); ++shard)
+  {
+    if(mNext.at(shard) >= publishedLength(shard))
+    {
+      continue;
+    }
+    const auto stamp =
+        std::max(mFloors.at(shard), (*mShardFiles.at(shard))[mNext.at(shard)].mTimestamp);
+    if(not chosen or stamp < chosenStamp)
+    {
+      chosen = shard;
+      chosenStamp = stamp;
+    }
+  }
+  if(not chosen)
+  {
+    return nullptr;
+  }
+
+  mFloors.at(*chosen) = chosenStamp;
+  return &(*mShardFiles.at(*chosen))[mNext.at(*chosen)++].mEntry;
+}
+
+void Follower::followGrowth()
+{
+  const auto& committed = mDoorbell[0].mCommitted;
+  if(mShardFiles.empty())
+  {
+    if(mTimelineFile and loadAcquire(committed.front()) > mTimelineFile->size())
+    {
+      mTimelineFile = std::make_unique<const TimelineFile>(mTimelineFile->remap());
+    }
+    return;
+  }
+
+  for(auto shard = std::size_t{0}; shard < mShardFiles.size(); ++shard)
+  {
+    auto& file = mShardFiles.at(shard);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-avoid-unchecked-container-access): one per shard.
+    if(file and loadAcquire(committed[shard]) > file->size())
+    {
+      file = std::make_unique<const ShardFile>(file->remap());
+    }
+  }
+}
+
+std::uint64_t Follower::publishedLength(const std::size_t shard) const noexcept
+{
+  auto mapped = std::uint64_t{0ULL};
+  if(mShardFiles.empty())
+  {
+    mapped = mTimelineFile ? mTimelineFile->size() : 0ULL;
+  }
+  else if(const auto& file = mShardFiles.at(shard))
+  {
+    mapped = file->size();
+  }
+
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-avoid-unchecked-container-access): one per shard.
+  return std::min<std::uint64_t>(mapped, loadAcquire(mDoorbell[0].mCommitted[shard]));
+}
+
+std::optional<Entry> Follower::load(const TimelineEntry& entry)
+{
+  if(not isCommitted(entry))
+  {
+    return std::nullopt; // Discarded under the Writer's retention policy before it was read.
+  }
+
+  auto& roll = acquireRoll(entry.mChannelId, entry.mRollId);
+  if(roll.mCompressed)
+  {
+    return Entry{
+        .mChannelId = entry.mChannelId,
+        .mCrate = roll.mCompressed->read(entry.mOffset, entry.mSize)};
+  }
+  if(not roll.mRoll)
+  {
+    return std::nullopt;
+  }
+
+  // The roll grows as its channel writes, so a record past the end of the mapping is in the file.
+  if(entry.mOffset + entry.mSize > roll.mRoll->size())
+  {
+    roll.mRoll = std::make_shared<const Roll>(roll.mRoll->remap());
+  }
+
+  const auto span = std::span{*roll.mRoll}.subspan(entry.mOffset, entry.mSize);
+  return Entry{.mChannelId = entry.mChannelId, .mCrate = Crate{roll.mRoll, span}};
+}
+
+Follower::OpenRoll& Follower::acquireRoll(const ChannelId channelId, const std::uint64_t rollId)
+{
+  auto& open = mRolls[channelId];
+  if(const auto found = open.find(rollId); found != open.end())
+  {
+    return found->second;
+  }
+
+  // The Writer may compress and remove a sealed roll at any moment, so the roll is mapped as
+  // written if it is still there, and its compressed copy is looked for only if it is not.
+  const auto path = mLogRoot / common::hexString(channelId.mValue) / buildRollName(rollId);
+  auto compressedPath = path;
+  compressedPath += kCompressedRollSuffix;
+  auto roll = OpenRoll{};
+  try
+  {
+    roll.mRoll = std::make_shared<const Roll>(path);
+  }
+  catch(const std::runtime_error&)
+  {
+    if(std::filesystem::exists(compressedPath))
+    {
+      roll.mCompressed = std::make_unique<CompressedRoll>(compressedPath);
+    }
+    else
+    {
+      logger::warn(
+          "Skipping the records of roll {} of channel {}: retention removed it.",
+          rollId,
+          common::hexString(channelId.mValue));
+    }
+  }
+
+  auto& opened = open.emplace(rollId, std::move(roll)).first->second;
+
+  // Close the roll furthest from the one just opened, as a channel rarely goes back.
+  const auto distance = [rollId](const std::uint64_t other)
+  { return other > rollId ? other - rollId : rollId - other; };
+  while(open.size() > 2)
+  {
+    const auto last = std::prev(open.end());
+    open.erase(distance(open.begin()->first) > distance(last->first) ? open.begin() : last);
+  }
+
+  return opened;
+}
+
+} // namespace nioc::chronicle
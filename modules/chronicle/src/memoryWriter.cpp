@@ -0,0 +1,50 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <memory>
+#include <nioc/chronicle/channel.hpp>
+#include <nioc/chronicle/memoryWriter.hpp>
+
+namespace nioc::chronicle
+{
+
+MemoryWriter::MemoryWriter(
+    const std::size_t rollCapacity,
+    const containers::MapPolicy mapPolicy,
+    const std::size_t pooledRolls,
+    const std::uint64_t pooledBytes):
+  mRollCapacity{rollCapacity},
+  mMapPolicy{mapPolicy},
+  mPooledRolls{pooledRolls},
+  mPooledBytes{pooledBytes}
+{
+}
+
+Channel& MemoryWriter::channel(const ChannelId channelId)
+{
+  return mLockedChannelMap.execute(
+      [this, channelId](ChannelMap& channelMap) -> Channel&
+      {
+        auto& channelPtr = channelMap[channelId];
+        if(not channelPtr)
+        {
+          channelPtr = std::make_unique<Channel>(
+              channelId,
+              mRollCapacity,
+              mMapPolicy,
+              mPooledRolls,
+              mPooledBytes);
+        }
+        return *channelPtr;
+      });
+}
+
+Crate MemoryWriter::write(const ChannelId channelId, const std::span<const std::byte> data)
+{
+  return channel(channelId).write(data);
+}
+
+} // namespace nioc::chronicle
@@ -0,0 +1,429 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "utils.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <nioc/chronicle/channelIndex.hpp>
+#include <nioc/chronicle/defines.hpp>
+#include <nioc/chronicle/merge.hpp>
+#include <nioc/chronicle/reader.hpp>
+#include <nioc/chronicle/timeline.hpp>
+#include <nioc/common/filesystem.hpp>
+#include <nioc/common/utils.hpp>
+#include <nioc/containers/mmapArray.hpp>
+#include <nioc/containers/mmapConstArray.hpp>
+#include <nioc/logger/logger.hpp>
+#include <optional>
+#include <queue>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace nioc::chronicle
+{
+namespace
+{
+
+namespace fs = std::filesystem;
+
+/// Most time index samples a source's clock offset is estimated from, spread over its timeline.
+constexpr auto kMaxClockSamples = std::size_t{64};
+
+/// One chronicle being merged, with its timeline read into replay order.
+struct Source
+{
+  /// The chronicle's root directory.
+  fs::path mRoot;
+
+  /// Reads the records' bytes, mapping and decoding rolls as they are needed.
+  std::unique_ptr<Reader> mReader;
+
+  /// The timeline, in the order the Reader replays it.
+  std::vector<TimelineEntry> mEntries;
+
+  /// Each entry's checksum, if the chronicle was recorded with them.
+  std::vector<std::uint32_t> mChecksums;
+
+  /// Samples of the wall-clock instant entries were committed at.
+  std::vector<TimeIndexEntry> mSamples;
+
+  /// Added to the source's keys to put them on the wall clock.
+  std::int64_t mClockOffset{0LL};
+
+  /// Per channel, added to the source's roll ids to number them among the merged channel's rolls.
+  std::unordered_map<ChannelId, std::uint64_t> mRollIdBase;
+
+  /// Position of the next record to merge.
+  std::uint64_t mNext{0ULL};
+};
+
+/// Read the single-file timeline of @p source, with its checksums and time index.
+void loadTimeline(Source& source)
+{
+  const auto timeline =
+      mapIfRecorded<containers::MmapConstArray<TimelineEntry>>(source.mRoot / kTimelineFileName);
+  if(not timeline)
+  {
+    return;
+  }
+  const auto length =
+      committedLength({timeline->data(), timeline->size()}, discardedLength(source.mRoot));
+  source.mEntries.assign(timeline->data(), timeline->data() + length);
+
+  if(const auto checksums = mapIfRecorded<containers::MmapConstArray<std::uint32_t>>(
+         source.mRoot / kChecksumsFileName);
+     checksums and checksums->size() >= length)
+  {
+    source.mChecksums.assign(checksums->data(), checksums->data() + length);
+  }
+
+  if(const auto timeIndex = mapIfRecorded<containers::MmapConstArray<TimeIndexEntry>>(
+         source.mRoot / kTimeIndexFileName))
+  {
+    const auto sampled = sampledLength({timeIndex->data(), timeIndex->size()}, length);
+    source.mSamples.assign(timeIndex->data(), timeIndex->data() + sampled);
+  }
+}
+
+/// Read the @p shardCount shards of @p source in merged order, with their checksums. Every entry
+/// is stamped, so every stride-th one samples the wall clock.
+void loadShards(Source& source, const std::uint64_t shardCount)
+{
+  const auto shards = mapShards<ShardFile>(source.mRoot, kTimelineShardStem, shardCount);
+  const auto checksums = mapShards<containers::MmapConstArray<std::uint32_t>>(
+      source.mRoot,
+      kChecksumsShardStem,
+      shardCount);
+  const auto committed = committedShards(shards);
+  const auto merged = mergeShards(committed).mOrder;
+
+  // A shard whose checksums fall short leaves the whole source without them.
+  auto checksummed = source.mReader->hasChecksums();
+  for(auto shard = std::uint64_t{0ULL}; shard < shardCount; ++shard)
+  {
+    const auto recorded = checksums.at(shard) ? checksums.at(shard)->size() : std::size_t{0};
+    checksummed = checksummed and recorded >= committed.at(shard).size();
+  }
+
+  source.mEntries.reserve(merged.size());
+  for(auto position = std::uint64_t{0ULL}; position < merged.size(); ++position)
+  {
+    const auto shard = shardOf(merged.at(position));
+    const auto index = indexInShard(merged.at(position));
+    const auto& stamped = committed.at(shard)[index];
+    source.mEntries.push_back(stamped.mEntry);
+    if(checksummed)
+    {
+      source.mChecksums.push_back(checksums.at(shard)->at(index));
+    }
+    if(position % Timeline::kDefaultTimeIndexStride == 0ULL)
+    {
+      source.mSamples.push_back(
+          TimeIndexEntry{.mTimestamp = stamped.mTimestamp, .mEntryInTimeline = position});
+    }
+  }
+}
+
+/// Whether the record at @p position of @p source is there to merge: committed, and with its bytes
+/// still on disk. If so, leaves its head, as a MergeKey reads it, in @p entry.
+bool isMergeable(Source& source, const std::uint64_t position, std::optional<Entry>& entry)
+{
+  const auto& timelineEntry = source.mEntries.at(position);
+  if(not isCommitted(timelineEntry))
+  {
+    return false;
+  }
+  entry = source.mReader->head(position, kMergeKeyBytes);
+  return entry->mCrate.span().size() == std::min(timelineEntry.mSize, kMergeKeyBytes);
+}
+
+/// Estimate the offset from the clock @p key reads off @p source's records to the wall clock.
+std::int64_t estimateClockOffset(Source& source, const MergeKey& key)
+{
+  if(source.mSamples.empty())
+  {
+    return 0LL;
+  }
+
+  auto offsets = std::vector<std::int64_t>{};
+  const auto step = std::max<std::size_t>(1U, source.mSamples.size() / kMaxClockSamples);
+  auto entry = std::optional<Entry>{};
+  for(auto sample = std::size_t{0}; sample < source.mSamples.size(); sample += step)
+  {
+    const auto& [instant, position] = source.mSamples.at(sample);
+    if(isMergeable(source, position, entry))
+    {
+      offsets.push_back(instant - key(*entry));
+    }
+  }
+  if(offsets.empty())
+  {
+    return 0LL;
+  }
+
+  const auto median = offsets.begin() + static_cast<std::ptrdiff_t>(offsets.size() / 2U);
+  std::ranges::nth_element(offsets, median);
+  return *median;
+}
+
+/// The largest roll id of each channel of @p source, on disk or referenced by its timeline.
+std::unordered_map<ChannelId, std::uint64_t> findLastRollIds(const Source& source)
+{
+  auto lastRollIds = std::unordered_map<ChannelId, std::uint64_t>{};
+  const auto raise = [&lastRollIds](const ChannelId channelId, const std::uint64_t rollId)
+  {
+    auto& lastRollId = lastRollIds.try_emplace(channelId, rollId).first->second;
+    lastRollId = std::max(lastRollId, rollId);
+  };
+
+  for(const auto& entry: source.mEntries)
+  {
+    if(isCommitted(entry))
+    {
+      raise(entry.mChannelId, entry.mRollId);
+    }
+  }
+  for(const auto& directoryEntry: fs::directory_iterator{source.mRoot})
+  {
+    if(not directoryEntry.is_directory())
+    {
+      continue;
+    }
+    try
+    {
+      const auto channelId = ChannelId{
+          common::fromHexString<std::uint64_t>(directoryEntry.path().filename().string())};
+      for(const auto& file: fs::directory_iterator{directoryEntry.path()})
+      {
+        if(const auto rollId = parseRollName(file.path().filename().string()))
+        {
+          raise(channelId, *rollId);
+        }
+      }
+    }
+    catch(const std::logic_error&)
+    {
+      logger::warn("Skipping {}: not a channel directory.", directoryEntry.path().string());
+    }
+  }
+  return lastRollIds;
+}
+
+/// Link every roll of @p source into @p destination, renumbered by the source's roll id bases.
+void linkRolls(const Source& source, const fs::path& destination)
+{
+  for(const auto& [channelId, rollIdBase]: source.mRollIdBase)
+  {
+    const auto channelName = common::hexString(channelId.mValue);
+    const auto sourceDir = source.mRoot / channelName;
+    if(not fs::is_directory(sourceDir))
+    {
+      continue;
+    }
+
+    const auto destinationDir = destination / channelName;
+    fs::create_directories(destinationDir);
+    for(const auto& file: fs::directory_iterator{sourceDir})
+    {
+      const auto name = file.path().filename().string();
+      const auto rollId = parseRollName(name);
+      if(not rollId or name.ends_with(kTemporaryFileSuffix))
+      {
+        continue;
+      }
+      auto target = destinationDir / buildRollName(rollIdBase + *rollId);
+      if(name.ends_with(kCompressedRollSuffix))
+      {
+        target += kCompressedRollSuffix;
+      }
+      linkRoll(file.path(), target);
+    }
+  }
+}
+
+/// Move @p source past its next record, to the next one there is to merge; the record is left in
+/// @p entry, or empty once the source is exhausted. Counts the records skipped in @p lost.
+void advance(Source& source, std::optional<Entry>& entry, std::uint64_t& lost)
+{
+  entry.reset();
+  while(source.mNext < source.mEntries.size())
+  {
+    const auto position = source.mNext;
+    if(isMergeable(source, position, entry))
+    {
+      return;
+    }
+    lost += isCommitted(source.mEntries.at(position)) ? 1ULL : 0ULL;
+    ++source.mNext;
+  }
+  entry.reset();
+}
+
+} // namespace
+
+void merge(
+    const std::vector<std::filesystem::path>& sources,
+    const std::filesystem::path& destination,
+    const MergeKey& key)
+{
+  if(fs::exists(destination))
+  {
+    static_cast<void>(common::requireEmptyDirectory(destination));
+  }
+
+  auto merged = std::vector<Source>{};
+  merged.reserve(sources.size());
+  for(const auto& sourceRoot: sources)
+  {
+    auto& source = merged.emplace_back();
+    source.mRoot = common::requireExistingDirectory(sourceRoot);
+    source.mReader = std::make_unique<Reader>(source.mRoot);
+    if(const auto shardCount = countShards(source.mRoot); shardCount > 0ULL)
+    {
+      loadShards(source, shardCount);
+    }
+    else
+    {
+      loadTimeline(source);
+    }
+    source.mClockOffset = estimateClockOffset(source, key);
+  }
+
+  // Each channel's rolls are numbered source after source, so no two sources' rolls collide.
+  auto nextRollIds = std::unordered_map<ChannelId, std::uint64_t>{};
+  auto total = std::uint64_t{0ULL};
+  for(auto& source: merged)
+  {
+    for(const auto& [channelId, lastRollId]: findLastRollIds(source))
+    {
+      auto& nextRollId = nextRollIds[channelId];
+      source.mRollIdBase.emplace(channelId, nextRollId);
+      nextRollId += lastRollId + 1ULL;
+    }
+    total += source.mEntries.size();
+  }
+
+  fs::create_directories(destination);
+  writeFormat(destination);
+  for(const auto& source: merged)
+  {
+    linkRolls(source, destination);
+  }
+
+  const auto recordsChecksums = [](const Source& source)
+  { return source.mReader->hasChecksums(); };
+  const auto checksummed = std::ranges::all_of(
+      merged,
+      [&recordsChecksums](const Source& source)
+      { return recordsChecksums(source) and source.mChecksums.size() == source.mEntries.size(); });
+  if(not checksummed and std::ranges::any_of(merged, recordsChecksums))
+  {
+    logger::warn(
+        "Merging into {} without checksums: a source's fall short of its timeline, or it has none.",
+        destination.string());
+  }
+  const auto stride = Timeline::kDefaultTimeIndexStride;
+  auto timeline = std::optional<containers::MmapArray<TimelineEntry>>{};
+  auto timeIndex = std::optional<containers::MmapArray<TimeIndexEntry>>{};
+  auto checksums = std::optional<containers::MmapArray<std::uint32_t>>{};
+  if(total > 0ULL)
+  {
+    timeline.emplace(destination / kTimelineFileName, total);
+    timeIndex.emplace(destination / kTimeIndexFileName, ((total - 1ULL) / stride) + 1ULL);
+    if(checksummed)
+    {
+      checksums.emplace(destination / kChecksumsFileName, total);
+    }
+  }
+
+  // A min-heap of each source's next record, by its aligned key; ties go to the earlier source.
+  using Head = std::pair<std::int64_t, std::size_t>;
+  auto heads = std::priority_queue<Head, std::vector<Head>, std::greater<>>{};
+  auto entries = std::vector<std::optional<Entry>>(merged.size());
+  auto lost = std::uint64_t{0ULL};
+  const auto push = [&](const std::size_t index)
+  {
+    advance(merged.at(index), entries.at(index), lost);
+    if(entries.at(index))
+    {
+      heads.emplace(key(*entries.at(index)) + merged.at(index).mClockOffset, index);
+    }
+  };
+  for(auto index = std::size_t{0}; index < merged.size(); ++index)
+  {
+    push(index);
+  }
+
+  auto length = std::uint64_t{0ULL};
+  auto latest = std::numeric_limits<std::int64_t>::min();
+  while(not heads.empty())
+  {
+    const auto [instant, index] = heads.top();
+    heads.pop();
+    auto& source = merged.at(index);
+    const auto& entry = source.mEntries.at(source.mNext);
+
+    (*timeline)[length] = TimelineEntry{
+        .mChannelId = entry.mChannelId,
+        .mRollId = source.mRollIdBase.at(entry.mChannelId) + entry.mRollId,
+        .mOffset = entry.mOffset,
+        .mSize = entry.mSize,
+        .mCommitted = kCommitted};
+    if(checksums)
+    {
+      (*checksums)[length] = source.mChecksums.at(source.mNext);
+    }
+
+    // Each source keeps its own order, so the keys may step back; the samples must not.
+    latest = std::max(latest, instant);
+    if(length % stride == 0ULL)
+    {
+      (*timeIndex)[length / stride] =
+          TimeIndexEntry{.mTimestamp = latest, .mEntryInTimeline = length};
+    }
+    ++length;
+
+    ++source.mNext;
+    push(index);
+  }
+
+  if(timeline)
+  {
+    // Records lost to retention leave the files longer than the merged timeline.
+    timeline->resize(length);
+    timeline->sync();
+    timeIndex->resize(length == 0ULL ? 0ULL : ((length - 1ULL) / stride) + 1ULL);
+    timeIndex->sync();
+    if(checksums)
+    {
+      checksums->resize(length);
+      checksums->sync();
+    }
+  }
+  if(lost > 0ULL)
+  {
+    logger::warn("Left {} records out of the merge: their rolls are gone.", lost);
+  }
+  logger::info(
+      "Merged {} records of {} chronicles into {}.",
+      length,
+      merged.size(),
+      destination.string());
+
+  buildChannelIndices(destination);
+}
+
+} // namespace nioc::chronicle
@@ -0,0 +1,131 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <nioc/chronicle/parallelScan.hpp>
+#include <nioc/chronicle/reader.hpp>
+#include <nioc/common/filesystem.hpp>
+#include <optional>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace nioc::chronicle
+{
+namespace
+{
+
+/// Open a Reader over @p logRoot, restricted to @p channelIds when given. Reader is not movable, so
+/// it is built in place.
+void openReader(
+    std::optional<Reader>& reader,
+    const std::filesystem::path& logRoot,
+    const std::optional<std::unordered_set<ChannelId>>& channelIds)
+{
+  if(channelIds)
+  {
+    reader.emplace(logRoot, *channelIds);
+  }
+  else
+  {
+    reader.emplace(logRoot);
+  }
+}
+
+} // namespace
+
+ParallelScan::ParallelScan(std::filesystem::path logRoot, const std::size_t workerCount):
+  ParallelScan{std::move(logRoot), std::nullopt, workerCount}
+{
+}
+
+ParallelScan::ParallelScan(
+    std::filesystem::path logRoot,
+    std::unordered_set<ChannelId> channelIds,
+    const std::size_t workerCount):
+  ParallelScan{std::move(logRoot), std::optional{std::move(channelIds)}, workerCount}
+{
+}
+
+ParallelScan::ParallelScan(
+    std::filesystem::path logRoot,
+    std::optional<std::unordered_set<ChannelId>> channelIds,
+    const std::size_t workerCount):
+  mLogRoot{common::requireExistingDirectory(std::move(logRoot))},
+  mChannelIds{std::move(channelIds)}
+{
+  auto reader = std::optional<Reader>{};
+  openReader(reader, mLogRoot, mChannelIds);
+  mRecordCount = reader->entries().size();
+
+  const auto workers =
+      workerCount > 0 ? workerCount : std::size_t{std::max(std::thread::hardware_concurrency(), 1U)};
+  mShardCount = static_cast<std::size_t>(std::min<std::uint64_t>(workers, mRecordCount));
+}
+
+std::uint64_t ParallelScan::size() const noexcept
+{
+  return mRecordCount;
+}
+
+std::size_t ParallelScan::shardCount() const noexcept
+{
+  return mShardCount;
+}
+
+std::uint64_t ParallelScan::shardBegin(const std::size_t shardIndex) const noexcept
+{
+  // Balanced split: shard sizes differ by at most one record.
+  return mShardCount == 0U ? 0ULL : mRecordCount * shardIndex / mShardCount;
+}
+
+void ParallelScan::forEachShard(const std::function<void(std::size_t, Shard)>& visit) const
+{
+  auto failures = std::vector<std::exception_ptr>(mShardCount);
+  {
+    auto workers = std::vector<std::jthread>{};
+    workers.reserve(mShardCount);
+
+    for(auto shardIndex = std::size_t{0}; shardIndex < mShardCount; ++shardIndex)
+    {
+      workers.emplace_back(
+          [this, &visit, &failures, shardIndex]
+          {
+            try
+            {
+              // Each worker maps the chronicle on its own: the Reader's roll cache is not
+              // thread-safe, and the mappings themselves are shared by the kernel anyway.
+              auto reader = std::optional<Reader>{};
+              openReader(reader, mLogRoot, mChannelIds);
+              const auto entries = reader->entries();
+
+              const auto first = static_cast<std::ptrdiff_t>(shardBegin(shardIndex));
+              const auto last = static_cast<std::ptrdiff_t>(shardBegin(shardIndex + 1U));
+              visit(shardIndex, Shard{entries.begin() + first, entries.begin() + last});
+            }
+            catch(...)
+            {
+              failures.at(shardIndex) = std::current_exception();
+            }
+          });
+    }
+  } // Joins every worker.
+
+  for(const auto& failure: failures)
+  {
+    if(failure)
+    {
+      std::rethrow_exception(failure);
+    }
+  }
+}
+
+} // namespace nioc::chronicle
@@ -5,18 +5,53 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "utils.hpp"
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
 #include <iterator>
+#include <map>
+#include <memory>
+#include <nioc/chronicle/checksum.hpp>
 #include <nioc/chronicle/reader.hpp>
+#include <nioc/common/exception.hpp>
 #include <nioc/common/filesystem.hpp>
 #include <nioc/common/utils.hpp>
+#include <nioc/logger/logger.hpp>
 #include <optional>
 #include <span>
+#include <stdexcept>
 #include <system_error>
+#include <thread>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 namespace nioc::chronicle
 {
+namespace
+{
+
+/// Close the rolls in @p open furthest from @p rollId until two remain. The one just opened and
+/// the one before or after it, which the cursor and read-ahead are using, stay open.
+template<typename OpenRoll>
+void closeFurthest(
+    std::map<std::uint64_t, std::unique_ptr<OpenRoll>>& open,
+    const std::uint64_t rollId)
+{
+  const auto distance = [rollId](const std::uint64_t other)
+  { return other > rollId ? other - rollId : rollId - other; };
+  while(open.size() > 2)
+  {
+    const auto last = std::prev(open.end());
+    open.erase(distance(open.begin()->first) > distance(last->first) ? open.begin() : last);
+  }
+}
+
+} // namespace
 
 const Entry& Reader::Iterator::operator*() const noexcept
 {
@@ -58,36 +93,734 @@ std::default_sentinel_t Reader::end() noexcept
   return {};
 }
 
-Reader::Reader(std::filesystem::path logRoot):
+Entry Reader::Entries::Iterator::operator*() const
+{
+  return mReader->loadEntry(static_cast<std::uint64_t>(mPosition));
+}
+
+Entry Reader::Entries::Iterator::operator[](const difference_type offset) const
+{
+  return *(*this + offset);
+}
+
+Reader::Entries::Iterator& Reader::Entries::Iterator::operator++() noexcept
+{
+  ++mPosition;
+  return *this;
+}
+
+Reader::Entries::Iterator Reader::Entries::Iterator::operator++(int) noexcept
+{
+  auto previous = *this;
+  ++mPosition;
+  return previous;
+}
+
+Reader::Entries::Iterator& Reader::Entries::Iterator::operator--() noexcept
+{
+  --mPosition;
+  return *this;
+}
+
+Reader::Entries::Iterator Reader::Entries::Iterator::operator--(int) noexcept
+{
+  auto previous = *this;
+  --mPosition;
+  return previous;
+}
+
+Reader::Entries::Iterator& Reader::Entries::Iterator::operator+=(
+    const difference_type offset) noexcept
+{
+  mPosition += offset;
+  return *this;
+}
+
+Reader::Entries::Iterator& Reader::Entries::Iterator::operator-=(
+    const difference_type offset) noexcept
+{
+  mPosition -= offset;
+  return *this;
+}
+
+Reader::Entries::Iterator operator+(
+    Reader::Entries::Iterator iterator,
+    const Reader::Entries::Iterator::difference_type offset) noexcept
+{
+  return iterator += offset;
+}
+
+Reader::Entries::Iterator operator+(
+    const Reader::Entries::Iterator::difference_type offset,
+    Reader::Entries::Iterator iterator) noexcept
+{
+  return iterator += offset;
+}
+
+Reader::Entries::Iterator operator-(
+    Reader::Entries::Iterator iterator,
+    const Reader::Entries::Iterator::difference_type offset) noexcept
+{
+  return iterator -= offset;
+}
+
+Reader::Entries::Iterator::difference_type operator-(
+    const Reader::Entries::Iterator& lhs,
+    const Reader::Entries::Iterator& rhs) noexcept
+{
+  return lhs.mPosition - rhs.mPosition;
+}
+
+Reader::Entries::Iterator::Iterator(Reader& reader, const difference_type position) noexcept:
+  mReader{&reader},
+  mPosition{position}
+{
+}
+
+Reader::Entries::Iterator Reader::Entries::begin() const noexcept
+{
+  return mReader ? Iterator{*mReader, 0} : Iterator{};
+}
+
+Reader::Entries::Iterator Reader::Entries::end() const noexcept
+{
+  if(not mReader)
+  {
+    return Iterator{};
+  }
+  return Iterator{*mReader, static_cast<Iterator::difference_type>(mReader->recordCount())};
+}
+
+Reader::Entries::Entries(Reader& reader) noexcept: mReader{&reader} {}
+
+Reader::Iterator Reader::seek(const std::chrono::system_clock::time_point instant)
+{
+  auto entryInTimeline = std::uint64_t{0ULL};
+  const auto timestamp =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(instant.time_since_epoch()).count();
+
+  // A sharded timeline's samples carry the keys its shards merged by, which never decrease along
+  // the merged order, just as a single-file timeline's samples never decrease along it.
+  auto samples = std::span<const TimeIndexEntry>{mOwnMergedSamples};
+  if(mTimeIndexFile)
+  {
+    samples = std::span{mTimeIndexFile->data(), mTimeIndexLength};
+  }
+
+  // The first sample at or after the instant bounds the target from above, and the sample before
+  // it was committed earlier than the instant. Every record from just past that earlier sample is
+  // therefore a candidate, and the stride bounds how many of them precede the target.
+  const auto firstAtOrAfter =
+      std::ranges::lower_bound(samples, timestamp, {}, &TimeIndexEntry::mTimestamp);
+  if(firstAtOrAfter != samples.begin())
+  {
+    const auto& before = *std::prev(firstAtOrAfter);
+    entryInTimeline = before.mEntryInTimeline + 1ULL;
+
+    // Past the sample, every entry's key is its stamp floored by the sample's key and by the keys
+    // of its shard's entries since, so stepping on until one reaches the instant lands exactly. The
+    // next sample's key reaches it, so this steps over fewer entries than the stride.
+    if(not mMergedOrder.empty())
+    {
+      auto floors = std::vector<std::int64_t>(mShardFiles.size(), before.mTimestamp);
+      for(; entryInTimeline < mTimelineLength; ++entryInTimeline)
+      {
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-avoid-unchecked-container-access): merged.
+        const auto shardPosition = mMergedOrder[entryInTimeline];
+        const auto& shard = *mShardFiles[shardOf(shardPosition)];
+        // NOLINTEND(cppcoreguidelines-pro-bounds-avoid-unchecked-container-access)
+        auto& floor = floors.at(shardOf(shardPosition));
+        floor = std::max(floor, shard[indexInShard(shardPosition)].mTimestamp);
+        if(floor >= timestamp)
+        {
+          break;
+        }
+      }
+    }
+  }
+
+  // The samples of discarded entries read as zero, so a seek may land among them.
+  entryInTimeline = std::max(entryInTimeline, mDiscarded);
+
+  resetReadAhead();
+  mNextRecord = mSelection ? static_cast<std::uint64_t>(std::distance(
+                                 mSelection->begin(),
+                                 std::ranges::lower_bound(*mSelection, entryInTimeline)))
+                           : entryInTimeline;
+
+  return begin();
+}
+
+Reader::Reader(std::filesystem::path logRoot): Reader{std::move(logRoot), true} {}
+
+Reader::Reader(std::filesystem::path logRoot, const bool mapTimeline):
   mLogRoot{common::requireExistingDirectory(std::move(logRoot))}
 {
-  // Map the single timeline file if the chronicle recorded anything. A missing or empty (trimmed,
-  // never-written) file is a chronicle that recorded nothing - replay nothing.
-  const auto timelinePath = mLogRoot / kTimelineFileName;
-  auto errorCode = std::error_code{};
-  if(const auto byteCount = std::filesystem::file_size(timelinePath, errorCode);
-     not errorCode and byteCount > 0)
+  if(not mapTimeline)
   {
-    mTimelineFile = std::make_unique<const TimelineFile>(timelinePath);
+    return;
+  }
+  requireFormat(mLogRoot);
+
+  auto untrimmed = false;
+  if(const auto shardCount = countShards(mLogRoot); shardCount > 0ULL)
+  {
+    mShardFiles = mapShards<ShardFile>(mLogRoot, kTimelineShardStem, shardCount);
+    mShardChecksumFiles = mapShards<ChecksumFile>(mLogRoot, kChecksumsShardStem, shardCount);
+    mHasChecksums = std::filesystem::exists(mLogRoot / buildShardName(kChecksumsShardStem, 0ULL));
+
+    const auto committed = committedShards(mShardFiles);
+    auto committedCount = std::uint64_t{0ULL};
+    for(auto shard = std::size_t{0}; shard < committed.size(); ++shard)
+    {
+      const auto& file = mShardFiles.at(shard);
+      untrimmed = untrimmed or (file and committed.at(shard).size() < file->size());
+      committedCount += committed.at(shard).size();
+    }
+
+    // The merge skips the holes a crash left, so the written order may be shorter than the shards.
+    mMergedOrderFile = mapIfRecorded<MergedOrderFile>(mLogRoot / kMergedOrderFileName);
+    if(mMergedOrderFile and mMergedOrderFile->size() <= committedCount)
+    {
+      mMergedOrder = std::span{mMergedOrderFile->data(), mMergedOrderFile->size()};
+      mTimeIndexFile = mapIfRecorded<TimeIndexFile>(mLogRoot / kTimeIndexFileName);
+    }
+    else
+    {
+      mMergedOrderFile.reset();
+      auto merged = mergeShards(committed);
+      mOwnMergedOrder = std::move(merged.mOrder);
+      mOwnMergedSamples = std::move(merged.mSamples);
+      mMergedOrder = mOwnMergedOrder;
+    }
+    mTimelineLength = mMergedOrder.size();
+    mTimeIndexLength =
+        mTimeIndexFile
+            ? sampledLength({mTimeIndexFile->data(), mTimeIndexFile->size()}, mTimelineLength)
+            : 0ULL;
+  }
+  else
+  {
+    mTimelineFile = mapIfRecorded<TimelineFile>(mLogRoot / kTimelineFileName);
+    mTimeIndexFile = mapIfRecorded<TimeIndexFile>(mLogRoot / kTimeIndexFileName);
+    mDiscarded = discardedLength(mLogRoot);
+    mTimelineLength =
+        mTimelineFile ? committedLength({mTimelineFile->data(), mTimelineFile->size()}, mDiscarded)
+                      : 0ULL;
+    mTimeIndexLength =
+        mTimeIndexFile
+            ? sampledLength({mTimeIndexFile->data(), mTimeIndexFile->size()}, mTimelineLength)
+            : 0ULL;
+    mHasChecksums = std::filesystem::exists(mLogRoot / kChecksumsFileName);
+    mChecksumFile = mapIfRecorded<ChecksumFile>(mLogRoot / kChecksumsFileName);
+    untrimmed = mTimelineFile and mTimelineLength < mTimelineFile->size();
+  }
+
+  if(untrimmed)
+  {
+    logger::warn(
+        "The timeline of {} was not trimmed; replaying its {} committed entries. Run recover() to "
+        "trim it.",
+        mLogRoot.string(),
+        mTimelineLength);
   }
 }
 
+Reader::Reader(std::filesystem::path logRoot, const std::unordered_set<ChannelId>& channelIds):
+  Reader{std::move(logRoot)}
+{
+  mSelection = selectRecords(channelIds);
+}
+
 Reader::~Reader() = default;
 
+Reader::Entries Reader::entries() noexcept
+{
+  return Entries{*this};
+}
+
+Entry Reader::at(const std::uint64_t index)
+{
+  if(index >= recordCount())
+  {
+    common::throwException<std::out_of_range>(
+        "Index {} is out of range for a replay of {} entries.",
+        index,
+        recordCount());
+  }
+  return loadEntry(index);
+}
+
+Entry Reader::head(const std::uint64_t index, const std::uint64_t length)
+{
+  if(index >= recordCount())
+  {
+    common::throwException<std::out_of_range>(
+        "Index {} is out of range for a replay of {} entries.",
+        index,
+        recordCount());
+  }
+
+  auto entry = timelineEntry(index);
+  entry.mSize = std::min(entry.mSize, length);
+  return loadEntry(entry);
+}
+
+std::vector<std::uint64_t> Reader::selectRecords(
+    const std::unordered_set<ChannelId>& channelIds) const
+{
+  auto selection = std::vector<std::uint64_t>{};
+  if(mTimelineLength == 0ULL)
+  {
+    return selection;
+  }
+
+  for(const auto channelId: channelIds)
+  {
+    const auto channelDir = mLogRoot / common::hexString(channelId.mValue);
+    if(not std::filesystem::is_directory(channelDir))
+    {
+      continue; // Never written: nothing to select.
+    }
+
+    const auto indexPath = channelDir / kChannelIndexFileName;
+    if(not std::filesystem::exists(indexPath))
+    {
+      logger::warn(
+          "Channel {} in {} has no entry index; scanning the whole timeline instead.",
+          common::hexString(channelId.mValue),
+          mLogRoot.string());
+
+      selection.clear();
+      for(auto position = mDiscarded; position < mTimelineLength; ++position)
+      {
+        if(channelIds.contains(entryAt(position).mChannelId))
+        {
+          selection.push_back(position);
+        }
+      }
+      return selection;
+    }
+
+    if(const auto index = mapIfRecorded<ChannelIndexFile>(indexPath))
+    {
+      // The positions of discarded entries read as zero, sorted ahead of the rest.
+      const auto middle = static_cast<std::ptrdiff_t>(selection.size());
+      selection.insert(
+          selection.end(),
+          std::ranges::lower_bound(*index, mDiscarded),
+          index->end());
+      std::ranges::inplace_merge(selection, std::next(selection.begin(), middle));
+    }
+  }
+
+  return selection;
+}
+
+std::uint64_t Reader::recordCount() const noexcept
+{
+  if(mSelection)
+  {
+    return mSelection->size();
+  }
+  return mTimelineLength;
+}
+
+std::uint64_t Reader::timelinePosition(const std::uint64_t index) const noexcept
+{
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-avoid-unchecked-container-access): caller checks.
+  return mSelection ? (*mSelection)[index] : index;
+}
+
+const TimelineEntry& Reader::entryAt(const std::uint64_t position) const noexcept
+{
+  if(mMergedOrder.empty())
+  {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-avoid-unchecked-container-access): caller checks.
+    return (*mTimelineFile)[position];
+  }
+
+  // NOLINTBEGIN(cppcoreguidelines-pro-bounds-avoid-unchecked-container-access): caller checks.
+  const auto shardPosition = mMergedOrder[position];
+  return (*mShardFiles[shardOf(shardPosition)])[indexInShard(shardPosition)].mEntry;
+  // NOLINTEND(cppcoreguidelines-pro-bounds-avoid-unchecked-container-access)
+}
+
+const TimelineEntry& Reader::timelineEntry(const std::uint64_t index) const noexcept
+{
+  return entryAt(timelinePosition(index));
+}
+
+Entry Reader::loadEntry(const std::uint64_t index)
+{
+  return loadEntry(timelineEntry(index));
+}
+
+Entry Reader::loadEntry(const TimelineEntry& entry)
+{
+  if(isLost(entry))
+  {
+    return Entry{.mChannelId = entry.mChannelId, .mCrate = Crate{}};
+  }
+
+  if(auto* const compressed = acquireCompressedRoll(entry.mChannelId, entry.mRollId))
+  {
+    return Entry{
+        .mChannelId = entry.mChannelId,
+        .mCrate = compressed->read(entry.mOffset, entry.mSize)};
+  }
+
+  if(auto* const windowed = acquireWindowedRoll(entry.mChannelId, entry.mRollId))
+  {
+    auto slice = windowed->slice(entry.mOffset, entry.mSize);
+    return Entry{
+        .mChannelId = entry.mChannelId,
+        .mCrate = Crate{std::move(slice.mWindow), slice.mElements}};
+  }
+
+  auto roll = acquireRoll(entry.mChannelId, entry.mRollId);
+  const auto span = std::span{*roll}.subspan(entry.mOffset, entry.mSize);
+
+  return Entry{.mChannelId = entry.mChannelId, .mCrate = Crate{std::move(roll), span}};
+}
+
+bool Reader::isLost(const TimelineEntry& entry)
+{
+  if(not isCommitted(entry))
+  {
+    return true;
+  }
+
+  const auto [firstSurviving, first] = mFirstSurvivingRolls.try_emplace(entry.mChannelId, 0ULL);
+  if(first)
+  {
+    auto errorCode = std::error_code{};
+    auto rollId = std::optional<std::uint64_t>{};
+    for(const auto& file: std::filesystem::directory_iterator{
+            mLogRoot / common::hexString(entry.mChannelId.mValue),
+            errorCode})
+    {
+      if(const auto parsed = parseRollName(file.path().filename().string()))
+      {
+        rollId = std::min(rollId.value_or(*parsed), *parsed);
+      }
+    }
+    firstSurviving->second = rollId.value_or(0ULL);
+  }
+  return entry.mRollId < firstSurviving->second;
+}
+
+bool Reader::matchesChecksum(const std::uint64_t position, const Crate& crate) const noexcept
+{
+  // NOLINTBEGIN(cppcoreguidelines-pro-bounds-avoid-unchecked-container-access): checked below.
+  const auto* checksums = mChecksumFile.get();
+  auto checksumPosition = position;
+  if(not mMergedOrder.empty())
+  {
+    const auto shardPosition = mMergedOrder[position];
+    checksums = mShardChecksumFiles[shardOf(shardPosition)].get();
+    checksumPosition = indexInShard(shardPosition);
+  }
+
+  if(not checksums or checksumPosition >= checksums->size())
+  {
+    return true;
+  }
+  return crc32c(crate.span()) == (*checksums)[checksumPosition];
+  // NOLINTEND(cppcoreguidelines-pro-bounds-avoid-unchecked-container-access)
+}
+
 std::optional<Entry> Reader::readNextEntry()
 {
-  if(not mTimelineFile or mEntryInTimeline >= mTimelineFile->size())
+  while(mNextRecord < recordCount())
+  {
+    const auto index = mNextRecord++;
+    if(isLost(timelineEntry(index)))
+    {
+      continue;
+    }
+
+    if(mReadAhead.mEntryCount > 0ULL)
+    {
+      readAhead(index);
+    }
+
+    auto entry = loadEntry(index);
+    if(mVerifyChecksums and not matchesChecksum(timelinePosition(index), entry.mCrate))
+    {
+      logger::error(
+          "Skipping record {} of {}: its bytes do not match their checksum.",
+          timelinePosition(index),
+          mLogRoot.string());
+      continue;
+    }
+    return entry;
+  }
+
+  return std::nullopt;
+}
+
+void Reader::setReadAhead(const ReadAhead& readAhead) noexcept
+{
+  mReadAhead = readAhead;
+  resetReadAhead();
+}
+
+void Reader::setRollWindows(const RollWindows& rollWindows) noexcept
+{
+  mRollWindows = rollWindows;
+  mWindowedRolls.clear();
+  resetReadAhead();
+}
+
+bool Reader::hasChecksums() const noexcept
+{
+  return mHasChecksums;
+}
+
+void Reader::setChecksumVerification(const bool enabled) noexcept
+{
+  mVerifyChecksums = enabled;
+}
+
+std::vector<std::uint64_t> Reader::verify(const std::size_t workerCount) const
+{
+  if(not mHasChecksums)
+  {
+    common::throwException<std::runtime_error>(
+        "The chronicle in {} was recorded without checksums.",
+        mLogRoot.string());
+  }
+
+  const auto recordTotal = recordCount();
+  const auto hardwareThreads = std::size_t{std::thread::hardware_concurrency()};
+  const auto workers = workerCount > 0 ? workerCount : std::max(std::size_t{1}, hardwareThreads);
+  const auto shardCount = static_cast<std::size_t>(
+      std::min<std::uint64_t>(workers, std::max<std::uint64_t>(recordTotal, 1ULL)));
+
+  auto corrupt = std::vector<std::vector<std::uint64_t>>(shardCount);
+  auto failures = std::vector<std::exception_ptr>(shardCount);
+  {
+    auto threads = std::vector<std::jthread>{};
+    threads.reserve(shardCount);
+    for(auto shard = std::size_t{0}; shard < shardCount; ++shard)
+    {
+      threads.emplace_back(
+          [this, recordTotal, shardCount, shard, &corrupt, &failures]()
+          {
+            try
+            {
+              // Rolls are mapped through each Reader's own cache, which is not thread-safe, so
+              // every worker opens its own Reader to load the entries this one looks up.
+              auto reader = Reader{mLogRoot, false};
+              reader.mRollWindows = mRollWindows;
+              const auto first = recordTotal * shard / shardCount;
+              const auto last = recordTotal * (shard + 1) / shardCount;
+              for(auto index = first; index < last; ++index)
+              {
+                const auto& entry = timelineEntry(index);
+                if(reader.isLost(entry))
+                {
+                  continue;
+                }
+                const auto position = timelinePosition(index);
+                if(not matchesChecksum(position, reader.loadEntry(entry).mCrate))
+                {
+                  corrupt.at(shard).push_back(position);
+                }
+              }
+            }
+            catch(...)
+            {
+              failures.at(shard) = std::current_exception();
+            }
+          });
+    }
+  }
+
+  for(const auto& failure: failures)
+  {
+    if(failure)
+    {
+      std::rethrow_exception(failure);
+    }
+  }
+
+  auto positions = std::vector<std::uint64_t>{};
+  for(const auto& shard: corrupt)
+  {
+    positions.insert(positions.end(), shard.begin(), shard.end());
+  }
+  return positions;
+}
+
+void Reader::readAhead(const std::uint64_t index)
+{
+  const auto& replayed = timelineEntry(index);
+  if(index < mPrefetchedUntil)
+  {
+    mPrefetchedBytes -= std::min(mPrefetchedBytes, replayed.mSize);
+  }
+  else
   {
-    return std::nullopt;
+    // Nothing ahead of the cursor is prefetched: it just started, or the window held it back.
+    mPrefetchedBytes = 0ULL;
+    mPrefetchedUntil = index + 1ULL;
   }
 
-  const auto& timelineEntry = mTimelineFile->at(mEntryInTimeline);
-  ++mEntryInTimeline;
+  // The cursor has moved on to a later roll of this channel, so it will not read the earlier one
+  // again: drop its pages from the mapping, if it is still mapped at all.
+  const auto [replayedRoll, first] =
+      mReplayedRolls.try_emplace(replayed.mChannelId, replayed.mRollId);
+  if(not first and replayedRoll->second != replayed.mRollId)
+  {
+    if(const auto left = mRollCache[replayed.mChannelId][replayedRoll->second].lock())
+    {
+      left->advise(0, left->size(), containers::Advice::DontNeed);
+    }
+    const auto& windowedRolls = mWindowedRolls[replayed.mChannelId];
+    if(const auto left = windowedRolls.find(replayedRoll->second); left != windowedRolls.end())
+    {
+      left->second->advise(0, left->second->size(), containers::Advice::DontNeed);
+    }
+    replayedRoll->second = replayed.mRollId;
+  }
+
+  // Advise in generous chunks so that a channel of small records costs one call per chunk, not one
+  // per record. A chunk may run past the byte window by at most its own size.
+  constexpr auto kAdviceGranularity = std::uint64_t{256ULL * 1024ULL};
+
+  const auto horizon =
+      std::min<std::uint64_t>(recordCount(), index + 1ULL + mReadAhead.mEntryCount);
+  for(; mPrefetchedUntil < horizon; ++mPrefetchedUntil)
+  {
+    const auto& upcoming = timelineEntry(mPrefetchedUntil);
+    if(isLost(upcoming))
+    {
+      continue;
+    }
+    if(mPrefetchedBytes > 0ULL and mPrefetchedBytes + upcoming.mSize > mReadAhead.mWindowBytes)
+    {
+      break;
+    }
+    mPrefetchedBytes += upcoming.mSize;
 
-  auto roll = acquireRoll(timelineEntry.mChannelId, timelineEntry.mRollId);
-  const auto span = std::span{*roll}.subspan(timelineEntry.mOffset, timelineEntry.mSize);
+    // A compressed roll is prefetched by its blocks' compressed bytes; decoding waits for replay.
+    // A roll mapped a window at a time is prefetched through the page cache, mapping nothing.
+    auto& prefetched = mPrefetchedRolls[upcoming.mChannelId];
+    auto* const compressed = acquireCompressedRoll(upcoming.mChannelId, upcoming.mRollId);
+    auto* const windowed =
+        compressed ? nullptr : acquireWindowedRoll(upcoming.mChannelId, upcoming.mRollId);
+    const auto mappedWhole = not compressed and not windowed;
+    if(prefetched.mRollId != upcoming.mRollId or (mappedWhole and not prefetched.mRoll))
+    {
+      prefetched = PrefetchedRoll{
+          .mRollId = upcoming.mRollId,
+          .mRoll = mappedWhole ? acquireRoll(upcoming.mChannelId, upcoming.mRollId) : nullptr,
+          .mAdvisedEnd = 0ULL};
+      if(prefetched.mRoll)
+      {
+        prefetched.mRoll->advise(0, prefetched.mRoll->size(), containers::Advice::Sequential);
+      }
+      else if(windowed)
+      {
+        windowed->advise(0, windowed->size(), containers::Advice::Sequential);
+      }
+    }
+
+    const auto end = upcoming.mOffset + upcoming.mSize;
+    if(end > prefetched.mAdvisedEnd)
+    {
+      const auto begin = std::max(upcoming.mOffset, prefetched.mAdvisedEnd);
+      const auto advisedEnd = std::max(end, begin + kAdviceGranularity);
+      if(compressed)
+      {
+        compressed->advise(begin, advisedEnd - begin, containers::Advice::WillNeed);
+      }
+      else if(windowed)
+      {
+        windowed->advise(begin, advisedEnd - begin, containers::Advice::WillNeed);
+      }
+      else
+      {
+        prefetched.mRoll->advise(begin, advisedEnd - begin, containers::Advice::WillNeed);
+      }
+      prefetched.mAdvisedEnd = advisedEnd;
+    }
+  }
+}
+
+void Reader::resetReadAhead() noexcept
+{
+  mPrefetchedUntil = 0ULL;
+  mPrefetchedBytes = 0ULL;
+  mPrefetchedRolls.clear();
+  mReplayedRolls.clear();
+}
+
+CompressedRoll* Reader::acquireCompressedRoll(const ChannelId channelId, const std::uint64_t rollId)
+{
+  auto& open = mCompressedRolls[channelId];
+  if(const auto found = open.find(rollId); found != open.end())
+  {
+    return found->second.get();
+  }
+
+  // A roll already mapped as written is read that way, even if it has been compressed since.
+  auto& rollCache = mRollCache[channelId];
+  if(const auto cached = rollCache.find(rollId);
+     cached != rollCache.end() and not cached->second.expired())
+  {
+    return nullptr;
+  }
+  if(mWindowedRolls[channelId].contains(rollId))
+  {
+    return nullptr;
+  }
+
+  auto path = mLogRoot / common::hexString(channelId.mValue) / buildRollName(rollId);
+  path += kCompressedRollSuffix;
+  if(not std::filesystem::exists(path))
+  {
+    return nullptr;
+  }
+
+  auto* const opened =
+      open.emplace(rollId, std::make_unique<CompressedRoll>(path)).first->second.get();
+  closeFurthest(open, rollId);
+  return opened;
+}
+
+Reader::WindowedRoll* Reader::acquireWindowedRoll(
+    const ChannelId channelId,
+    const std::uint64_t rollId)
+{
+  if(mRollWindows.mWindowBytes == 0U)
+  {
+    return nullptr;
+  }
+
+  auto& open = mWindowedRolls[channelId];
+  if(const auto found = open.find(rollId); found != open.end())
+  {
+    return found->second.get();
+  }
+
+  // A roll some live entry holds mapped whole is read that way until the last such entry dies.
+  auto& rollCache = mRollCache[channelId];
+  if(const auto cached = rollCache.find(rollId);
+     cached != rollCache.end() and not cached->second.expired())
+  {
+    return nullptr;
+  }
 
-  return Entry{.mChannelId = timelineEntry.mChannelId, .mCrate = Crate{std::move(roll), span}};
+  auto roll = std::make_unique<WindowedRoll>(
+      mLogRoot / common::hexString(channelId.mValue) / buildRollName(rollId),
+      mRollWindows.mWindowBytes,
+      mRollWindows.mWindowCount);
+  auto* const opened = open.emplace(rollId, std::move(roll)).first->second.get();
+  closeFurthest(open, rollId);
+  return opened;
 }
 
 std::shared_ptr<const Reader::Roll> Reader::acquireRoll(
@@ -0,0 +1,427 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "utils.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <nioc/chronicle/channelIndex.hpp>
+#include <nioc/chronicle/defines.hpp>
+#include <nioc/chronicle/recovery.hpp>
+#include <nioc/common/filesystem.hpp>
+#include <nioc/common/utils.hpp>
+#include <nioc/containers/mmapArray.hpp>
+#include <nioc/containers/mmapConstArray.hpp>
+#include <nioc/logger/logger.hpp>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace nioc::chronicle
+{
+namespace
+{
+
+namespace fs = std::filesystem;
+
+/// What the timeline's tail says about one channel's newest rolls.
+struct ChannelTail
+{
+  /// The newest roll a committed record references.
+  std::uint64_t mNewestRollId{0ULL};
+
+  /// End of the last committed record in the newest roll.
+  std::uint64_t mNewestEnd{0ULL};
+
+  /// End of the last committed record in the roll before the newest, if seen.
+  std::uint64_t mPreviousEnd{0ULL};
+
+  /// Whether the walk has passed every record of the two newest rolls.
+  bool mSettled{false};
+};
+
+/// Walk the @p length timeline entries that @p entryAt yields by position backwards, until the
+/// newest two rolls of each of the @p channelCount channels are settled.
+template<typename EntryAt>
+std::unordered_map<ChannelId, ChannelTail> findChannelTails(
+    const std::uint64_t length,
+    const EntryAt& entryAt,
+    const std::size_t channelCount)
+{
+  auto tails = std::unordered_map<ChannelId, ChannelTail>{};
+  auto settledCount = std::size_t{0};
+
+  for(auto position = length; position > 0 and settledCount < channelCount; --position)
+  {
+    const TimelineEntry& entry = entryAt(position - 1);
+    if(not isCommitted(entry))
+    {
+      continue;
+    }
+
+    const auto end = entry.mOffset + entry.mSize;
+    const auto [found, first] = tails.try_emplace(
+        entry.mChannelId,
+        ChannelTail{.mNewestRollId = entry.mRollId, .mNewestEnd = end});
+    auto& tail = found->second;
+    if(first or tail.mSettled)
+    {
+      continue;
+    }
+
+    // A reservation may commit into a roll after the channel moved on to the next, so a newer roll
+    // can still turn up; past that, a channel's records in older rolls precede the newest two.
+    if(entry.mRollId > tail.mNewestRollId)
+    {
+      tail.mPreviousEnd = entry.mRollId == tail.mNewestRollId + 1ULL ? tail.mNewestEnd : 0ULL;
+      tail.mNewestRollId = entry.mRollId;
+      tail.mNewestEnd = end;
+    }
+    else if(entry.mRollId == tail.mNewestRollId)
+    {
+      tail.mNewestEnd = std::max(tail.mNewestEnd, end);
+    }
+    else if(entry.mRollId + 1ULL == tail.mNewestRollId)
+    {
+      tail.mPreviousEnd = std::max(tail.mPreviousEnd, end);
+    }
+    else
+    {
+      tail.mSettled = true;
+      ++settledCount;
+    }
+  }
+
+  return tails;
+}
+
+/// The durable marks each channel written directly left behind, by channel (see
+/// kDurableMarksFileName).
+using DurableMarks = std::unordered_map<ChannelId, std::vector<std::uint64_t>>;
+
+/// Read the durable marks of each channel in @p channelDirs that left any.
+DurableMarks loadDurableMarks(const std::unordered_map<ChannelId, fs::path>& channelDirs)
+{
+  auto marks = DurableMarks{};
+  for(const auto& [channelId, channelDir]: channelDirs)
+  {
+    const auto path = channelDir / kDurableMarksFileName;
+    if(not fs::exists(path))
+    {
+      continue;
+    }
+    auto& channelMarks = marks[channelId];
+    if(const auto file = mapIfRecorded<containers::MmapConstArray<std::uint64_t>>(path))
+    {
+      const auto values = std::span{file->data(), file->size()};
+      channelMarks.assign(values.begin(), values.end());
+    }
+  }
+  return marks;
+}
+
+/// The location part of a timeline entry, whether or not its shard stamps it.
+const TimelineEntry& entryOf(const TimelineEntry& entry) noexcept
+{
+  return entry;
+}
+
+const TimelineEntry& entryOf(const StampedEntry& entry) noexcept
+{
+  return entry.mEntry;
+}
+
+/// Length of the committed @p entries of shard @p shard before the first whose channel's durable
+/// mark falls short of it: that entry's record may never have reached its roll's file, and every
+/// entry past it goes with it, so the timeline stays a prefix of what was recorded.
+template<typename Entry>
+std::uint64_t durableLength(
+    const std::span<const Entry> entries,
+    const std::uint64_t shard,
+    const DurableMarks& marks)
+{
+  const auto markOf = [shard](const std::vector<std::uint64_t>& channelMarks)
+  { return shard < channelMarks.size() ? channelMarks.at(shard) : 0ULL; };
+
+  // Entries before every channel's mark are covered whoever wrote them.
+  auto position = std::uint64_t{entries.size()};
+  for(const auto& [channelId, channelMarks]: marks)
+  {
+    position = std::min<std::uint64_t>(position, markOf(channelMarks));
+  }
+
+  for(; position < entries.size(); ++position)
+  {
+    const TimelineEntry& entry = entryOf(entries[position]);
+    if(not isCommitted(entry))
+    {
+      continue;
+    }
+    if(const auto found = marks.find(entry.mChannelId);
+       found != marks.end() and position >= markOf(found->second))
+    {
+      return position;
+    }
+  }
+  return entries.size();
+}
+
+/// Shrink @p path to @p size bytes unless it already is no larger.
+void trimFile(const fs::path& path, const std::uint64_t size)
+{
+  if(fs::file_size(path) > size)
+  {
+    fs::resize_file(path, size);
+  }
+}
+
+/// Trim or delete every roll of the channel in @p channelDir to match @p tail, or to nothing when
+/// no committed record is on the channel.
+void recoverRolls(const fs::path& channelDir, const std::optional<ChannelTail>& tail)
+{
+  for(const auto& file: fs::directory_iterator{channelDir})
+  {
+    // A compressed roll was renamed into place whole, so only a half-written one needs removing,
+    // and the original it was compressed from once the compressed roll is in place.
+    const auto name = file.path().filename().string();
+    if(name.ends_with(kTemporaryFileSuffix))
+    {
+      fs::remove(file.path());
+      continue;
+    }
+
+    const auto rollId = parseRollName(name);
+    if(not rollId or name.ends_with(kCompressedRollSuffix))
+    {
+      continue;
+    }
+
+    if(fs::exists(fs::path{file.path()} += kCompressedRollSuffix))
+    {
+      fs::remove(file.path());
+      continue;
+    }
+
+    if(not tail)
+    {
+      trimFile(file.path(), 0ULL);
+    }
+    else if(*rollId > tail->mNewestRollId)
+    {
+      fs::remove(file.path());
+    }
+    else if(*rollId == tail->mNewestRollId)
+    {
+      trimFile(file.path(), tail->mNewestEnd);
+    }
+    else if(*rollId + 1ULL == tail->mNewestRollId and tail->mPreviousEnd > 0ULL)
+    {
+      trimFile(file.path(), tail->mPreviousEnd);
+    }
+  }
+}
+
+/// Clamp the first @p length samples of the time index at @p path to the latest stamp before each,
+/// as a clean close would have, through a copy renamed over the original.
+void clampTimeIndex(const fs::path& path, const std::uint64_t length)
+{
+  const auto copyPath = fs::path{path} += kTemporaryFileSuffix;
+  {
+    const auto original = containers::MmapConstArray<TimeIndexEntry>{path};
+    auto copy = containers::MmapArray<TimeIndexEntry>{copyPath, length};
+    std::ranges::copy(std::span{original.data(), length}, copy.data());
+    clampToRunningMax({copy.data(), copy.size()});
+    copy.sync();
+  }
+  fs::rename(copyPath, path);
+}
+
+/// Trim the single-file timeline, its time index, and its checksums in @p root to the committed
+/// entries that @p marks cover, returning the tail each of the @p channelCount channels leaves
+/// behind.
+std::unordered_map<ChannelId, ChannelTail> recoverTimeline(
+    const fs::path& root,
+    const std::size_t channelCount,
+    const DurableMarks& marks)
+{
+  const auto timelinePath = root / kTimelineFileName;
+  auto timelineLength = std::uint64_t{0ULL};
+  auto tails = std::unordered_map<ChannelId, ChannelTail>{};
+  if(const auto timeline = mapIfRecorded<containers::MmapConstArray<TimelineEntry>>(timelinePath))
+  {
+    const auto entries = std::span{timeline->data(), timeline->size()};
+    const auto committed = committedLength(entries, discardedLength(root));
+    timelineLength = durableLength(entries.first(committed), 0ULL, marks);
+    if(timelineLength < committed)
+    {
+      logger::warn(
+          "Recovering {}: cutting {} committed timeline entries whose records were written "
+          "directly and may not have reached disk.",
+          root.string(),
+          committed - timelineLength);
+    }
+    tails = findChannelTails(
+        timelineLength,
+        [entries](const std::uint64_t position) -> const TimelineEntry&
+        { return entries[position]; },
+        channelCount);
+
+    if(timelineLength < entries.size())
+    {
+      logger::info(
+          "Recovering {}: {} committed timeline entries.",
+          root.string(),
+          timelineLength);
+    }
+  }
+
+  const auto timeIndexPath = root / kTimeIndexFileName;
+  auto timeIndexLength = std::uint64_t{0ULL};
+  auto timeIndexOrdered = true;
+  if(const auto timeIndex =
+         mapIfRecorded<containers::MmapConstArray<TimeIndexEntry>>(timeIndexPath))
+  {
+    const auto samples = std::span{timeIndex->data(), timeIndex->size()};
+    timeIndexLength = sampledLength(samples, timelineLength);
+    timeIndexOrdered =
+        std::ranges::is_sorted(samples.first(timeIndexLength), {}, &TimeIndexEntry::mTimestamp);
+  }
+
+  // Every mapping is closed by now, so nothing maps the bytes about to be cut off.
+  if(fs::exists(timelinePath))
+  {
+    trimFile(timelinePath, timelineLength * sizeof(TimelineEntry));
+  }
+  if(not timeIndexOrdered)
+  {
+    clampTimeIndex(timeIndexPath, timeIndexLength);
+  }
+  else if(fs::exists(timeIndexPath))
+  {
+    trimFile(timeIndexPath, timeIndexLength * sizeof(TimeIndexEntry));
+  }
+  if(const auto checksumsPath = root / kChecksumsFileName; fs::exists(checksumsPath))
+  {
+    trimFile(checksumsPath, timelineLength * sizeof(std::uint32_t));
+  }
+
+  return tails;
+}
+
+/// Trim each of the @p shardCount shards in @p root, and its checksums, to its committed entries
+/// that @p marks cover, returning the tail each of the @p channelCount channels leaves behind on
+/// the merged timeline.
+std::unordered_map<ChannelId, ChannelTail> recoverShards(
+    const fs::path& root,
+    const std::uint64_t shardCount,
+    const std::size_t channelCount,
+    const DurableMarks& marks)
+{
+  auto shardLengths = std::vector<std::uint64_t>{};
+  auto tails = std::unordered_map<ChannelId, ChannelTail>{};
+  {
+    const auto shards = mapShards<ShardFile>(root, kTimelineShardStem, shardCount);
+    auto committed = committedShards(shards);
+    for(auto shard = std::uint64_t{0ULL}; shard < committed.size(); ++shard)
+    {
+      auto& entries = committed.at(shard);
+      if(const auto length = durableLength(entries, shard, marks); length < entries.size())
+      {
+        logger::warn(
+            "Recovering {}: cutting {} committed entries of shard {} whose records were written "
+            "directly and may not have reached disk.",
+            root.string(),
+            entries.size() - length,
+            shard);
+        entries = entries.first(length);
+      }
+    }
+    const auto merged = mergeShards(committed).mOrder;
+    tails = findChannelTails(
+        merged.size(),
+        [&merged, &committed](const std::uint64_t position) -> const TimelineEntry&
+        {
+          const auto shardPosition = merged.at(position);
+          return committed.at(shardOf(shardPosition))[indexInShard(shardPosition)].mEntry;
+        },
+        channelCount);
+
+    for(const auto& entries: committed)
+    {
+      shardLengths.push_back(entries.size());
+    }
+  }
+
+  // The shards are unmapped by now, so nothing maps the bytes about to be cut off.
+  for(auto shard = std::uint64_t{0ULL}; shard < shardCount; ++shard)
+  {
+    trimFile(
+        root / buildShardName(kTimelineShardStem, shard),
+        shardLengths.at(shard) * sizeof(StampedEntry));
+    if(const auto checksumsPath = root / buildShardName(kChecksumsShardStem, shard);
+       fs::exists(checksumsPath))
+    {
+      trimFile(checksumsPath, shardLengths.at(shard) * sizeof(std::uint32_t));
+    }
+  }
+
+  // The crashed Writer never merged its shards, as it would have on closing.
+  writeMergedOrder(root, Timeline::kDefaultTimeIndexStride);
+
+  return tails;
+}
+
+} // namespace
+
+void recover(const std::filesystem::path& logRoot)
+{
+  const auto root = common::requireExistingDirectory(logRoot);
+  requireFormat(root);
+
+  auto channelDirs = std::unordered_map<ChannelId, fs::path>{};
+  for(const auto& directoryEntry: fs::directory_iterator{root})
+  {
+    if(directoryEntry.is_directory())
+    {
+      try
+      {
+        const auto value =
+            common::fromHexString<std::uint64_t>(directoryEntry.path().filename().string());
+        channelDirs.emplace(ChannelId{value}, directoryEntry.path());
+      }
+      catch(const std::logic_error&)
+      {
+        logger::warn("Skipping {}: not a channel directory.", directoryEntry.path().string());
+      }
+    }
+  }
+
+  const auto marks = loadDurableMarks(channelDirs);
+  const auto shardCount = countShards(root);
+  const auto tails = shardCount > 0ULL
+                         ? recoverShards(root, shardCount, channelDirs.size(), marks)
+                         : recoverTimeline(root, channelDirs.size(), marks);
+
+  for(const auto& [channelId, channelDir]: channelDirs)
+  {
+    const auto tail = tails.find(channelId);
+    recoverRolls(
+        channelDir,
+        tail == tails.end() ? std::nullopt : std::optional<ChannelTail>{tail->second});
+  }
+
+  // The timeline reaches no further than the directly written records on disk now.
+  for(const auto& [channelId, channelMarks]: marks)
+  {
+    fs::remove(channelDirs.at(channelId) / kDurableMarksFileName);
+  }
+
+  buildChannelIndices(root);
+}
+
+} // namespace nioc::chronicle
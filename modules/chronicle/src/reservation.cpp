@@ -13,9 +13,6 @@
 #include <nioc/chronicle/crate.hpp>
 #include <nioc/chronicle/defines.hpp>
 #include <nioc/chronicle/reservation.hpp>
-#include <nioc/containers/mmapArray.hpp>
-#include <nioc/containers/tape.hpp>
-#include <nioc/logger/logger.hpp>
 #include <span>
 #include <utility>
 
@@ -24,29 +21,30 @@ namespace nioc::chronicle
 
 Reservation::Reservation(
     Channel& channel,
-    std::shared_ptr<containers::Tape<containers::MmapArray<std::byte>>> rollPtr,
-    const std::uint64_t rollId,
+    std::shared_ptr<RollLease> lease,
+    ChannelLane* const lane,
     const std::span<std::byte> span):
   mChannelPtr{&channel},
-  mRollPtr{std::move(rollPtr)},
-  mRollId{rollId},
+  mLease{std::move(lease)},
+  mLane{lane},
   mSpan{span}
 {
 }
 
 Reservation::~Reservation()
 {
-  if(mRollPtr)
+  if(mLease)
   {
-    mChannelPtr->rewind(*this, 0);
+    mChannelPtr->accountDrop(*this, mChannelPtr->rewind(*this, 0) ? 0 : mSpan.size());
+    mLease->leave();
   }
 }
 
 Reservation& Reservation::operator=(Reservation&& other) noexcept
 {
   std::swap(mChannelPtr, other.mChannelPtr);
-  std::swap(mRollPtr, other.mRollPtr);
-  std::swap(mRollId, other.mRollId);
+  std::swap(mLease, other.mLease);
+  std::swap(mLane, other.mLane);
   std::swap(mSpan, other.mSpan);
 
   return *this;
@@ -64,26 +62,35 @@ void Reservation::modify(const std::size_t newSize)
 
 Crate Reservation::commit(const std::size_t usedSize) &&
 {
-  const auto offset = static_cast<std::uint64_t>(std::distance(mRollPtr->data(), mSpan.data()));
+  const auto& roll = mLease->roll();
+  const auto offset = static_cast<std::uint64_t>(std::distance(roll->data(), mSpan.data()));
 
-  if(not mRollPtr->rewind(mSpan, roundUpToWord(usedSize)))
+  const auto keptSize = static_cast<std::size_t>(roundUpToWord(usedSize));
+  if(mChannelPtr->reclaim(*this, keptSize))
   {
-    // A later claim moved the cursor past this reservation, so its unused reserved tail can't be
-    // reclaimed and stays stranded - the frame itself still records correctly. Expected once the
-    // channel is multi-producer.
-    logger::warn("Could not reclaim the reservation's unused tail; a later claim followed it.");
+    mChannelPtr->accountCommit(*this, keptSize, usedSize);
+  }
+  else
+  {
+    // A later reservation was claimed past this one, or this one is committed on another thread
+    // than reserved it, so its unused reserved tail can't be reclaimed and stays stranded - the
+    // frame itself still records correctly. The channel counts the stranded bytes.
+    mChannelPtr->accountCommit(*this, mSpan.size(), usedSize);
   }
 
+  const auto record = std::as_bytes(mSpan.first(usedSize));
   mChannelPtr->append(
       TimelineEntry{
           .mChannelId = mChannelPtr->id(),
-          .mRollId = mRollId,
+          .mRollId = mLease->rollId(),
           .mOffset = offset,
-          .mSize = usedSize});
+          .mSize = usedSize},
+      record);
 
-  return Crate{
-      std::shared_ptr<const void>(std::move(mRollPtr)),
-      std::as_bytes(mSpan.first(usedSize))};
+  // The record is complete; the roll may seal once no other reservation writes into it.
+  auto crate = Crate{std::shared_ptr<const void>(roll), record};
+  std::exchange(mLease, nullptr)->leave();
+  return crate;
 }
 
 } // namespace nioc::chronicle
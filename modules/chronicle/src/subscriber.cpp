@@ -0,0 +1,232 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "utils.hpp"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <nioc/chronicle/broker.hpp>
+#include <nioc/chronicle/subscriber.hpp>
+#include <nioc/common/exception.hpp>
+#include <nioc/common/utils.hpp>
+#include <nioc/logger/logger.hpp>
+#include <poll.h>
+#include <span>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <system_error>
+#include <unistd.h>
+
+namespace nioc::chronicle
+{
+namespace
+{
+
+int connectTo(const std::filesystem::path& path)
+{
+  const auto address = makeSocketAddress(path);
+  const auto socket = ::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+  if(socket < 0)
+  {
+    common::throwException<std::runtime_error>(
+        "Unable to create a socket to connect to {}: {}",
+        path.string(),
+        std::generic_category().message(errno));
+  }
+
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast): the POSIX socket API.
+  if(::connect(socket, reinterpret_cast<const ::sockaddr*>(&address), sizeof(address)) != 0)
+  {
+    const auto errorNumber = errno;
+    static_cast<void>(::close(socket));
+    common::throwException<std::runtime_error>(
+        "Unable to connect to a Broker at {}: {}",
+        path.string(),
+        std::generic_category().message(errorNumber));
+  }
+  return socket;
+}
+
+} // namespace
+
+Subscriber::Subscriber(std::filesystem::path socketPath):
+  mSocketPath{std::move(socketPath)},
+  mSocket{connectTo(mSocketPath)}
+{
+}
+
+Subscriber::~Subscriber()
+{
+  static_cast<void>(::close(mSocket));
+}
+
+void Subscriber::subscribe(const ChannelId channelId)
+{
+  if(::send(mSocket, &channelId, sizeof(channelId), MSG_NOSIGNAL) !=
+     static_cast<::ssize_t>(sizeof(channelId)))
+  {
+    common::throwException<std::runtime_error>(
+        "Unable to subscribe to channel {} at {}: {}",
+        common::hexString(channelId.mValue),
+        mSocketPath.string(),
+        std::generic_category().message(errno));
+  }
+}
+
+std::optional<Entry> Subscriber::next(const std::chrono::nanoseconds timeout)
+{
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  while(not mClosed)
+  {
+    const auto remaining = std::max(
+        std::chrono::nanoseconds::zero(),
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            deadline - std::chrono::steady_clock::now()));
+    const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(remaining);
+    const auto wait =
+        ::timespec{.tv_sec = seconds.count(), .tv_nsec = (remaining - seconds).count()};
+
+    auto polled = ::pollfd{.fd = mSocket, .events = POLLIN, .revents = 0};
+    const auto ready = ::ppoll(&polled, 1, &wait, nullptr);
+    if(ready == 0)
+    {
+      return std::nullopt;
+    }
+    if(ready < 0 and errno != EINTR)
+    {
+      common::throwException<std::runtime_error>(
+          "Unable to wait on the Broker at {}: {}",
+          mSocketPath.string(),
+          std::generic_category().message(errno));
+    }
+
+    if(auto entry = receive())
+    {
+      return entry;
+    }
+  }
+  return std::nullopt;
+}
+
+bool Subscriber::closed() const noexcept
+{
+  return mClosed;
+}
+
+const std::filesystem::path& Subscriber::path() const noexcept
+{
+  return mSocketPath;
+}
+
+std::optional<Entry> Subscriber::receive()
+{
+  auto notice = TimelineEntry{};
+  auto vector = ::iovec{.iov_base = &notice, .iov_len = sizeof(notice)};
+  alignas(::cmsghdr) auto control = std::array<char, CMSG_SPACE(sizeof(int))>{};
+  auto message = ::msghdr{};
+  message.msg_iov = &vector;
+  message.msg_iovlen = 1;
+  message.msg_control = control.data();
+  message.msg_controllen = control.size();
+
+  const auto received = ::recvmsg(mSocket, &message, MSG_DONTWAIT | MSG_CMSG_CLOEXEC);
+  if(received < 0 and (errno == EAGAIN or errno == EWOULDBLOCK or errno == EINTR))
+  {
+    return std::nullopt;
+  }
+  if(received == 0 or (received < 0 and errno == ECONNRESET))
+  {
+    mClosed = true;
+    return std::nullopt;
+  }
+  if(received < 0)
+  {
+    common::throwException<std::runtime_error>(
+        "Unable to receive from the Broker at {}: {}",
+        mSocketPath.string(),
+        std::generic_category().message(errno));
+  }
+
+  auto fileDescriptor = -1;
+  const auto* const header = CMSG_FIRSTHDR(&message);
+  if(header != nullptr and header->cmsg_level == SOL_SOCKET and header->cmsg_type == SCM_RIGHTS)
+  {
+    std::memcpy(&fileDescriptor, CMSG_DATA(header), sizeof(int));
+  }
+
+  if(received != static_cast<::ssize_t>(sizeof(notice)) or
+     (message.msg_flags & (MSG_TRUNC | MSG_CTRUNC)) != 0)
+  {
+    if(fileDescriptor >= 0)
+    {
+      static_cast<void>(::close(fileDescriptor));
+    }
+    common::throwException<std::runtime_error>(
+        "Received a malformed notice of {} bytes from the Broker at {}.",
+        received,
+        mSocketPath.string());
+  }
+
+  if(fileDescriptor >= 0)
+  {
+    adopt(notice.mChannelId, notice.mRollId, fileDescriptor);
+  }
+
+  auto& rolls = mRolls[notice.mChannelId];
+  const auto found = std::ranges::find(
+      rolls,
+      notice.mRollId,
+      [](const auto& roll) { return roll.first; });
+  if(found == rolls.end())
+  {
+    logger::warn(
+        "Skipping a record of roll {} of channel {}: its file never reached this Subscriber.",
+        notice.mRollId,
+        common::hexString(notice.mChannelId.mValue));
+    return std::nullopt;
+  }
+
+  // The roll grows as its channel writes, so a record past the end of the mapping is in the file.
+  auto& roll = found->second;
+  if(notice.mOffset + notice.mSize > roll->size())
+  {
+    roll = std::make_shared<const Roll>(roll->remap());
+  }
+
+  const auto span = std::span{*roll}.subspan(notice.mOffset, notice.mSize);
+  return Entry{.mChannelId = notice.mChannelId, .mCrate = Crate{roll, span}};
+}
+
+void Subscriber::adopt(
+    const ChannelId channelId,
+    const std::uint64_t rollId,
+    const int fileDescriptor)
+{
+  // The path only names the roll in diagnostics; the Subscriber never opens it.
+  auto roll = std::make_shared<const Roll>(
+      fileDescriptor,
+      mSocketPath / common::hexString(channelId.mValue) / buildRollName(rollId));
+
+  auto& rolls = mRolls[channelId];
+  const auto found =
+      std::ranges::find(rolls, rollId, [](const auto& open) { return open.first; });
+  if(found != rolls.end())
+  {
+    found->second = std::move(roll);
+    return;
+  }
+
+  // The Broker drops its record of the same roll, so it sends the descriptor again if need be.
+  rolls.emplace_back(rollId, std::move(roll));
+  if(rolls.size() > Broker::kOpenRollsPerChannel)
+  {
+    rolls.pop_front();
+  }
+}
+
+} // namespace nioc::chronicle
@@ -0,0 +1,438 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "utils.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <nioc/chronicle/timeline.hpp>
+#include <nioc/common/exception.hpp>
+#include <sched.h>
+#include <stdexcept>
+#include <thread>
+
+namespace nioc::chronicle
+{
+namespace
+{
+
+std::uint64_t requireStride(const std::uint64_t timeIndexStride)
+{
+  if(timeIndexStride == 0ULL)
+  {
+    common::throwException<std::invalid_argument>("The time index stride must be non-zero.");
+  }
+  return timeIndexStride;
+}
+
+std::int64_t now() noexcept
+{
+  const auto sinceEpoch = std::chrono::system_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(sinceEpoch).count();
+}
+
+/// The shard a producer on the calling core appends to. Producers on one core rarely contend, so
+/// keying shards by core keeps a claim's cache line local however many threads there are.
+std::size_t shardOfThisCore(const std::size_t shardCount) noexcept
+{
+  const auto cpu = ::sched_getcpu();
+  if(cpu >= 0)
+  {
+    return static_cast<std::size_t>(cpu) % shardCount;
+  }
+  return std::hash<std::thread::id>{}(std::this_thread::get_id()) % shardCount;
+}
+
+/// Write @p entry into @p slot, publishing its commit marker last, so a crash mid-write leaves a
+/// slot that reads as uncommitted rather than one pointing at the wrong bytes.
+void publish(TimelineEntry& slot, const TimelineEntry& entry) noexcept
+{
+  slot.mChannelId = entry.mChannelId;
+  slot.mRollId = entry.mRollId;
+  slot.mOffset = entry.mOffset;
+  slot.mSize = entry.mSize;
+  std::atomic_ref{slot.mCommitted}.store(kCommitted, std::memory_order_release);
+}
+
+bool isPublished(TimelineEntry& slot) noexcept
+{
+  return std::atomic_ref{slot.mCommitted}.load(std::memory_order_acquire) != 0ULL;
+}
+
+bool isPublished(StampedEntry& slot) noexcept
+{
+  return isPublished(slot.mEntry);
+}
+
+template<typename Entries>
+void advanceOverPublished(Entries& entries, std::uint64_t& length) noexcept
+{
+  const auto size = entries.size();
+  while(length < size and isPublished(entries[length]))
+  {
+    ++length;
+  }
+}
+
+/// Grow @p array, at least doubling it, until it holds @p index, as the entries it accompanies
+/// grew to hold that position. Writes that fit never take @p mutex.
+template<typename Value>
+void cover(containers::MmapArray<Value>& array, const std::uint64_t index, std::mutex& mutex)
+{
+  if(index < array.size())
+  {
+    return;
+  }
+
+  const auto lock = std::scoped_lock{mutex};
+  const auto size = array.size();
+  if(index < size)
+  {
+    return;
+  }
+  array.grow(std::min(array.reservation(), std::max<std::size_t>(index + 1ULL, 2U * size)));
+}
+
+} // namespace
+
+Timeline::Shard::Shard(
+    const std::filesystem::path& logRoot,
+    const std::size_t index,
+    const std::size_t initialCapacity,
+    const std::size_t capacity,
+    const bool checksums,
+    const containers::MapPolicy& mapPolicy):
+  mEntries{
+      logRoot / buildShardName(kTimelineShardStem, index),
+      initialCapacity,
+      containers::WriteMode::Mapped,
+      capacity,
+      mapPolicy}
+{
+  if(checksums)
+  {
+    mChecksums.emplace(
+        logRoot / buildShardName(kChecksumsShardStem, index),
+        initialCapacity,
+        containers::WriteMode::Mapped,
+        capacity,
+        mapPolicy);
+  }
+}
+
+Timeline::Timeline(
+    const std::filesystem::path& logRoot,
+    const std::size_t capacity,
+    const std::uint64_t timeIndexStride,
+    const bool checksums,
+    const std::size_t shards,
+    const containers::MapPolicy mapPolicy):
+  mLogRoot{logRoot},
+  mTimeIndexStride{requireStride(timeIndexStride)}
+{
+  if(shards == 0 or shards > kMaxShards)
+  {
+    common::throwException<std::invalid_argument>(
+        "A timeline splits into 1 to {} shards, not {}.",
+        kMaxShards,
+        shards);
+  }
+
+  // Readers check the layout before they map a single entry.
+  writeFormat(logRoot);
+
+  if(shards == 1)
+  {
+    // What an earlier run discarded says nothing of this one.
+    std::filesystem::remove(logRoot / kDiscardedFileName);
+
+    const auto initial = std::min(capacity, kInitialCapacity);
+    mEntries.emplace(
+        logRoot / kTimelineFileName,
+        initial,
+        containers::WriteMode::Mapped,
+        capacity,
+        mapPolicy);
+    mTimeIndex.emplace(
+        logRoot / kTimeIndexFileName,
+        (initial / mTimeIndexStride) + 1ULL,
+        containers::WriteMode::Mapped,
+        (capacity / mTimeIndexStride) + 1ULL,
+        mapPolicy);
+    if(checksums)
+    {
+      mChecksums.emplace(
+          logRoot / kChecksumsFileName,
+          initial,
+          containers::WriteMode::Mapped,
+          capacity,
+          mapPolicy);
+    }
+    return;
+  }
+
+  const auto shardCapacity = std::max(capacity / shards, std::size_t{1});
+  const auto shardInitial =
+      std::min(shardCapacity, std::max(kInitialCapacity / shards, std::size_t{1}));
+  mShards.reserve(shards);
+  for(auto shard = std::size_t{0}; shard < shards; ++shard)
+  {
+    mShards.push_back(std::make_unique<Shard>(
+        logRoot,
+        shard,
+        shardInitial,
+        shardCapacity,
+        checksums,
+        mapPolicy));
+  }
+}
+
+std::size_t Timeline::size() const noexcept
+{
+  if(mEntries)
+  {
+    return mEntries->size();
+  }
+
+  auto size = std::size_t{0};
+  for(const auto& shard: mShards)
+  {
+    size += shard->mEntries.size();
+  }
+  return size;
+}
+
+std::size_t Timeline::capacity() const noexcept
+{
+  if(mEntries)
+  {
+    return mEntries->max_size();
+  }
+
+  auto capacity = std::size_t{0};
+  for(const auto& shard: mShards)
+  {
+    capacity += shard->mEntries.max_size();
+  }
+  return capacity;
+}
+
+std::size_t Timeline::shardCount() const noexcept
+{
+  return mShards.empty() ? 1 : mShards.size();
+}
+
+bool Timeline::hasChecksums() const noexcept
+{
+  return mChecksums.has_value() or (not mShards.empty() and mShards.front()->mChecksums);
+}
+
+std::uint64_t Timeline::timeIndexStride() const noexcept
+{
+  return mTimeIndexStride;
+}
+
+std::uint64_t Timeline::append(const TimelineEntry& entry, const std::uint32_t checksum)
+{
+  if(not mEntries)
+  {
+    return appendToShard(entry, checksum);
+  }
+
+  const auto slot = mEntries->claim();
+  if(slot.empty())
+  {
+    common::throwException<std::runtime_error>(
+        "Timeline capacity of {} entries is exhausted.",
+        mEntries->max_size());
+  }
+
+  const auto position = static_cast<std::uint64_t>(std::distance(mEntries->data(), slot.data()));
+  if(mChecksums)
+  {
+    cover(*mChecksums, position, mGrowthMutex);
+    (*mChecksums)[position] = checksum;
+  }
+
+  publish(slot.front(), entry);
+
+  if(position % mTimeIndexStride == 0ULL)
+  {
+    // Producers sample in whatever order they get here; clamping to the latest sample taken keeps
+    // a late one from stamping itself before a later position's. shrink_to_fit() orders the rest.
+    auto stamp = now();
+    auto latest = mLatestSample.load(std::memory_order_relaxed);
+    while(latest < stamp and
+          not mLatestSample.compare_exchange_weak(latest, stamp, std::memory_order_relaxed))
+    {
+    }
+    stamp = std::max(stamp, latest);
+
+    cover(*mTimeIndex, position / mTimeIndexStride, mGrowthMutex);
+    (*mTimeIndex)[position / mTimeIndexStride] =
+        TimeIndexEntry{.mTimestamp = stamp, .mEntryInTimeline = position};
+  }
+
+  return position;
+}
+
+std::uint64_t Timeline::appendToShard(const TimelineEntry& entry, const std::uint32_t checksum)
+{
+  const auto first = shardOfThisCore(mShards.size());
+  for(auto step = std::size_t{0}; step < mShards.size(); ++step)
+  {
+    auto& shard = *mShards.at((first + step) % mShards.size());
+    const auto slot = shard.mEntries.claim();
+    if(slot.empty())
+    {
+      continue;
+    }
+
+    const auto position =
+        static_cast<std::uint64_t>(std::distance(shard.mEntries.data(), slot.data()));
+    if(shard.mChecksums)
+    {
+      cover(*shard.mChecksums, position, mGrowthMutex);
+      (*shard.mChecksums)[position] = checksum;
+    }
+
+    auto& written = slot.front();
+    written.mTimestamp = now();
+    publish(written.mEntry, entry);
+    return position;
+  }
+
+  common::throwException<std::runtime_error>(
+      "Timeline capacity of {} entries is exhausted in every shard.",
+      capacity());
+}
+
+void Timeline::scanCommitted(const std::span<std::uint64_t> lengths) noexcept
+{
+  if(mEntries)
+  {
+    auto& length = lengths.front();
+    length = std::max(length, mDiscarded.load(std::memory_order_acquire));
+    advanceOverPublished(*mEntries, length);
+    return;
+  }
+
+  for(auto shard = std::size_t{0}; shard < mShards.size(); ++shard)
+  {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-avoid-unchecked-container-access): one per shard.
+    advanceOverPublished(mShards.at(shard)->mEntries, lengths[shard]);
+  }
+}
+
+void Timeline::shrink_to_fit() noexcept
+{
+  for(const auto& shard: mShards)
+  {
+    shard->mEntries.shrink_to_fit();
+    if(shard->mChecksums)
+    {
+      shard->mChecksums->resize(shard->mEntries.size());
+    }
+  }
+  if(not mEntries)
+  {
+    return;
+  }
+
+  mEntries->shrink_to_fit();
+
+  // One sample per started stride: entries [0, size) hold ceil(size / stride) sampled positions.
+  mTimeIndex->resize((mEntries->size() + mTimeIndexStride - 1ULL) / mTimeIndexStride);
+  const auto samples = std::span{mTimeIndex->data(), mTimeIndex->size()};
+  const auto discarded = mDiscarded.load(std::memory_order_relaxed);
+  clampToRunningMax(samples.subspan(std::min(discarded / mTimeIndexStride, samples.size())));
+  if(mChecksums)
+  {
+    mChecksums->resize(mEntries->size());
+  }
+}
+
+void Timeline::startWriteback() noexcept
+{
+  for(const auto& shard: mShards)
+  {
+    const auto size = shard->mEntries.size();
+    shard->mEntries.storage().startWriteback(shard->mWrittenBack, size - shard->mWrittenBack);
+    if(shard->mChecksums)
+    {
+      shard->mChecksums->startWriteback(shard->mWrittenBack, size - shard->mWrittenBack);
+    }
+    shard->mWrittenBack = size;
+  }
+  if(not mEntries)
+  {
+    return;
+  }
+
+  const auto size = mEntries->size();
+  mEntries->storage().startWriteback(mWrittenBack, size - mWrittenBack);
+  if(mChecksums)
+  {
+    mChecksums->startWriteback(mWrittenBack, size - mWrittenBack);
+  }
+  mWrittenBack = size;
+}
+
+void Timeline::discard(const std::uint64_t count)
+{
+  if(not mEntries or count <= mDiscarded.load(std::memory_order_relaxed))
+  {
+    return;
+  }
+
+  // Recorded durably first, so no reader takes the holes for the end of the timeline.
+  if(not mDiscardedFile)
+  {
+    mDiscardedFile.emplace(mLogRoot / kDiscardedFileName, 1U);
+  }
+  mDiscardedFile->at(0) = count;
+  mDiscardedFile->sync();
+
+  mEntries->storage().discard(0, count);
+  if(mChecksums)
+  {
+    mChecksums->discard(0, count);
+  }
+  mTimeIndex->discard(0, count / mTimeIndexStride);
+
+  // A scan stopped at the zeroed entries meanwhile moves past them on its next call.
+  mDiscarded.store(count, std::memory_order_release);
+}
+
+void Timeline::sync() const
+{
+  // Checksums first: an entry on disk then has its checksum there too, and a record that entry
+  // points at but that did not reach its roll fails it rather than reading as valid.
+  for(const auto& shard: mShards)
+  {
+    if(shard->mChecksums)
+    {
+      shard->mChecksums->sync();
+    }
+    shard->mEntries.storage().sync();
+  }
+  if(not mEntries)
+  {
+    return;
+  }
+
+  if(mChecksums)
+  {
+    mChecksums->sync();
+  }
+  mEntries->storage().sync();
+  mTimeIndex->sync(); // Last, so it samples no entry that is not on disk.
+}
+
+} // namespace nioc::chronicle
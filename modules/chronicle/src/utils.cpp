@@ -5,9 +5,68 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 #include "utils.hpp"
 #include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <linux/fs.h>
+#include <linux/futex.h>
+#include <nioc/common/exception.hpp>
+#include <nioc/containers/mmapArray.hpp>
+#include <optional>
+#include <queue>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <system_error>
+#include <unistd.h>
+#include <utility>
 
 namespace nioc::chronicle
 {
+namespace
+{
+
+template<typename Entry>
+std::uint64_t committedPrefix(
+    const std::span<const Entry> timeline,
+    const std::uint64_t discarded = 0ULL) noexcept
+{
+  const auto committed = [](const Entry& entry) { return isCommitted(entry); };
+
+  // Committed entries form a prefix but for a few holes near its end, so the partition point lands
+  // within kTailScanWindow slots of the last committed entry. Discarded entries read as holes, so
+  // the search starts past them.
+  const auto kept = timeline.subspan(std::min<std::uint64_t>(discarded, timeline.size()));
+  const auto boundary = static_cast<std::uint64_t>(std::distance(
+      timeline.begin(),
+      std::ranges::partition_point(kept, committed)));
+
+  auto length = boundary;
+  const auto scanEnd = std::min<std::uint64_t>(timeline.size(), boundary + kTailScanWindow);
+  for(auto position = boundary; position < scanEnd; ++position)
+  {
+    if(isCommitted(timeline[position]))
+    {
+      length = position + 1ULL;
+    }
+  }
+  return length;
+}
+
+} // namespace
 
 std::string padString(
     const std::string& input,
@@ -24,4 +83,361 @@ std::string buildRollName(const std::uint64_t rollId)
          kFileNameExtension;
 }
 
+std::optional<std::uint64_t> parseRollName(std::string_view fileName)
+{
+  if(fileName.ends_with(kCompressedRollSuffix))
+  {
+    fileName.remove_suffix(std::strlen(kCompressedRollSuffix));
+  }
+
+  const auto prefixLength = std::strlen(kRollFileNamePrefix);
+  const auto extensionLength = std::strlen(kFileNameExtension);
+  if(fileName.size() != prefixLength + kPaddedNumberLength + extensionLength or
+     not fileName.starts_with(kRollFileNamePrefix) or not fileName.ends_with(kFileNameExtension))
+  {
+    return std::nullopt;
+  }
+
+  const auto digits = fileName.substr(prefixLength, kPaddedNumberLength);
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic): one past the digits.
+  const auto* const last = digits.data() + digits.size();
+  auto rollId = std::uint64_t{0ULL};
+  const auto [end, error] = std::from_chars(digits.data(), last, rollId);
+  if(error != std::errc{} or end != last)
+  {
+    return std::nullopt;
+  }
+  return rollId;
+}
+
+std::uint64_t committedLength(
+    const std::span<const TimelineEntry> timeline,
+    const std::uint64_t discarded) noexcept
+{
+  return committedPrefix(timeline, discarded);
+}
+
+std::uint64_t discardedLength(const std::filesystem::path& logRoot)
+{
+  const auto discarded =
+      mapIfRecorded<containers::MmapConstArray<std::uint64_t>>(logRoot / kDiscardedFileName);
+  return discarded ? discarded->at(0) : 0ULL;
+}
+
+void writeFormat(const std::filesystem::path& logRoot)
+{
+  auto format = containers::MmapArray<ChronicleFormat>{logRoot / kFormatFileName, 1U};
+  format.at(0) = ChronicleFormat{};
+  format.sync();
+}
+
+void requireFormat(const std::filesystem::path& logRoot)
+{
+  const auto path = logRoot / kFormatFileName;
+  auto errorCode = std::error_code{};
+  const auto byteCount = std::filesystem::file_size(path, errorCode);
+  if(errorCode)
+  {
+    const auto timelineSize = std::filesystem::file_size(logRoot / kTimelineFileName, errorCode);
+    if((not errorCode and timelineSize > 0) or countShards(logRoot) > 0ULL)
+    {
+      common::throwException<std::runtime_error>(
+          "The chronicle {} has no {}: it was recorded in format version 1, with 32-byte timeline "
+          "entries, which this build (version {}, {}-byte entries) cannot read.",
+          logRoot.string(),
+          kFormatFileName,
+          kChronicleFormatVersion,
+          sizeof(TimelineEntry));
+    }
+    return;
+  }
+
+  if(byteCount != sizeof(ChronicleFormat))
+  {
+    common::throwException<std::runtime_error>(
+        "The chronicle {} holds a {} of {} bytes, not {}: it is not a chronicle's format file.",
+        logRoot.string(),
+        kFormatFileName,
+        byteCount,
+        sizeof(ChronicleFormat));
+  }
+
+  const auto format = containers::MmapConstArray<ChronicleFormat>{path}.at(0);
+  if(format.mMagic != kChronicleMagic)
+  {
+    common::throwException<std::runtime_error>(
+        "The chronicle {} holds a {} that is not a chronicle's format file.",
+        logRoot.string(),
+        kFormatFileName);
+  }
+  if(format.mVersion != kChronicleFormatVersion or format.mEntrySize != sizeof(TimelineEntry))
+  {
+    common::throwException<std::runtime_error>(
+        "The chronicle {} was recorded in format version {}, with {}-byte timeline entries, which "
+        "this build (version {}, {}-byte entries) cannot read.",
+        logRoot.string(),
+        format.mVersion,
+        format.mEntrySize,
+        kChronicleFormatVersion,
+        sizeof(TimelineEntry));
+  }
+}
+
+std::uint64_t committedLength(const std::span<const StampedEntry> shard) noexcept
+{
+  return committedPrefix(shard);
+}
+
+std::string buildShardName(const std::string_view stem, const std::uint64_t shard)
+{
+  return std::string{stem} + "-" + std::to_string(shard) + kFileNameExtension;
+}
+
+MergedShards mergeShards(
+    const std::span<const std::span<const StampedEntry>> shards,
+    const std::uint64_t sampleStride)
+{
+  // A min-heap of each shard's next entry, keyed by stamp and then by shard.
+  using Head = std::pair<std::int64_t, std::uint64_t>;
+  auto heads = std::priority_queue<Head, std::vector<Head>, std::greater<>>{};
+  auto next = std::vector<std::uint64_t>(shards.size(), 0ULL);
+
+  const auto pushNext = [&heads, &next, shards](const std::uint64_t shard, const std::int64_t floor)
+  {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-avoid-unchecked-container-access): a shard index.
+    const auto entries = shards[shard];
+    auto& position = next.at(shard);
+    while(position < entries.size() and not isCommitted(entries[position]))
+    {
+      ++position; // A hole a crash left behind.
+    }
+    if(position < entries.size())
+    {
+      heads.emplace(std::max(entries[position].mTimestamp, floor), shard);
+    }
+  };
+
+  auto total = std::size_t{0};
+  for(auto shard = std::uint64_t{0ULL}; shard < shards.size(); ++shard)
+  {
+    pushNext(shard, std::numeric_limits<std::int64_t>::min());
+  }
+  for(const auto& entries: shards)
+  {
+    total += entries.size();
+  }
+
+  auto merged = MergedShards{};
+  merged.mOrder.reserve(total);
+  while(not heads.empty())
+  {
+    const auto [timestamp, shard] = heads.top();
+    heads.pop();
+    if(const auto position = merged.mOrder.size(); position % sampleStride == 0ULL)
+    {
+      merged.mSamples.push_back(
+          TimeIndexEntry{.mTimestamp = timestamp, .mEntryInTimeline = position});
+    }
+    merged.mOrder.push_back(makeShardPosition(shard, next.at(shard)++));
+    pushNext(shard, timestamp);
+  }
+  return merged;
+}
+
+void writeMergedOrder(const std::filesystem::path& logRoot, const std::uint64_t sampleStride)
+{
+  const auto shards = mapShards<ShardFile>(logRoot, kTimelineShardStem, countShards(logRoot));
+  const auto merged = mergeShards(committedShards(shards), sampleStride);
+  if(merged.mOrder.empty())
+  {
+    return; // Nothing to map; a Reader finds no order and merges nothing.
+  }
+
+  {
+    auto samples = containers::MmapArray<TimeIndexEntry>{
+        logRoot / kTimeIndexFileName,
+        merged.mSamples.size()};
+    std::ranges::copy(merged.mSamples, samples.data());
+    samples.sync();
+  }
+
+  // Renamed into place whole and last, so a Reader that finds the order finds its samples too.
+  const auto orderPath = logRoot / kMergedOrderFileName;
+  const auto copyPath = std::filesystem::path{orderPath} += kTemporaryFileSuffix;
+  {
+    auto order = containers::MmapArray<std::uint64_t>{copyPath, merged.mOrder.size()};
+    std::ranges::copy(merged.mOrder, order.data());
+    order.sync();
+  }
+  std::filesystem::rename(copyPath, orderPath);
+}
+
+std::uint64_t countShards(const std::filesystem::path& logRoot)
+{
+  constexpr auto kMostShards = std::uint64_t{1ULL} << (64U - kShardPositionBits);
+
+  auto shardCount = std::uint64_t{0ULL};
+  while(shardCount < kMostShards and
+        std::filesystem::exists(logRoot / buildShardName(kTimelineShardStem, shardCount)))
+  {
+    ++shardCount;
+  }
+  return shardCount;
+}
+
+std::vector<std::span<const StampedEntry>> committedShards(
+    const std::vector<std::unique_ptr<const ShardFile>>& shards)
+{
+  auto committed = std::vector<std::span<const StampedEntry>>{};
+  committed.reserve(shards.size());
+  for(const auto& shard: shards)
+  {
+    const auto entries =
+        shard ? std::span{shard->data(), shard->size()} : std::span<const StampedEntry>{};
+    committed.push_back(entries.first(committedLength(entries)));
+  }
+  return committed;
+}
+
+void ringDoorbell(Doorbell& doorbell) noexcept
+{
+  std::atomic_ref{doorbell.mSequence}.fetch_add(1U, std::memory_order_release);
+
+  // A plain (not FUTEX_PRIVATE) wake reaches waiters in other processes mapping the same file.
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg): the futex call has no libc wrapper.
+  static_cast<void>(
+      ::syscall(SYS_futex, &doorbell.mSequence, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0));
+}
+
+void waitForDoorbell(
+    const Doorbell& doorbell,
+    const std::uint32_t sequence,
+    const std::chrono::nanoseconds timeout) noexcept
+{
+  const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+  const auto relative =
+      ::timespec{.tv_sec = seconds.count(), .tv_nsec = (timeout - seconds).count()};
+
+  // The kernel compares the word with @p sequence before sleeping, so a ring between the caller's
+  // load and this call is not lost. A read-only mapping suffices to wait.
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg): the futex call has no libc wrapper.
+  static_cast<void>(
+      ::syscall(SYS_futex, &doorbell.mSequence, FUTEX_WAIT, sequence, &relative, nullptr, 0));
+}
+
+::sockaddr_un makeSocketAddress(const std::filesystem::path& path)
+{
+  auto address = ::sockaddr_un{};
+  address.sun_family = AF_UNIX;
+  const auto& native = path.native();
+  if(native.size() >= sizeof(address.sun_path))
+  {
+    common::throwException<std::invalid_argument>(
+        "The socket path {} is longer than the {} bytes a Unix socket address holds.",
+        path.string(),
+        sizeof(address.sun_path) - 1);
+  }
+  std::ranges::copy(native, std::begin(address.sun_path));
+  return address;
+}
+
+BridgeFrame toWireOrder(BridgeFrame frame) noexcept
+{
+  if constexpr(std::endian::native == std::endian::big)
+  {
+    frame.mVersion = std::byteswap(frame.mVersion);
+    frame.mReserved = std::byteswap(frame.mReserved);
+    frame.mChannelId.mValue = std::byteswap(frame.mChannelId.mValue);
+    frame.mSize = std::byteswap(frame.mSize);
+  }
+  return frame;
+}
+
+void setSocketTimeout(
+    const int socket,
+    const int option,
+    const std::chrono::nanoseconds timeout) noexcept
+{
+  const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+  const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(timeout - seconds);
+  const auto limit = ::timeval{.tv_sec = seconds.count(), .tv_usec = micros.count()};
+  static_cast<void>(::setsockopt(socket, SOL_SOCKET, option, &limit, sizeof(limit)));
+}
+
+void linkRoll(const std::filesystem::path& from, const std::filesystem::path& to)
+{
+  auto errorCode = std::error_code{};
+  std::filesystem::create_hard_link(from, to, errorCode);
+  if(not errorCode)
+  {
+    return;
+  }
+
+  // NOLINTBEGIN(cppcoreguidelines-pro-type-vararg,hicpp-vararg): the POSIX file API.
+  const auto source = ::open(from.c_str(), O_RDONLY | O_CLOEXEC);
+  const auto target = ::open(to.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+  const auto cloned = source >= 0 and target >= 0 and ::ioctl(target, FICLONE, source) == 0;
+  // NOLINTEND(cppcoreguidelines-pro-type-vararg,hicpp-vararg)
+  if(source >= 0)
+  {
+    static_cast<void>(::close(source));
+  }
+  if(target >= 0)
+  {
+    static_cast<void>(::close(target));
+  }
+  if(not cloned)
+  {
+    std::filesystem::copy_file(from, to, std::filesystem::copy_options::overwrite_existing);
+  }
+  syncPath(to);
+}
+
+void syncPath(const std::filesystem::path& path)
+{
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg,hicpp-vararg): the POSIX file API.
+  const auto fileDescriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if(fileDescriptor < 0)
+  {
+    common::throwException<std::runtime_error>(
+        "Unable to open {} to sync it: {}",
+        path.string(),
+        std::generic_category().message(errno));
+  }
+  const auto synced = ::fsync(fileDescriptor) == 0;
+  const auto errorNumber = errno;
+  static_cast<void>(::close(fileDescriptor));
+  if(not synced)
+  {
+    common::throwException<std::runtime_error>(
+        "Unable to sync {}: {}",
+        path.string(),
+        std::generic_category().message(errorNumber));
+  }
+}
+
+void clampToRunningMax(const std::span<TimeIndexEntry> samples) noexcept
+{
+  auto latest = std::numeric_limits<std::int64_t>::min();
+  for(auto& sample: samples)
+  {
+    latest = std::max(latest, sample.mTimestamp);
+    sample.mTimestamp = latest;
+  }
+}
+
+std::uint64_t sampledLength(
+    const std::span<const TimeIndexEntry> timeIndex,
+    const std::uint64_t timelineLength) noexcept
+{
+  return static_cast<std::uint64_t>(std::distance(
+      timeIndex.begin(),
+      std::ranges::partition_point(
+          timeIndex,
+          [timelineLength](const TimeIndexEntry& sample)
+          {
+            return sample.mTimestamp != 0LL and sample.mEntryInTimeline < timelineLength;
+          })));
+}
+
 } // namespace nioc::chronicle
@@ -5,8 +5,21 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <nioc/chronicle/defines.hpp>
+#include <nioc/chronicle/timeline.hpp>
+#include <nioc/containers/mmapConstArray.hpp>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <sys/un.h>
+#include <system_error>
+#include <vector>
 
 namespace nioc::chronicle
 {
@@ -19,6 +32,54 @@ static constexpr auto kPaddedNumberLength = 20UL;
 
 static constexpr auto kTimelineFileName = "timeline.nioc";
 
+static constexpr auto kTimeIndexFileName = "timeIndex.nioc";
+
+static constexpr auto kChannelIndexFileName = "index.nioc";
+
+static constexpr auto kChecksumsFileName = "checksums.nioc";
+
+static constexpr auto kDoorbellFileName = "doorbell.nioc";
+
+/// A sharded timeline's entries in merged order, as shard positions (see makeShardPosition).
+static constexpr auto kMergedOrderFileName = "mergedOrder.nioc";
+
+/// Stem of a sharded timeline's shard files, named by buildShardName.
+static constexpr auto kTimelineShardStem = "timeline";
+
+/// Stem of a sharded timeline's per-shard checksum files, named by buildShardName.
+static constexpr auto kChecksumsShardStem = "checksums";
+
+/// Bits of a shard position that hold the entry's position within its shard; the shard's index
+/// takes the rest. See makeShardPosition.
+static constexpr auto kShardPositionBits = 56U;
+
+/// Appended to a roll's file name once compressRoll has compressed it.
+static constexpr auto kCompressedRollSuffix = ".z";
+
+/// Appended to the name of a file being written, until it is renamed into place whole.
+static constexpr auto kTemporaryFileSuffix = ".tmp";
+
+/// A channel's spare roll while it is prepared, renamed to its roll's name once a rollover takes
+/// it. Ends in kTemporaryFileSuffix, so recovery removes one a crash left behind.
+static constexpr auto kSpareRollFileName = "spare.tmp";
+
+/// A WriteMode::Direct channel's durable marks: per timeline shard, the length before which each of
+/// the channel's entries has its record's bytes on disk. Removed once the channel closes cleanly,
+/// and by recovery once it has cut the timeline back to them.
+static constexpr auto kDurableMarksFileName = "durable.nioc";
+
+/// How many leading entries of a single-file timeline a Writer under a Retention policy discarded,
+/// as one std::uint64_t. Those entries, their checksums, and their samples read as zero.
+static constexpr auto kDiscardedFileName = "discarded.nioc";
+
+/// The chronicle's ChronicleFormat, written by its Timeline and checked by whatever reads it.
+static constexpr auto kFormatFileName = "format.nioc";
+
+/// Most uncommitted timeline slots that may sit before the last committed entry: concurrent
+/// producers claim slots in order but publish them in any order, so a crash can leave a few holes
+/// behind the tail. Far more than the producers a chronicle sees at once.
+static constexpr auto kTailScanWindow = std::uint64_t{4096ULL};
+
 constexpr std::uint64_t roundUpToWord(const std::uint64_t value) noexcept
 {
   constexpr auto kWord = std::uint64_t{8ULL};
@@ -29,4 +90,205 @@ std::string padString(const std::string& input, std::uint64_t paddedLength, char
 
 std::string buildRollName(std::uint64_t rollId);
 
+/// The inverse of buildRollName: the roll id a roll file is named for, or empty if @p fileName is
+/// not a roll file name. Accepts compressed roll names too.
+std::optional<std::uint64_t> parseRollName(std::string_view fileName);
+
+/// The file name of shard @p shard of a sharded timeline's @p stem file, such as
+/// `timeline-3.nioc`.
+std::string buildShardName(std::string_view stem, std::uint64_t shard);
+
+/// Pack shard @p shard and the position @p index within it into one value, the way the merged
+/// order of a sharded timeline refers to entries.
+constexpr std::uint64_t makeShardPosition(const std::uint64_t shard, const std::uint64_t index)
+{
+  return (shard << kShardPositionBits) | index;
+}
+
+/// The shard a shard position refers into.
+constexpr std::uint64_t shardOf(const std::uint64_t shardPosition) noexcept
+{
+  return shardPosition >> kShardPositionBits;
+}
+
+/// The position within its shard a shard position refers to.
+constexpr std::uint64_t indexInShard(const std::uint64_t shardPosition) noexcept
+{
+  return shardPosition & ((std::uint64_t{1ULL} << kShardPositionBits) - 1ULL);
+}
+
+/// Whether @p retention limits anything, rather than keeping every roll.
+constexpr bool isBounded(const Retention& retention) noexcept
+{
+  return retention.mMaxBytes != 0ULL or retention.mMaxAge != std::chrono::nanoseconds::zero();
+}
+
+/// The commit marker a committed TimelineEntry carries.
+inline constexpr auto kCommitted = std::uint64_t{1ULL};
+
+/// Whether a timeline slot holds a committed entry. Timeline::append publishes the commit marker
+/// last, so a slot a crash left unwritten or half-written reads as uncommitted.
+constexpr bool isCommitted(const TimelineEntry& entry) noexcept
+{
+  return entry.mCommitted != 0ULL;
+}
+
+/// Whether a shard slot holds a committed entry, as for a TimelineEntry.
+constexpr bool isCommitted(const StampedEntry& entry) noexcept
+{
+  return isCommitted(entry.mEntry);
+}
+
+/// Length of @p timeline up to and including its last committed entry, found by binary search plus
+/// a scan of at most kTailScanWindow slots. A cleanly closed timeline is committed throughout but
+/// for its first @p discarded entries (see discardedLength).
+std::uint64_t committedLength(
+    std::span<const TimelineEntry> timeline,
+    std::uint64_t discarded = 0ULL) noexcept;
+
+/// How many leading entries of the single-file timeline in @p logRoot were discarded, as recorded
+/// in kDiscardedFileName; zero if none were.
+///
+/// @throws std::runtime_error If the file exists but cannot be mapped.
+std::uint64_t discardedLength(const std::filesystem::path& logRoot);
+
+/// Record this build's ChronicleFormat in kFormatFileName at @p logRoot.
+///
+/// @throws std::runtime_error If the file cannot be written.
+void writeFormat(const std::filesystem::path& logRoot);
+
+/// Check that the chronicle in @p logRoot was recorded in this build's ChronicleFormat. One that
+/// recorded no timeline has no entries to misread, so it passes with or without a format file.
+///
+/// @throws std::runtime_error If the chronicle holds a timeline in an older layout, one that
+/// predates kFormatFileName, or in a layout that is not a chronicle's at all.
+void requireFormat(const std::filesystem::path& logRoot);
+
+/// As committedLength, for one shard of a sharded timeline.
+std::uint64_t committedLength(std::span<const StampedEntry> shard) noexcept;
+
+/// The order mergeShards puts the entries of a sharded timeline in.
+struct MergedShards
+{
+  /// The committed entries as shard positions (see makeShardPosition), in merged order.
+  std::vector<std::uint64_t> mOrder;
+
+  /// The merge key of every stride-th entry of mOrder, paired with the entry's index in it. The
+  /// keys never decrease, so a seek binary-searches them as it does a single-file time index.
+  std::vector<TimeIndexEntry> mSamples;
+};
+
+/// Merge the committed entries of @p shards by their stamps into one global order, sampling every
+/// @p sampleStride-th entry's key. Each shard must be cut to its committedLength.
+///
+/// Producers on one core may stamp their entries slightly out of the order they claimed them in,
+/// so an entry stamped before its predecessor in the shard is taken to share the predecessor's
+/// stamp; each shard then stays in its own order. Equal stamps go to the lower shard first.
+MergedShards mergeShards(
+    std::span<const std::span<const StampedEntry>> shards,
+    std::uint64_t sampleStride = Timeline::kDefaultTimeIndexStride);
+
+/// Merge the shards of the sharded timeline in @p logRoot and write the result beside them: the
+/// order to kMergedOrderFileName and its samples to kTimeIndexFileName. A Reader that finds both
+/// maps them instead of merging the shards itself.
+///
+/// @throws std::runtime_error If a file cannot be mapped or written.
+void writeMergedOrder(const std::filesystem::path& logRoot, std::uint64_t sampleStride);
+
+/// The number of shards of the timeline in @p logRoot; zero if it is not sharded.
+std::uint64_t countShards(const std::filesystem::path& logRoot);
+
+/// Make @p to share @p from's bytes: by a hard link, else a reflink, else a copy. A copy is synced.
+///
+/// @throws std::filesystem::filesystem_error If @p from cannot be copied.
+void linkRoll(const std::filesystem::path& from, const std::filesystem::path& to);
+
+/// Flush @p path to disk: a file's bytes, or a directory's entries, so files created, renamed, or
+/// linked in it stay so across a crash.
+///
+/// @throws std::runtime_error If @p path cannot be opened or synced.
+void syncPath(const std::filesystem::path& path);
+
+/// Raise each sample in @p samples to the latest stamp before it, so the stamps never decrease
+/// along the index however the producers that wrote them interleaved.
+void clampToRunningMax(std::span<TimeIndexEntry> samples) noexcept;
+
+/// Length of @p timeIndex up to its first sample that was never written or that samples a position
+/// at or past @p timelineLength.
+std::uint64_t sampledLength(
+    std::span<const TimeIndexEntry> timeIndex,
+    std::uint64_t timelineLength) noexcept;
+
+/// Load @p value with acquire ordering through a mapping that may be read-only, as a Follower maps
+/// the files another process writes.
+template<typename Value>
+Value loadAcquire(const Value& value) noexcept
+{
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast): atomic_ref views no const object; a load
+  // does not write.
+  return std::atomic_ref{const_cast<Value&>(value)}.load(std::memory_order_acquire);
+}
+
+/// Bump @p doorbell's sequence and wake every Follower sleeping on it, in any process. Everything
+/// stored into the doorbell before is visible to a Follower that sees the new sequence.
+void ringDoorbell(Doorbell& doorbell) noexcept;
+
+/// Sleep until @p doorbell's sequence moves on from @p sequence, or @p timeout passes. Returns at
+/// once if it has moved on already; may also return spuriously.
+void waitForDoorbell(
+    const Doorbell& doorbell,
+    std::uint32_t sequence,
+    std::chrono::nanoseconds timeout) noexcept;
+
+/// The address of the Unix socket at @p path, as a Broker listens on and a Subscriber connects to.
+///
+/// @throws std::invalid_argument If @p path is too long for a Unix socket address.
+::sockaddr_un makeSocketAddress(const std::filesystem::path& path);
+
+/// Convert @p frame between host byte order and the little-endian order it travels in. Its own
+/// inverse, so the sender and the receiver both use it.
+BridgeFrame toWireOrder(BridgeFrame frame) noexcept;
+
+/// Bound each blocking call on @p socket in the direction of @p option (SO_RCVTIMEO or
+/// SO_SNDTIMEO) to @p timeout; one that stalls longer fails with EAGAIN.
+void setSocketTimeout(int socket, int option, std::chrono::nanoseconds timeout) noexcept;
+
+/// Map @p path if the chronicle recorded anything into it. A missing or empty (trimmed,
+/// never-written) file holds nothing and cannot be mapped, so it maps to null.
+template<typename Array>
+std::unique_ptr<const Array> mapIfRecorded(const std::filesystem::path& path)
+{
+  auto errorCode = std::error_code{};
+  if(const auto byteCount = std::filesystem::file_size(path, errorCode);
+     not errorCode and byteCount > 0)
+  {
+    return std::make_unique<const Array>(path);
+  }
+  return nullptr;
+}
+
+/// A mapped shard of a sharded timeline.
+using ShardFile = containers::MmapConstArray<StampedEntry>;
+
+/// Map the @p shardCount shards named for @p stem in @p logRoot, in shard order. A shard with
+/// nothing recorded in it maps to null, like mapIfRecorded.
+template<typename Array>
+std::vector<std::unique_ptr<const Array>> mapShards(
+    const std::filesystem::path& logRoot,
+    const std::string_view stem,
+    const std::uint64_t shardCount)
+{
+  auto shards = std::vector<std::unique_ptr<const Array>>{};
+  shards.reserve(shardCount);
+  for(auto shard = std::uint64_t{0ULL}; shard < shardCount; ++shard)
+  {
+    shards.push_back(mapIfRecorded<Array>(logRoot / buildShardName(stem, shard)));
+  }
+  return shards;
+}
+
+/// The committed prefix of each of @p shards, empty for a shard that maps to null.
+std::vector<std::span<const StampedEntry>> committedShards(
+    const std::vector<std::unique_ptr<const ShardFile>>& shards);
+
 } // namespace nioc::chronicle
@@ -5,31 +5,165 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "utils.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <nioc/chronicle/channel.hpp>
+#include <nioc/chronicle/channelIndex.hpp>
 #include <nioc/chronicle/writer.hpp>
+#include <nioc/common/exception.hpp>
 #include <nioc/common/filesystem.hpp>
 #include <nioc/common/utils.hpp>
 #include <nioc/logger/logger.hpp>
+#include <stdexcept>
+#include <stop_token>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace nioc::chronicle
 {
+namespace
+{
+
+/// Return @p writeback, once sure its rolls reach a file a Reader can open.
+Writeback requireStored(const Writeback& writeback)
+{
+  if(writeback.mMode == containers::WriteMode::Memory)
+  {
+    common::throwException<std::invalid_argument>(
+        "A chronicle's rolls must reach disk; use a MemoryWriter to keep records in memory only.");
+  }
+  return writeback;
+}
+
+/// Return @p writeback, once sure Followers can tail what it writes if a doorbell invites them.
+Writeback requireTailable(
+    const Writeback& writeback,
+    const std::chrono::nanoseconds doorbellInterval)
+{
+  if(writeback.mMode == containers::WriteMode::Direct and
+     doorbellInterval > std::chrono::nanoseconds::zero())
+  {
+    common::throwException<std::invalid_argument>(
+        "Followers cannot tail a chronicle whose rolls reach disk only as written through; ask for "
+        "either a doorbell or direct writeback, not both.");
+  }
+  return writeback;
+}
+
+/// Bytes each channel's rolls grow to: @p rollCapacity, unless @p writeback stages them in memory
+/// and bounds what it stages.
+std::size_t channelRollCapacity(const std::size_t rollCapacity, const Writeback& writeback)
+{
+  if(writeback.mMode != containers::WriteMode::Direct or writeback.mStagingBytes == 0ULL)
+  {
+    return rollCapacity;
+  }
+  return std::min<std::size_t>(rollCapacity, writeback.mStagingBytes);
+}
+
+} // namespace
 
 Writer::Writer(
     std::filesystem::path rootDir,
     const std::size_t rollCapacity,      // NOLINT(bugprone-easily-swappable-parameters)
     const std::size_t timelineCapacity): // NOLINT(bugprone-easily-swappable-parameters)
+  Writer{
+      std::move(rootDir),
+      WriterOptions{.mRollCapacity = rollCapacity, .mTimelineCapacity = timelineCapacity}}
+{
+}
+
+Writer::Writer(std::filesystem::path rootDir, const WriterOptions& options):
   mLogRoot{common::requireEmptyDirectory(std::move(rootDir))},
-  mRollCapacity{rollCapacity},
-  mTimeline{mLogRoot / kTimelineFileName, timelineCapacity / sizeof(TimelineEntry)}
+  mRollCapacity{options.mRollCapacity},
+  mRetention{options.mRetention},
+  mWriteback{requireTailable(requireStored(options.mWriteback), options.mDoorbellInterval)},
+  mCompression{options.mCompression},
+  mRollPolicy{options.mRollPolicy},
+  mChannelPolicies{options.mChannelPolicies},
+  mTimeline{
+      mLogRoot,
+      options.mTimelineCapacity /
+          (options.mTimelineShards > 1 ? sizeof(StampedEntry) : sizeof(TimelineEntry)),
+      options.mTimeIndexStride,
+      options.mChecksums,
+      options.mTimelineShards,
+      options.mTimelinePolicy},
+  mDoorbellInterval{options.mDoorbellInterval}
 {
   logger::info("Writing chronicle to {} with roll capacity {}.", mLogRoot.string(), mRollCapacity);
+
+  if(mWriteback.mInterval > std::chrono::nanoseconds::zero() or isBounded(mRetention))
+  {
+    mWritebackThread =
+        std::jthread([this](const std::stop_token& stopToken) { paceWriteback(stopToken); });
+  }
+
+  // Created after the timeline, so a Follower that finds the doorbell finds the timeline too.
+  if(mDoorbellInterval > std::chrono::nanoseconds::zero())
+  {
+    mDoorbell.emplace(mLogRoot / kDoorbellFileName, 1);
+    mDoorbellThread =
+        std::jthread([this](const std::stop_token& stopToken) { paceDoorbell(stopToken); });
+  }
 }
 
 Writer::~Writer()
 {
+  if(mWritebackThread.joinable())
+  {
+    mWritebackThread.request_stop();
+    mWritebackThread.join();
+  }
+
+  // Followers never read past the published lengths, so publishing the final ones before the
+  // timeline is trimmed keeps them clear of the pages the trim unmaps.
+  if(mDoorbellThread.joinable())
+  {
+    mDoorbellThread.request_stop();
+    mDoorbellThread.join();
+  }
+  if(mDoorbell)
+  {
+    publishCommitted(true);
+  }
+
   mTimeline.shrink_to_fit();
+
+  // Each channel indexes its records as they commit, but a sharded timeline's positions count
+  // along the order its shards merge into, known only now.
+  if(mTimeline.shardCount() > 1)
+  {
+    try
+    {
+      writeMergedOrder(mLogRoot, mTimeline.timeIndexStride());
+    }
+    catch(const std::exception& exception)
+    {
+      logger::error(
+          "Unable to write the merged order of {}; readers will merge its shards instead: {}",
+          mLogRoot.string(),
+          exception.what());
+    }
+
+    try
+    {
+      buildChannelIndices(mLogRoot);
+    }
+    catch(const std::exception& exception)
+    {
+      logger::error(
+          "Unable to index the channels of {}; readers will scan its timeline instead: {}",
+          mLogRoot.string(),
+          exception.what());
+    }
+  }
 }
 
 Channel& Writer::channel(const ChannelId channelId)
@@ -40,11 +174,16 @@ Channel& Writer::channel(const ChannelId channelId)
         auto& channelPtr = channelMap[channelId];
         if(not channelPtr)
         {
+          const auto policy = mChannelPolicies.find(channelId);
           channelPtr = std::make_unique<Channel>(
               channelId,
               mLogRoot / common::hexString(channelId.mValue),
-              mRollCapacity,
-              mTimeline);
+              channelRollCapacity(mRollCapacity, mWriteback),
+              mTimeline,
+              mRetention,
+              mCompression,
+              mWriteback,
+              policy == mChannelPolicies.end() ? mRollPolicy : policy->second);
         }
         return *channelPtr;
       });
@@ -55,9 +194,156 @@ Crate Writer::write(const ChannelId channelId, const std::span<const std::byte>
   return channel(channelId).write(data);
 }
 
+void Writer::checkpoint()
+{
+  for(auto* const channel: channels())
+  {
+    channel->sync();
+  }
+  mTimeline.sync();
+}
+
 const std::filesystem::path& Writer::path() const noexcept
 {
   return mLogRoot;
 }
 
+void Writer::paceWriteback(const std::stop_token& stopToken)
+{
+  // The rate's share of one interval; at least a byte, so a tiny rate still makes progress.
+  const auto budgetPerPass = [this]() -> std::uint64_t
+  {
+    if(mWriteback.mBytesPerSecond == 0ULL)
+    {
+      return std::numeric_limits<std::uint64_t>::max();
+    }
+    const auto seconds = std::chrono::duration<double>{mWriteback.mInterval}.count();
+    return std::max(
+        std::uint64_t{1ULL},
+        static_cast<std::uint64_t>(static_cast<double>(mWriteback.mBytesPerSecond) * seconds));
+  }();
+
+  const auto pacing = mWriteback.mInterval > std::chrono::nanoseconds::zero();
+  const auto interval = pacing ? mWriteback.mInterval : kRetentionInterval;
+  while(not stopToken.stop_requested())
+  {
+    {
+      auto lock = std::unique_lock{mWritebackMutex};
+      const auto neverReady = [] { return false; };
+      static_cast<void>(mWritebackCondition.wait_for(lock, stopToken, interval, neverReady));
+    }
+    if(stopToken.stop_requested())
+    {
+      return;
+    }
+
+    if(pacing)
+    {
+      auto budget = budgetPerPass;
+      for(auto* const channel: channels())
+      {
+        budget -= channel->startWriteback(budget);
+      }
+      mTimeline.startWriteback();
+    }
+    if(isBounded(mRetention))
+    {
+      enforceRetention();
+    }
+  }
+}
+
+void Writer::enforceRetention() noexcept
+{
+  // Every record a channel keeps lies at or past its keptFrom(), so the entries before the earliest
+  // of them locate deleted records only.
+  const auto channelList = channels();
+  auto keptFrom = std::numeric_limits<std::uint64_t>::max();
+  try
+  {
+    for(auto* const channel: channelList)
+    {
+      channel->expire();
+      keptFrom = std::min(keptFrom, channel->keptFrom());
+    }
+    if(keptFrom == std::numeric_limits<std::uint64_t>::max())
+    {
+      return;
+    }
+
+    for(auto* const channel: channelList)
+    {
+      channel->discardIndex(keptFrom);
+    }
+    mTimeline.discard(keptFrom);
+  }
+  catch(const std::exception& exception)
+  {
+    logger::error(
+        "Unable to discard the expired timeline entries of {}: {}",
+        mLogRoot.string(),
+        exception.what());
+  }
+}
+
+void Writer::paceDoorbell(const std::stop_token& stopToken)
+{
+  while(not stopToken.stop_requested())
+  {
+    {
+      auto lock = std::unique_lock{mDoorbellMutex};
+      const auto neverReady = [] { return false; };
+      static_cast<void>(
+          mDoorbellCondition.wait_for(lock, stopToken, mDoorbellInterval, neverReady));
+    }
+    if(stopToken.stop_requested())
+    {
+      return;
+    }
+
+    publishCommitted(false);
+  }
+}
+
+void Writer::publishCommitted(const bool closing) noexcept
+{
+  const auto shardCount = mTimeline.shardCount();
+  auto committed = mPublished;
+  mTimeline.scanCommitted(std::span{committed}.first(shardCount));
+  if(committed == mPublished and not closing)
+  {
+    return;
+  }
+
+  auto& doorbell = (*mDoorbell)[0];
+  for(auto shard = std::size_t{0}; shard < shardCount; ++shard)
+  {
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-avoid-unchecked-container-access): one per shard.
+    std::atomic_ref{doorbell.mCommitted[shard]}.store(committed[shard], std::memory_order_release);
+    // NOLINTEND(cppcoreguidelines-pro-bounds-avoid-unchecked-container-access)
+  }
+  if(closing)
+  {
+    std::atomic_ref{doorbell.mClosed}.store(1U, std::memory_order_release);
+  }
+  mPublished = committed;
+
+  ringDoorbell(doorbell);
+}
+
+std::vector<Channel*> Writer::channels() const
+{
+  return mLockedChannelMap.cExecute(
+      [](const ChannelMap& channelMap)
+      {
+        auto channels = std::vector<Channel*>{};
+        channels.reserve(channelMap.size());
+        for(const auto& [channelId, channel]: channelMap)
+        {
+          channels.push_back(channel.get());
+        }
+        return channels;
+      });
+}
+
 } // namespace nioc::chronicle
@@ -0,0 +1,159 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <memory>
+#include <nioc/chronicle/bridgeReceiver.hpp>
+#include <nioc/chronicle/bridgeSender.hpp>
+#include <nioc/chronicle/reader.hpp>
+#include <nioc/chronicle/writer.hpp>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+
+namespace nioc::chronicle
+{
+namespace
+{
+namespace fs = std::filesystem;
+
+constexpr auto channelA = ChannelId{16983ULL};
+constexpr auto channelB = ChannelId{68964786ULL};
+constexpr auto kLoopback = "127.0.0.1";
+constexpr auto kPatience = std::chrono::seconds{10};
+
+fs::path makeFreshEmptyDir(const std::string_view name)
+{
+  const auto path = fs::temp_directory_path() / "nioc-chronicleTest" / name;
+  fs::remove_all(path);
+  fs::create_directories(path);
+  return path;
+}
+
+std::unique_ptr<Writer> makeWriter(const fs::path& dir)
+{
+  // Small rolls, so a few hundred records span many of them.
+  return std::make_unique<Writer>(dir, 256);
+}
+
+void writeNumber(Writer& writer, const ChannelId channelId, const std::uint64_t number)
+{
+  static_cast<void>(writer.write(channelId, std::as_bytes(std::span{&number, 1})));
+}
+
+std::uint64_t readNumber(const Entry& entry)
+{
+  auto number = std::uint64_t{0ULL};
+  EXPECT_EQ(entry.mCrate.span().size(), sizeof(number));
+  std::memcpy(&number, entry.mCrate.span().data(), sizeof(number));
+  return number;
+}
+
+} // namespace
+
+TEST(Bridge, forwardedRecordsAreRecordedOnTheReceivingSide)
+{
+  const auto sendingDir = makeFreshEmptyDir("bridgeSending");
+  const auto receivingDir = makeFreshEmptyDir("bridgeReceiving");
+  constexpr auto kCount = 500ULL;
+  {
+    auto receivingWriter = makeWriter(receivingDir);
+    auto receiver = BridgeReceiver{*receivingWriter};
+    receiver.accept(channelA);
+
+    const auto sendingWriter = makeWriter(sendingDir);
+    {
+      auto sender = BridgeSender{*sendingWriter, kLoopback, receiver.port()};
+      sender.forward(channelA);
+      for(auto number = 0ULL; number < kCount; ++number)
+      {
+        writeNumber(*sendingWriter, channelA, number);
+      }
+    }
+
+    for(auto expected = 0ULL; expected < kCount; ++expected)
+    {
+      const auto entry = receiver.next(kPatience);
+      ASSERT_TRUE(entry.has_value());
+      EXPECT_EQ(entry->mChannelId, channelA);
+      EXPECT_EQ(readNumber(*entry), expected);
+    }
+  }
+
+  // The receiving chronicle holds the forwarded records under their own channel.
+  auto expected = 0ULL;
+  for(const auto& entry: Reader{receivingDir})
+  {
+    EXPECT_EQ(entry.mChannelId, channelA);
+    EXPECT_EQ(readNumber(entry), expected);
+    ++expected;
+  }
+  EXPECT_EQ(expected, kCount);
+}
+
+TEST(Bridge, recordsOfChannelsNotAcceptedAreDropped)
+{
+  const auto sendingWriter = makeWriter(makeFreshEmptyDir("bridgeFilterSending"));
+  const auto receivingWriter = makeWriter(makeFreshEmptyDir("bridgeFilterReceiving"));
+  auto receiver = BridgeReceiver{*receivingWriter};
+  receiver.accept(channelA);
+
+  auto sender = BridgeSender{*sendingWriter, kLoopback, receiver.port()};
+  sender.forward(channelA);
+  sender.forward(channelB);
+  writeNumber(*sendingWriter, channelB, 1ULL);
+  writeNumber(*sendingWriter, channelA, 2ULL);
+
+  const auto entry = receiver.next(kPatience);
+  ASSERT_TRUE(entry.has_value());
+  EXPECT_EQ(entry->mChannelId, channelA);
+  EXPECT_EQ(readNumber(*entry), 2ULL);
+  EXPECT_TRUE(receiver.connected());
+}
+
+TEST(Bridge, aSenderAnnouncingARecordPastTheLimitIsHungUpOn)
+{
+  const auto sendingWriter = makeWriter(makeFreshEmptyDir("bridgeLimitSending"));
+  const auto receivingWriter = makeWriter(makeFreshEmptyDir("bridgeLimitReceiving"));
+  auto receiver = BridgeReceiver{*receivingWriter, 0U, BridgeReceiver::kDefaultAddress, 4U};
+  receiver.accept(channelA);
+
+  auto sender = BridgeSender{*sendingWriter, kLoopback, receiver.port()};
+  sender.forward(channelA);
+  writeNumber(*sendingWriter, channelA, 1ULL);
+
+  EXPECT_FALSE(receiver.next(std::chrono::milliseconds{500}).has_value());
+  EXPECT_FALSE(receiver.connected());
+}
+
+TEST(Bridge, listeningOnAnAddressThatIsNotIPv4Throws)
+{
+  const auto writer = makeWriter(makeFreshEmptyDir("bridgeBadAddress"));
+  EXPECT_THROW((BridgeReceiver{*writer, 0U, "rig-b.local"}), std::invalid_argument);
+}
+
+TEST(Bridge, aReceiverTimesOutWithoutASender)
+{
+  const auto writer = makeWriter(makeFreshEmptyDir("bridgeIdle"));
+  auto receiver = BridgeReceiver{*writer};
+  EXPECT_FALSE(receiver.next(std::chrono::milliseconds{20}).has_value());
+  EXPECT_FALSE(receiver.connected());
+}
+
+TEST(Bridge, connectingWhereNothingListensThrows)
+{
+  const auto writer = makeWriter(makeFreshEmptyDir("bridgeAbsent"));
+  const auto port = BridgeReceiver{*writer}.port();
+  EXPECT_THROW((BridgeSender{*writer, kLoopback, port}), std::runtime_error);
+}
+
+} // namespace nioc::chronicle
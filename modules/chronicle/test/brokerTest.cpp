@@ -0,0 +1,160 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <memory>
+#include <nioc/chronicle/broker.hpp>
+#include <nioc/chronicle/subscriber.hpp>
+#include <nioc/chronicle/writer.hpp>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace nioc::chronicle
+{
+namespace
+{
+namespace fs = std::filesystem;
+
+constexpr auto channelA = ChannelId{16983ULL};
+constexpr auto channelB = ChannelId{68964786ULL};
+constexpr auto kProbe = ~0ULL;
+constexpr auto kPatience = std::chrono::seconds{10};
+
+fs::path makeFreshEmptyDir(const std::string_view name)
+{
+  const auto path = fs::temp_directory_path() / "nioc-chronicleTest" / name;
+  fs::remove_all(path);
+  fs::create_directories(path);
+  return path;
+}
+
+std::unique_ptr<Writer> makeWriter(const fs::path& dir)
+{
+  // Small rolls, so a few hundred records span many of them.
+  return std::make_unique<Writer>(dir, 256);
+}
+
+void writeNumber(Writer& writer, const ChannelId channelId, const std::uint64_t number)
+{
+  static_cast<void>(writer.write(channelId, std::as_bytes(std::span{&number, 1})));
+}
+
+std::uint64_t readNumber(const Entry& entry)
+{
+  auto number = std::uint64_t{0ULL};
+  EXPECT_EQ(entry.mCrate.span().size(), sizeof(number));
+  std::memcpy(&number, entry.mCrate.span().data(), sizeof(number));
+  return number;
+}
+
+/// Subscribe to @p channelId and wait until the Broker has taken the subscription in, probing the
+/// channel until a probe comes through, then draining the probes. The Broker's thread sends them,
+/// so the drain goes on until none has come for a while.
+void subscribeAndSettle(Writer& writer, Subscriber& subscriber, const ChannelId channelId)
+{
+  subscriber.subscribe(channelId);
+  const auto deadline = std::chrono::steady_clock::now() + kPatience;
+  while(std::chrono::steady_clock::now() < deadline)
+  {
+    writeNumber(writer, channelId, kProbe);
+    if(subscriber.next(std::chrono::milliseconds{1}).has_value())
+    {
+      break;
+    }
+  }
+  while(subscriber.next(std::chrono::milliseconds{50}).has_value())
+  {
+  }
+}
+
+} // namespace
+
+TEST(Broker, subscribersReceiveEveryLaterRecordAcrossRolls)
+{
+  const auto dir = makeFreshEmptyDir("brokerRolls");
+  const auto writer = makeWriter(dir);
+  auto broker = Broker{*writer, dir / "broker.sock"};
+  broker.share(channelA);
+
+  auto subscriber = Subscriber{broker.path()};
+  subscribeAndSettle(*writer, subscriber, channelA);
+
+  // Far more rolls than a Subscriber keeps mapped, so rolls are dropped and new ones passed on.
+  constexpr auto kCount = 500ULL;
+  for(auto number = 0ULL; number < kCount; ++number)
+  {
+    writeNumber(*writer, channelA, number);
+  }
+
+  auto first = std::optional<Entry>{};
+  for(auto expected = 0ULL; expected < kCount; ++expected)
+  {
+    auto entry = subscriber.next(kPatience);
+    ASSERT_TRUE(entry.has_value());
+    EXPECT_EQ(entry->mChannelId, channelA);
+    EXPECT_EQ(readNumber(*entry), expected);
+    if(not first)
+    {
+      first = std::move(entry);
+    }
+  }
+
+  // The first record's roll is no longer mapped by the Subscriber, but its Crate still holds it.
+  EXPECT_EQ(readNumber(*first), 0ULL);
+  EXPECT_FALSE(subscriber.next(std::chrono::milliseconds{20}).has_value());
+}
+
+TEST(Broker, subscribersReceiveOnlyTheChannelsTheySubscribedTo)
+{
+  const auto dir = makeFreshEmptyDir("brokerChannels");
+  const auto writer = makeWriter(dir);
+  auto broker = Broker{*writer, dir / "broker.sock"};
+  broker.share(channelA);
+  broker.share(channelB);
+
+  auto subscriber = Subscriber{broker.path()};
+  subscribeAndSettle(*writer, subscriber, channelB);
+
+  writeNumber(*writer, channelA, 1ULL);
+  writeNumber(*writer, channelB, 2ULL);
+  writeNumber(*writer, channelA, 3ULL);
+
+  const auto entry = subscriber.next(kPatience);
+  ASSERT_TRUE(entry.has_value());
+  EXPECT_EQ(entry->mChannelId, channelB);
+  EXPECT_EQ(readNumber(*entry), 2ULL);
+  EXPECT_FALSE(subscriber.next(std::chrono::milliseconds{20}).has_value());
+}
+
+TEST(Broker, subscribersSeeTheBrokerHangUp)
+{
+  const auto dir = makeFreshEmptyDir("brokerHangUp");
+  const auto writer = makeWriter(dir);
+  auto broker = std::make_unique<Broker>(*writer, dir / "broker.sock");
+  auto subscriber = Subscriber{broker->path()};
+  EXPECT_FALSE(subscriber.closed());
+
+  broker.reset();
+  EXPECT_FALSE(subscriber.next(kPatience).has_value());
+  EXPECT_TRUE(subscriber.closed());
+  EXPECT_FALSE(fs::exists(dir / "broker.sock"));
+}
+
+TEST(Broker, subscribingWhereNoBrokerListensThrows)
+{
+  const auto dir = makeFreshEmptyDir("brokerAbsent");
+  EXPECT_THROW((Subscriber{dir / "broker.sock"}), std::runtime_error);
+}
+
+} // namespace nioc::chronicle
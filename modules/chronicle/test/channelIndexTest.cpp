@@ -0,0 +1,136 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "utils.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <memory>
+#include <nioc/chronicle/channelIndex.hpp>
+#include <nioc/chronicle/writer.hpp>
+#include <nioc/common/utils.hpp>
+#include <nioc/containers/mmapConstArray.hpp>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace nioc::chronicle
+{
+namespace
+{
+namespace fs = std::filesystem;
+
+constexpr auto channelA = ChannelId{16983ULL};
+constexpr auto channelB = ChannelId{68964786ULL};
+
+fs::path freshDir(const std::string_view name)
+{
+  const auto path = fs::temp_directory_path() / "nioc-chronicleTest" / name;
+  fs::remove_all(path);
+  fs::create_directories(path);
+  return path;
+}
+
+fs::path indexPath(const fs::path& logRoot, const ChannelId channelId)
+{
+  return logRoot / common::hexString(channelId.mValue) / kChannelIndexFileName;
+}
+
+std::vector<std::uint64_t> readIndex(const fs::path& file)
+{
+  if(fs::file_size(file) == 0)
+  {
+    return {}; // an empty index holds nothing and cannot be mapped
+  }
+  const auto array = containers::MmapConstArray<std::uint64_t>{file};
+  return {array.begin(), array.end()};
+}
+
+// Records A B A A B and returns the chronicle's root.
+fs::path recordInterleaved(const std::string_view name)
+{
+  const auto payload = std::vector<std::byte>(8);
+  auto writer = Writer{freshDir(name), 256};
+  for(const auto channelId: {channelA, channelB, channelA, channelA, channelB})
+  {
+    writer.write(channelId, payload);
+  }
+  return writer.path();
+}
+
+} // namespace
+
+TEST(ChannelIndex, writerIndexesEachChannelOnClose)
+{
+  const auto logRoot = recordInterleaved("ciOnClose");
+
+  EXPECT_EQ(readIndex(indexPath(logRoot, channelA)), (std::vector<std::uint64_t>{0, 2, 3}));
+  EXPECT_EQ(readIndex(indexPath(logRoot, channelB)), (std::vector<std::uint64_t>{1, 4}));
+}
+
+TEST(ChannelIndex, aChannelIndexesItsRecordsAsTheyCommit)
+{
+  const auto payload = std::vector<std::byte>(8);
+  auto writer = std::make_unique<Writer>(freshDir("ciOnCommit"), 256);
+  const auto logRoot = writer->path();
+  writer->write(channelA, payload);
+
+  // Written as the records commit, and put in place only once the channel closes.
+  const auto unfinished = fs::path{indexPath(logRoot, channelA)} += kTemporaryFileSuffix;
+  EXPECT_TRUE(fs::exists(unfinished));
+  EXPECT_FALSE(fs::exists(indexPath(logRoot, channelA)));
+
+  writer.reset();
+  EXPECT_FALSE(fs::exists(unfinished));
+  EXPECT_EQ(readIndex(indexPath(logRoot, channelA)), (std::vector<std::uint64_t>{0}));
+}
+
+TEST(ChannelIndex, dropsAnIndexAWriterLeftUnfinished)
+{
+  const auto logRoot = recordInterleaved("ciUnfinished");
+  const auto unfinished = fs::path{indexPath(logRoot, channelA)} += kTemporaryFileSuffix;
+  fs::rename(indexPath(logRoot, channelA), unfinished);
+
+  buildChannelIndices(logRoot);
+
+  EXPECT_FALSE(fs::exists(unfinished));
+  EXPECT_EQ(readIndex(indexPath(logRoot, channelA)), (std::vector<std::uint64_t>{0, 2, 3}));
+}
+
+TEST(ChannelIndex, rebuildsAMissingIndex)
+{
+  const auto logRoot = recordInterleaved("ciRebuild");
+  fs::remove(indexPath(logRoot, channelA));
+  fs::remove(indexPath(logRoot, channelB));
+
+  buildChannelIndices(logRoot);
+
+  EXPECT_EQ(readIndex(indexPath(logRoot, channelA)), (std::vector<std::uint64_t>{0, 2, 3}));
+  EXPECT_EQ(readIndex(indexPath(logRoot, channelB)), (std::vector<std::uint64_t>{1, 4}));
+}
+
+TEST(ChannelIndex, aChannelWithoutRecordsGetsAnEmptyIndex)
+{
+  const auto logRoot = [&]
+  {
+    auto writer = Writer{freshDir("ciUncommitted"), 256};
+    static_cast<void>(writer.channel(channelA).reserve(8)); // dropped: released, never committed
+    return writer.path();
+  }();
+
+  EXPECT_TRUE(fs::exists(indexPath(logRoot, channelA)));
+  EXPECT_TRUE(readIndex(indexPath(logRoot, channelA)).empty());
+}
+
+TEST(ChannelIndex, rejectsMissingDirectory)
+{
+  const auto missing = fs::temp_directory_path() / "nioc-chronicleTest" / "ciAbsent";
+  fs::remove_all(missing);
+  EXPECT_THROW(buildChannelIndices(missing), std::invalid_argument);
+}
+
+} // namespace nioc::chronicle
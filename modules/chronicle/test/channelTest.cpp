@@ -6,18 +6,20 @@
 
 #include "utils.hpp"
 #include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <filesystem>
 #include <gtest/gtest.h>
 #include <nioc/chronicle/channel.hpp>
 #include <nioc/chronicle/crate.hpp>
 #include <nioc/chronicle/defines.hpp>
-#include <nioc/containers/mmapArray.hpp>
+#include <nioc/chronicle/timeline.hpp>
 #include <nioc/containers/mmapConstArray.hpp>
-#include <nioc/containers/tape.hpp>
 #include <span>
 #include <string_view>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -27,8 +29,6 @@ namespace
 {
 namespace fs = std::filesystem;
 
-using TimelineTape = containers::Tape<containers::MmapArray<TimelineEntry>>;
-
 constexpr auto channelA = ChannelId{16983ULL};
 constexpr auto kRollCapacity = std::size_t{4096};
 constexpr auto kTimelineEntries = std::size_t{64}; // far more than any test below records
@@ -72,7 +72,7 @@ TEST(Channel, recordedFrameLandsInRollAndTimeline)
 
   auto crate = Crate{};
   {
-    auto timeline = TimelineTape{dir / kTimelineFileName, kTimelineEntries};
+    auto timeline = Timeline{dir, kTimelineEntries};
     auto channel = Channel{channelA, dir / "chanA", kRollCapacity, timeline};
     crate = channel.write(data);
     timeline.shrink_to_fit(); // trim to the written entries for the read-back below
@@ -99,7 +99,7 @@ TEST(Channel, anAbandonedReservationRecordsNothing)
   const auto dir = freshDir("chAbandon");
 
   {
-    auto timeline = TimelineTape{dir / kTimelineFileName, kTimelineEntries};
+    auto timeline = Timeline{dir, kTimelineEntries};
     auto channel = Channel{channelA, dir / "chanA", kRollCapacity, timeline};
 
     auto reservation = channel.reserve(16); // built but never made into a crate
@@ -113,7 +113,7 @@ TEST(Channel, anAbandonedReservationRecordsNothing)
 TEST(Channel, anAbandonedReservationRewindsSoItsSpaceIsReused)
 {
   const auto dir = freshDir("chAbandonRewind");
-  auto timeline = TimelineTape{dir / kTimelineFileName, kTimelineEntries};
+  auto timeline = Timeline{dir, kTimelineEntries};
   auto channel = Channel{channelA, dir / "chanA", kRollCapacity, timeline};
 
   const std::byte* start = nullptr;
@@ -135,7 +135,7 @@ TEST(Channel, rollsOverToANewRollWhenFull)
       std::byte{7}); // 104 word-aligned; two will not share a 128-byte roll
 
   {
-    auto timeline = TimelineTape{dir / kTimelineFileName, kTimelineEntries};
+    auto timeline = Timeline{dir, kTimelineEntries};
     auto channel = Channel{channelA, dir / "chanA", kTinyRoll, timeline};
     static_cast<void>(channel.write(frame)); // roll 0
     static_cast<void>(channel.write(frame)); // roll 1
@@ -158,7 +158,7 @@ TEST(Channel, aFrameLargerThanTheRollCapacityGetsItsOwnRoll)
   const auto big = makeBytes(300, std::byte{3});
 
   {
-    auto timeline = TimelineTape{dir / kTimelineFileName, kTimelineEntries};
+    auto timeline = Timeline{dir, kTimelineEntries};
     auto channel = Channel{channelA, dir / "chanA", kTinyRoll, timeline};
     static_cast<void>(channel.write(big));
   }
@@ -175,7 +175,7 @@ TEST(Channel, reclaimsTheUnusedTailOfAnOverReservation)
   const auto frame = makeBytes(8, std::byte{1});
 
   {
-    auto timeline = TimelineTape{dir / kTimelineFileName, kTimelineEntries};
+    auto timeline = Timeline{dir, kTimelineEntries};
     auto channel = Channel{channelA, dir / "chanA", kTinyRoll, timeline};
 
     // Reserve more than each frame uses, then commit only a few bytes so the over-reservation's
@@ -201,6 +201,78 @@ TEST(Channel, reclaimsTheUnusedTailOfAnOverReservation)
   EXPECT_FALSE(fs::exists(dir / "chanA" / buildRollName(1)));
 }
 
+TEST(Channel, accountsForEveryReservedByte)
+{
+  const auto dir = freshDir("chUsage");
+  auto timeline = Timeline{dir, kTimelineEntries};
+  auto channel = Channel{channelA, dir / "chanA", kRollCapacity, timeline};
+
+  // Still the latest claim at commit: the unused tail goes back, but for the word padding.
+  {
+    auto reservation = channel.reserve(100);
+    static_cast<void>(std::move(reservation).commit(10));
+  }
+
+  // A later claim strands the unused tail of an earlier one, and keeps a dropped one's bytes.
+  auto first = channel.reserve(40);
+  {
+    auto dropped = channel.reserve(24);
+    auto last = channel.reserve(8);
+    static_cast<void>(std::move(first).commit(8));
+    static_cast<void>(std::move(last).commit(8));
+  }
+
+  // A shrunk reservation hands its tail back at once, and its span says so.
+  {
+    auto reservation = channel.reserve(64);
+    reservation.modify(10);
+    EXPECT_EQ(reservation.span().size(), 16U);
+    static_cast<void>(std::move(reservation).commit(10));
+  }
+
+  const auto usage = channel.usage();
+  EXPECT_EQ(usage.mReservedBytes, 104U + 40U + 24U + 8U + 64U);
+  EXPECT_EQ(usage.mCommittedBytes, 10U + 8U + 8U + 10U);
+  EXPECT_EQ(usage.mReclaimedBytes, 88U + 48U);
+  EXPECT_EQ(usage.mStrandedBytes, 6U + 32U + 6U);
+  EXPECT_EQ(usage.mAbandonedBytes, 24U);
+  EXPECT_EQ(usage.mLaneSlackBytes, 0U);
+  EXPECT_EQ(
+      usage.mCommittedBytes + usage.mReclaimedBytes + usage.mStrandedBytes + usage.mAbandonedBytes,
+      usage.mReservedBytes);
+  EXPECT_EQ(usage.wastedBytes(), 6U + 32U + 6U + 24U);
+}
+
+TEST(Channel, keepsASpareRollReadyAndDeletesItOnClose)
+{
+  const auto dir = freshDir("chSpare");
+  constexpr auto kTinyRoll = std::size_t{128};
+  const auto frame = makeBytes(100, std::byte{3}); // one frame per 128-byte roll
+
+  {
+    auto timeline = Timeline{dir, kTimelineEntries};
+    auto channel = Channel{channelA, dir / "chanA", kTinyRoll, timeline};
+    static_cast<void>(channel.write(frame)); // roll 0; a spare is prepared
+    static_cast<void>(channel.write(frame)); // swaps in the spare as roll 1, or opens it inline
+    static_cast<void>(channel.write(frame)); // likewise roll 2
+
+    // A spare is renamed for its roll as it is swapped in, whether or not it was ready in time.
+    EXPECT_TRUE(fs::exists(dir / "chanA" / buildRollName(2)));
+    timeline.shrink_to_fit();
+  }
+
+  // Full rolls are sealed down to their written bytes; the unused spare is gone.
+  EXPECT_EQ(fs::file_size(dir / "chanA" / buildRollName(0)), 104U);
+  EXPECT_EQ(fs::file_size(dir / "chanA" / buildRollName(1)), 104U);
+  EXPECT_EQ(fs::file_size(dir / "chanA" / buildRollName(2)), 104U);
+  EXPECT_FALSE(fs::exists(dir / "chanA" / buildRollName(3)));
+  EXPECT_FALSE(fs::exists(dir / "chanA" / kSpareRollFileName));
+
+  const auto entries = readEntries(dir / kTimelineFileName);
+  ASSERT_EQ(entries.size(), 3U);
+  EXPECT_EQ(entries.at(2).mRollId, 2U);
+}
+
 TEST(Channel, modifyGrowsAReservationInTheSameRollWhenItFits)
 {
   const auto dir = freshDir("chModifyFit");
@@ -208,7 +280,7 @@ TEST(Channel, modifyGrowsAReservationInTheSameRollWhenItFits)
 
   auto crate = Crate{};
   {
-    auto timeline = TimelineTape{dir / kTimelineFileName, kTimelineEntries};
+    auto timeline = Timeline{dir, kTimelineEntries};
     auto channel = Channel{channelA, dir / "chanA", kRollCapacity, timeline};
 
     auto reservation = channel.reserve(16); // start small
@@ -236,7 +308,7 @@ TEST(Channel, modifyRollsOverWhenTheNewSizeNoLongerFits)
 
   auto crate = Crate{};
   {
-    auto timeline = TimelineTape{dir / kTimelineFileName, kTimelineEntries};
+    auto timeline = Timeline{dir, kTimelineEntries};
     auto channel = Channel{channelA, dir / "chanA", kTinyRoll, timeline};
 
     auto reservation = channel.reserve(16); // fits in roll 0
@@ -263,7 +335,7 @@ TEST(Channel, aCrateStaysReadableAfterTheChannelRollsToANewRoll)
   const auto first = makeBytes(100, std::byte{1});
   const auto second = makeBytes(100, std::byte{200});
 
-  auto timeline = TimelineTape{dir / kTimelineFileName, kTimelineEntries};
+  auto timeline = Timeline{dir, kTimelineEntries};
   auto channel = Channel{channelA, dir / "chanA", kTinyRoll, timeline};
 
   const auto crateA = channel.write(first);  // lives in roll 0
@@ -274,4 +346,111 @@ TEST(Channel, aCrateStaysReadableAfterTheChannelRollsToANewRoll)
   EXPECT_TRUE(std::ranges::equal(crateB.span(), std::as_bytes(std::span{second})));
 }
 
+TEST(Channel, concurrentProducersShareOneChannelWithoutLosingOrWastingBytes)
+{
+  const auto dir = freshDir("chProducers");
+  constexpr auto kThreads = std::uint64_t{4};
+  constexpr auto kRecordsPerThread = std::uint64_t{200};
+  constexpr auto kRecordCount = kThreads * kRecordsPerThread;
+
+  {
+    auto timeline = Timeline{dir, kRecordCount};
+    auto channel = Channel{channelA, dir / "chanA", kRollCapacity, timeline};
+    {
+      auto producers = std::vector<std::jthread>{};
+      for(auto thread = std::uint64_t{0}; thread < kThreads; ++thread)
+      {
+        producers.emplace_back(
+            [&channel, thread]
+            {
+              // Over-reserve like a Publisher does, then commit only the payload.
+              for(auto index = std::uint64_t{0}; index < kRecordsPerThread; ++index)
+              {
+                const auto payload = std::array{thread, index};
+                auto reservation = channel.reserve(64);
+                std::memcpy(reservation.span().data(), payload.data(), sizeof(payload));
+                static_cast<void>(std::move(reservation).commit(sizeof(payload)));
+              }
+            });
+      }
+    }
+    timeline.shrink_to_fit();
+  }
+
+  const auto entries = readEntries(dir / kTimelineFileName);
+  ASSERT_EQ(entries.size(), kRecordCount);
+
+  auto nextIndex = std::array<std::uint64_t, kThreads>{};
+  auto rollBytes = std::uint64_t{0};
+  auto rollId = std::uint64_t{0};
+  for(; fs::exists(dir / "chanA" / buildRollName(rollId)); ++rollId)
+  {
+    rollBytes += fs::file_size(dir / "chanA" / buildRollName(rollId));
+  }
+
+  for(auto roll = std::uint64_t{0}; roll < rollId; ++roll)
+  {
+    const auto bytes = containers::MmapConstArray<std::byte>{dir / "chanA" / buildRollName(roll)};
+    for(const auto& entry: entries)
+    {
+      if(entry.mRollId != roll)
+      {
+        continue;
+      }
+      ASSERT_EQ(entry.mSize, 2U * sizeof(std::uint64_t));
+      auto payload = std::array<std::uint64_t, 2>{};
+      std::memcpy(payload.data(), std::span{bytes}.subspan(entry.mOffset).data(), entry.mSize);
+
+      // Each producer's records land on the timeline in the order it committed them.
+      ASSERT_LT(payload.at(0), kThreads);
+      EXPECT_EQ(payload.at(1), nextIndex.at(payload.at(0)));
+      ++nextIndex.at(payload.at(0));
+    }
+  }
+
+  for(const auto& count: nextIndex)
+  {
+    EXPECT_EQ(count, kRecordsPerThread);
+  }
+
+  // Every over-reservation's tail went back to its lane: far less than the 64 bytes reserved per
+  // record were kept, only the chunk ends each lane had not used when its roll filled.
+  EXPECT_LT(rollBytes, kRecordCount * 32U);
+}
+
+TEST(Channel, shortLivedProducersLeaveTheirLanesToTheThreadsAfterThem)
+{
+  const auto dir = freshDir("chShortLived");
+  constexpr auto kThreads = std::uint64_t{4};
+  constexpr auto kRounds = std::uint64_t{50};
+  constexpr auto kRecordsPerThread = std::uint64_t{4};
+  constexpr auto kRecordCount = kRounds * kThreads * kRecordsPerThread;
+
+  {
+    auto timeline = Timeline{dir, kRecordCount};
+    auto channel = Channel{channelA, dir / "chanA", kRollCapacity, timeline};
+    for(auto round = std::uint64_t{0}; round < kRounds; ++round)
+    {
+      auto producers = std::vector<std::jthread>{};
+      for(auto thread = std::uint64_t{0}; thread < kThreads; ++thread)
+      {
+        producers.emplace_back(
+            [&channel]
+            {
+              for(auto index = std::uint64_t{0}; index < kRecordsPerThread; ++index)
+              {
+                static_cast<void>(channel.write(makeBytes(16)));
+              }
+            });
+      }
+    }
+
+    // Each round's threads exit before the next round's start, so no more lanes than ran at once.
+    EXPECT_LE(channel.laneCount(), kThreads);
+    timeline.shrink_to_fit();
+  }
+
+  EXPECT_EQ(readEntries(dir / kTimelineFileName).size(), kRecordCount);
+}
+
 } // namespace nioc::chronicle
@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <nioc/chronicle/checksum.hpp>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace nioc::chronicle
+{
+namespace
+{
+
+std::span<const std::byte> bytesOf(const std::string_view text)
+{
+  return std::as_bytes(std::span{text});
+}
+
+} // namespace
+
+TEST(Checksum, matchesTheStandardCheckValue)
+{
+  EXPECT_EQ(crc32c(bytesOf("123456789")), 0xE3069283U);
+}
+
+TEST(Checksum, isZeroForNoBytes)
+{
+  EXPECT_EQ(crc32c({}), 0U);
+}
+
+TEST(Checksum, chainsAcrossPieces)
+{
+  // Long enough for the eight-byte steps, with a ragged head and tail around them.
+  auto bytes = std::vector<std::byte>(1031);
+  for(auto index = std::size_t{0}; index < bytes.size(); ++index)
+  {
+    bytes.at(index) = std::byte(static_cast<unsigned char>(index * 7U));
+  }
+
+  const auto whole = crc32c(bytes);
+  const auto span = std::span<const std::byte>{bytes};
+  EXPECT_EQ(crc32c(span.subspan(13), crc32c(span.first(13))), whole);
+  EXPECT_EQ(crc32c(span.subspan(512), crc32c(span.first(512))), whole);
+}
+
+TEST(Checksum, detectsASingleFlippedBit)
+{
+  auto bytes = std::vector<std::byte>(64, std::byte{0x5A});
+  const auto original = crc32c(bytes);
+  bytes.at(40) ^= std::byte{0x01};
+  EXPECT_NE(crc32c(bytes), original);
+}
+
+} // namespace nioc::chronicle
@@ -0,0 +1,163 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "utils.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <nioc/chronicle/compaction.hpp>
+#include <nioc/chronicle/reader.hpp>
+#include <nioc/chronicle/writer.hpp>
+#include <nioc/common/utils.hpp>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace nioc::chronicle
+{
+namespace
+{
+namespace fs = std::filesystem;
+
+constexpr auto channelA = ChannelId{16983ULL};
+constexpr auto channelB = ChannelId{68964786ULL};
+
+fs::path freshDir(const std::string_view name)
+{
+  const auto path = fs::temp_directory_path() / "nioc-chronicleTest" / name;
+  fs::remove_all(path);
+  fs::create_directories(path);
+  return path;
+}
+
+fs::path rollPath(const fs::path& logRoot, const ChannelId channelId, const std::uint64_t rollId)
+{
+  return logRoot / common::hexString(channelId.mValue) / buildRollName(rollId);
+}
+
+void commitNumber(Reservation&& reservation, const std::uint64_t number)
+{
+  std::memcpy(reservation.span().data(), &number, sizeof(number));
+  static_cast<void>(std::move(reservation).commit(sizeof(number)));
+}
+
+// Leaves slack of every kind in channel A's roll 0: a tail stranded behind a later claim and a
+// reservation dropped between two committed ones. Channel B is written densely.
+fs::path recordWithSlack(const std::string_view name)
+{
+  auto writer = Writer{freshDir(name), 4096};
+  auto& channel = writer.channel(channelA);
+  {
+    auto first = channel.reserve(64);
+    auto second = channel.reserve(64);
+    commitNumber(std::move(first), 1ULL);
+    commitNumber(std::move(second), 2ULL);
+  }
+  {
+    // Dropped once a later claim follows it, so its bytes cannot go back to the roll.
+    auto dropped = channel.reserve(32);
+    commitNumber(channel.reserve(8), 3ULL);
+  }
+  for(auto number = std::uint64_t{10ULL}; number < 13ULL; ++number)
+  {
+    static_cast<void>(writer.write(channelB, std::as_bytes(std::span{&number, 1})));
+  }
+  return writer.path();
+}
+
+std::vector<std::pair<ChannelId, std::uint64_t>> readAll(const fs::path& logRoot)
+{
+  auto records = std::vector<std::pair<ChannelId, std::uint64_t>>{};
+  for(const auto& entry: Reader{logRoot})
+  {
+    auto number = std::uint64_t{0ULL};
+    EXPECT_EQ(entry.mCrate.span().size(), sizeof(number));
+    std::memcpy(&number, entry.mCrate.span().data(), sizeof(number));
+    records.emplace_back(entry.mChannelId, number);
+  }
+  return records;
+}
+
+} // namespace
+
+TEST(Compaction, dropsTheSlackAndKeepsEveryRecord)
+{
+  const auto logRoot = recordWithSlack("compactionSlack");
+  const auto before = readAll(logRoot);
+  ASSERT_EQ(before.size(), 6U);
+  const auto rollA = rollPath(logRoot, channelA, 0);
+  const auto rollB = rollPath(logRoot, channelB, 0);
+  const auto sizeA = fs::file_size(rollA);
+  const auto sizeB = fs::file_size(rollB);
+
+  const auto saved = compact(logRoot);
+
+  // Channel A's roll moves to a fresh id, its original deleted; channel B's is left in place.
+  const auto compactedA = rollPath(logRoot, channelA, 1);
+  EXPECT_FALSE(fs::exists(rollA));
+  EXPECT_EQ(fs::file_size(compactedA), 3U * sizeof(std::uint64_t));
+  EXPECT_EQ(fs::file_size(rollB), sizeB);
+  EXPECT_EQ(saved, sizeA - fs::file_size(compactedA));
+  EXPECT_EQ(readAll(logRoot), before);
+  EXPECT_FALSE(fs::exists(fs::path{logRoot / kTimelineFileName} += kTemporaryFileSuffix));
+}
+
+TEST(Compaction, deletesRollsNoRecordReferences)
+{
+  const auto logRoot = recordWithSlack("compactionUnreferenced");
+  const auto orphan = rollPath(logRoot, channelA, 7);
+  fs::copy_file(rollPath(logRoot, channelA, 0), orphan);
+  const auto orphanSize = fs::file_size(orphan);
+  const auto before = readAll(logRoot);
+
+  const auto saved = compact(logRoot);
+
+  EXPECT_FALSE(fs::exists(orphan));
+  EXPECT_TRUE(fs::exists(rollPath(logRoot, channelA, 8))); // past the orphan's id
+  EXPECT_GE(saved, orphanSize);
+  EXPECT_EQ(readAll(logRoot), before);
+}
+
+TEST(Compaction, leavesADenseChronicleAsItIs)
+{
+  const auto logRoot = recordWithSlack("compactionTwice");
+  static_cast<void>(compact(logRoot));
+  const auto before = readAll(logRoot);
+
+  EXPECT_EQ(compact(logRoot), 0U);
+  EXPECT_EQ(readAll(logRoot), before);
+}
+
+TEST(Compaction, anInterruptedCompactionLeavesTheChronicleReadable)
+{
+  const auto logRoot = recordWithSlack("compactionInterrupted");
+  const auto before = readAll(logRoot);
+
+  // As if interrupted before its commit: a compacted roll written, the timeline not yet renamed.
+  const auto stray = rollPath(logRoot, channelA, 1);
+  fs::copy_file(rollPath(logRoot, channelA, 0), stray);
+  fs::copy_file(
+      logRoot / kTimelineFileName,
+      fs::path{logRoot / kTimelineFileName} += kTemporaryFileSuffix);
+  EXPECT_EQ(readAll(logRoot), before);
+
+  static_cast<void>(compact(logRoot));
+  EXPECT_FALSE(fs::exists(stray));
+  EXPECT_EQ(readAll(logRoot), before);
+}
+
+TEST(Compaction, rejectsAMissingDirectory)
+{
+  EXPECT_THROW(
+      static_cast<void>(compact(fs::temp_directory_path() / "nioc-chronicleTest" / "absent")),
+      std::invalid_argument);
+}
+
+} // namespace nioc::chronicle
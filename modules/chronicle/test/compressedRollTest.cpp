@@ -0,0 +1,154 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "utils.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <nioc/chronicle/compressedRoll.hpp>
+#include <nioc/chronicle/reader.hpp>
+#include <nioc/chronicle/writer.hpp>
+#include <nioc/common/utils.hpp>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace nioc::chronicle
+{
+namespace
+{
+namespace fs = std::filesystem;
+
+constexpr auto channelA = ChannelId{16983ULL};
+
+fs::path freshDir(const std::string_view name)
+{
+  const auto path = fs::temp_directory_path() / "nioc-chronicleTest" / name;
+  fs::remove_all(path);
+  fs::create_directories(path);
+  return path;
+}
+
+// A run of repeating bytes that deflates well, followed by noise that does not.
+std::vector<std::byte> makeRollBytes(const std::size_t size)
+{
+  auto bytes = std::vector<std::byte>(size);
+  auto generator = std::mt19937{42U};
+  for(auto index = std::size_t{0}; index < size; ++index)
+  {
+    bytes.at(index) = index < size / 2 ? static_cast<std::byte>(index % 7U)
+                                       : static_cast<std::byte>(generator());
+  }
+  return bytes;
+}
+
+fs::path writeRoll(const fs::path& dir, const std::span<const std::byte> bytes)
+{
+  const auto path = dir / buildRollName(0U);
+  auto file = std::ofstream{path, std::ios::binary};
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast): ostream writes chars.
+  file.write(reinterpret_cast<const char*>(bytes.data()), std::ssize(bytes));
+  return path;
+}
+
+bool bytesEqual(const std::span<const std::byte> lhs, const std::span<const std::byte> rhs)
+{
+  return std::ranges::equal(lhs, rhs);
+}
+
+} // namespace
+
+TEST(CompressedRoll, readsBackAnyRangeOfTheOriginal)
+{
+  const auto bytes = makeRollBytes(1000);
+  const auto rollPath = writeRoll(freshDir("crRoundTrip"), bytes);
+
+  const auto compressedPath = compressRoll(rollPath, Compression{.mBlockSize = 64ULL});
+  EXPECT_FALSE(fs::exists(rollPath));
+  EXPECT_LT(fs::file_size(compressedPath), bytes.size());
+
+  auto roll = CompressedRoll{compressedPath};
+  EXPECT_EQ(roll.size(), bytes.size());
+
+  const auto original = std::span<const std::byte>{bytes};
+  EXPECT_TRUE(bytesEqual(roll.read(3, 40).span(), original.subspan(3, 40)));      // within a block
+  EXPECT_TRUE(bytesEqual(roll.read(60, 200).span(), original.subspan(60, 200)));  // across blocks
+  EXPECT_TRUE(bytesEqual(roll.read(900, 100).span(), original.subspan(900, 100))); // stored block
+  EXPECT_TRUE(bytesEqual(roll.read(0, 1000).span(), original));
+  EXPECT_TRUE(roll.read(500, 0).span().empty());
+  EXPECT_THROW(static_cast<void>(roll.read(990, 11)), std::out_of_range);
+}
+
+TEST(CompressedRoll, cratesOutliveTheRoll)
+{
+  const auto bytes = makeRollBytes(256);
+  const auto compressedPath =
+      compressRoll(writeRoll(freshDir("crOutlive"), bytes), Compression{.mBlockSize = 128ULL});
+
+  const auto crate = CompressedRoll{compressedPath}.read(10, 20);
+  EXPECT_TRUE(bytesEqual(crate.span(), std::span<const std::byte>{bytes}.subspan(10, 20)));
+}
+
+TEST(CompressedRoll, rejectsAFileThatIsNotACompressedRoll)
+{
+  const auto path = freshDir("crReject") / "garbage";
+  std::ofstream{path} << "definitely not a compressed roll";
+  EXPECT_THROW(CompressedRoll{path}, std::runtime_error);
+}
+
+TEST(CompressedRoll, aZeroBlockSizeIsRejected)
+{
+  const auto rollPath = writeRoll(freshDir("crZeroBlock"), makeRollBytes(16));
+  EXPECT_THROW(static_cast<void>(compressRoll(rollPath, Compression{})), std::invalid_argument);
+  EXPECT_TRUE(fs::exists(rollPath));
+}
+
+TEST(CompressedRoll, writerCompressesSealedRollsAndReaderReplaysThem)
+{
+  const auto payloads = std::vector<std::vector<std::byte>>{
+      makeRollBytes(100),
+      makeRollBytes(120),
+      makeRollBytes(90),
+      makeRollBytes(110)};
+
+  const auto logPath = [&payloads]
+  {
+    auto writer = Writer{
+        freshDir("crWriter"),
+        {.mRollCapacity = 256, .mTimelineCapacity = 4096, .mCompression = {.mBlockSize = 64ULL}}};
+    for(const auto& payload: payloads)
+    {
+      writer.write(channelA, payload);
+    }
+    return writer.path();
+  }();
+
+  const auto channelDir = logPath / common::hexString(channelA.mValue);
+  for(const auto& file: fs::directory_iterator{channelDir})
+  {
+    const auto name = file.path().filename().string();
+    EXPECT_TRUE(name == kChannelIndexFileName or name.ends_with(kCompressedRollSuffix)) << name;
+  }
+
+  auto reader = Reader{logPath};
+  reader.setReadAhead(Reader::kDefaultReadAhead);
+  auto index = std::size_t{0};
+  for(const auto& entry: reader)
+  {
+    ASSERT_LT(index, payloads.size());
+    EXPECT_TRUE(bytesEqual(entry.mCrate.span(), payloads.at(index)));
+    ++index;
+  }
+  EXPECT_EQ(index, payloads.size());
+}
+
+} // namespace nioc::chronicle
@@ -0,0 +1,178 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <initializer_list>
+#include <memory>
+#include <nioc/chronicle/follower.hpp>
+#include <nioc/chronicle/writer.hpp>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace nioc::chronicle
+{
+namespace
+{
+namespace fs = std::filesystem;
+
+constexpr auto channelA = ChannelId{16983ULL};
+constexpr auto channelB = ChannelId{68964786ULL};
+constexpr auto kDoorbellInterval = std::chrono::milliseconds{1};
+constexpr auto kPatience = std::chrono::seconds{10};
+
+fs::path makeFreshEmptyDir(const std::string_view name)
+{
+  const auto path = fs::temp_directory_path() / "nioc-chronicleTest" / name;
+  fs::remove_all(path);
+  fs::create_directories(path);
+  return path;
+}
+
+std::unique_ptr<Writer> makeWriter(const fs::path& dir, const std::size_t timelineShards = 1)
+{
+  return std::make_unique<Writer>(
+      dir,
+      WriterOptions{
+          .mRollCapacity = 256,
+          .mTimelineCapacity = 4096 * sizeof(TimelineEntry),
+          .mTimelineShards = timelineShards,
+          .mDoorbellInterval = kDoorbellInterval});
+}
+
+void writeNumber(Writer& writer, const ChannelId channelId, const std::uint64_t number)
+{
+  static_cast<void>(writer.write(channelId, std::as_bytes(std::span{&number, 1})));
+}
+
+std::uint64_t readNumber(const Entry& entry)
+{
+  auto number = std::uint64_t{0ULL};
+  EXPECT_EQ(entry.mCrate.span().size(), sizeof(number));
+  std::memcpy(&number, entry.mCrate.span().data(), sizeof(number));
+  return number;
+}
+
+} // namespace
+
+TEST(Follower, aChronicleWithoutADoorbellCannotBeFollowed)
+{
+  const auto dir = makeFreshEmptyDir("followerNoDoorbell");
+  {
+    auto writer = Writer{dir};
+    writeNumber(writer, channelA, 1ULL);
+  }
+  EXPECT_THROW((Follower{dir}), std::invalid_argument);
+}
+
+TEST(Follower, yieldsRecordsAsTheyAreCommittedThenFinishes)
+{
+  const auto dir = makeFreshEmptyDir("followerLive");
+  auto writer = makeWriter(dir);
+  auto follower = Follower{dir};
+
+  constexpr auto kCount = 300ULL;
+  auto producer = std::jthread(
+      [&writer]
+      {
+        for(auto number = 0ULL; number < kCount; ++number)
+        {
+          writeNumber(*writer, channelA, number);
+          if(number % 50ULL == 0ULL)
+          {
+            std::this_thread::sleep_for(std::chrono::milliseconds{2});
+          }
+        }
+      });
+
+  // Every record arrives, in order, while the Writer is still open; rolls fill and seal meanwhile.
+  for(auto expected = 0ULL; expected < kCount; ++expected)
+  {
+    const auto entry = follower.next(kPatience);
+    ASSERT_TRUE(entry.has_value());
+    EXPECT_EQ(entry->mChannelId, channelA);
+    EXPECT_EQ(readNumber(*entry), expected);
+  }
+  producer.join();
+  EXPECT_FALSE(follower.finished());
+
+  writer.reset();
+  EXPECT_FALSE(follower.next(kPatience).has_value());
+  EXPECT_TRUE(follower.finished());
+}
+
+TEST(Follower, timesOutWhileNothingIsCommitted)
+{
+  const auto dir = makeFreshEmptyDir("followerQuiet");
+  const auto writer = makeWriter(dir);
+  auto follower = Follower{dir};
+
+  EXPECT_FALSE(follower.next(std::chrono::milliseconds{20}).has_value());
+  EXPECT_FALSE(follower.finished());
+}
+
+TEST(Follower, skipToEndYieldsOnlyLaterRecords)
+{
+  const auto dir = makeFreshEmptyDir("followerSkip");
+  auto writer = makeWriter(dir);
+  auto follower = Follower{dir};
+
+  writeNumber(*writer, channelA, 1ULL);
+  ASSERT_TRUE(follower.next(kPatience).has_value());
+  writeNumber(*writer, channelA, 2ULL);
+  writeNumber(*writer, channelA, 3ULL);
+  std::this_thread::sleep_for(kDoorbellInterval * 200); // rung many times over by now
+
+  follower.skipToEnd();
+  writeNumber(*writer, channelA, 4ULL);
+  const auto entry = follower.next(kPatience);
+  ASSERT_TRUE(entry.has_value());
+  EXPECT_EQ(readNumber(*entry), 4ULL);
+}
+
+TEST(Follower, aFollowerOpenedAfterCloseReplaysAShardedChronicle)
+{
+  const auto dir = makeFreshEmptyDir("followerShardsClosed");
+  constexpr auto kCount = 200ULL;
+  {
+    const auto writer = makeWriter(dir, 4);
+    auto producers = std::vector<std::jthread>{};
+    for(const auto channelId: {channelA, channelB})
+    {
+      producers.emplace_back(
+          [&writer, channelId]
+          {
+            for(auto number = 0ULL; number < kCount; ++number)
+            {
+              writeNumber(*writer, channelId, number);
+            }
+          });
+    }
+  }
+
+  auto follower = Follower{dir};
+  auto nextA = 0ULL;
+  auto nextB = 0ULL;
+  while(const auto entry = follower.next(kPatience))
+  {
+    // Each producer's records come in its own order, however the shards interleave them.
+    auto& expected = entry->mChannelId == channelA ? nextA : nextB;
+    EXPECT_EQ(readNumber(*entry), expected);
+    ++expected;
+  }
+  EXPECT_TRUE(follower.finished());
+  EXPECT_EQ(nextA, kCount);
+  EXPECT_EQ(nextB, kCount);
+}
+
+} // namespace nioc::chronicle
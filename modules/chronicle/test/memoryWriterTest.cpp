@@ -0,0 +1,87 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <nioc/chronicle/crate.hpp>
+#include <nioc/chronicle/memoryWriter.hpp>
+#include <nioc/common/utils.hpp>
+#include <set>
+#include <span>
+#include <vector>
+
+namespace nioc::chronicle
+{
+namespace
+{
+
+constexpr auto kChannel = ChannelId{16983ULL};
+
+/// Small enough that a few hundred records span many rolls.
+constexpr auto kRollCapacity = std::size_t{4096};
+
+std::vector<std::byte> makeRecord(const std::size_t index)
+{
+  return std::vector<std::byte>(256, static_cast<std::byte>(index));
+}
+
+} // namespace
+
+TEST(MemoryWriter, recyclesRollsItsCratesLetGoOf)
+{
+  auto writer = MemoryWriter{kRollCapacity};
+  auto rolls = std::set<const std::byte*>{};
+  for(auto index = std::size_t{0}; index < 1000U; ++index)
+  {
+    const auto crate = writer.write(kChannel, makeRecord(index));
+    ASSERT_EQ(crate.span().size(), 256U);
+    EXPECT_EQ(crate.span().front(), static_cast<std::byte>(index));
+
+    // Each roll holds 16 records; the first of each tells the rolls apart.
+    if(index % 16U == 0U)
+    {
+      rolls.insert(crate.span().data());
+    }
+  }
+
+  // 62 rollovers, yet only the active roll, the spare, and a pooled roll or two ever hold records.
+  EXPECT_LE(rolls.size(), 4U);
+}
+
+TEST(MemoryWriter, keepsTheBytesOfHeldCratesIntact)
+{
+  auto writer = MemoryWriter{kRollCapacity};
+  auto held = std::vector<Crate>{};
+  for(auto index = std::size_t{0}; index < 200U; ++index)
+  {
+    auto crate = writer.write(kChannel, makeRecord(index));
+    if(index % 10U == 0U)
+    {
+      held.push_back(std::move(crate));
+    }
+  }
+
+  for(auto index = std::size_t{0}; index < held.size(); ++index)
+  {
+    const auto bytes = held.at(index).span();
+    ASSERT_EQ(bytes.size(), 256U);
+    for(const auto byte: bytes)
+    {
+      ASSERT_EQ(byte, static_cast<std::byte>(index * 10U));
+    }
+  }
+}
+
+TEST(MemoryWriter, writesNothingToDisk)
+{
+  auto writer = MemoryWriter{kRollCapacity};
+  static_cast<void>(writer.write(kChannel, makeRecord(0)));
+  EXPECT_FALSE(std::filesystem::exists(common::hexString(kChannel.mValue)));
+}
+
+} // namespace nioc::chronicle
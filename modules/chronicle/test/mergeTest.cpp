@@ -0,0 +1,181 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "utils.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <memory>
+#include <nioc/chronicle/merge.hpp>
+#include <nioc/chronicle/reader.hpp>
+#include <nioc/chronicle/writer.hpp>
+#include <nioc/common/utils.hpp>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace nioc::chronicle
+{
+namespace
+{
+namespace fs = std::filesystem;
+
+constexpr auto channelA = ChannelId{16983ULL};
+constexpr auto channelB = ChannelId{68964786ULL};
+constexpr auto channelShared = ChannelId{4242ULL};
+
+fs::path freshDir(const std::string_view name)
+{
+  const auto path = fs::temp_directory_path() / "nioc-chronicleTest" / name;
+  fs::remove_all(path);
+  fs::create_directories(path);
+  return path;
+}
+
+std::unique_ptr<Writer> makeWriter(const fs::path& dir)
+{
+  // Small rolls, so each source spans several; every entry sampled, with checksums.
+  return std::make_unique<Writer>(
+      dir,
+      WriterOptions{.mRollCapacity = 128, .mTimeIndexStride = 1ULL, .mChecksums = true});
+}
+
+// A record is its taking instant on its writer's clock, then its sequence across both writers.
+struct Record
+{
+  std::int64_t mTakenAt{0LL};
+  std::uint64_t mSequence{0ULL};
+};
+
+void writeRecord(Writer& writer, const ChannelId channelId, const Record& record)
+{
+  static_cast<void>(writer.write(channelId, std::as_bytes(std::span{&record, 1})));
+}
+
+Record readRecord(const Entry& entry)
+{
+  auto record = Record{};
+  EXPECT_EQ(entry.mCrate.span().size(), sizeof(record));
+  std::memcpy(&record, entry.mCrate.span().data(), sizeof(record));
+  return record;
+}
+
+std::int64_t takenAt(const Entry& entry)
+{
+  return readRecord(entry).mTakenAt;
+}
+
+// Alternates records between two writers, whose clocks disagree by an hour.
+std::pair<fs::path, fs::path> recordTwoSources(const std::string_view name)
+{
+  const auto root = freshDir(name);
+  fs::create_directories(root / "first");
+  fs::create_directories(root / "second");
+  const auto first = makeWriter(root / "first");
+  const auto second = makeWriter(root / "second");
+  constexpr auto kSkew = std::chrono::hours{1};
+  for(auto sequence = std::uint64_t{0ULL}; sequence < 10ULL; ++sequence)
+  {
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    const auto isFirst = sequence % 2ULL == 0ULL;
+    const auto record = Record{
+        .mTakenAt = std::chrono::nanoseconds{isFirst ? now : now - kSkew}.count(),
+        .mSequence = sequence};
+    writeRecord(isFirst ? *first : *second, isFirst ? channelA : channelB, record);
+    writeRecord(isFirst ? *first : *second, channelShared, record);
+    std::this_thread::sleep_for(std::chrono::milliseconds{2});
+  }
+  return {first->path(), second->path()};
+}
+
+} // namespace
+
+TEST(Merge, interleavesTheSourcesByTheirAlignedKeys)
+{
+  const auto [first, second] = recordTwoSources("mergeSources");
+  const auto destination = fs::temp_directory_path() / "nioc-chronicleTest" / "mergeDestination";
+  fs::remove_all(destination);
+
+  merge({first, second}, destination, takenAt);
+
+  auto reader = Reader{destination};
+  EXPECT_TRUE(reader.hasChecksums());
+  EXPECT_TRUE(reader.verify().empty());
+  auto merged = std::vector<std::pair<ChannelId, Record>>{};
+  for(const auto& entry: reader)
+  {
+    merged.emplace_back(entry.mChannelId, readRecord(entry));
+  }
+
+  // Each source wrote its own channel's record, then the shared channel's, per sequence number.
+  ASSERT_EQ(merged.size(), 20U);
+  for(auto sequence = std::uint64_t{0ULL}; sequence < 10ULL; ++sequence)
+  {
+    const auto& own = merged.at(2U * sequence);
+    const auto& shared = merged.at((2U * sequence) + 1U);
+    EXPECT_EQ(own.first, sequence % 2ULL == 0ULL ? channelA : channelB);
+    EXPECT_EQ(own.second.mSequence, sequence);
+    EXPECT_EQ(shared.first, channelShared);
+    EXPECT_EQ(shared.second.mSequence, sequence);
+  }
+
+  auto sharedCount = std::uint64_t{0ULL};
+  for(const auto& entry: Reader{destination, {channelShared}})
+  {
+    EXPECT_EQ(readRecord(entry).mSequence, sharedCount);
+    ++sharedCount;
+  }
+  EXPECT_EQ(sharedCount, 10ULL);
+}
+
+TEST(Merge, linksTheRollsInsteadOfCopyingThem)
+{
+  const auto [first, second] = recordTwoSources("mergeLinks");
+  const auto destination = fs::temp_directory_path() / "nioc-chronicleTest" / "mergeLinked";
+  fs::remove_all(destination);
+
+  merge({first, second}, destination, takenAt);
+
+  const auto roll = destination / common::hexString(channelA.mValue) / buildRollName(0);
+  ASSERT_TRUE(fs::exists(roll));
+  EXPECT_EQ(fs::hard_link_count(roll), 2U);
+}
+
+TEST(Merge, leavesOutChecksumsASourceFallsShortOf)
+{
+  const auto [first, second] = recordTwoSources("mergeShortChecksums");
+  fs::resize_file(first / kChecksumsFileName, sizeof(std::uint32_t));
+  const auto destination = fs::temp_directory_path() / "nioc-chronicleTest" / "mergeUnchecked";
+  fs::remove_all(destination);
+
+  merge({first, second}, destination, takenAt);
+
+  auto reader = Reader{destination};
+  EXPECT_FALSE(reader.hasChecksums());
+  EXPECT_EQ(reader.entries().size(), 20U);
+}
+
+TEST(Merge, refusesADestinationInUse)
+{
+  const auto [first, second] = recordTwoSources("mergeOccupied");
+  EXPECT_THROW(merge({first, second}, first, takenAt), std::invalid_argument);
+}
+
+TEST(Merge, rejectsAMissingSource)
+{
+  const auto destination = freshDir("mergeNowhere");
+  EXPECT_THROW(
+      merge({destination / "absent"}, destination / "merged", takenAt),
+      std::invalid_argument);
+}
+
+} // namespace nioc::chronicle
@@ -0,0 +1,156 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <nioc/chronicle/parallelScan.hpp>
+#include <nioc/chronicle/writer.hpp>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace nioc::chronicle
+{
+namespace
+{
+namespace fs = std::filesystem;
+
+constexpr auto channelA = ChannelId{16983ULL};
+constexpr auto channelB = ChannelId{68964786ULL};
+
+fs::path freshDir(const std::string_view name)
+{
+  const auto path = fs::temp_directory_path() / "nioc-chronicleTest" / name;
+  fs::remove_all(path);
+  fs::create_directories(path);
+  return path;
+}
+
+// Records @p count one-byte-tagged records, alternating channels A and B, tagged 0, 1, 2, ...
+fs::path recordTagged(const std::string_view name, const std::size_t count)
+{
+  auto writer = Writer{freshDir(name), 4096};
+  for(auto index = std::size_t{0}; index < count; ++index)
+  {
+    const auto tag = std::vector{std::byte(index)};
+    writer.write(index % 2 == 0 ? channelA : channelB, tag);
+  }
+  return writer.path();
+}
+
+// Concatenates the tags of a shard's records.
+std::vector<std::byte> tagsOf(const ParallelScan::Shard shard)
+{
+  auto tags = std::vector<std::byte>{};
+  for(const auto& entry: shard)
+  {
+    tags.push_back(entry.mCrate.span().front());
+  }
+  return tags;
+}
+
+std::vector<std::byte> concatenate(std::vector<std::byte> lhs, const std::vector<std::byte>& rhs)
+{
+  lhs.insert(lhs.end(), rhs.begin(), rhs.end());
+  return lhs;
+}
+
+} // namespace
+
+TEST(ParallelScan, mergesShardsInTimelineOrder)
+{
+  const auto logRoot = recordTagged("psOrder", 101);
+  const auto scan = ParallelScan{logRoot, 4};
+  EXPECT_EQ(scan.size(), 101U);
+  EXPECT_EQ(scan.shardCount(), 4U);
+
+  const auto tags = scan.reduce<std::vector<std::byte>>(tagsOf, concatenate);
+  ASSERT_EQ(tags.size(), 101U);
+  for(auto index = std::size_t{0}; index < tags.size(); ++index)
+  {
+    EXPECT_EQ(tags.at(index), std::byte(index));
+  }
+}
+
+TEST(ParallelScan, eachShardBeginsWhereThePreviousEnded)
+{
+  const auto scan = ParallelScan{recordTagged("psBegin", 103), 4};
+  EXPECT_EQ(scan.shardBegin(0), 0U);
+  EXPECT_EQ(scan.shardBegin(scan.shardCount()), scan.size());
+
+  // Every tag lands at the position shardBegin gives its shard, so the output comes out dense.
+  auto tags = std::vector<std::byte>(scan.size());
+  scan.forEachShard(
+      [&scan, &tags](const std::size_t shardIndex, const ParallelScan::Shard shard)
+      {
+        EXPECT_EQ(scan.shardBegin(shardIndex + 1U) - scan.shardBegin(shardIndex), shard.size());
+        const auto begin = static_cast<std::ptrdiff_t>(scan.shardBegin(shardIndex));
+        std::ranges::copy(tagsOf(shard), std::next(tags.begin(), begin));
+      });
+  for(auto index = std::size_t{0}; index < tags.size(); ++index)
+  {
+    EXPECT_EQ(tags.at(index), std::byte(index));
+  }
+}
+
+TEST(ParallelScan, neverSpawnsMoreWorkersThanRecords)
+{
+  const auto scan = ParallelScan{recordTagged("psFew", 3), 16};
+  EXPECT_EQ(scan.shardCount(), 3U);
+
+  const auto count = scan.reduce<std::uint64_t>(
+      [](const ParallelScan::Shard shard) { return static_cast<std::uint64_t>(shard.size()); },
+      std::plus{});
+  EXPECT_EQ(count, 3U);
+}
+
+TEST(ParallelScan, anEmptyChronicleReturnsTheInitialValue)
+{
+  const auto logRoot = [&]
+  {
+    const auto writer = Writer{freshDir("psEmpty")};
+    return writer.path();
+  }();
+
+  const auto scan = ParallelScan{logRoot};
+  EXPECT_EQ(scan.shardCount(), 0U);
+  EXPECT_EQ(
+      scan.reduce<int>([](ParallelScan::Shard /*shard*/) { return 1; }, std::plus{}, 7),
+      7);
+}
+
+TEST(ParallelScan, scansOnlyTheSelectedChannels)
+{
+  const auto scan = ParallelScan{recordTagged("psChannels", 10), {channelB}, 2};
+  EXPECT_EQ(scan.size(), 5U);
+
+  const auto tags = scan.reduce<std::vector<std::byte>>(tagsOf, concatenate);
+  EXPECT_EQ(
+      tags,
+      (std::vector{std::byte{1}, std::byte{3}, std::byte{5}, std::byte{7}, std::byte{9}}));
+}
+
+TEST(ParallelScan, rethrowsAWorkerFailureAfterJoining)
+{
+  const auto scan = ParallelScan{recordTagged("psFailure", 8), 4};
+  EXPECT_THROW(
+      scan.forEachShard(
+          [](const std::size_t shardIndex, ParallelScan::Shard /*shard*/)
+          {
+            if(shardIndex == 2)
+            {
+              throw std::runtime_error{"shard failed"};
+            }
+          }),
+      std::runtime_error);
+}
+
+} // namespace nioc::chronicle
@@ -4,15 +4,25 @@
 // Author   : Anurag Jakhotia
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include "utils.hpp"
 #include <array>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
 #include <functional>
 #include <gtest/gtest.h>
 #include <iterator>
 #include <nioc/chronicle/reader.hpp>
 #include <nioc/chronicle/writer.hpp>
+#include <nioc/common/utils.hpp>
+#include <nioc/containers/mmapArray.hpp>
 #include <ranges>
 #include <span>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -22,6 +32,10 @@ namespace fs = std::filesystem;
 
 static_assert(std::input_iterator<Reader::Iterator>);
 static_assert(std::ranges::input_range<Reader>);
+static_assert(std::random_access_iterator<Reader::Entries::Iterator>);
+static_assert(std::ranges::random_access_range<Reader::Entries>);
+static_assert(std::ranges::sized_range<Reader::Entries>);
+static_assert(std::ranges::view<Reader::Entries>);
 
 namespace
 {
@@ -53,6 +67,27 @@ void expectBytesEqual(std::span<const std::byte> lhs, std::span<const std::byte>
   EXPECT_TRUE(std::ranges::equal(lhs, rhs));
 }
 
+// Reads the first payload byte of every entry from @p first to the end.
+std::vector<std::byte> leadingBytes(Reader::Iterator first)
+{
+  auto bytes = std::vector<std::byte>{};
+  for(; first != Reader::end(); ++first)
+  {
+    bytes.push_back(first->mCrate.span().front());
+  }
+  return bytes;
+}
+
+// Lets the system clock step clearly past the previous commit, so instants taken around this call
+// separate the records written before it from those written after.
+std::chrono::system_clock::time_point pauseAndMark()
+{
+  std::this_thread::sleep_for(std::chrono::milliseconds{2});
+  const auto mark = std::chrono::system_clock::now();
+  std::this_thread::sleep_for(std::chrono::milliseconds{2});
+  return mark;
+}
+
 } // namespace
 
 TEST(Reader, readsFramesInRecordOrder)
@@ -99,6 +134,492 @@ TEST(Reader, emptyChronicleHasNoEntries)
   EXPECT_TRUE(reader.begin() == reader.end());
 }
 
+TEST(Reader, seekLandsOnTheFirstRecordCommittedAtOrAfterTheInstant)
+{
+  auto beforeAll = std::chrono::system_clock::time_point{};
+  auto between = std::chrono::system_clock::time_point{};
+  auto afterAll = std::chrono::system_clock::time_point{};
+
+  const auto logPath = [&]
+  {
+    // A stride of one samples every record, so seek resolves exactly.
+    auto writer = Writer{
+        makeFreshEmptyDir("reader-seekExact"),
+        {.mRollCapacity = 256, .mTimelineCapacity = 4096, .mTimeIndexStride = 1}};
+    beforeAll = pauseAndMark();
+    writer.write(channelA, makeBytes(4, std::byte{0}));
+    writer.write(channelA, makeBytes(4, std::byte{1}));
+    between = pauseAndMark();
+    writer.write(channelB, makeBytes(4, std::byte{2}));
+    writer.write(channelB, makeBytes(4, std::byte{3}));
+    afterAll = pauseAndMark();
+    return writer.path();
+  }();
+
+  auto reader = Reader{logPath};
+  EXPECT_EQ(leadingBytes(reader.seek(between)), (std::vector{std::byte{2}, std::byte{3}}));
+  EXPECT_TRUE(reader.seek(afterAll) == reader.end());
+
+  // Seeking backwards rewinds the pass.
+  EXPECT_EQ(
+      leadingBytes(reader.seek(beforeAll)),
+      (std::vector{std::byte{0}, std::byte{1}, std::byte{2}, std::byte{3}}));
+}
+
+TEST(Reader, seekOvershootsBackwardsByLessThanTheStride)
+{
+  constexpr auto kStride = 4U;
+  auto between = std::chrono::system_clock::time_point{};
+
+  const auto logPath = [&]
+  {
+    auto writer = Writer{
+        makeFreshEmptyDir("reader-seekSparse"),
+        {.mRollCapacity = 256, .mTimelineCapacity = 4096, .mTimeIndexStride = kStride}};
+    for(auto index = std::uint8_t{0}; index < 6U; ++index)
+    {
+      writer.write(channelA, makeBytes(4, std::byte{index}));
+    }
+    between = pauseAndMark();
+    for(auto index = std::uint8_t{6}; index < 10U; ++index)
+    {
+      writer.write(channelA, makeBytes(4, std::byte{index}));
+    }
+    return writer.path();
+  }();
+
+  // Records 0 and 4 are sampled, both before the instant; seek resumes just past the later one.
+  auto reader = Reader{logPath};
+  const auto bytes = leadingBytes(reader.seek(between));
+  ASSERT_FALSE(bytes.empty());
+  EXPECT_EQ(bytes.front(), std::byte{5});
+  EXPECT_EQ(bytes.size(), 5U);
+}
+
+TEST(Reader, seekOnAnEmptyChronicleYieldsEnd)
+{
+  const auto logPath = [&]
+  {
+    const auto writer = Writer{makeFreshEmptyDir("reader-seekEmpty")};
+    return writer.path();
+  }();
+
+  auto reader = Reader{logPath};
+  EXPECT_TRUE(reader.seek(std::chrono::system_clock::now()) == reader.end());
+}
+
+TEST(Reader, entriesIndexesTheTimelineWithoutMovingTheCursor)
+{
+  const auto logPath = [&]
+  {
+    auto writer = Writer{makeFreshEmptyDir("reader-entriesIndex"), 256};
+    for(auto index = 0; index < 5; ++index)
+    {
+      writer.write(index % 2 == 0 ? channelA : channelB, makeBytes(8, std::byte(10 * index)));
+    }
+    return writer.path();
+  }();
+
+  auto reader = Reader{logPath};
+  const auto entries = reader.entries();
+  ASSERT_EQ(entries.size(), 5U);
+
+  EXPECT_EQ(entries[3].mChannelId, channelB);
+  expectBytesEqual(entries[3].mCrate.span(), makeBytes(8, std::byte{30}));
+  expectBytesEqual(reader.at(4).mCrate.span(), makeBytes(8, std::byte{40}));
+  EXPECT_EQ(entries.end() - entries.begin(), 5);
+
+  // Random access left the replay cursor at the first record.
+  EXPECT_EQ(leadingBytes(reader.begin()).size(), 5U);
+}
+
+TEST(Reader, entriesIterateInReverse)
+{
+  const auto logPath = [&]
+  {
+    auto writer = Writer{makeFreshEmptyDir("reader-entriesReverse"), 256};
+    for(auto index = 0; index < 4; ++index)
+    {
+      writer.write(channelA, makeBytes(4, std::byte(index)));
+    }
+    return writer.path();
+  }();
+
+  auto reader = Reader{logPath};
+  auto bytes = std::vector<std::byte>{};
+  for(const auto& entry: reader.entries() | std::views::reverse)
+  {
+    bytes.push_back(entry.mCrate.span().front());
+  }
+  EXPECT_EQ(bytes, (std::vector{std::byte{3}, std::byte{2}, std::byte{1}, std::byte{0}}));
+}
+
+TEST(Reader, atRejectsAnIndexPastTheEnd)
+{
+  const auto logPath = [&]
+  {
+    auto writer = Writer{makeFreshEmptyDir("reader-atRange"), 256};
+    writer.write(channelA, makeBytes(4));
+    return writer.path();
+  }();
+
+  auto reader = Reader{logPath};
+  EXPECT_NO_THROW(static_cast<void>(reader.at(0)));
+  EXPECT_THROW(static_cast<void>(reader.at(1)), std::out_of_range);
+
+  auto empty = Reader{[&]
+                      {
+                        const auto writer = Writer{makeFreshEmptyDir("reader-atEmpty")};
+                        return writer.path();
+                      }()};
+  EXPECT_TRUE(empty.entries().empty());
+  EXPECT_THROW(static_cast<void>(empty.at(0)), std::out_of_range);
+}
+
+TEST(Reader, aDefaultConstructedEntriesViewIsEmpty)
+{
+  const auto entries = Reader::Entries{};
+  EXPECT_TRUE(entries.empty());
+  EXPECT_EQ(entries.begin(), entries.end());
+}
+
+TEST(Reader, aChannelSetReplaysOnlyItsRecordsInTimelineOrder)
+{
+  constexpr auto channelC = ChannelId{4242ULL};
+  const auto logPath = [&]
+  {
+    auto writer = Writer{makeFreshEmptyDir("reader-channelSet"), 256};
+    const auto channels = std::array{channelA, channelB, channelC, channelA, channelC, channelB};
+    for(auto index = std::size_t{0}; index < channels.size(); ++index)
+    {
+      writer.write(channels.at(index), makeBytes(4, std::byte(index)));
+    }
+    return writer.path();
+  }();
+
+  auto reader = Reader{logPath, {channelA, channelB}};
+  EXPECT_EQ(
+      leadingBytes(reader.begin()),
+      (std::vector{std::byte{0}, std::byte{1}, std::byte{3}, std::byte{5}}));
+
+  const auto entries = reader.entries();
+  ASSERT_EQ(entries.size(), 4U);
+  EXPECT_EQ(entries[2].mChannelId, channelA);
+  EXPECT_THROW(static_cast<void>(reader.at(4)), std::out_of_range);
+
+  auto unknown = Reader{logPath, {ChannelId{1ULL}}};
+  EXPECT_TRUE(unknown.begin() == unknown.end());
+}
+
+TEST(Reader, aChannelSetFallsBackToScanningAnUnindexedLog)
+{
+  const auto logPath = [&]
+  {
+    auto writer = Writer{makeFreshEmptyDir("reader-channelSetScan"), 256};
+    for(auto index = 0; index < 4; ++index)
+    {
+      writer.write(index % 2 == 0 ? channelA : channelB, makeBytes(4, std::byte(index)));
+    }
+    return writer.path();
+  }();
+  fs::remove(logPath / common::hexString(channelB.mValue) / kChannelIndexFileName);
+
+  auto reader = Reader{logPath, {channelB}};
+  EXPECT_EQ(leadingBytes(reader.begin()), (std::vector{std::byte{1}, std::byte{3}}));
+}
+
+TEST(Reader, seekWithinAChannelSetLandsOnASelectedRecord)
+{
+  const auto dir = makeFreshEmptyDir("reader-channelSetSeek");
+  auto mark = std::chrono::system_clock::time_point{};
+  {
+    auto writer =
+        Writer{dir, {.mRollCapacity = 256, .mTimelineCapacity = 4096, .mTimeIndexStride = 1}};
+    writer.write(channelA, makeBytes(4, std::byte{0}));
+    writer.write(channelB, makeBytes(4, std::byte{1}));
+    mark = pauseAndMark();
+    writer.write(channelA, makeBytes(4, std::byte{2}));
+    writer.write(channelB, makeBytes(4, std::byte{3}));
+  }
+
+  auto reader = Reader{dir, {channelB}};
+  EXPECT_EQ(leadingBytes(reader.seek(mark)), (std::vector{std::byte{3}}));
+}
+
+TEST(Reader, readAheadReplaysTheSameRecords)
+{
+  const auto logPath = [&]
+  {
+    // 64-byte rolls hold two 24-byte records each, so the replay crosses many rolls per channel.
+    auto writer = Writer{makeFreshEmptyDir("reader-readAhead"), 64};
+    for(auto index = 0; index < 24; ++index)
+    {
+      writer.write(index % 3 == 0 ? channelB : channelA, makeBytes(24, std::byte(index)));
+    }
+    return writer.path();
+  }();
+
+  auto expected = std::vector<std::byte>{};
+  for(auto index = 0; index < 24; ++index)
+  {
+    expected.push_back(std::byte(index));
+  }
+
+  auto reader = Reader{logPath};
+  reader.setReadAhead(ReadAhead{.mEntryCount = 5ULL, .mWindowBytes = 50ULL});
+  EXPECT_EQ(leadingBytes(reader.begin()), expected);
+
+  // A seek restarts the prefetch from the new position.
+  const auto replayed = leadingBytes(reader.seek(std::chrono::system_clock::time_point{}));
+  EXPECT_EQ(replayed, expected);
+}
+
+TEST(Reader, rollWindowsReplayTheSameRecords)
+{
+  const auto logPath = [&]
+  {
+    // 1000-byte records in 64 KiB rolls run across the 4 KiB windows the replay maps.
+    auto writer = Writer{makeFreshEmptyDir("reader-rollWindows"), 64ULL * 1024ULL};
+    for(auto index = 0; index < 200; ++index)
+    {
+      writer.write(index % 3 == 0 ? channelB : channelA, makeBytes(1000, std::byte(index)));
+    }
+    return writer.path();
+  }();
+
+  auto expected = std::vector<std::vector<std::byte>>{};
+  for(auto index = 0; index < 200; ++index)
+  {
+    expected.push_back(makeBytes(1000, std::byte(index)));
+  }
+
+  auto reader = Reader{logPath};
+  reader.setRollWindows(RollWindows{.mWindowBytes = 4096U, .mWindowCount = 2U});
+  reader.setReadAhead(ReadAhead{.mEntryCount = 8ULL, .mWindowBytes = 8192ULL});
+  auto entries = std::vector<Entry>{};
+  for(const auto& entry: reader)
+  {
+    entries.push_back(entry);
+  }
+
+  // Entries kept past eviction still hold their windows.
+  ASSERT_EQ(entries.size(), expected.size());
+  for(auto index = std::size_t{0}; index < entries.size(); ++index)
+  {
+    expectBytesEqual(entries.at(index).mCrate.span(), expected.at(index));
+  }
+  expectBytesEqual(reader.at(100).mCrate.span(), expected.at(100));
+}
+
+// Writes eight records over two channels with checksums, then flips a byte of channel A's third.
+fs::path writeAndCorrupt(const std::string_view name)
+{
+  const auto logPath = [&]
+  {
+    auto writer = Writer{
+        makeFreshEmptyDir(name),
+        {.mRollCapacity = 1024,
+         .mTimelineCapacity = 4096,
+         .mTimeIndexStride = 4,
+         .mChecksums = true}};
+    for(auto index = 0; index < 8; ++index)
+    {
+      writer.write(index % 2 == 0 ? channelA : channelB, makeBytes(16, std::byte(index)));
+    }
+    return writer.path();
+  }();
+
+  // Channel A holds records 0, 2, 4 and 6 back to back; corrupt record 4.
+  auto roll = std::fstream{
+      logPath / common::hexString(channelA.mValue) / buildRollName(0),
+      std::ios::binary | std::ios::in | std::ios::out};
+  roll.seekp(2 * 16 + 5);
+  roll.put('\xFF');
+  return logPath;
+}
+
+TEST(Reader, verifyReportsTheCorruptRecords)
+{
+  const auto logPath = writeAndCorrupt("reader-verify");
+
+  const auto reader = Reader{logPath};
+  EXPECT_TRUE(reader.hasChecksums());
+  EXPECT_EQ(reader.verify(3), std::vector<std::uint64_t>{4});
+  EXPECT_EQ(reader.verify(), std::vector<std::uint64_t>{4});
+
+  // Only the selection is checked, and reported by timeline position.
+  EXPECT_EQ(Reader(logPath, {channelA}).verify(2), std::vector<std::uint64_t>{4});
+  EXPECT_TRUE(Reader(logPath, {channelB}).verify(2).empty());
+}
+
+TEST(Reader, checksumVerificationSkipsCorruptRecords)
+{
+  const auto logPath = writeAndCorrupt("reader-verifyReplay");
+
+  auto reader = Reader{logPath};
+  EXPECT_EQ(leadingBytes(reader.begin()).size(), 8U);
+
+  reader.setChecksumVerification(true);
+  const auto replayed = leadingBytes(reader.seek(std::chrono::system_clock::time_point{}));
+  EXPECT_EQ(
+      replayed,
+      (std::vector{
+          std::byte{0}, std::byte{1}, std::byte{2}, std::byte{3}, std::byte{5}, std::byte{6},
+          std::byte{7}}));
+}
+
+TEST(Reader, verifyRequiresChecksums)
+{
+  const auto logPath = [&]
+  {
+    auto writer = Writer{makeFreshEmptyDir("reader-noChecksums"), 1024};
+    writer.write(channelA, makeBytes(8));
+    return writer.path();
+  }();
+
+  const auto reader = Reader{logPath};
+  EXPECT_FALSE(reader.hasChecksums());
+  EXPECT_THROW(static_cast<void>(reader.verify()), std::runtime_error);
+}
+
+TEST(Reader, aShardedTimelineReplaysLikeASingleOne)
+{
+  constexpr auto kShards = std::size_t{4};
+  auto mark = std::chrono::system_clock::time_point{};
+  const auto logPath = [&]
+  {
+    auto writer = Writer{
+        makeFreshEmptyDir("reader-sharded"),
+        {.mRollCapacity = 1024,
+         .mTimelineCapacity = 4096,
+         .mChecksums = true,
+         .mTimelineShards = kShards}};
+    for(auto index = 0U; index < 8U; ++index)
+    {
+      if(index == 5U)
+      {
+        mark = pauseAndMark();
+      }
+      writer.write(index % 3U == 0U ? channelB : channelA, makeBytes(8, std::byte(index)));
+    }
+    return writer.path();
+  }();
+
+  EXPECT_FALSE(fs::exists(logPath / kTimelineFileName));
+  EXPECT_TRUE(fs::exists(logPath / buildShardName(kTimelineShardStem, kShards - 1)));
+
+  auto reader = Reader{logPath};
+  EXPECT_EQ(
+      leadingBytes(reader.begin()),
+      (std::vector{
+          std::byte{0}, std::byte{1}, std::byte{2}, std::byte{3}, std::byte{4}, std::byte{5},
+          std::byte{6}, std::byte{7}}));
+  EXPECT_EQ(reader.entries().size(), 8U);
+  EXPECT_EQ(reader.at(6).mChannelId, channelB);
+
+  // Every entry is stamped, so the seek is exact.
+  EXPECT_EQ(leadingBytes(reader.seek(mark)).front(), std::byte{5});
+  EXPECT_TRUE(reader.verify(2).empty());
+
+  auto selected = Reader{logPath, {channelB}};
+  EXPECT_EQ(
+      leadingBytes(selected.begin()),
+      (std::vector{std::byte{0}, std::byte{3}, std::byte{6}}));
+
+  // Without the merged order its Writer wrote, a Reader merges the shards itself, to the same end.
+  EXPECT_TRUE(fs::exists(logPath / kMergedOrderFileName));
+  fs::remove(logPath / kMergedOrderFileName);
+  fs::remove(logPath / kTimeIndexFileName);
+  auto merging = Reader{logPath};
+  EXPECT_EQ(merging.entries().size(), 8U);
+  EXPECT_EQ(merging.at(6).mChannelId, channelB);
+  EXPECT_EQ(leadingBytes(merging.seek(mark)).front(), std::byte{5});
+}
+
+TEST(Reader, aShardedTimelineKeepsEachProducersOrder)
+{
+  constexpr auto kProducers = 4U;
+  constexpr auto kRecordsEach = 200U;
+
+  const auto logPath = [&]
+  {
+    auto writer = Writer{
+        makeFreshEmptyDir("reader-shardedProducers"),
+        {.mRollCapacity = 4096,
+         .mTimelineCapacity = 1024ULL * 1024ULL,
+         .mTimelineShards = kProducers}};
+    {
+      auto producers = std::vector<std::jthread>{};
+      for(auto producer = 0U; producer < kProducers; ++producer)
+      {
+        producers.emplace_back(
+            [&writer, producer]
+            {
+              const auto channelId = ChannelId{producer + 1ULL};
+              for(auto index = 0U; index < kRecordsEach; ++index)
+              {
+                const auto value = static_cast<std::uint32_t>(index);
+                writer.write(channelId, std::as_bytes(std::span{&value, 1}));
+              }
+            });
+      }
+    }
+    return writer.path();
+  }();
+
+  auto next = std::array<std::uint32_t, kProducers>{};
+  auto count = 0U;
+  for(const auto& entry: Reader{logPath})
+  {
+    auto value = std::uint32_t{0};
+    std::memcpy(&value, entry.mCrate.span().data(), sizeof(value));
+    EXPECT_EQ(value, next.at(entry.mChannelId.mValue - 1ULL)++);
+    ++count;
+  }
+  EXPECT_EQ(count, kProducers * kRecordsEach);
+}
+
+TEST(Reader, rejectsATimelineOfThirtyTwoByteEntries)
+{
+  // Format version 1 recorded 32-byte entries, without a commit marker or a format file.
+  const auto logPath = makeFreshEmptyDir("reader-formatVersion1");
+  const auto entries = std::array<std::uint64_t, 8>{channelA.mValue, 0U, 0U, 8U, channelB.mValue};
+  {
+    auto file = std::ofstream{logPath / kTimelineFileName, std::ios::binary};
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast): ostream writes chars.
+    file.write(reinterpret_cast<const char*>(entries.data()), sizeof(entries));
+  }
+
+  EXPECT_THROW(Reader{logPath}, std::runtime_error);
+  EXPECT_THROW((Reader{logPath, {channelA}}), std::runtime_error);
+}
+
+TEST(Reader, rejectsAChronicleOfAnotherFormat)
+{
+  const auto logPath = [&]
+  {
+    auto writer = Writer{makeFreshEmptyDir("reader-otherFormat"), 1024};
+    writer.write(channelA, makeBytes(8));
+    return writer.path();
+  }();
+  EXPECT_EQ(Reader{logPath}.entries().size(), 1U);
+
+  {
+    auto format = containers::MmapArray<ChronicleFormat>{logPath / kFormatFileName, 1U};
+    format.at(0) = ChronicleFormat{.mVersion = kChronicleFormatVersion + 1U};
+  }
+  EXPECT_THROW(Reader{logPath}, std::runtime_error);
+
+  {
+    auto format = containers::MmapArray<ChronicleFormat>{logPath / kFormatFileName, 1U};
+    format.at(0) = ChronicleFormat{.mMagic = 0U};
+  }
+  EXPECT_THROW(Reader{logPath}, std::runtime_error);
+
+  std::ofstream{logPath / kFormatFileName} << "not a chronicle";
+  EXPECT_THROW(Reader{logPath}, std::runtime_error);
+}
+
 TEST(Reader, constructionRejectsMissingDirectory)
 {
   const auto missing = fs::temp_directory_path() / "nioc-chronicleTest" / "absent";
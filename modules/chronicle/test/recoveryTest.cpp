@@ -0,0 +1,253 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "utils.hpp"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <nioc/chronicle/reader.hpp>
+#include <nioc/chronicle/recovery.hpp>
+#include <nioc/chronicle/writer.hpp>
+#include <nioc/common/utils.hpp>
+#include <nioc/containers/mmapArray.hpp>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace nioc::chronicle
+{
+namespace
+{
+namespace fs = std::filesystem;
+
+constexpr auto channelA = ChannelId{16983ULL};
+constexpr auto channelB = ChannelId{68964786ULL};
+
+constexpr auto kRecordSize = std::size_t{100};
+
+fs::path freshDir(const std::string_view name)
+{
+  const auto path = fs::temp_directory_path() / "nioc-chronicleTest" / name;
+  fs::remove_all(path);
+  fs::create_directories(path);
+  return path;
+}
+
+fs::path rollPath(const fs::path& logRoot, const ChannelId channelId, const std::uint64_t rollId)
+{
+  return logRoot / common::hexString(channelId.mValue) / buildRollName(rollId);
+}
+
+// Records A A A B into 256-byte rolls, so channel A fills roll 0 and writes one record into roll 1,
+// then leaves the files as a crash would have: untrimmed, with a spare roll, and without indices.
+fs::path recordAndCrash(const std::string_view name)
+{
+  const auto logRoot = [name]
+  {
+    auto writer = Writer{freshDir(name), 256};
+    for(const auto channelId: {channelA, channelA, channelA, channelB})
+    {
+      writer.write(channelId, std::vector<std::byte>(kRecordSize, std::byte{7}));
+    }
+    return writer.path();
+  }();
+
+  fs::resize_file(logRoot / kTimelineFileName, 1024ULL * sizeof(TimelineEntry));
+  fs::resize_file(logRoot / kTimeIndexFileName, 16ULL * sizeof(TimeIndexEntry));
+  fs::resize_file(rollPath(logRoot, channelA, 1), 256ULL);
+  fs::resize_file(rollPath(logRoot, channelB, 0), 256ULL);
+  std::ofstream{rollPath(logRoot, channelA, 2)} << "spare";
+  fs::remove(logRoot / common::hexString(channelA.mValue) / kChannelIndexFileName);
+  fs::remove(logRoot / common::hexString(channelB.mValue) / kChannelIndexFileName);
+  return logRoot;
+}
+
+std::size_t countEntries(const fs::path& logRoot)
+{
+  auto reader = Reader{logRoot};
+  auto count = std::size_t{0};
+  for(const auto& entry: reader)
+  {
+    EXPECT_EQ(entry.mCrate.span().size(), kRecordSize);
+    ++count;
+  }
+  return count;
+}
+
+} // namespace
+
+TEST(Recovery, readerReplaysOnlyTheCommittedEntriesOfACrashedChronicle)
+{
+  const auto logRoot = recordAndCrash("recoveryReader");
+
+  EXPECT_EQ(countEntries(logRoot), 4U);
+  auto reader = Reader{logRoot};
+  EXPECT_EQ(reader.entries().size(), 4U);
+}
+
+TEST(Recovery, trimsTheFilesAndDeletesTheSpareRoll)
+{
+  const auto logRoot = recordAndCrash("recoveryTrim");
+
+  recover(logRoot);
+
+  EXPECT_EQ(fs::file_size(logRoot / kTimelineFileName), 4U * sizeof(TimelineEntry));
+  EXPECT_EQ(fs::file_size(logRoot / kTimeIndexFileName), sizeof(TimeIndexEntry));
+  EXPECT_EQ(fs::file_size(rollPath(logRoot, channelA, 1)), kRecordSize);
+  EXPECT_EQ(fs::file_size(rollPath(logRoot, channelB, 0)), kRecordSize);
+  EXPECT_FALSE(fs::exists(rollPath(logRoot, channelA, 2)));
+  EXPECT_EQ(countEntries(logRoot), 4U);
+  auto reader = Reader{logRoot, {channelA}};
+  EXPECT_EQ(reader.entries().size(), 3U);
+}
+
+TEST(Recovery, leavesACleanChronicleAsItIs)
+{
+  const auto logRoot = recordAndCrash("recoveryTwice");
+  recover(logRoot);
+  const auto rollSize = fs::file_size(rollPath(logRoot, channelA, 0));
+
+  recover(logRoot);
+
+  EXPECT_EQ(fs::file_size(logRoot / kTimelineFileName), 4U * sizeof(TimelineEntry));
+  EXPECT_EQ(fs::file_size(rollPath(logRoot, channelA, 0)), rollSize);
+  EXPECT_EQ(countEntries(logRoot), 4U);
+}
+
+TEST(Recovery, trimsEveryShardOfAShardedTimeline)
+{
+  constexpr auto kShards = 2ULL;
+  const auto logRoot = [&]
+  {
+    auto writer =
+        Writer{freshDir("recoveryShards"), {.mRollCapacity = 256, .mTimelineShards = kShards}};
+    for(const auto channelId: {channelA, channelA, channelA, channelB})
+    {
+      writer.write(channelId, std::vector<std::byte>(kRecordSize, std::byte{7}));
+    }
+    return writer.path();
+  }();
+
+  auto shardBytes = std::uint64_t{0ULL};
+  for(auto shard = 0ULL; shard < kShards; ++shard)
+  {
+    const auto shardPath = logRoot / buildShardName(kTimelineShardStem, shard);
+    shardBytes += fs::file_size(shardPath);
+    fs::resize_file(shardPath, 64ULL * sizeof(StampedEntry));
+  }
+  EXPECT_EQ(shardBytes, 4U * sizeof(StampedEntry));
+  fs::resize_file(rollPath(logRoot, channelA, 1), 256ULL);
+  EXPECT_EQ(countEntries(logRoot), 4U);
+
+  recover(logRoot);
+
+  shardBytes = 0ULL;
+  for(auto shard = 0ULL; shard < kShards; ++shard)
+  {
+    shardBytes += fs::file_size(logRoot / buildShardName(kTimelineShardStem, shard));
+  }
+  EXPECT_EQ(shardBytes, 4U * sizeof(StampedEntry));
+  EXPECT_EQ(fs::file_size(rollPath(logRoot, channelA, 1)), kRecordSize);
+  EXPECT_EQ(countEntries(logRoot), 4U);
+  EXPECT_EQ((Reader{logRoot, {channelA}}.entries().size()), 3U);
+}
+
+TEST(Recovery, cutsTheTimelineBackToTheRecordsWrittenDirectlyToDisk)
+{
+  const auto logRoot = []
+  {
+    auto writer = Writer{
+        freshDir("recoveryDirect"),
+        {.mRollCapacity = 256, .mWriteback = {.mMode = containers::WriteMode::Direct}}};
+    for(const auto channelId: {channelA, channelA, channelA, channelB})
+    {
+      writer.write(channelId, std::vector<std::byte>(kRecordSize, std::byte{7}));
+    }
+    return writer.path();
+  }();
+
+  // As a crash would have left them had channel A's record in roll 1 never reached disk.
+  const auto marksPath = logRoot / common::hexString(channelA.mValue) / kDurableMarksFileName;
+  EXPECT_FALSE(fs::exists(marksPath));
+  containers::MmapArray<std::uint64_t>{marksPath, 1U}[0] = 2U;
+
+  recover(logRoot);
+
+  EXPECT_EQ(fs::file_size(logRoot / kTimelineFileName), 2U * sizeof(TimelineEntry));
+  EXPECT_FALSE(fs::exists(rollPath(logRoot, channelA, 1)));
+  EXPECT_EQ(fs::file_size(rollPath(logRoot, channelB, 0)), 0U);
+  EXPECT_FALSE(fs::exists(marksPath));
+  EXPECT_EQ(countEntries(logRoot), 2U);
+}
+
+TEST(Recovery, keepsTheRecordsOfAChannelCreatedAfterRetentionDiscardedEntries)
+{
+  const auto logRoot = freshDir("recoveryDirectRetention");
+  const auto crashed = freshDir("recoveryDirectRetentionCrashed");
+  {
+    auto writer = Writer{
+        logRoot,
+        {.mRollCapacity = 256,
+         .mRetention = {.mMaxAge = std::chrono::milliseconds{1}},
+         .mWriteback =
+             {.mInterval = std::chrono::milliseconds{1}, .mMode = containers::WriteMode::Direct}}};
+    for(auto index = 0; index < 8; ++index)
+    {
+      writer.write(channelA, std::vector<std::byte>(kRecordSize, std::byte{7})); // two a roll
+    }
+
+    // The pacing thread ages channel A's sealed rolls out and discards their timeline entries.
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    ASSERT_TRUE(fs::exists(logRoot / kDiscardedFileName));
+
+    writer.write(channelB, std::vector<std::byte>(kRecordSize, std::byte{7}));
+    writer.write(channelA, std::vector<std::byte>(kRecordSize, std::byte{7}));
+    writer.checkpoint();
+
+    // As a crash right after the checkpoint would have left the files.
+    fs::copy(logRoot, crashed, fs::copy_options::recursive);
+  }
+
+  recover(crashed);
+
+  // Channel B's durable mark covers its record, so the timeline is not cut back to it.
+  auto channels = std::vector<ChannelId>{};
+  for(const auto& entry: Reader{crashed})
+  {
+    channels.push_back(entry.mChannelId);
+  }
+  ASSERT_GE(channels.size(), 2U);
+  EXPECT_EQ(channels.at(channels.size() - 2U), channelB);
+  EXPECT_EQ(channels.back(), channelA);
+}
+
+TEST(Recovery, leavesATimelineOfThirtyTwoByteEntriesUntouched)
+{
+  // Format version 1 recorded 32-byte entries, without a commit marker or a format file; cutting
+  // it back to the entries this build takes as committed would destroy it.
+  const auto logRoot = freshDir("recoveryFormatVersion1");
+  const auto entries = std::array<std::uint64_t, 8>{channelA.mValue, 0U, 0U, 8U, channelB.mValue};
+  {
+    auto file = std::ofstream{logRoot / kTimelineFileName, std::ios::binary};
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast): ostream writes chars.
+    file.write(reinterpret_cast<const char*>(entries.data()), sizeof(entries));
+  }
+
+  EXPECT_THROW(recover(logRoot), std::runtime_error);
+  EXPECT_EQ(fs::file_size(logRoot / kTimelineFileName), sizeof(entries));
+}
+
+TEST(Recovery, rejectsAMissingDirectory)
+{
+  EXPECT_THROW(recover(freshDir("recoveryMissing") / "absent"), std::invalid_argument);
+}
+
+} // namespace nioc::chronicle
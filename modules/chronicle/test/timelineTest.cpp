@@ -0,0 +1,190 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "utils.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <nioc/chronicle/defines.hpp>
+#include <nioc/chronicle/timeline.hpp>
+#include <nioc/containers/mmapConstArray.hpp>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace nioc::chronicle
+{
+namespace
+{
+namespace fs = std::filesystem;
+
+constexpr auto channelA = ChannelId{16983ULL};
+
+fs::path freshDir(const std::string_view name)
+{
+  const auto path = fs::temp_directory_path() / "nioc-chronicleTest" / name;
+  fs::remove_all(path);
+  fs::create_directories(path);
+  return path;
+}
+
+TimelineEntry makeEntry(const std::uint64_t offset)
+{
+  return TimelineEntry{.mChannelId = channelA, .mRollId = 0ULL, .mOffset = offset, .mSize = 8ULL};
+}
+
+template<typename ValueType>
+std::vector<ValueType> readBack(const fs::path& file)
+{
+  if(fs::file_size(file) == 0)
+  {
+    return {}; // a trimmed-empty file holds nothing and cannot be mapped
+  }
+  const auto array = containers::MmapConstArray<ValueType>{file};
+  return {array.begin(), array.end()};
+}
+
+} // namespace
+
+TEST(Timeline, appendReturnsConsecutivePositions)
+{
+  auto timeline = Timeline{freshDir("tlPositions"), 8};
+
+  EXPECT_EQ(timeline.append(makeEntry(0)), 0U);
+  EXPECT_EQ(timeline.append(makeEntry(8)), 1U);
+  EXPECT_EQ(timeline.append(makeEntry(16)), 2U);
+  EXPECT_EQ(timeline.size(), 3U);
+  EXPECT_EQ(timeline.capacity(), 8U);
+}
+
+TEST(Timeline, appendThrowsOnceFull)
+{
+  auto timeline = Timeline{freshDir("tlFull"), 1};
+  static_cast<void>(timeline.append(makeEntry(0)));
+  EXPECT_THROW(static_cast<void>(timeline.append(makeEntry(8))), std::runtime_error);
+}
+
+TEST(Timeline, aZeroStrideIsRejected)
+{
+  EXPECT_THROW((Timeline{freshDir("tlZeroStride"), 8, 0}), std::invalid_argument);
+}
+
+TEST(Timeline, samplesEveryStrideIntoTheTimeIndex)
+{
+  const auto dir = freshDir("tlSamples");
+  {
+    auto timeline = Timeline{dir, 16, 3};
+    for(auto index = 0ULL; index < 7ULL; ++index)
+    {
+      static_cast<void>(timeline.append(makeEntry(index * 8ULL)));
+    }
+    timeline.shrink_to_fit();
+  }
+
+  EXPECT_EQ(readBack<TimelineEntry>(dir / kTimelineFileName).size(), 7U);
+
+  // Entries 0, 3 and 6 fall on the stride; the samples are in position and time order.
+  const auto samples = readBack<TimeIndexEntry>(dir / kTimeIndexFileName);
+  ASSERT_EQ(samples.size(), 3U);
+  EXPECT_EQ(samples.at(0).mEntryInTimeline, 0U);
+  EXPECT_EQ(samples.at(1).mEntryInTimeline, 3U);
+  EXPECT_EQ(samples.at(2).mEntryInTimeline, 6U);
+  EXPECT_GT(samples.at(0).mTimestamp, 0);
+  EXPECT_LE(samples.at(0).mTimestamp, samples.at(1).mTimestamp);
+  EXPECT_LE(samples.at(1).mTimestamp, samples.at(2).mTimestamp);
+}
+
+TEST(Timeline, shrinkToFitEmptiesBothFilesWhenNothingWasAppended)
+{
+  const auto dir = freshDir("tlEmpty");
+  {
+    auto timeline = Timeline{dir, 16};
+    timeline.shrink_to_fit();
+  }
+
+  EXPECT_EQ(fs::file_size(dir / kTimelineFileName), 0U);
+  EXPECT_EQ(fs::file_size(dir / kTimeIndexFileName), 0U);
+}
+
+TEST(Timeline, writebackAndSyncLeaveTheEntriesInPlace)
+{
+  const auto dir = freshDir("tlSync");
+  {
+    auto timeline = Timeline{dir, 16, 4};
+    timeline.startWriteback(); // nothing appended yet
+    static_cast<void>(timeline.append(makeEntry(0)));
+    timeline.startWriteback();
+    static_cast<void>(timeline.append(makeEntry(8)));
+    timeline.sync();
+    timeline.shrink_to_fit();
+  }
+
+  const auto entries = readBack<TimelineEntry>(dir / kTimelineFileName);
+  ASSERT_EQ(entries.size(), 2U);
+  EXPECT_EQ(entries.at(1).mOffset, 8U);
+}
+
+TEST(Timeline, aShardCountOutOfRangeIsRejected)
+{
+  EXPECT_THROW((Timeline{freshDir("tlNoShards"), 8, 4, false, 0}), std::invalid_argument);
+  EXPECT_THROW(
+      (Timeline{freshDir("tlTooManyShards"), 8, 4, false, Timeline::kMaxShards + 1}),
+      std::invalid_argument);
+}
+
+TEST(Timeline, aShardedTimelineStampsEveryEntryIntoItsShards)
+{
+  const auto dir = freshDir("tlShards");
+  {
+    auto timeline = Timeline{dir, 64, 4, true, 4};
+    EXPECT_EQ(timeline.shardCount(), 4U);
+    EXPECT_EQ(timeline.capacity(), 64U);
+    EXPECT_TRUE(timeline.hasChecksums());
+    for(auto index = 0ULL; index < 10ULL; ++index)
+    {
+      static_cast<void>(timeline.append(makeEntry(index * 8ULL), 7U));
+    }
+    EXPECT_EQ(timeline.size(), 10U);
+    timeline.sync();
+    timeline.shrink_to_fit();
+  }
+
+  // The shards replace the single timeline and its time index.
+  EXPECT_FALSE(fs::exists(dir / kTimelineFileName));
+  EXPECT_FALSE(fs::exists(dir / kTimeIndexFileName));
+
+  auto offsets = std::vector<std::uint64_t>{};
+  for(auto shard = 0ULL; shard < 4ULL; ++shard)
+  {
+    const auto entries =
+        readBack<StampedEntry>(dir / buildShardName(kTimelineShardStem, shard));
+    const auto checksums =
+        readBack<std::uint32_t>(dir / buildShardName(kChecksumsShardStem, shard));
+    EXPECT_EQ(checksums.size(), entries.size());
+    for(const auto& entry: entries)
+    {
+      EXPECT_GT(entry.mTimestamp, 0);
+      EXPECT_EQ(entry.mEntry.mChannelId, channelA);
+      offsets.push_back(entry.mEntry.mOffset);
+    }
+  }
+  std::ranges::sort(offsets);
+  ASSERT_EQ(offsets.size(), 10U);
+  EXPECT_EQ(offsets.back(), 72U);
+}
+
+TEST(Timeline, aFullShardHandsItsAppendsToTheNext)
+{
+  auto timeline = Timeline{freshDir("tlShardsFull"), 2, 4, false, 2};
+  static_cast<void>(timeline.append(makeEntry(0)));
+  static_cast<void>(timeline.append(makeEntry(8)));
+  EXPECT_EQ(timeline.size(), 2U);
+  EXPECT_THROW(static_cast<void>(timeline.append(makeEntry(16))), std::runtime_error);
+}
+
+} // namespace nioc::chronicle
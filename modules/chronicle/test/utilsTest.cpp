@@ -5,7 +5,9 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "utils.hpp"
+#include <algorithm>
 #include <gtest/gtest.h>
+#include <vector>
 
 namespace nioc::chronicle
 {
@@ -24,4 +26,58 @@ TEST(ChronicleUtils, buildRollName)
   EXPECT_EQ("roll00000003519894239162.nioc", buildRollName(3519894239162U));
 }
 
+TEST(ChronicleUtils, parseRollName)
+{
+  EXPECT_EQ(parseRollName(buildRollName(0U)), 0U);
+  EXPECT_EQ(parseRollName(buildRollName(3519894239162U)), 3519894239162U);
+  EXPECT_FALSE(parseRollName("index.nioc").has_value());
+  EXPECT_FALSE(parseRollName("roll0000000000000000000x.nioc").has_value());
+  EXPECT_FALSE(parseRollName("roll00000000000000000001.tmp").has_value());
+  EXPECT_EQ(parseRollName(buildRollName(7U) + kCompressedRollSuffix), 7U);
+}
+
+TEST(ChronicleUtils, committedLengthFindsTheTailPastHoles)
+{
+  const auto committed =
+      TimelineEntry{.mChannelId = ChannelId{7ULL}, .mSize = 8ULL, .mCommitted = kCommitted};
+  auto timeline = std::vector<TimelineEntry>(100000);
+  EXPECT_EQ(committedLength(timeline), 0U);
+
+  std::fill_n(timeline.begin(), 70000, committed);
+  EXPECT_EQ(committedLength(timeline), 70000U);
+
+  // A producer that claimed slot 69998 crashed before publishing it; later slots were published.
+  timeline.at(69998) = TimelineEntry{};
+  timeline.at(70002) = committed;
+  EXPECT_EQ(committedLength(timeline), 70003U);
+
+  std::ranges::fill(timeline, committed);
+  EXPECT_EQ(committedLength(timeline), timeline.size());
+}
+
+TEST(ChronicleUtils, sampledLengthStopsAtTheFirstUnwrittenSample)
+{
+  const auto samples = std::vector<TimeIndexEntry>{
+      {.mTimestamp = 10LL, .mEntryInTimeline = 0ULL},
+      {.mTimestamp = 20LL, .mEntryInTimeline = 4ULL},
+      {.mTimestamp = 30LL, .mEntryInTimeline = 8ULL},
+      {}};
+  EXPECT_EQ(sampledLength(samples, 100ULL), 3U);
+  EXPECT_EQ(sampledLength(samples, 8ULL), 2U);
+}
+
+TEST(ChronicleUtils, clampToRunningMaxOrdersSamplesWrittenOutOfOrder)
+{
+  // The producer of position 4 sampled after the one of position 8.
+  auto samples = std::vector<TimeIndexEntry>{
+      {.mTimestamp = 10LL, .mEntryInTimeline = 0ULL},
+      {.mTimestamp = 35LL, .mEntryInTimeline = 4ULL},
+      {.mTimestamp = 30LL, .mEntryInTimeline = 8ULL},
+      {.mTimestamp = 40LL, .mEntryInTimeline = 12ULL}};
+  clampToRunningMax(samples);
+  EXPECT_TRUE(std::ranges::is_sorted(samples, {}, &TimeIndexEntry::mTimestamp));
+  EXPECT_EQ(samples.at(2).mTimestamp, 35LL);
+  EXPECT_EQ(samples.at(3).mTimestamp, 40LL);
+}
+
 } // namespace nioc::chronicle
@@ -6,6 +6,7 @@
 
 #include "utils.hpp"
 #include <array>
+#include <chrono>
 #include <cstddef>
 #include <cstring>
 #include <fstream>
@@ -15,7 +16,10 @@
 #include <nioc/chronicle/reader.hpp>
 #include <nioc/chronicle/writer.hpp>
 #include <nioc/common/utils.hpp>
+#include <nioc/containers/mmapConstArray.hpp>
+#include <set>
 #include <span>
+#include <stdexcept>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -286,6 +290,260 @@ TEST(Writer, recordsAcrossChannelsAndReplaysInGlobalOrder)
   EXPECT_EQ(kFrameCount, index);
 }
 
+TEST(Writer, mapsEachChannelsRollsAndTheTimelineUnderTheirOwnPolicies)
+{
+  const auto populated = containers::MapPolicy{.mPopulate = true};
+  const auto logPath = [&]
+  {
+    auto writer = Writer{
+        makeFreshEmptyDir("mapPolicies"),
+        {.mRollCapacity = 256,
+         .mChannelPolicies = {{channelA, populated}},
+         .mTimelinePolicy = populated}};
+    for(auto index = std::uint8_t{0}; index < 4U; ++index)
+    {
+      writer.write(index % 2 == 0 ? channelA : channelB, makeBytes(4, std::byte{index}));
+    }
+    return writer.path();
+  }();
+
+  auto index = std::uint8_t{0};
+  for(const auto& entry: Reader{logPath})
+  {
+    EXPECT_EQ(index % 2 == 0 ? channelA : channelB, entry.mChannelId);
+    expectBytesEqual(makeBytes(4, std::byte{index}), entry.mCrate.span());
+    ++index;
+  }
+  EXPECT_EQ(index, 4U);
+}
+
+TEST(Writer, retentionByBytesKeepsOnlyTheNewestRolls)
+{
+  // Each 100-byte frame fills a 128-byte roll of its own; the budget keeps two sealed rolls.
+  const auto retention = Retention{.mMaxBytes = 2U * 104U};
+  const auto logPath = [&]
+  {
+    auto writer = Writer{
+        makeFreshEmptyDir("retentionBytes"),
+        {.mRollCapacity = 128, .mTimelineCapacity = 4096, .mRetention = retention}};
+    for(auto index = 0; index < 6; ++index)
+    {
+      writer.write(channelA, makeBytes(100, std::byte(index)));
+    }
+    return writer.path();
+  }();
+
+  for(auto rollId = 0U; rollId < 3U; ++rollId)
+  {
+    EXPECT_FALSE(fs::exists(rollPath(logPath, channelA, rollId)));
+  }
+  for(auto rollId = 3U; rollId < 6U; ++rollId)
+  {
+    EXPECT_TRUE(fs::exists(rollPath(logPath, channelA, rollId)));
+  }
+
+  // Replay resumes at the surviving window; random access still counts every record.
+  const auto entries = drain(logPath);
+  ASSERT_EQ(entries.size(), 3U);
+  EXPECT_EQ(entries.front().mCrate.span().front(), std::byte{3});
+
+  auto reader = Reader{logPath};
+  EXPECT_EQ(reader.entries().size(), 6U);
+  EXPECT_TRUE(reader.at(0).mCrate.span().empty());
+  EXPECT_EQ(reader.at(5).mCrate.span().front(), std::byte{5});
+}
+
+TEST(Writer, retentionByAgeDropsStaleRollsAtTheNextRollover)
+{
+  const auto retention = Retention{.mMaxAge = std::chrono::milliseconds{1}};
+  const auto logPath = [&]
+  {
+    auto writer = Writer{
+        makeFreshEmptyDir("retentionAge"),
+        {.mRollCapacity = 128, .mTimelineCapacity = 4096, .mRetention = retention}};
+    writer.write(channelA, makeBytes(100, std::byte{0})); // roll 0
+    writer.write(channelA, makeBytes(100, std::byte{1})); // roll 1; roll 0 sealed
+    std::this_thread::sleep_for(std::chrono::milliseconds{5});
+    writer.write(channelA, makeBytes(100, std::byte{2})); // roll 2; roll 0 has expired
+    return writer.path();
+  }();
+
+  EXPECT_FALSE(fs::exists(rollPath(logPath, channelA, 0)));
+  EXPECT_TRUE(fs::exists(rollPath(logPath, channelA, 2)));
+  EXPECT_EQ(drain(logPath).front().mCrate.span().front(), std::byte{1});
+}
+
+TEST(Writer, retentionAgesAQuietChannelOutAndDiscardsItsTimelineEntries)
+{
+  const auto retention = Retention{.mMaxAge = std::chrono::milliseconds{1}};
+  const auto writeback = Writeback{.mInterval = std::chrono::milliseconds{1}};
+  constexpr auto kFrameCount = 300U;
+  const auto logPath = [&]
+  {
+    auto writer = Writer{
+        makeFreshEmptyDir("retentionQuiet"),
+        {.mRollCapacity = 128,
+         .mTimelineCapacity = 65536,
+         .mRetention = retention,
+         .mWriteback = writeback}};
+    for(auto index = 0U; index < kFrameCount; ++index)
+    {
+      writer.write(channelA, makeBytes(100, static_cast<std::byte>(index))); // a roll each
+    }
+
+    // No rollover follows, yet the pacing thread ages every sealed roll out.
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    EXPECT_FALSE(fs::exists(rollPath(writer.path(), channelA, kFrameCount - 2U)));
+    return writer.path();
+  }();
+
+  EXPECT_TRUE(fs::exists(rollPath(logPath, channelA, kFrameCount - 1U)));
+  const auto discarded = containers::MmapConstArray<std::uint64_t>{logPath / kDiscardedFileName};
+  EXPECT_EQ(discarded.at(0), kFrameCount - 1U);
+
+  // The discarded entries read as lost; the surviving record replays, in place.
+  auto reader = Reader{logPath};
+  EXPECT_EQ(reader.entries().size(), kFrameCount);
+  EXPECT_TRUE(reader.at(0).mCrate.span().empty());
+  const auto entries = drain(logPath);
+  ASSERT_EQ(entries.size(), 1U);
+  EXPECT_EQ(entries.front().mCrate.span().front(), static_cast<std::byte>(kFrameCount - 1U));
+
+  auto selected = std::size_t{0};
+  for(const auto& entry: Reader{logPath, {channelA}})
+  {
+    EXPECT_FALSE(entry.mCrate.span().empty());
+    ++selected;
+  }
+  EXPECT_EQ(selected, 1U);
+}
+
+TEST(Writer, checkpointFlushesAcrossRolloversAndPacedWriteback)
+{
+  const auto writeback =
+      Writeback{.mInterval = std::chrono::milliseconds{1}, .mBytesPerSecond = 64ULL * 1024ULL};
+  const auto logPath = [&]
+  {
+    auto writer = Writer{
+        makeFreshEmptyDir("checkpoint"),
+        {.mRollCapacity = 128, .mTimelineCapacity = 4096, .mWriteback = writeback}};
+    writer.checkpoint(); // nothing written yet
+    for(auto index = 0; index < 6; ++index)
+    {
+      writer.write(channelA, makeBytes(100, static_cast<std::byte>(index)));
+      std::this_thread::sleep_for(std::chrono::milliseconds{2});
+    }
+    writer.checkpoint();
+    return writer.path();
+  }();
+
+  const auto entries = drain(logPath);
+  ASSERT_EQ(entries.size(), 6U);
+  for(auto index = 0U; index < entries.size(); ++index)
+  {
+    const auto expected = makeBytes(100, static_cast<std::byte>(index));
+    expectBytesEqual(entries.at(index).mCrate.span(), expected);
+  }
+}
+
+TEST(Writer, directWritebackRecordsRollsAReaderReplays)
+{
+  const auto writeback = Writeback{.mMode = containers::WriteMode::Direct};
+  const auto logPath = [&]
+  {
+    auto writer = Writer{
+        makeFreshEmptyDir("directWriteback"),
+        {.mRollCapacity = 8192, .mTimelineCapacity = 4096, .mWriteback = writeback}};
+    for(auto index = 0; index < 10; ++index)
+    {
+      writer.write(channelA, makeBytes(3000, static_cast<std::byte>(index)));
+      if(index == 4)
+      {
+        writer.checkpoint();
+      }
+    }
+    return writer.path();
+  }();
+
+  const auto entries = drain(logPath);
+  ASSERT_EQ(entries.size(), 10U);
+  for(auto index = 0U; index < entries.size(); ++index)
+  {
+    const auto expected = makeBytes(3000, static_cast<std::byte>(index));
+    expectBytesEqual(entries.at(index).mCrate.span(), expected);
+  }
+}
+
+TEST(Writer, directWritebackRestagesTheRollsItsCratesLetGoOf)
+{
+  const auto writeback = Writeback{.mMode = containers::WriteMode::Direct};
+  auto rolls = std::set<const std::byte*>{};
+  const auto logPath = [&]
+  {
+    auto writer = Writer{
+        makeFreshEmptyDir("directPool"),
+        {.mRollCapacity = 8192, .mTimelineCapacity = 4096, .mWriteback = writeback}};
+    for(auto index = 0; index < 40; ++index)
+    {
+      const auto crate = writer.write(channelA, makeBytes(3000, static_cast<std::byte>(index)));
+
+      // Each roll holds two records. Checkpointing waits for the last seal, which pools its roll.
+      if(index % 2 == 0)
+      {
+        rolls.insert(crate.span().data());
+      }
+      writer.checkpoint();
+    }
+    return writer.path();
+  }();
+
+  // 19 rollovers, yet only the active roll, the spare, and a pooled roll or two stage records.
+  EXPECT_LE(rolls.size(), 4U);
+
+  const auto entries = drain(logPath);
+  ASSERT_EQ(entries.size(), 40U);
+  for(auto index = 0U; index < entries.size(); ++index)
+  {
+    const auto expected = makeBytes(3000, static_cast<std::byte>(index));
+    expectBytesEqual(entries.at(index).mCrate.span(), expected);
+  }
+}
+
+TEST(Writer, directWritebackMarksTheRecordsOnDisk)
+{
+  const auto writeback = Writeback{.mMode = containers::WriteMode::Direct};
+  const auto logPath = makeFreshEmptyDir("directMarks");
+  const auto marksPath = logPath / common::hexString(channelA.mValue) / kDurableMarksFileName;
+  {
+    auto writer = Writer{
+        logPath,
+        {.mRollCapacity = 8192, .mTimelineCapacity = 4096, .mWriteback = writeback}};
+    for(auto index = 0; index < 3; ++index)
+    {
+      writer.write(channelA, makeBytes(3000, static_cast<std::byte>(index)));
+    }
+    EXPECT_EQ(containers::MmapConstArray<std::uint64_t>{marksPath}.at(0), 0U);
+
+    writer.checkpoint();
+    EXPECT_EQ(containers::MmapConstArray<std::uint64_t>{marksPath}.at(0), 3U);
+  }
+
+  // Closing writes every roll out in full, leaving nothing for recovery to cut.
+  EXPECT_FALSE(fs::exists(marksPath));
+}
+
+TEST(Writer, directWritebackCannotBeTailed)
+{
+  EXPECT_THROW(
+      (Writer{
+          makeFreshEmptyDir("directDoorbell"),
+          {.mRollCapacity = 8192,
+           .mTimelineCapacity = 4096,
+           .mWriteback = {.mMode = containers::WriteMode::Direct},
+           .mDoorbellInterval = std::chrono::milliseconds{1}}}),
+      std::invalid_argument);
+}
+
 TEST(Writer, path)
 {
   const auto dir = makeFreshEmptyDir("writerPath");
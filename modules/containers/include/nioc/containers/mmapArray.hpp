@@ -18,7 +18,7 @@ namespace nioc::containers
 
 /// @brief A writable, file-backed array of `ValueType` whose storage is a memory-mapped file.
 ///
-/// Use this as a fixed-size, std-like contiguous container that persists to disk. Reads and writes
+/// Use this as a std-like contiguous container that persists to disk. Reads and writes
 /// go straight to the mapping, so every element write reaches the backing file. The constructor
 /// creates or truncates the file and maps it read-write, so any prior file contents are discarded
 /// and every element starts zero-filled. Element access is unchecked; an out-of-range index is
@@ -31,6 +31,9 @@ namespace nioc::containers
 ///     a[0] = 3.14; // persisted to the file
 ///     for (auto x : a) { ... }
 ///
+/// The size is fixed, unless the array is created with a larger reservation: then grow() extends
+/// it in place, up to that many elements, without moving one.
+///
 /// Non-copyable; move-constructible. The mapped bytes never change address, so a move transfers
 /// the mapping and file descriptor while every element reference stays valid; the moved-from
 /// array is empty. Destruction unmaps the region and closes the file. It is not thread-safe;
@@ -65,9 +68,26 @@ public:
   ///
   /// @param count Number of elements. Must be non-zero; a zero-length mapping is rejected.
   ///
+  /// @param writeMode How written elements reach the file (see WriteMode).
+  ///
+  /// @param reservedCount Most elements grow() can extend the array to in place. No more than
+  /// @p count, the default, leaves the array fixed at @p count.
+  ///
+  /// @param policy How to map the elements, and those the array grows by (see MapPolicy).
+  ///
   /// @throws std::runtime_error If the file cannot be created, sized, or mapped.
-  MmapArray(std::filesystem::path path, const size_type count):
-    mRegion{std::move(path), count * sizeof(ValueType)}
+  MmapArray(
+      std::filesystem::path path,
+      const size_type count,
+      const WriteMode writeMode = WriteMode::Mapped,
+      const size_type reservedCount = 0,
+      const MapPolicy policy = {}):
+    mRegion{
+        std::move(path),
+        count * sizeof(ValueType),
+        writeMode,
+        reservedCount * sizeof(ValueType),
+        policy}
   {
   }
 
@@ -154,6 +174,27 @@ public:
     return mRegion.size() / sizeof(ValueType);
   }
 
+  /// @brief Most elements grow() can extend the array to in place.
+  [[nodiscard]] size_type reservation() const noexcept
+  {
+    return mRegion.reservation() / sizeof(ValueType);
+  }
+
+  /// @brief Extend the file and the mapping to @p count elements in place; the new elements read
+  /// as zero, and every element keeps its address.
+  ///
+  /// Safe alongside element access and size(); not alongside itself or resize().
+  ///
+  /// @throws std::invalid_argument If @p count exceeds reservation().
+  ///
+  /// @throws std::runtime_error If the file cannot be extended or mapped.
+  ///
+  /// @see MmapRegion::grow
+  void grow(const size_type count)
+  {
+    mRegion.grow(count * sizeof(ValueType));
+  }
+
   /// @brief Truncate or extend the on-disk backing file to @p count elements; does not remap.
   ///
   /// Only the file's length changes. The mapping is untouched, so `size()`, `data()`, and the
@@ -166,6 +207,66 @@ public:
     mRegion.resize(count * sizeof(ValueType));
   }
 
+  /// @brief Point a Direct array's staged elements at a fresh file at @p path, @p count elements
+  /// long, keeping the staging memory.
+  ///
+  /// @throws std::logic_error if the array is not a Direct one.
+  ///
+  /// @throws std::runtime_error if the file cannot be created or sized.
+  ///
+  /// @see MmapRegion::restage
+  void restage(std::filesystem::path path, const size_type count)
+  {
+    mRegion.restage(std::move(path), count * sizeof(ValueType));
+  }
+
+  /// @brief Move the array's file to @p path, keeping its mapping and elements.
+  ///
+  /// @throws std::filesystem::filesystem_error if the file cannot be moved.
+  ///
+  /// @see MmapRegion::rename
+  void rename(std::filesystem::path path)
+  {
+    mRegion.rename(std::move(path));
+  }
+
+  /// @brief Start writing back elements `[first, first + count)` without waiting for the I/O.
+  ///
+  /// @see MmapRegion::startWriteback
+  void startWriteback(const size_type first, const size_type count) const noexcept
+  {
+    mRegion.startWriteback(first * sizeof(ValueType), count * sizeof(ValueType));
+  }
+
+  /// @brief Free the file space and pages of elements `[first, first + count)`, which read as zero
+  /// from then on.
+  ///
+  /// @see MmapRegion::discard
+  void discard(const size_type first, const size_type count) const noexcept
+  {
+    mRegion.discard(first * sizeof(ValueType), count * sizeof(ValueType));
+  }
+
+  /// @brief Copy staged elements `[first, first + count)` of a Direct array into the file.
+  ///
+  /// @throws std::runtime_error if the write fails.
+  ///
+  /// @see MmapRegion::writeThrough
+  void writeThrough(const size_type first, const size_type count) const
+  {
+    mRegion.writeThrough(first * sizeof(ValueType), count * sizeof(ValueType));
+  }
+
+  /// @brief Make every element, and the file's length, durable on disk.
+  ///
+  /// @throws std::runtime_error if the flush fails.
+  ///
+  /// @see MmapRegion::sync
+  void sync() const
+  {
+    mRegion.sync();
+  }
+
 private:
   /// The read-write memory mapping and its backing file. Owns both; sizing this region in bytes
   /// defines the element count, and every element access reads or writes through it.
@@ -68,18 +68,35 @@ public:
   /// @param path Path to an existing file. Its byte length must be a whole multiple of
   /// sizeof(ValueType).
   ///
+  /// @param policy How to map the elements (see MapPolicy); lazily by default.
+  ///
   /// @throws std::runtime_error if the file cannot be opened or mapped, or if its byte length is
   /// not a whole multiple of sizeof(ValueType).
-  explicit MmapConstArray(std::filesystem::path path): mRegion{std::move(path)}
+  explicit MmapConstArray(std::filesystem::path path, const MapPolicy policy = {}):
+    mRegion{std::move(path), policy}
   {
-    if(mRegion.size() % sizeof(ValueType) != 0)
-    {
-      common::throwException<std::runtime_error>(
-          "{} is {} bytes, not a whole multiple of the {}-byte element size",
-          mRegion.path().string(),
-          mRegion.size(),
-          sizeof(ValueType));
-    }
+    requireWholeElements();
+  }
+
+  /// @brief Map the file open as @p fileDescriptor read-only and view its bytes as a sequence of
+  /// @p ValueType, taking ownership of the descriptor (see MmapRegion).
+  ///
+  /// @param fileDescriptor Descriptor of a file open for reading. Its byte length must be a whole
+  /// multiple of sizeof(ValueType).
+  ///
+  /// @param path Names the file in diagnostics; never opened.
+  ///
+  /// @param policy How to map the elements (see MapPolicy); lazily by default.
+  ///
+  /// @throws std::runtime_error if the file cannot be mapped, or if its byte length is not a whole
+  /// multiple of sizeof(ValueType).
+  MmapConstArray(
+      const int fileDescriptor,
+      std::filesystem::path path,
+      const MapPolicy policy = {}):
+    mRegion{fileDescriptor, std::move(path), policy}
+  {
+    requireWholeElements();
   }
 
   MmapConstArray(const MmapConstArray&) = delete;
@@ -166,11 +183,49 @@ public:
     return mRegion.size() / sizeof(ValueType);
   }
 
+  /// @brief Hint the kernel about how elements `[first, first + count)` will be read.
+  ///
+  /// @see MmapRegion::advise
+  void advise(const size_type first, const size_type count, const Advice advice) const noexcept
+  {
+    mRegion.advise(first * sizeof(ValueType), count * sizeof(ValueType), advice);
+  }
+
+  /// @brief View the same file again, at its current length, as when a writer has grown it past
+  /// this view. This view stays valid.
+  ///
+  /// @throws std::runtime_error As the constructors do.
+  ///
+  /// @see MmapRegion::remap
+  [[nodiscard]] MmapConstArray remap() const
+  {
+    return MmapConstArray{mRegion.remap()};
+  }
+
 private:
+  /// @brief View the bytes of @p region, already mapped.
+  explicit MmapConstArray(MmapRegion region): mRegion{std::move(region)}
+  {
+    requireWholeElements();
+  }
+
   /// The read-only memory mapping of the file. Owns the lifetime of the bytes that every element
   /// pointer, reference, and iterator refers to, and supplies the byte length divided to compute
   /// size().
   MmapRegion mRegion;
+
+  /// @brief Throw unless the mapped file holds a whole number of elements.
+  void requireWholeElements() const
+  {
+    if(mRegion.size() % sizeof(ValueType) != 0)
+    {
+      common::throwException<std::runtime_error>(
+          "{} is {} bytes, not a whole multiple of the {}-byte element size",
+          mRegion.path().string(),
+          mRegion.size(),
+          sizeof(ValueType));
+    }
+  }
 };
 
 } // namespace nioc::containers
@@ -5,6 +5,7 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <filesystem>
 #include <span>
@@ -13,14 +14,113 @@
 namespace nioc::containers
 {
 
+/// @brief Access-pattern hints for a mapped range, passed to MmapRegion::advise.
+///
+/// Hints only: the kernel may ignore them, and none changes what the mapped bytes read as.
+enum class Advice
+{
+  /// No special treatment; undoes Sequential.
+  Normal,
+
+  /// The range will be read front to back: read ahead aggressively and drop pages soon after use.
+  Sequential,
+
+  /// The range will be read in no particular order: read ahead nothing past the page faulted.
+  Random,
+
+  /// The range will be read soon: start reading it in now, without waiting for the I/O.
+  WillNeed,
+
+  /// The range will not be read again soon: unmap its pages. A later read faults them back in from
+  /// the page cache or the file, so this is safe on a shared file mapping.
+  DontNeed
+};
+
+/// @brief How a writable MmapRegion carries the bytes written to it into its backing file.
+enum class WriteMode
+{
+  /// The bytes are the file's own pages, mapped shared; the kernel writes them back from the page
+  /// cache as it sees fit.
+  Mapped,
+
+  /// The bytes are an anonymous staging mapping, copied into the file only by
+  /// MmapRegion::writeThrough, with direct I/O that bypasses the page cache. Suits large sequential
+  /// writes to fast storage, where page-cache writeback is slower and more jittery. The file holds
+  /// nothing written until then, and a crash loses what was not yet written through.
+  Direct,
+
+  /// The bytes are an anonymous in-memory file (`memfd_create`), mapped shared, that never reaches
+  /// a disk. The path only names the file in diagnostics; nothing is created at it. Grows, shrinks,
+  /// and maps like a Mapped region, so a program can swap storage for memory and keep its code.
+  Memory
+};
+
+/// @brief Which pages back the memory of a MmapRegion.
+enum class HugePages
+{
+  /// Base pages, unless the system enables transparent huge pages everywhere.
+  None,
+
+  /// Ask for transparent huge pages (`MADV_HUGEPAGE`), which the kernel backs the mapping with as
+  /// it can. File pages get them only on a filesystem that supports large folios.
+  Transparent,
+
+  /// Take pages from the explicit 2 MiB huge page pool (`MAP_HUGETLB`). Applies to the staging
+  /// memory of a Direct region that reserves no room to grow and is a whole number of huge pages
+  /// long; elsewhere, and where the pool is empty, acts as Transparent.
+  Explicit
+};
+
+/// @brief How a MmapRegion maps its bytes: faulted in up front or on first touch, on which pages,
+/// advised how, locked or not, and on which NUMA node.
+///
+/// The default maps lazily, as a plain `mmap` does, which suits cold readers. A hot mapping,
+/// written or read at a high rate, can trade memory and mapping time for fewer page faults and TLB
+/// misses. The policy covers the bytes a region grows by too. The kernel or the process's limits
+/// may refuse a part of it; that part is logged and skipped, as none is worth failing a mapping.
+///
+/// Example:
+///
+///     const auto hot = nioc::containers::MapPolicy{
+///         .mPopulate = true,
+///         .mHugePages = nioc::containers::HugePages::Transparent,
+///         .mLock = true};
+///     nioc::containers::MmapRegion region{"/tmp/hot.bin", 1ULL << 30U, WriteMode::Mapped, 0, hot};
+struct MapPolicy
+{
+  /// Fault every page in as it is mapped (`MAP_POPULATE`), so no access faults later.
+  bool mPopulate{false};
+
+  /// Which pages back the mapping.
+  HugePages mHugePages{HugePages::None};
+
+  /// The access pattern of the whole mapping, as MmapRegion::advise takes it. DontNeed is ignored.
+  Advice mAdvice{Advice::Normal};
+
+  /// Lock the mapped pages in memory (`mlock`), faulting them in, so they are never paged out.
+  /// Bounded by RLIMIT_MEMLOCK.
+  bool mLock{false};
+
+  /// NUMA node to take the mapping's pages from (`mbind`), or negative to follow the process's
+  /// policy. Binds the pages faulted in after mapping; file pages cached already stay put.
+  int mNumaNode{-1};
+};
+
 /// @brief Owns a file-backed, shared (`MAP_SHARED`) memory mapping of a contiguous range of bytes.
 ///
 /// Writes through the mapping reach the backing file and any other mapping of it. Choose a mode at
-/// construction: the two-argument constructor creates a writable region of a fixed size; the
-/// one-argument constructor maps an existing file read-only. Access the bytes through bytes() or
+/// construction: the two-argument constructor creates a writable region; the one-argument
+/// constructor maps an existing file read-only. A writable region maps the file itself by default,
+/// stages its bytes in memory under WriteMode::Direct, or keeps them in an in-memory file that is
+/// never stored under WriteMode::Memory. A MapPolicy chooses how the bytes are
+/// mapped; by default, lazily. Access the bytes through bytes() or
 /// data(); they stay valid until the region is destroyed, which unmaps the memory and closes the
 /// file.
 ///
+/// A writable region created with a reservation larger than its size holds that much address space
+/// from the start, inaccessible and uncommitted, and grow() extends the file and the mapping into
+/// it in place. So a file that may get large starts small, without its bytes ever moving.
+///
 /// Example:
 ///
 ///     nioc::containers::MmapRegion region{"/tmp/buffer.bin", 4096};
@@ -28,11 +128,15 @@ namespace nioc::containers
 ///     // ... fill bytes ...
 ///     region.resize(usedBytes);  // trim the file before it is unmapped
 ///
+///     nioc::containers::MmapRegion log{"/tmp/log.bin", 4096, WriteMode::Mapped, 1ULL << 40};
+///     log.grow(8192); // same address, twice the bytes
+///
 /// Non-copyable; move-constructible. The mapped bytes never change address, so a move transfers
 /// the mapping and file descriptor to the new owner while every previously obtained view stays
 /// valid; the moved-from region is empty and fit only for destruction.
 ///
-/// Not thread-safe. Synchronize concurrent access to the mapped bytes externally.
+/// Not thread-safe, but for grow(), which may run alongside readers of bytes() and size().
+/// Synchronize concurrent access to the mapped bytes externally.
 class MmapRegion
 {
 public:
@@ -42,11 +146,27 @@ public:
   ///
   /// @param path Backing file. Created if absent; truncated to empty first if it exists.
   ///
-  /// @param size Byte length of the file and mapping. Must be non-zero; the kernel rejects a
-  /// zero-length mapping.
+  /// @param size Byte length of the file and mapping. Must be non-zero, as the kernel rejects a
+  /// zero-length mapping, unless @p reservation holds room to grow: then the region may start
+  /// empty, as a file that holds nothing yet.
+  ///
+  /// @param writeMode How written bytes reach the file. A filesystem that refuses direct I/O, such
+  /// as tmpfs, has a Direct region write through the page cache instead, with a warning.
+  ///
+  /// @param reservation Bytes of address space to hold for grow(). Nothing past @p size is
+  /// committed or backed by the file until the region grows into it. No larger than @p size, the
+  /// default, reserves nothing beyond the mapping, and the region cannot grow.
   ///
-  /// @throws std::runtime_error if the file cannot be created, sized, or mapped.
-  MmapRegion(std::filesystem::path path, std::size_t size);
+  /// @param policy How to map the bytes, and the bytes the region grows by.
+  ///
+  /// @throws std::runtime_error if the file cannot be created, sized, or mapped, or the address
+  /// space cannot be reserved.
+  MmapRegion(
+      std::filesystem::path path,
+      std::size_t size,
+      WriteMode writeMode = WriteMode::Mapped,
+      std::size_t reservation = 0,
+      MapPolicy policy = {});
 
   /// @brief Map the existing file at @p path read-only, sized to the file's current length.
   ///
@@ -55,8 +175,52 @@ public:
   ///
   /// @param path Existing file to map. Must already exist.
   ///
+  /// @param policy How to map the bytes.
+  ///
   /// @throws std::runtime_error if the file cannot be opened, stat'd, or mapped.
-  explicit MmapRegion(std::filesystem::path path);
+  explicit MmapRegion(std::filesystem::path path, MapPolicy policy = {});
+
+  /// @brief Map the file open as @p fileDescriptor read-only, sized to the file's current length,
+  /// taking ownership of the descriptor.
+  ///
+  /// For a file handed over rather than found by path, such as one received from another process.
+  /// The region closes the descriptor when destroyed, or at once if mapping fails.
+  ///
+  /// @param fileDescriptor Descriptor of a file open for reading.
+  ///
+  /// @param path Names the file in path() and diagnostics; never opened.
+  ///
+  /// @param policy How to map the bytes.
+  ///
+  /// @throws std::runtime_error if the file cannot be stat'd or mapped.
+  MmapRegion(int fileDescriptor, std::filesystem::path path, MapPolicy policy = {});
+
+  /// @brief Map bytes `[offset, offset + length)` of the file open as @p fileDescriptor read-only,
+  /// without taking ownership of the descriptor.
+  ///
+  /// For a window onto part of a file too large to map whole (see MmapWindowedRegion). The region
+  /// holds no descriptor, so it can neither remap() nor sync(); the caller may close the
+  /// descriptor once the region is made.
+  ///
+  /// @param fileDescriptor Descriptor of a file open for reading.
+  ///
+  /// @param path Names the file in path() and diagnostics; never opened.
+  ///
+  /// @param offset Byte offset of the window within the file. Must be a multiple of the page size.
+  ///
+  /// @param length Byte length of the window. Must be non-zero.
+  ///
+  /// @param policy How to map the bytes.
+  ///
+  /// @throws std::invalid_argument if @p offset is not page-aligned.
+  ///
+  /// @throws std::runtime_error if the bytes cannot be mapped.
+  MmapRegion(
+      int fileDescriptor,
+      std::filesystem::path path,
+      std::size_t offset,
+      std::size_t length,
+      MapPolicy policy = {});
 
   MmapRegion(const MmapRegion&) = delete;
 
@@ -96,6 +260,38 @@ public:
   /// @brief Number of mapped bytes.
   [[nodiscard]] std::size_t size() const noexcept;
 
+  /// @brief How the region maps its bytes.
+  [[nodiscard]] const MapPolicy& policy() const noexcept;
+
+  /// @brief Most bytes the region can grow() to in place: the reservation it was created with, or
+  /// its size if that is larger.
+  [[nodiscard]] std::size_t reservation() const noexcept;
+
+  /// @brief Extend the backing file and the mapping to @p size bytes, in place.
+  ///
+  /// The bytes keep their address, so every span and pointer obtained before stays valid and
+  /// bytes() merely gets longer. The new bytes read as zero. A @p size no larger than the current
+  /// one changes nothing; see resize() to trim the file. Safe alongside readers of bytes() and
+  /// size(), which see the old or the new length; not alongside itself or resize().
+  ///
+  /// @param size New byte length of the file and mapping.
+  ///
+  /// @throws std::invalid_argument if @p size exceeds reservation().
+  ///
+  /// @throws std::runtime_error if the file cannot be extended or the new bytes cannot be mapped;
+  /// the region is left as it was.
+  void grow(std::size_t size);
+
+  /// @brief Map the same file again, read-only, at its current length and under the same policy.
+  ///
+  /// Suits a reader following a file that another process grows: once the file has outgrown this
+  /// mapping, a fresh one covers the new bytes, while views into this one stay valid. Maps through
+  /// a duplicate of the descriptor, so it works after the file is renamed or unlinked.
+  ///
+  /// @throws std::runtime_error if the descriptor cannot be duplicated or the file cannot be stat'd
+  /// or mapped.
+  [[nodiscard]] MmapRegion remap() const;
+
   /// @brief Truncate or extend the backing file on disk to @p size bytes without remapping.
   ///
   /// The mapping and every span/pointer from bytes() and data() keep their original length and
@@ -106,16 +302,124 @@ public:
   /// @param size New on-disk length in bytes.
   void resize(std::size_t size) noexcept;
 
+  /// @brief Point a Direct region's staged bytes at a fresh file at @p path, @p fileSize bytes
+  /// long, and close the file they were written to so far.
+  ///
+  /// The staging memory stays mapped where it is, with its pages and contents, so a region whose
+  /// file is finished can stage the next file without mapping and faulting in memory anew. The
+  /// previous file keeps what was written through to it. The fresh file may start shorter than the
+  /// staged bytes, as a region grown large starts its next file small: writing through extends it.
+  /// Not safe alongside any other use of the region.
+  ///
+  /// @param path The fresh file, created or truncated as by the writable constructor.
+  ///
+  /// @param fileSize Starting length of the fresh file; no more than size() is used.
+  ///
+  /// @throws std::logic_error if the region is not a Direct one.
+  ///
+  /// @throws std::runtime_error if the file cannot be created or sized; the region is left as it
+  /// was.
+  void restage(std::filesystem::path path, std::size_t fileSize);
+
+  /// @brief Move the region's file to @p path, keeping the mapping, its pages, and its contents.
+  ///
+  /// A WriteMode::Memory region has no file on disk and only takes the new name. Not safe
+  /// alongside any other use of the region.
+  ///
+  /// @param path Where the file moves to; a file already there is replaced.
+  ///
+  /// @throws std::filesystem::filesystem_error if the file cannot be moved; the region is left as
+  /// it was.
+  void rename(std::filesystem::path path);
+
+  /// @brief Hint the kernel about how bytes `[offset, offset + length)` will be accessed.
+  ///
+  /// The range is clamped to the mapping and widened down to a page boundary. On failure logs a
+  /// warning; a hint is never worth an exception.
+  ///
+  /// @param offset Byte offset of the range's start within the mapping.
+  ///
+  /// @param length Byte length of the range.
+  ///
+  /// @param advice The expected access pattern. DontNeed is ignored on a Direct region, where it
+  /// would discard the staged bytes.
+  void advise(std::size_t offset, std::size_t length, Advice advice) const noexcept;
+
+  /// @brief Start writing back dirty bytes `[offset, offset + length)` of the backing file,
+  /// without waiting for the I/O to finish.
+  ///
+  /// Pacing writeback this way keeps dirty pages from piling up until the kernel throttles the
+  /// writers. Makes nothing durable on its own; see sync(). On failure logs a warning. No effect on
+  /// a Direct region, which leaves no dirty pages behind (see writeThrough()), nor on a Memory
+  /// region, which has nowhere to write them.
+  ///
+  /// @param offset Byte offset of the range's start within the file.
+  ///
+  /// @param length Byte length of the range.
+  void startWriteback(std::size_t offset, std::size_t length) const noexcept;
+
+  /// @brief Free the file space and the pages of bytes `[offset, offset + length)`, which read as
+  /// zero from then on; the file keeps its length and the mapping its address.
+  ///
+  /// The range is narrowed to the whole pages within it, so bytes sharing a page with ones outside
+  /// it stay as they are. On failure, such as on a file system that cannot punch holes, logs a
+  /// warning and leaves the bytes in place. No effect on a Direct region, whose staged bytes would
+  /// be written through again.
+  ///
+  /// @param offset Byte offset of the range's start within the file.
+  ///
+  /// @param length Byte length of the range.
+  void discard(std::size_t offset, std::size_t length) const noexcept;
+
+  /// @brief Copy staged bytes `[offset, offset + length)` of a Direct region into the backing file,
+  /// blocking until the device has taken them.
+  ///
+  /// The range is clamped to the region and widened to whole direct-I/O blocks, so the file may
+  /// grow up to a block past its length; resize() trims it back. No effect on a Mapped region.
+  ///
+  /// @param offset Byte offset of the range's start within the region.
+  ///
+  /// @param length Byte length of the range.
+  ///
+  /// @throws std::runtime_error if the write fails.
+  void writeThrough(std::size_t offset, std::size_t length) const;
+
+  /// @brief Make every byte written through the mapping, and the file's length, durable on disk.
+  ///
+  /// Blocks until the device acknowledges the write. A Direct region makes only the bytes already
+  /// written through durable. No effect on a Memory region, which is never stored.
+  ///
+  /// @throws std::runtime_error if the flush fails.
+  void sync() const;
+
 private:
   /// Path of the backing file, retained for path() and for diagnostics.
   std::filesystem::path mPath;
 
-  /// Descriptor of the open backing file, or -1 in a moved-from region. Held open for the region's
-  /// lifetime and closed by the destructor; resize() truncates the file through it.
+  /// Descriptor of the open backing file, or -1 in a window or a moved-from region. Held open for
+  /// the region's lifetime and closed by the destructor; resize() truncates the file through it.
   int mFileDescriptor;
 
-  /// The mapped bytes; empty in a moved-from region. The destructor unmaps this range.
-  std::span<std::byte> mBytes;
+  /// How written bytes reach the file. Under Direct, the bytes are anonymous memory, not the file.
+  WriteMode mWriteMode;
+
+  /// How the bytes are mapped, kept to map the bytes grow() adds the same way.
+  MapPolicy mPolicy;
+
+  /// Number of mapped bytes; zero in a moved-from region. Atomic, so grow() may lengthen it while
+  /// other threads read it.
+  std::atomic<std::size_t> mSize;
+
+  /// Bytes of address space held from mAddress: the mapping and the room reserved for it to grow
+  /// into. The destructor unmaps all of it.
+  std::size_t mReservation;
+
+  /// The first mapped byte, or null in a moved-from region. Never changes while the region owns it.
+  std::byte* mAddress;
+
+  /// @brief Bind, advise, populate, and lock mapped bytes `[offset, offset + length)` as mPolicy
+  /// asks, logging each part the kernel refuses.
+  void applyPolicy(std::size_t offset, std::size_t length, bool writable) const noexcept;
 };
 
 /// @brief Reinterpret a span of bytes as a pointer to @p ValueType, preserving const-ness.
@@ -0,0 +1,163 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "mmapRegion.hpp"
+#include "mmapWindowedRegion.hpp"
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <nioc/common/exception.hpp>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace nioc::containers
+{
+
+/// @brief A read-only view of an existing file's bytes as a sequence of @p ValueType elements,
+/// mapped a window at a time, for files too large to map whole.
+///
+/// Where MmapConstArray maps the whole file for its lifetime, this view maps only the windows the
+/// elements read lie in, and unmaps the least recently used ones beyond a count (see
+/// MmapWindowedRegion). A replay over a file of terabytes then keeps a bounded footprint, page
+/// tables included, rather than one that grows with the file. In return, elements are read through
+/// slice() or at() rather than through a pointer that stays valid for the view's lifetime.
+///
+/// Example:
+///
+///     MmapWindowedConstArray<float> samples{"/data/samples.bin", 16ULL << 20U, 2};
+///     const auto slice = samples.slice(first, count);
+///     process(slice.mElements); // valid while slice.mWindow lives
+///
+/// Non-copyable and non-movable. Not thread-safe: reading updates the window cache.
+///
+/// @tparam ValueType The element type the file's bytes are reinterpreted as. Must be trivially
+/// copyable and have no top-level cv-qualifiers; elements are mapped, never constructed.
+///
+/// @see MmapWindowedRegion, MmapConstArray
+template<typename ValueType>
+  requires std::is_trivially_copyable_v<ValueType> and
+           std::is_same_v<ValueType, std::remove_cv_t<ValueType>>
+class MmapWindowedConstArray
+{
+public:
+  using value_type = ValueType;
+  using size_type = std::size_t;
+
+  /// @brief A run of elements and a share of the window mapping them.
+  struct Slice
+  {
+    /// The window the elements lie in; null for an empty run.
+    std::shared_ptr<const MmapRegion> mWindow;
+
+    /// The elements, valid while mWindow lives.
+    std::span<const ValueType> mElements;
+  };
+
+  /// @brief Open the existing file at @p path to view it a window at a time.
+  ///
+  /// @param path Path to an existing file. Its byte length must be a whole multiple of
+  /// sizeof(ValueType).
+  ///
+  /// @param windowSize Bytes each window maps, rounded up to whole pages.
+  ///
+  /// @param windowCount Most windows to keep mapped that no Slice holds.
+  ///
+  /// @param policy How to map each window (see MapPolicy).
+  ///
+  /// @throws std::runtime_error if the file cannot be opened, or if its byte length is not a whole
+  /// multiple of sizeof(ValueType).
+  explicit MmapWindowedConstArray(
+      std::filesystem::path path,
+      const size_type windowSize = MmapWindowedRegion::kDefaultWindowSize,
+      const size_type windowCount = MmapWindowedRegion::kDefaultWindowCount,
+      const MapPolicy policy = {}):
+    mRegion{std::move(path), windowSize, windowCount, policy}
+  {
+    if(mRegion.size() % sizeof(ValueType) != 0)
+    {
+      common::throwException<std::runtime_error>(
+          "{} is {} bytes, not a whole multiple of the {}-byte element size",
+          mRegion.path().string(),
+          mRegion.size(),
+          sizeof(ValueType));
+    }
+  }
+
+  MmapWindowedConstArray(const MmapWindowedConstArray&) = delete;
+
+  MmapWindowedConstArray(MmapWindowedConstArray&&) noexcept = delete;
+
+  ~MmapWindowedConstArray() = default;
+
+  MmapWindowedConstArray& operator=(const MmapWindowedConstArray&) = delete;
+
+  MmapWindowedConstArray& operator=(MmapWindowedConstArray&&) noexcept = delete;
+
+  /// @brief Elements `[first, first + count)`, mapping their window if need be.
+  ///
+  /// @throws std::out_of_range if the run goes past the last element.
+  ///
+  /// @throws std::runtime_error if the window cannot be mapped.
+  [[nodiscard]] Slice slice(const size_type first, const size_type count)
+  {
+    if(first > size() or count > size() - first)
+    {
+      common::throwException<std::out_of_range>(
+          "Elements {} to {} are out of range for an array of size {}.",
+          first,
+          first + count,
+          size());
+    }
+
+    auto view = mRegion.map(first * sizeof(ValueType), count * sizeof(ValueType));
+    return Slice{
+        .mWindow = std::move(view.mWindow),
+        .mElements = {asElementPointer<ValueType>(view.mBytes), count}};
+  }
+
+  /// @brief A copy of the element at @p index.
+  ///
+  /// @throws std::out_of_range if @p index is not less than size().
+  [[nodiscard]] ValueType at(const size_type index)
+  {
+    return slice(index, 1).mElements.front();
+  }
+
+  /// True if the view holds no elements.
+  [[nodiscard]] bool empty() const noexcept
+  {
+    return size() == 0;
+  }
+
+  /// @brief Number of elements: the file's byte length at open divided by sizeof(ValueType).
+  [[nodiscard]] size_type size() const noexcept
+  {
+    return mRegion.size() / sizeof(ValueType);
+  }
+
+  /// @brief Hint the kernel about how elements `[first, first + count)` will be read.
+  ///
+  /// @see MmapWindowedRegion::advise
+  void advise(const size_type first, const size_type count, const Advice advice) const noexcept
+  {
+    mRegion.advise(first * sizeof(ValueType), count * sizeof(ValueType), advice);
+  }
+
+  /// @brief The windowed mapping of the file's bytes.
+  [[nodiscard]] const MmapWindowedRegion& region() const noexcept
+  {
+    return mRegion;
+  }
+
+private:
+  /// The file, mapped a window at a time.
+  MmapWindowedRegion mRegion;
+};
+
+} // namespace nioc::containers
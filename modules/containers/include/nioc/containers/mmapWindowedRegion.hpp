@@ -0,0 +1,143 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "mmapRegion.hpp"
+#include <cstddef>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <span>
+#include <utility>
+
+namespace nioc::containers
+{
+
+/// @brief Maps an existing file read-only a window at a time, so a file far larger than memory
+/// costs only the windows in use, whatever its size.
+///
+/// The file is split into windows of a fixed size. map() hands out a range of bytes along with a
+/// share of the window mapping them, mapping the window on first use. The region keeps the most
+/// recently used windows mapped, up to a count, and lets go of the least recently used one beyond
+/// that. A window it lets go of stays mapped for as long as a share handed out lives, then unmaps.
+/// So the mapped footprint, page tables included, stays within the window size times the count,
+/// plus the windows callers still hold.
+///
+/// A range that runs across the end of its window gets a mapping of its own, shared with no other
+/// range. Keep windows large next to the ranges read, and such ranges rare.
+///
+/// Example:
+///
+///     nioc::containers::MmapWindowedRegion file{"/data/huge.bin", 64ULL << 20U, 4};
+///     const auto [window, bytes] = file.map(offset, length);
+///     process(bytes); // valid while window lives
+///
+/// Non-copyable and non-movable. Not thread-safe: map() updates the window cache. The windows it
+/// hands out may be read from any thread.
+///
+/// @see MmapRegion, MmapWindowedConstArray
+class MmapWindowedRegion
+{
+public:
+  /// Default bytes a window maps.
+  static constexpr auto kDefaultWindowSize = std::size_t{64ULL << 20U};
+
+  /// Default number of windows kept mapped.
+  static constexpr auto kDefaultWindowCount = std::size_t{4};
+
+  /// @brief Bytes of the file and a share of the mapping that keeps them valid.
+  struct View
+  {
+    /// The window the bytes lie in; null for an empty range.
+    std::shared_ptr<const MmapRegion> mWindow;
+
+    /// The bytes, valid while mWindow lives.
+    std::span<const std::byte> mBytes;
+  };
+
+  /// @brief Open the existing file at @p path to map it a window at a time.
+  ///
+  /// Sized to the file's length at open; nothing is mapped until map().
+  ///
+  /// @param path Existing file to map.
+  ///
+  /// @param windowSize Bytes each window maps, rounded up to whole pages.
+  ///
+  /// @param windowCount Most windows to keep mapped that no caller holds. At least one is kept.
+  ///
+  /// @param policy How to map each window.
+  ///
+  /// @throws std::runtime_error if the file cannot be opened or stat'd.
+  explicit MmapWindowedRegion(
+      std::filesystem::path path,
+      std::size_t windowSize = kDefaultWindowSize,
+      std::size_t windowCount = kDefaultWindowCount,
+      MapPolicy policy = {});
+
+  MmapWindowedRegion(const MmapWindowedRegion&) = delete;
+
+  MmapWindowedRegion(MmapWindowedRegion&&) noexcept = delete;
+
+  /// @brief Let go of every window and close the file. Windows callers hold stay mapped.
+  ~MmapWindowedRegion();
+
+  MmapWindowedRegion& operator=(const MmapWindowedRegion&) = delete;
+
+  MmapWindowedRegion& operator=(MmapWindowedRegion&&) noexcept = delete;
+
+  /// @brief Bytes `[offset, offset + length)` of the file, mapping their window if need be.
+  ///
+  /// @throws std::out_of_range if the range runs past the end of the file.
+  ///
+  /// @throws std::runtime_error if the window cannot be mapped.
+  [[nodiscard]] View map(std::size_t offset, std::size_t length);
+
+  /// @brief Hint the kernel about how bytes `[offset, offset + length)` will be read.
+  ///
+  /// Advises the file's page cache rather than a mapping, so it reaches bytes whose window is not
+  /// mapped yet: WillNeed starts reading them in, and DontNeed drops them from the cache once
+  /// written back. On failure logs a warning.
+  void advise(std::size_t offset, std::size_t length, Advice advice) const noexcept;
+
+  /// @brief Path of the file.
+  [[nodiscard]] const std::filesystem::path& path() const noexcept;
+
+  /// @brief Byte length of the file at open.
+  [[nodiscard]] std::size_t size() const noexcept;
+
+  /// @brief Bytes each window maps.
+  [[nodiscard]] std::size_t windowSize() const noexcept;
+
+  /// @brief Number of windows the region keeps mapped now, not counting those only callers hold.
+  [[nodiscard]] std::size_t mappedWindows() const noexcept;
+
+private:
+  /// A window the region keeps mapped: its index in the file and its mapping.
+  using Window = std::pair<std::size_t, std::shared_ptr<const MmapRegion>>;
+
+  /// Path of the file, retained for path() and diagnostics.
+  std::filesystem::path mPath;
+
+  /// Descriptor of the open file, through which every window is mapped; closed by the destructor.
+  int mFileDescriptor;
+
+  /// Byte length of the file at open.
+  std::size_t mSize;
+
+  /// Bytes each window maps; a whole number of pages.
+  std::size_t mWindowSize;
+
+  /// Most windows kept in mWindows.
+  std::size_t mWindowCount;
+
+  /// How each window is mapped.
+  MapPolicy mPolicy;
+
+  /// The windows kept mapped, most recently used first.
+  std::list<Window> mWindows;
+};
+
+} // namespace nioc::containers
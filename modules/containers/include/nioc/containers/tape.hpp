@@ -5,11 +5,13 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <concepts>
 #include <cstddef>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <nioc/common/exception.hpp>
 #include <nioc/logger/logger.hpp>
 #include <ranges>
@@ -26,7 +28,11 @@ namespace nioc::containers
 /// Think of it as a tape with a cursor. The cursor starts at 0 and only moves forward as callers
 /// reserve slots with claim or emplace. Every reservation returns its own region; no two overlap.
 /// The cursor moves backward only when rewind gives back the unused tail of the latest claim.
-/// Capacity is fixed at construction and never grows (shrink_to_fit can lower it).
+/// Capacity is fixed at construction (shrink_to_fit can lower it), unless the storage can grow in
+/// place, as an MmapArray created with a reservation can: then a claim that does not fit grows the
+/// storage, at least doubling it, up to max_size(). Elements never move as the tape grows.
+/// An MmapArray takes its MapPolicy as its last constructor argument, so a hot tape can have its
+/// pages faulted in, backed by huge pages, or locked from the start.
 ///
 /// The tape reserves space; it does not construct, destroy, or zero elements. Filling a claimed
 /// slot is the caller's job, and element access is unchecked.
@@ -37,6 +43,9 @@ namespace nioc::containers
 ///     std::span<int> slot = tape.claim(3);
 ///     slot[0] = 1; slot[1] = 2; slot[2] = 3;
 ///
+///     // Starts at 1 MiB of file and grows into its 1 TiB reservation as it fills.
+///     Tape<MmapArray<std::byte>> log{"/data/log.bin", 1ULL << 20, WriteMode::Mapped, 1ULL << 40};
+///
 /// The reservation methods (claim, emplace, rewind, size, capacity, empty, full) are safe to call
 /// from many threads at once. The cursor does NOT publish element contents: claim only reserves
 /// bytes, so a reader that sees a grown size() must establish its own happens-before with the
@@ -151,10 +160,10 @@ public:
     return size() == 0;
   }
 
-  /// @brief True when the cursor has reached capacity; any further non-zero claim will fail.
+  /// @brief True when the cursor has reached max_size(); any further non-zero claim will fail.
   [[nodiscard]] bool full() const noexcept
   {
-    return size() == capacity();
+    return size() == max_size();
   }
 
   /// @brief Number of slots claimed so far, i.e. the cursor position.
@@ -165,12 +174,27 @@ public:
     return mCursor.load(std::memory_order_relaxed);
   }
 
-  /// @brief Total slot capacity, fixed at construction (until shrink_to_fit).
+  /// @brief Number of slots the storage holds now: fixed at construction (until shrink_to_fit),
+  /// unless the storage grows.
   [[nodiscard]] size_type capacity() const noexcept
   {
     return std::ranges::size(mStorage);
   }
 
+  /// @brief Most slots the tape can hold: the storage's reservation if it can grow, or else its
+  /// capacity().
+  [[nodiscard]] size_type max_size() const noexcept
+  {
+    if constexpr(kGrowable)
+    {
+      return std::max<size_type>(mStorage.reservation(), capacity());
+    }
+    else
+    {
+      return capacity();
+    }
+  }
+
   /// @brief Drop unclaimed capacity by resizing the storage down to size().
   ///
   /// Afterward capacity() equals size(). Only available when @p Storage has a resize member.
@@ -182,17 +206,30 @@ public:
     mStorage.resize(size());
   }
 
+  /// @brief Move the cursor back to the start, so the whole storage can be claimed again.
+  ///
+  /// The storage keeps its size and contents; the next claims hand out its slots anew. NOT
+  /// thread-safe: call it with no concurrent reservations, once nothing reads the claimed slots.
+  void clear() noexcept
+  {
+    mCursor.store(0, std::memory_order_relaxed);
+  }
+
   /// @brief Reserve @p count contiguous slots and return a writable span over them.
   ///
   /// The returned region is disjoint from every other reservation. Thread-safe. If fewer than
-  /// @p count slots remain, returns an empty span and leaves the cursor unchanged. The slots are
-  /// uninitialized: fill them, then arrange your own happens-before before signaling any reader.
+  /// @p count slots remain, a growable tape grows its storage first, with a lock only claims that
+  /// grow take; if it cannot grow that far, returns an empty span and leaves the cursor unchanged.
+  /// The slots are uninitialized: fill them, then arrange your own happens-before before signaling
+  /// any reader.
   ///
   /// @param count Number of slots to reserve. Must be non-zero.
   ///
   /// @return A span over the reserved slots, or an empty span if not enough room.
   ///
   /// @throws std::invalid_argument if @p count is zero.
+  ///
+  /// @throws std::runtime_error if the storage fails to grow.
   [[nodiscard]] std::span<value_type> claim(const size_type count = 1)
   {
     if(count == 0)
@@ -209,7 +246,11 @@ public:
     {
       if(count > capacity() - current)
       {
-        return {};
+        if(count > max_size() - current or not growFor(current + count))
+        {
+          return {};
+        }
+        continue;
       }
 
       if(mCursor.compare_exchange_weak(current, current + count, std::memory_order_relaxed))
@@ -286,9 +327,46 @@ public:
   }
 
 private:
-  /// The backing buffer that owns the slots. Its element count is the tape's fixed capacity.
+  /// Whether the storage can grow in place, keeping every element where it is.
+  static constexpr auto kGrowable = requires(Storage& storage, const size_type count) {
+    storage.grow(count);
+    { storage.reservation() } -> std::convertible_to<size_type>;
+  };
+
+  /// @brief Grow the storage to hold at least @p required slots, unless a concurrent claim already
+  /// has, and report whether it now does.
+  ///
+  /// The storage at least doubles, so a tape filled one claim at a time grows a logarithmic number
+  /// of times.
+  bool growFor(const size_type required)
+  {
+    if constexpr(kGrowable)
+    {
+      const auto lock = std::scoped_lock{mGrowthMutex};
+      const auto current = capacity();
+      if(required <= current)
+      {
+        return true;
+      }
+
+      const auto limit = max_size();
+      const auto doubled = current <= limit / 2U ? current * 2U : limit;
+      mStorage.grow(std::min(limit, std::max(required, doubled)));
+      return true;
+    }
+    else
+    {
+      static_cast<void>(required);
+      return false;
+    }
+  }
+
+  /// The backing buffer that owns the slots. Its element count is the tape's capacity.
   Storage mStorage;
 
+  /// Serializes growing the storage; claims that fit never take it.
+  std::mutex mGrowthMutex;
+
   /// The cursor: the number of slots claimed so far, and the offset of the next free slot. Advanced
   /// atomically by claim and emplace, so concurrent reservations stay disjoint without a lock;
   /// moved back only by rewind. Accessed with relaxed ordering, so it orders the reservation but
@@ -4,14 +4,19 @@
 // Author   : Anurag Jakhotia
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <array>
 #include <cerrno>
 #include <fcntl.h>
+#include <limits>
+#include <linux/mempolicy.h>
 #include <nioc/common/exception.hpp>
 #include <nioc/containers/mmapRegion.hpp>
 #include <nioc/logger/logger.hpp>
 #include <stdexcept>
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <sys/syscall.h>
 #include <system_error>
 #include <unistd.h>
 #include <utility>
@@ -21,15 +26,97 @@ namespace nioc::containers
 namespace
 {
 
-int openForWriting(const std::filesystem::path& path, const std::size_t size)
+/// Alignment of the file offsets, lengths, and memory of direct I/O; a multiple of the logical
+/// block size of every common device.
+constexpr auto kDirectBlockSize = std::size_t{4096};
+
+/// Most bytes one direct write moves, so a large range goes out in a few bounded requests.
+constexpr auto kDirectChunkSize = std::size_t{8} << 20U;
+
+/// Size of the pages HugePages::Explicit takes from the pool.
+constexpr auto kHugePageSize = std::size_t{2} << 20U;
+
+/// The mmap flags that take staging memory from the 2 MiB pool: log2 of the page size goes in the
+/// bits above MAP_HUGE_SHIFT.
+constexpr auto kHugePageFlags = MAP_HUGETLB | (21 << MAP_HUGE_SHIFT);
+
+/// Most NUMA nodes a policy can bind to.
+constexpr auto kMaxNumaNodes = std::size_t{1024};
+
+std::size_t pageSize() noexcept
+{
+  static const auto kPageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  return kPageSize;
+}
+
+std::size_t roundUpToPage(const std::size_t size) noexcept
+{
+  return (size + pageSize() - 1U) / pageSize() * pageSize();
+}
+
+/// Whether @p policy populates the bytes only once they are bound and advised, so they are faulted
+/// in where and as it wants them, rather than as they are mapped.
+bool populatesLate(const MapPolicy& policy) noexcept
+{
+  return policy.mPopulate and (policy.mNumaNode >= 0 or policy.mHugePages != HugePages::None);
+}
+
+/// The flags @p policy adds to each mmap of a region's bytes.
+int mapFlags(const MapPolicy& policy) noexcept
+{
+  return policy.mPopulate and not populatesLate(policy) ? MAP_POPULATE : 0;
+}
+
+/// Create an in-memory file named after @p path; nothing is created at @p path itself.
+int createInMemory(const std::filesystem::path& path)
+{
+  const auto fileDescriptor = ::memfd_create(path.filename().c_str(), MFD_CLOEXEC);
+  if(fileDescriptor < 0)
+  {
+    common::throwException<std::runtime_error>(
+        "Unable to create {} in memory: {}",
+        path.string(),
+        std::generic_category().message(errno));
+  }
+  return fileDescriptor;
+}
+
+int openForWriting(
+    const std::filesystem::path& path,
+    const std::size_t size,
+    const WriteMode writeMode)
 {
+  if(writeMode == WriteMode::Memory)
+  {
+    const auto fileDescriptor = createInMemory(path);
+    if(::ftruncate(fileDescriptor, static_cast<off_t>(size)) != 0)
+    {
+      const auto errorNumber = errno;
+      static_cast<void>(::close(fileDescriptor));
+      common::throwException<std::runtime_error>(
+          "Unable to size {} in memory: {}",
+          path.string(),
+          std::generic_category().message(errorNumber));
+    }
+    return fileDescriptor;
+  }
+
   std::filesystem::create_directories(path.parent_path());
 
   constexpr auto kFlags = O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC;
   constexpr auto kMode = S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH;
+  const auto direct = writeMode == WriteMode::Direct;
 
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg,hicpp-vararg): open is the POSIX file API.
-  const auto fileDescriptor = ::open(path.c_str(), kFlags, kMode);
+  auto fileDescriptor = ::open(path.c_str(), direct ? kFlags | O_DIRECT : kFlags, kMode);
+  if(fileDescriptor < 0 and direct and errno == EINVAL)
+  {
+    logger::warn(
+        "{} does not support direct I/O; writing it through the page cache instead.",
+        path.string());
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg,hicpp-vararg): open is the POSIX file API.
+    fileDescriptor = ::open(path.c_str(), kFlags, kMode);
+  }
   if(fileDescriptor < 0)
   {
     common::throwException<std::runtime_error>(
@@ -84,14 +171,15 @@ std::size_t fileSize(const int fileDescriptor, const std::filesystem::path& path
   return static_cast<std::size_t>(status.st_size);
 }
 
-std::span<std::byte> mapMemory(
+std::byte* mapMemory(
     const int fileDescriptor,
     const std::size_t size,
     const bool writable,
+    const int flags,
     const std::filesystem::path& path)
 {
   const auto protection = writable ? PROT_READ | PROT_WRITE : PROT_READ;
-  void* const address = ::mmap(nullptr, size, protection, MAP_SHARED, fileDescriptor, 0);
+  void* const address = ::mmap(nullptr, size, protection, MAP_SHARED | flags, fileDescriptor, 0);
   if(address == MAP_FAILED)
   {
     const auto errorNumber = errno;
@@ -102,37 +190,308 @@ std::span<std::byte> mapMemory(
         std::generic_category().message(errorNumber));
   }
 
-  return {static_cast<std::byte*>(address), size};
+  return static_cast<std::byte*>(address);
+}
+
+/// Map @p size bytes of anonymous memory to stage the writes of @p path, which is open as
+/// @p fileDescriptor: explicit huge pages if @p huge and the pool has them, else base pages.
+std::byte* mapStaging(
+    const int fileDescriptor,
+    const std::size_t size,
+    const int flags,
+    const bool huge,
+    const std::filesystem::path& path)
+{
+  constexpr auto kProtection = PROT_READ | PROT_WRITE;
+  const auto anonymous = MAP_SHARED | MAP_ANONYMOUS | flags;
+  void* address = MAP_FAILED;
+  if(huge)
+  {
+    address = ::mmap(nullptr, size, kProtection, anonymous | kHugePageFlags, -1, 0);
+    if(address == MAP_FAILED)
+    {
+      const auto errorNumber = errno;
+      logger::warn(
+          "Unable to stage {} on explicit huge pages; using base pages instead: {}",
+          path.string(),
+          std::generic_category().message(errorNumber));
+    }
+  }
+  if(address == MAP_FAILED)
+  {
+    address = ::mmap(nullptr, size, kProtection, anonymous, -1, 0);
+  }
+  if(address == MAP_FAILED)
+  {
+    const auto errorNumber = errno;
+    static_cast<void>(::close(fileDescriptor));
+    common::throwException<std::runtime_error>(
+        "Unable to map memory to stage {}: {}",
+        path.string(),
+        std::generic_category().message(errorNumber));
+  }
+
+  return static_cast<std::byte*>(address);
+}
+
+/// Map bytes `[offset, offset + length)` of the file open as @p fileDescriptor read-only, leaving
+/// the descriptor open whatever happens.
+std::byte* mapWindow(
+    const int fileDescriptor,
+    const std::size_t offset,
+    const std::size_t length,
+    const int flags,
+    const std::filesystem::path& path)
+{
+  if(offset % pageSize() != 0U)
+  {
+    common::throwException<std::invalid_argument>(
+        "Unable to map {} from byte {}: a window starts on a page.",
+        path.string(),
+        offset);
+  }
+
+  void* const address = ::mmap(
+      nullptr,
+      length,
+      PROT_READ,
+      MAP_SHARED | flags,
+      fileDescriptor,
+      static_cast<off_t>(offset));
+  if(address == MAP_FAILED)
+  {
+    common::throwException<std::runtime_error>(
+        "Unable to map bytes {} to {} of {}: {}",
+        offset,
+        offset + length,
+        path.string(),
+        std::generic_category().message(errno));
+  }
+  return static_cast<std::byte*>(address);
+}
+
+/// Map bytes `[offset, offset + length)` of a writable region at @p address, replacing the
+/// reservation there: the file's own bytes, or fresh staging memory under WriteMode::Direct.
+/// @p offset is a multiple of the page size. Returns the error number, or zero on success.
+int mapInto(
+    std::byte* const address,
+    const std::size_t offset,
+    const std::size_t length,
+    const int fileDescriptor,
+    const WriteMode writeMode,
+    const int flags) noexcept
+{
+  const auto direct = writeMode == WriteMode::Direct;
+  void* const mapped = ::mmap(
+      address,
+      length,
+      PROT_READ | PROT_WRITE,
+      (direct ? MAP_SHARED | MAP_ANONYMOUS | MAP_FIXED : MAP_SHARED | MAP_FIXED) | flags,
+      direct ? -1 : fileDescriptor,
+      direct ? 0 : static_cast<off_t>(offset));
+  return mapped == MAP_FAILED ? errno : 0;
+}
+
+/// Map the first @p size bytes of a writable region over @p reservation bytes of address space, the
+/// rest held inaccessible and uncommitted for the region to grow into.
+std::byte* mapReserved(
+    const int fileDescriptor,
+    const std::size_t size,
+    const std::size_t reservation,
+    const WriteMode writeMode,
+    const int flags,
+    const std::filesystem::path& path)
+{
+  void* const reserved =
+      ::mmap(nullptr, reservation, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if(reserved == MAP_FAILED)
+  {
+    const auto errorNumber = errno;
+    static_cast<void>(::close(fileDescriptor));
+    common::throwException<std::runtime_error>(
+        "Unable to reserve {} bytes of address space for {}: {}",
+        reservation,
+        path.string(),
+        std::generic_category().message(errorNumber));
+  }
+
+  // An empty region maps nothing until it grows.
+  auto* const address = static_cast<std::byte*>(reserved);
+  const auto errorNumber =
+      size == 0U ? 0 : mapInto(address, 0, size, fileDescriptor, writeMode, flags);
+  if(errorNumber != 0)
+  {
+    static_cast<void>(::munmap(reserved, reservation));
+    static_cast<void>(::close(fileDescriptor));
+    common::throwException<std::runtime_error>(
+        "Unable to map {}: {}",
+        path.string(),
+        std::generic_category().message(errorNumber));
+  }
+  return address;
+}
+
+std::byte* mapWritable(
+    const int fileDescriptor,
+    const std::size_t size,
+    const std::size_t reservation,
+    const WriteMode writeMode,
+    const MapPolicy& policy,
+    const std::filesystem::path& path)
+{
+  const auto flags = mapFlags(policy);
+  if(reservation > size)
+  {
+    return mapReserved(fileDescriptor, size, reservation, writeMode, flags, path);
+  }
+  if(writeMode == WriteMode::Direct)
+  {
+    // Huge pages unmap only whole, so only a region of whole ones takes them from the pool.
+    const auto huge = policy.mHugePages == HugePages::Explicit and size % kHugePageSize == 0U;
+    return mapStaging(fileDescriptor, size, flags, huge, path);
+  }
+  return mapMemory(fileDescriptor, size, true, flags, path);
+}
+
+int toNativeAdvice(const Advice advice) noexcept
+{
+  switch(advice)
+  {
+  case Advice::Sequential:
+    return MADV_SEQUENTIAL;
+  case Advice::Random:
+    return MADV_RANDOM;
+  case Advice::WillNeed:
+    return MADV_WILLNEED;
+  case Advice::DontNeed:
+    return MADV_DONTNEED;
+  case Advice::Normal:
+    break;
+  }
+  return MADV_NORMAL;
+}
+
+/// Pass @p advice on @p length bytes at @p address to the kernel, logging a refusal.
+void adviseKernel(
+    std::byte* const address,
+    const std::size_t length,
+    const int advice,
+    const std::filesystem::path& path) noexcept
+{
+  if(::madvise(address, length, advice) != 0)
+  {
+    const auto errorNumber = errno;
+    logger::warn(
+        "Unable to advise the kernel on {}: {}",
+        path.string(),
+        std::generic_category().message(errorNumber));
+  }
+}
+
+/// Take the pages of @p length bytes at @p address from NUMA node @p node, logging a refusal.
+void bindToNode(
+    std::byte* const address,
+    const std::size_t length,
+    const int node,
+    const std::filesystem::path& path) noexcept
+{
+  using Word = unsigned long; // NOLINT(google-runtime-int): the kernel's node mask word.
+  constexpr auto kBitsPerWord = static_cast<std::size_t>(std::numeric_limits<Word>::digits);
+  const auto bit = static_cast<std::size_t>(node);
+  if(bit >= kMaxNumaNodes)
+  {
+    logger::warn("Unable to bind {} to NUMA node {}: no such node.", path.string(), node);
+    return;
+  }
+
+  auto mask = std::array<Word, kMaxNumaNodes / kBitsPerWord>{};
+  mask.at(bit / kBitsPerWord) = Word{1} << (bit % kBitsPerWord);
+
+  // glibc wraps no mbind, and the kernel reads one bit fewer of the mask than it is told.
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg,hicpp-vararg): syscall is the kernel's API.
+  if(::syscall(SYS_mbind, address, length, MPOL_BIND, mask.data(), kMaxNumaNodes + 1U, 0U) != 0)
+  {
+    const auto errorNumber = errno;
+    logger::warn(
+        "Unable to bind {} to NUMA node {}: {}",
+        path.string(),
+        node,
+        std::generic_category().message(errorNumber));
+  }
 }
 
 } // namespace
 
-MmapRegion::MmapRegion(std::filesystem::path path, const std::size_t size):
+MmapRegion::MmapRegion(
+    std::filesystem::path path,
+    const std::size_t size,
+    const WriteMode writeMode,
+    const std::size_t reservation,
+    const MapPolicy policy):
+  mPath{std::move(path)},
+  mFileDescriptor{openForWriting(mPath, size, writeMode)},
+  mWriteMode{writeMode},
+  mPolicy{policy},
+  mSize{size},
+  mReservation{std::max(size, reservation)},
+  mAddress{mapWritable(mFileDescriptor, size, reservation, writeMode, mPolicy, mPath)}
+{
+  applyPolicy(0, size, true);
+}
+
+MmapRegion::MmapRegion(std::filesystem::path path, const MapPolicy policy):
+  MmapRegion{openForReading(path), std::move(path), policy}
+{
+}
+
+MmapRegion::MmapRegion(
+    const int fileDescriptor,
+    std::filesystem::path path,
+    const MapPolicy policy):
   mPath{std::move(path)},
-  mFileDescriptor{openForWriting(mPath, size)},
-  mBytes{mapMemory(mFileDescriptor, size, true, mPath)}
+  mFileDescriptor{fileDescriptor},
+  mWriteMode{WriteMode::Mapped},
+  mPolicy{policy},
+  mSize{fileSize(mFileDescriptor, mPath)},
+  mReservation{mSize.load(std::memory_order_relaxed)},
+  mAddress{mapMemory(mFileDescriptor, mReservation, false, mapFlags(mPolicy), mPath)}
 {
+  applyPolicy(0, mReservation, false);
 }
 
-MmapRegion::MmapRegion(std::filesystem::path path):
+MmapRegion::MmapRegion(
+    const int fileDescriptor,
+    std::filesystem::path path,
+    const std::size_t offset,
+    const std::size_t length,
+    const MapPolicy policy):
   mPath{std::move(path)},
-  mFileDescriptor{openForReading(mPath)},
-  mBytes{mapMemory(mFileDescriptor, fileSize(mFileDescriptor, mPath), false, mPath)}
+  mFileDescriptor{-1},
+  mWriteMode{WriteMode::Mapped},
+  mPolicy{policy},
+  mSize{length},
+  mReservation{length},
+  mAddress{mapWindow(fileDescriptor, offset, length, mapFlags(mPolicy), mPath)}
 {
+  applyPolicy(0, length, false);
 }
 
 MmapRegion::MmapRegion(MmapRegion&& other) noexcept:
   mPath{std::move(other.mPath)},
   mFileDescriptor{std::exchange(other.mFileDescriptor, -1)},
-  mBytes{std::exchange(other.mBytes, {})}
+  mWriteMode{other.mWriteMode},
+  mPolicy{other.mPolicy},
+  mSize{other.mSize.exchange(0, std::memory_order_relaxed)},
+  mReservation{std::exchange(other.mReservation, 0)},
+  mAddress{std::exchange(other.mAddress, nullptr)}
 {
 }
 
 MmapRegion::~MmapRegion()
 {
-  if(not mBytes.empty())
+  if(mAddress != nullptr)
   {
-    static_cast<void>(::munmap(mBytes.data(), mBytes.size()));
+    static_cast<void>(::munmap(mAddress, mReservation));
   }
 
   if(mFileDescriptor >= 0)
@@ -143,12 +502,12 @@ MmapRegion::~MmapRegion()
 
 std::span<std::byte> MmapRegion::bytes() noexcept
 {
-  return mBytes;
+  return {mAddress, size()};
 }
 
 std::span<const std::byte> MmapRegion::bytes() const noexcept
 {
-  return mBytes;
+  return {mAddress, size()};
 }
 
 const std::filesystem::path& MmapRegion::path() const noexcept
@@ -158,12 +517,84 @@ const std::filesystem::path& MmapRegion::path() const noexcept
 
 bool MmapRegion::empty() const noexcept
 {
-  return mBytes.empty();
+  return size() == 0;
 }
 
 std::size_t MmapRegion::size() const noexcept
 {
-  return mBytes.size();
+  return mSize.load(std::memory_order_acquire);
+}
+
+const MapPolicy& MmapRegion::policy() const noexcept
+{
+  return mPolicy;
+}
+
+std::size_t MmapRegion::reservation() const noexcept
+{
+  return mReservation;
+}
+
+void MmapRegion::grow(const std::size_t size)
+{
+  const auto current = this->size();
+  if(size <= current)
+  {
+    return;
+  }
+  if(size > mReservation)
+  {
+    common::throwException<std::invalid_argument>(
+        "Unable to grow {} to {} bytes; it reserves only {}.",
+        mPath.string(),
+        size,
+        mReservation);
+  }
+
+  if(::ftruncate(mFileDescriptor, static_cast<off_t>(size)) != 0)
+  {
+    common::throwException<std::runtime_error>(
+        "Unable to extend {}: {}",
+        mPath.string(),
+        std::generic_category().message(errno));
+  }
+
+  // The page holding the old end is mapped already, and now lies within the file.
+  const auto first = roundUpToPage(current);
+  if(size > first)
+  {
+    const auto errorNumber = mapInto(
+        mAddress + first, // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic): reserved.
+        first,
+        size - first,
+        mFileDescriptor,
+        mWriteMode,
+        mapFlags(mPolicy));
+    if(errorNumber != 0)
+    {
+      static_cast<void>(::ftruncate(mFileDescriptor, static_cast<off_t>(current)));
+      common::throwException<std::runtime_error>(
+          "Unable to map {} as it grows: {}",
+          mPath.string(),
+          std::generic_category().message(errorNumber));
+    }
+    applyPolicy(first, size - first, true);
+  }
+  mSize.store(size, std::memory_order_release);
+}
+
+MmapRegion MmapRegion::remap() const
+{
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg,hicpp-vararg): fcntl is the POSIX file API.
+  const auto fileDescriptor = ::fcntl(mFileDescriptor, F_DUPFD_CLOEXEC, 0);
+  if(fileDescriptor < 0)
+  {
+    common::throwException<std::runtime_error>(
+        "Unable to duplicate the descriptor of {}: {}",
+        mPath.string(),
+        std::generic_category().message(errno));
+  }
+  return MmapRegion{fileDescriptor, mPath, mPolicy};
 }
 
 void MmapRegion::resize(const std::size_t size) noexcept
@@ -178,4 +609,184 @@ void MmapRegion::resize(const std::size_t size) noexcept
   }
 }
 
+void MmapRegion::restage(std::filesystem::path path, const std::size_t fileSize)
+{
+  if(mWriteMode != WriteMode::Direct)
+  {
+    common::throwException<std::logic_error>(
+        "Unable to restage {} at {}: only a Direct region stages its bytes.",
+        mPath.string(),
+        path.string());
+  }
+
+  const auto fileDescriptor = openForWriting(path, std::min(fileSize, size()), mWriteMode);
+  static_cast<void>(::close(std::exchange(mFileDescriptor, fileDescriptor)));
+  mPath = std::move(path);
+}
+
+void MmapRegion::rename(std::filesystem::path path)
+{
+  if(mWriteMode != WriteMode::Memory)
+  {
+    std::filesystem::rename(mPath, path);
+  }
+  mPath = std::move(path);
+}
+
+void MmapRegion::advise(
+    const std::size_t offset,
+    const std::size_t length,
+    const Advice advice) const noexcept
+{
+  const auto size = this->size();
+  if(offset >= size or length == 0 or
+     (mWriteMode == WriteMode::Direct and advice == Advice::DontNeed))
+  {
+    return;
+  }
+
+  const auto first = offset - (offset % pageSize());
+  const auto last = std::min(size, offset + length);
+
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic): first lies within the mapping.
+  adviseKernel(mAddress + first, last - first, toNativeAdvice(advice), mPath);
+}
+
+void MmapRegion::startWriteback(const std::size_t offset, const std::size_t length) const noexcept
+{
+  if(length == 0 or mWriteMode != WriteMode::Mapped)
+  {
+    return;
+  }
+
+  if(::sync_file_range(
+         mFileDescriptor,
+         static_cast<off_t>(offset),
+         static_cast<off_t>(length),
+         SYNC_FILE_RANGE_WRITE) != 0)
+  {
+    const auto errorNumber = errno;
+    logger::warn(
+        "Unable to start writeback of {}: {}",
+        mPath.string(),
+        std::generic_category().message(errorNumber));
+  }
+}
+
+void MmapRegion::discard(const std::size_t offset, const std::size_t length) const noexcept
+{
+  const auto first = roundUpToPage(offset);
+  const auto last = (std::min(size(), offset + length) / pageSize()) * pageSize();
+  if(mWriteMode == WriteMode::Direct or first >= last)
+  {
+    return;
+  }
+
+  if(::fallocate(
+         mFileDescriptor,
+         FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+         static_cast<off_t>(first),
+         static_cast<off_t>(last - first)) != 0)
+  {
+    const auto errorNumber = errno;
+    logger::warn(
+        "Unable to discard bytes {} to {} of {}: {}",
+        first,
+        last,
+        mPath.string(),
+        std::generic_category().message(errorNumber));
+  }
+}
+
+void MmapRegion::writeThrough(const std::size_t offset, const std::size_t length) const
+{
+  const auto size = this->size();
+  if(mWriteMode != WriteMode::Direct or offset >= size or length == 0)
+  {
+    return;
+  }
+
+  // The staging mapping starts on a page and reads as zero to the end of its last page, so a range
+  // widened to whole blocks stays within it, and its memory is as aligned as its file offsets.
+  const auto end = std::min(size, offset + length);
+  auto position = offset - (offset % kDirectBlockSize);
+  const auto last = end + ((kDirectBlockSize - (end % kDirectBlockSize)) % kDirectBlockSize);
+  while(position < last)
+  {
+    const auto chunk = std::min(last - position, kDirectChunkSize);
+    const auto written = ::pwrite(
+        mFileDescriptor,
+        mAddress + position, // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        chunk,
+        static_cast<off_t>(position));
+    if(written < 0 and errno == EINTR)
+    {
+      continue;
+    }
+    if(written <= 0)
+    {
+      common::throwException<std::runtime_error>(
+          "Unable to write {} through: {}",
+          mPath.string(),
+          std::generic_category().message(errno));
+    }
+    position += static_cast<std::size_t>(written);
+  }
+}
+
+void MmapRegion::applyPolicy(
+    const std::size_t offset,
+    const std::size_t length,
+    const bool writable) const noexcept
+{
+  if(length == 0)
+  {
+    return;
+  }
+
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic): within the mapping.
+  auto* const address = mAddress + offset;
+  if(mPolicy.mNumaNode >= 0)
+  {
+    bindToNode(address, length, mPolicy.mNumaNode, mPath);
+  }
+  if(mPolicy.mHugePages != HugePages::None)
+  {
+    adviseKernel(address, length, MADV_HUGEPAGE, mPath);
+  }
+  if(mPolicy.mAdvice != Advice::Normal and mPolicy.mAdvice != Advice::DontNeed)
+  {
+    adviseKernel(address, length, toNativeAdvice(mPolicy.mAdvice), mPath);
+  }
+  if(populatesLate(mPolicy))
+  {
+    adviseKernel(address, length, writable ? MADV_POPULATE_WRITE : MADV_POPULATE_READ, mPath);
+  }
+  if(mPolicy.mLock and ::mlock(address, length) != 0)
+  {
+    const auto errorNumber = errno;
+    logger::warn(
+        "Unable to lock {} in memory: {}",
+        mPath.string(),
+        std::generic_category().message(errorNumber));
+  }
+}
+
+void MmapRegion::sync() const
+{
+  if(mWriteMode == WriteMode::Memory)
+  {
+    return;
+  }
+
+  // On Linux, fdatasync also writes back the dirty pages of every shared mapping of the file.
+  if(::fdatasync(mFileDescriptor) != 0)
+  {
+    common::throwException<std::runtime_error>(
+        "Unable to sync {}: {}",
+        mPath.string(),
+        std::generic_category().message(errno));
+  }
+}
+
 } // namespace nioc::containers
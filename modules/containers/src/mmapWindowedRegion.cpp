@@ -0,0 +1,199 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <nioc/common/exception.hpp>
+#include <nioc/containers/mmapWindowedRegion.hpp>
+#include <nioc/logger/logger.hpp>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+#include <utility>
+
+namespace nioc::containers
+{
+namespace
+{
+
+std::size_t pageSize() noexcept
+{
+  static const auto kPageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  return kPageSize;
+}
+
+int openForReading(const std::filesystem::path& path)
+{
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg,hicpp-vararg): open is the POSIX file API.
+  const auto fileDescriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if(fileDescriptor < 0)
+  {
+    common::throwException<std::runtime_error>(
+        "Unable to open {}: {}",
+        path.string(),
+        std::generic_category().message(errno));
+  }
+  return fileDescriptor;
+}
+
+std::size_t fileSize(const int fileDescriptor, const std::filesystem::path& path)
+{
+  struct stat status{};
+  if(::fstat(fileDescriptor, &status) != 0)
+  {
+    const auto errorNumber = errno;
+    static_cast<void>(::close(fileDescriptor));
+    common::throwException<std::runtime_error>(
+        "Unable to stat {}: {}",
+        path.string(),
+        std::generic_category().message(errorNumber));
+  }
+  return static_cast<std::size_t>(status.st_size);
+}
+
+int toFileAdvice(const Advice advice) noexcept
+{
+  switch(advice)
+  {
+  case Advice::Sequential:
+    return POSIX_FADV_SEQUENTIAL;
+  case Advice::Random:
+    return POSIX_FADV_RANDOM;
+  case Advice::WillNeed:
+    return POSIX_FADV_WILLNEED;
+  case Advice::DontNeed:
+    return POSIX_FADV_DONTNEED;
+  case Advice::Normal:
+    break;
+  }
+  return POSIX_FADV_NORMAL;
+}
+
+} // namespace
+
+MmapWindowedRegion::MmapWindowedRegion(
+    std::filesystem::path path,
+    const std::size_t windowSize,
+    const std::size_t windowCount,
+    const MapPolicy policy):
+  mPath{std::move(path)},
+  mFileDescriptor{openForReading(mPath)},
+  mSize{fileSize(mFileDescriptor, mPath)},
+  mWindowSize{(std::max(windowSize, std::size_t{1}) + pageSize() - 1U) / pageSize() * pageSize()},
+  mWindowCount{std::max(windowCount, std::size_t{1})},
+  mPolicy{policy}
+{
+}
+
+MmapWindowedRegion::~MmapWindowedRegion()
+{
+  static_cast<void>(::close(mFileDescriptor));
+}
+
+MmapWindowedRegion::View MmapWindowedRegion::map(const std::size_t offset, const std::size_t length)
+{
+  if(offset > mSize or length > mSize - offset)
+  {
+    common::throwException<std::out_of_range>(
+        "Bytes {} to {} run past the end of {}, which is {} bytes.",
+        offset,
+        offset + length,
+        mPath.string(),
+        mSize);
+  }
+  if(length == 0U)
+  {
+    return {};
+  }
+
+  const auto index = offset / mWindowSize;
+  const auto windowBegin = index * mWindowSize;
+  if(offset + length > windowBegin + mWindowSize)
+  {
+    // Across the end of its window: map just the pages under the range, for this range alone.
+    const auto begin = offset - (offset % pageSize());
+    auto window = std::make_shared<const MmapRegion>(
+        mFileDescriptor,
+        mPath,
+        begin,
+        offset + length - begin,
+        mPolicy);
+    const auto bytes = window->bytes().subspan(offset - begin, length);
+    return View{.mWindow = std::move(window), .mBytes = bytes};
+  }
+
+  const auto found = std::ranges::find(mWindows, index, &Window::first);
+  if(found != mWindows.end())
+  {
+    mWindows.splice(mWindows.begin(), mWindows, found);
+  }
+  else
+  {
+    mWindows.emplace_front(
+        index,
+        std::make_shared<const MmapRegion>(
+            mFileDescriptor,
+            mPath,
+            windowBegin,
+            std::min(mWindowSize, mSize - windowBegin),
+            mPolicy));
+    if(mWindows.size() > mWindowCount)
+    {
+      mWindows.pop_back();
+    }
+  }
+
+  const auto& window = mWindows.front().second;
+  return View{.mWindow = window, .mBytes = window->bytes().subspan(offset - windowBegin, length)};
+}
+
+void MmapWindowedRegion::advise(
+    const std::size_t offset,
+    const std::size_t length,
+    const Advice advice) const noexcept
+{
+  if(offset >= mSize or length == 0U)
+  {
+    return;
+  }
+
+  const auto errorNumber = ::posix_fadvise(
+      mFileDescriptor,
+      static_cast<off_t>(offset),
+      static_cast<off_t>(std::min(length, mSize - offset)),
+      toFileAdvice(advice));
+  if(errorNumber != 0)
+  {
+    logger::warn(
+        "Unable to advise the kernel on {}: {}",
+        mPath.string(),
+        std::generic_category().message(errorNumber));
+  }
+}
+
+const std::filesystem::path& MmapWindowedRegion::path() const noexcept
+{
+  return mPath;
+}
+
+std::size_t MmapWindowedRegion::size() const noexcept
+{
+  return mSize;
+}
+
+std::size_t MmapWindowedRegion::windowSize() const noexcept
+{
+  return mWindowSize;
+}
+
+std::size_t MmapWindowedRegion::mappedWindows() const noexcept
+{
+  return mWindows.size();
+}
+
+} // namespace nioc::containers
@@ -6,6 +6,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <fcntl.h>
 #include <filesystem>
 #include <gtest/gtest.h>
 #include <iterator>
@@ -68,6 +69,21 @@ TEST(MmapConstArray, readsAnExistingFile)
   }
 }
 
+TEST(MmapConstArray, adoptsAnOpenFileDescriptor)
+{
+  constexpr auto kCount = std::size_t{4};
+  const auto path = writeRamp("constArrayDescriptor", kCount);
+
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg,hicpp-vararg): open is the POSIX file API.
+  const auto fileDescriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  ASSERT_GE(fileDescriptor, 0);
+  fs::remove(path); // the descriptor alone keeps the file alive
+
+  const auto array = MmapConstArray<std::int32_t>{fileDescriptor, "ramp"};
+  ASSERT_EQ(array.size(), kCount);
+  EXPECT_EQ(array.at(3), 3);
+}
+
 TEST(MmapConstArray, worksAsAContiguousRange)
 {
   const auto path = writeRamp("constArrayRange", 5);
@@ -105,6 +121,21 @@ TEST(MmapConstArray, atReadsElementsAndThrowsOutOfRange)
   EXPECT_THROW(static_cast<void>(array.at(kCount)), std::out_of_range);
 }
 
+TEST(MmapConstArray, remapCoversWhatTheFileGrewBy)
+{
+  const auto path = freshPath("remapped");
+  auto array = MmapArray<std::int32_t>{path, 4, WriteMode::Mapped, 1024};
+  const auto view = MmapConstArray<std::int32_t>{path};
+
+  array.grow(1024);
+  array[1000] = 7;
+  EXPECT_EQ(view.size(), 4U);
+
+  const auto remapped = view.remap();
+  ASSERT_EQ(remapped.size(), 1024U);
+  EXPECT_EQ(remapped[1000], 7);
+}
+
 TEST(MmapConstArray, moveTransfersOwnershipOfTheMapping)
 {
   constexpr auto kCount = std::size_t{6};
@@ -66,6 +66,266 @@ TEST(MmapRegion, openingAMissingFileThrows)
   EXPECT_THROW((MmapRegion{freshPath("missingRegion")}), std::runtime_error);
 }
 
+TEST(MmapRegion, adviceLeavesTheBytesUnchanged)
+{
+  const auto path = freshPath("advisedRegion");
+  constexpr auto kSize = std::size_t{3 * 4096};
+  {
+    auto region = MmapRegion{path, kSize};
+    region.bytes()[5000] = std::byte{0x5A};
+  }
+
+  const auto region = MmapRegion{path};
+  region.advise(0, kSize, Advice::Sequential);
+  region.advise(4999, 2, Advice::WillNeed); // an unaligned offset widens down to its page
+  region.advise(kSize - 1, kSize, Advice::WillNeed); // a range running past the end is clamped
+  region.advise(kSize, 1, Advice::WillNeed);         // one wholly past the end is ignored
+  EXPECT_EQ(region.bytes()[5000], std::byte{0x5A});
+
+  region.advise(0, kSize, Advice::DontNeed);
+  EXPECT_EQ(region.bytes()[5000], std::byte{0x5A}); // faulted back in from the file
+
+  region.advise(0, kSize, Advice::Random);
+  region.advise(0, kSize, Advice::Normal);
+}
+
+TEST(MmapRegion, writebackAndSyncPersistTheBytes)
+{
+  const auto path = freshPath("syncedRegion");
+  constexpr auto kSize = std::size_t{2 * 4096};
+  {
+    auto region = MmapRegion{path, kSize};
+    region.bytes()[10] = std::byte{0x11};
+    region.bytes()[6000] = std::byte{0x22};
+    region.startWriteback(0, 4096);
+    region.startWriteback(4096, 0); // an empty range is a no-op
+    region.resize(6001);
+    EXPECT_NO_THROW(region.sync());
+  }
+
+  EXPECT_EQ(fs::file_size(path), 6001U);
+  const auto region = MmapRegion{path};
+  EXPECT_EQ(region.bytes()[10], std::byte{0x11});
+  EXPECT_EQ(region.bytes()[6000], std::byte{0x22});
+}
+
+TEST(MmapRegion, aDirectRegionReachesTheFileOnlyOnceWrittenThrough)
+{
+  const auto path = freshPath("directRegion");
+  constexpr auto kSize = std::size_t{3 * 4096};
+  {
+    auto region = MmapRegion{path, kSize, WriteMode::Direct};
+    region.bytes()[10] = std::byte{0x11};
+    region.bytes()[9000] = std::byte{0x22};
+    region.advise(0, kSize, Advice::DontNeed); // must not discard the staged bytes
+    EXPECT_EQ(region.bytes()[10], std::byte{0x11});
+
+    EXPECT_EQ(MmapRegion{path}.bytes()[10], std::byte{0x00});
+    region.writeThrough(0, 9001);
+    region.resize(9001);
+    EXPECT_NO_THROW(region.sync());
+  }
+
+  EXPECT_EQ(fs::file_size(path), 9001U);
+  const auto region = MmapRegion{path};
+  EXPECT_EQ(region.bytes()[10], std::byte{0x11});
+  EXPECT_EQ(region.bytes()[9000], std::byte{0x22});
+}
+
+TEST(MmapRegion, growExtendsTheFileAndMappingInPlace)
+{
+  const auto path = freshPath("regionGrow");
+
+  // Sizes off the page boundary, so the growth crosses a partly mapped page.
+  auto region = MmapRegion{path, 100, WriteMode::Mapped, 1U << 20U};
+  EXPECT_EQ(region.reservation(), 1U << 20U);
+  const auto* const data = region.data();
+  region.bytes().front() = std::byte{0x11};
+
+  region.grow(70000);
+  EXPECT_EQ(region.data(), data);
+  EXPECT_EQ(region.size(), 70000U);
+  EXPECT_EQ(fs::file_size(path), 70000U);
+  EXPECT_EQ(region.bytes().front(), std::byte{0x11});
+  EXPECT_EQ(region.bytes()[69999], std::byte{0});
+  region.bytes()[69999] = std::byte{0x22};
+
+  region.grow(50); // never shrinks
+  EXPECT_EQ(region.size(), 70000U);
+  EXPECT_THROW(region.grow((1U << 20U) + 1U), std::invalid_argument);
+
+  const auto reopened = MmapRegion{path};
+  EXPECT_EQ(reopened.bytes()[69999], std::byte{0x22});
+}
+
+TEST(MmapRegion, aDirectRegionGrowsItsStagedBytes)
+{
+  const auto path = freshPath("regionGrowDirect");
+
+  auto region = MmapRegion{path, 4096, WriteMode::Direct, 1U << 20U};
+  region.grow(3U * 4096U);
+  region.bytes()[9000] = std::byte{0x33};
+  region.writeThrough(0, region.size());
+
+  const auto reopened = MmapRegion{path};
+  EXPECT_EQ(reopened.size(), 3U * 4096U);
+  EXPECT_EQ(reopened.bytes()[9000], std::byte{0x33});
+}
+
+TEST(MmapRegion, aDirectRegionRestagesItsMemoryForAFreshFile)
+{
+  const auto first = freshPath("regionRestageFirst");
+  const auto second = freshPath("regionRestageSecond");
+
+  auto region = MmapRegion{first, 4096, WriteMode::Direct, 1U << 20U};
+  region.grow(2U * 4096U);
+  const auto* const data = region.data();
+  region.bytes()[5000] = std::byte{0x66};
+  region.writeThrough(0, region.size());
+
+  region.restage(second, 4096);
+  EXPECT_EQ(region.data(), data);
+  EXPECT_EQ(region.size(), 2U * 4096U);
+  EXPECT_EQ(region.path(), second);
+  EXPECT_EQ(fs::file_size(second), 4096U);
+  region.bytes()[5000] = std::byte{0x77};
+  region.writeThrough(0, region.size());
+
+  EXPECT_EQ(MmapRegion{first}.bytes()[5000], std::byte{0x66});
+  EXPECT_EQ(MmapRegion{second}.bytes()[5000], std::byte{0x77});
+  EXPECT_THROW(
+      MmapRegion(freshPath("regionRestageMapped"), 64).restage(first, 64),
+      std::logic_error);
+}
+
+TEST(MmapRegion, discardZeroesTheWholePagesOfARange)
+{
+  const auto path = freshPath("discardedRegion");
+  constexpr auto kSize = std::size_t{4 * 4096};
+  auto region = MmapRegion{path, kSize};
+  region.bytes()[100] = std::byte{0x11};
+  region.bytes()[5000] = std::byte{0x22};
+  region.bytes()[12000] = std::byte{0x33};
+
+  // Only the second page lies wholly within the range. File systems that cannot punch holes leave
+  // the bytes in place.
+  region.discard(100, 8100);
+  EXPECT_EQ(region.bytes()[100], std::byte{0x11});
+  EXPECT_EQ(region.size(), kSize);
+  EXPECT_EQ(fs::file_size(path), kSize);
+  if(region.bytes()[5000] == std::byte{0})
+  {
+    EXPECT_EQ(MmapRegion{path}.bytes()[5000], std::byte{0});
+  }
+  EXPECT_EQ(region.bytes()[12000], std::byte{0x33});
+
+  region.bytes()[5000] = std::byte{0x44}; // a discarded page takes writes again
+  EXPECT_EQ(MmapRegion{path}.bytes()[5000], std::byte{0x44});
+}
+
+TEST(MmapRegion, renameMovesTheFileAndKeepsTheMapping)
+{
+  const auto first = freshPath("regionRenameFirst");
+  const auto second = freshPath("regionRenameSecond");
+
+  auto region = MmapRegion{first, 4096};
+  const auto* const data = region.data();
+  region.rename(second);
+  EXPECT_EQ(region.data(), data);
+  EXPECT_EQ(region.path(), second);
+  EXPECT_FALSE(fs::exists(first));
+
+  region.bytes().front() = std::byte{0x44};
+  region.sync();
+  EXPECT_EQ(MmapRegion{second}.bytes().front(), std::byte{0x44});
+}
+
+TEST(MmapRegion, aMemoryRegionGrowsAndShrinksWithoutTouchingTheDisk)
+{
+  const auto path = freshPath("regionMemory") / "roll";
+
+  auto region = MmapRegion{path, 4096, WriteMode::Memory, 1U << 20U};
+  const auto* const data = region.data();
+  region.bytes().front() = std::byte{0x44};
+  region.grow(3U * 4096U);
+  EXPECT_EQ(region.data(), data);
+  region.bytes()[9000] = std::byte{0x55};
+  EXPECT_EQ(region.bytes().front(), std::byte{0x44});
+
+  region.startWriteback(0, region.size());
+  region.sync();
+  region.resize(4096);
+  EXPECT_FALSE(fs::exists(path.parent_path()));
+}
+
+TEST(MmapRegion, anEmptyReservedRegionGrowsFromNothing)
+{
+  const auto path = freshPath("regionEmpty");
+
+  auto region = MmapRegion{path, 0, WriteMode::Mapped, 1U << 16U};
+  EXPECT_EQ(region.size(), 0U);
+  EXPECT_EQ(fs::file_size(path), 0U);
+
+  region.grow(4096);
+  EXPECT_EQ(region.size(), 4096U);
+  EXPECT_EQ(fs::file_size(path), 4096U);
+  region.bytes().back() = std::byte{0x33};
+  EXPECT_EQ(MmapRegion{path}.bytes().back(), std::byte{0x33});
+}
+
+TEST(MmapRegion, aRegionWithoutAReservationCannotGrow)
+{
+  auto region = MmapRegion{freshPath("regionFixed"), 64};
+  EXPECT_EQ(region.reservation(), 64U);
+  EXPECT_THROW(region.grow(128), std::invalid_argument);
+}
+
+TEST(MmapRegion, aMapPolicyCoversTheMappingAndWhatItGrowsBy)
+{
+  const auto path = freshPath("regionPolicy");
+  const auto policy = MapPolicy{
+      .mPopulate = true,
+      .mHugePages = HugePages::Transparent,
+      .mAdvice = Advice::Random,
+      .mLock = true,
+      .mNumaNode = 0};
+
+  // Parts of the policy the sandbox may refuse, such as locking, are logged and skipped.
+  auto region = MmapRegion{path, 100, WriteMode::Mapped, 1U << 20U, policy};
+  EXPECT_TRUE(region.policy().mPopulate);
+  EXPECT_EQ(region.bytes().front(), std::byte{0});
+  region.bytes().front() = std::byte{0x44};
+
+  region.grow(70000);
+  EXPECT_EQ(region.bytes()[69999], std::byte{0});
+  region.bytes()[69999] = std::byte{0x55};
+
+  const auto remapped = region.remap();
+  EXPECT_EQ(remapped.policy().mHugePages, HugePages::Transparent);
+  EXPECT_EQ(remapped.bytes().front(), std::byte{0x44});
+  EXPECT_EQ(remapped.bytes()[69999], std::byte{0x55});
+}
+
+TEST(MmapRegion, explicitHugePagesStageADirectRegionOrFallBack)
+{
+  const auto path = freshPath("regionHugePages");
+  constexpr auto kSize = std::size_t{2} << 20U;
+  {
+    // With the huge page pool empty, as it is by default, the staging falls back to base pages.
+    auto region = MmapRegion{
+        path,
+        kSize,
+        WriteMode::Direct,
+        0,
+        MapPolicy{.mPopulate = true, .mHugePages = HugePages::Explicit}};
+    region.bytes()[kSize - 1U] = std::byte{0x66};
+    region.writeThrough(0, kSize);
+  }
+
+  const auto region = MmapRegion{path};
+  EXPECT_EQ(region.bytes()[kSize - 1U], std::byte{0x66});
+}
+
 TEST(MmapRegion, moveTransfersOwnershipOfTheMapping)
 {
   const auto path = freshPath("movedRegion");
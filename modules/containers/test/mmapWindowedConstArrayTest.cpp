@@ -0,0 +1,75 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <nioc/containers/mmapArray.hpp>
+#include <nioc/containers/mmapWindowedConstArray.hpp>
+#include <numeric>
+#include <stdexcept>
+#include <string_view>
+
+namespace nioc::containers
+{
+namespace
+{
+namespace fs = std::filesystem;
+
+fs::path freshPath(const std::string_view name)
+{
+  const auto directory = fs::temp_directory_path() / "nioc-containersTest";
+  fs::create_directories(directory);
+  const auto path = directory / name;
+  fs::remove(path);
+  return path;
+}
+
+} // namespace
+
+TEST(MmapWindowedConstArray, readsElementsAcrossManyWindows)
+{
+  constexpr auto kCount = std::size_t{100'000};
+  const auto path = freshPath("windowedArray");
+  {
+    auto array = MmapArray<std::int64_t>{path, kCount};
+    std::iota(array.begin(), array.end(), std::int64_t{0});
+  }
+
+  // Windows of a page or so, two kept: far less than the 800 kB file.
+  auto array = MmapWindowedConstArray<std::int64_t>{path, 4096, 2};
+  ASSERT_EQ(array.size(), kCount);
+  EXPECT_FALSE(array.empty());
+  for(auto first = std::size_t{0}; first < kCount; first += 97U)
+  {
+    const auto count = std::min(std::size_t{13}, kCount - first);
+    const auto slice = array.slice(first, count);
+    ASSERT_EQ(slice.mElements.size(), count);
+    for(auto index = std::size_t{0}; index < count; ++index)
+    {
+      EXPECT_EQ(slice.mElements[index], static_cast<std::int64_t>(first + index));
+    }
+    EXPECT_LE(array.region().mappedWindows(), 2U);
+  }
+  EXPECT_EQ(array.at(kCount - 1U), static_cast<std::int64_t>(kCount - 1U));
+  EXPECT_THROW(static_cast<void>(array.at(kCount)), std::out_of_range);
+  EXPECT_THROW(static_cast<void>(array.slice(kCount - 1U, 2)), std::out_of_range);
+}
+
+TEST(MmapWindowedConstArray, openingAFileThatIsNotAWholeNumberOfElementsThrows)
+{
+  const auto path = freshPath("windowedArrayPartial");
+  {
+    auto stream = std::ofstream{path, std::ios::binary};
+    stream << "abcde";
+  }
+  EXPECT_THROW(MmapWindowedConstArray<std::int32_t>{path}, std::runtime_error);
+}
+
+} // namespace nioc::containers
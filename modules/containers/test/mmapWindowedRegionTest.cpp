@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <nioc/containers/mmapArray.hpp>
+#include <nioc/containers/mmapWindowedRegion.hpp>
+#include <stdexcept>
+#include <string_view>
+#include <unistd.h>
+
+namespace nioc::containers
+{
+namespace
+{
+namespace fs = std::filesystem;
+
+std::size_t pageSize()
+{
+  return static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+}
+
+// Writes @p size bytes valued by their offset modulo 251 into a fresh file and returns its path.
+fs::path writeBytes(const std::string_view name, const std::size_t size)
+{
+  const auto directory = fs::temp_directory_path() / "nioc-containersTest";
+  fs::create_directories(directory);
+  const auto path = directory / name;
+  fs::remove(path);
+  auto array = MmapArray<std::uint8_t>{path, size};
+  for(auto offset = std::size_t{0}; offset < size; ++offset)
+  {
+    array[offset] = static_cast<std::uint8_t>(offset % 251U);
+  }
+  return path;
+}
+
+void expectBytes(const MmapWindowedRegion::View& view, const std::size_t offset)
+{
+  ASSERT_NE(view.mWindow, nullptr);
+  for(auto index = std::size_t{0}; index < view.mBytes.size(); ++index)
+  {
+    EXPECT_EQ(static_cast<std::uint8_t>(view.mBytes[index]), (offset + index) % 251U);
+  }
+}
+
+} // namespace
+
+TEST(MmapWindowedRegion, mapsRangesWithinAndAcrossWindows)
+{
+  const auto size = 8U * pageSize() + 100U;
+  const auto path = writeBytes("windowedRanges", size);
+  auto region = MmapWindowedRegion{path, 2U * pageSize(), 2};
+  ASSERT_EQ(region.size(), size);
+  ASSERT_EQ(region.windowSize(), 2U * pageSize());
+  EXPECT_EQ(region.mappedWindows(), 0U);
+
+  const auto within = region.map(pageSize() + 10U, 64);
+  expectBytes(within, pageSize() + 10U);
+  EXPECT_EQ(region.mappedWindows(), 1U);
+
+  // Across the end of the first window: a mapping of its own, not kept.
+  const auto across = region.map(2U * pageSize() - 32U, 64);
+  expectBytes(across, 2U * pageSize() - 32U);
+  EXPECT_EQ(region.mappedWindows(), 1U);
+
+  // The short last window ends at the end of the file.
+  const auto tail = region.map(size - 100U, 100);
+  expectBytes(tail, size - 100U);
+  EXPECT_TRUE(region.map(size, 0).mBytes.empty());
+}
+
+TEST(MmapWindowedRegion, keepsAtMostTheWindowCountAndViewsOutliveEviction)
+{
+  const auto path = writeBytes("windowedEviction", 8U * pageSize());
+  auto region = MmapWindowedRegion{path, pageSize(), 2};
+
+  const auto first = region.map(0, 16);
+  static_cast<void>(region.map(pageSize(), 16));
+  static_cast<void>(region.map(0, 16)); // the first window is now the most recently used
+  static_cast<void>(region.map(2U * pageSize(), 16));
+  static_cast<void>(region.map(3U * pageSize(), 16));
+  EXPECT_EQ(region.mappedWindows(), 2U);
+
+  // Evicted by the region, the first window stays mapped while the view holds it.
+  expectBytes(first, 0);
+  EXPECT_EQ(first.mWindow.use_count(), 1);
+}
+
+TEST(MmapWindowedRegion, mappingPastTheEndThrows)
+{
+  const auto path = writeBytes("windowedOutOfRange", pageSize());
+  auto region = MmapWindowedRegion{path, pageSize(), 1};
+  EXPECT_THROW(static_cast<void>(region.map(pageSize() - 1U, 2)), std::out_of_range);
+  EXPECT_THROW(static_cast<void>(region.map(pageSize() + 1U, 0)), std::out_of_range);
+  EXPECT_THROW(MmapWindowedRegion{path.string() + ".missing"}, std::runtime_error);
+}
+
+} // namespace nioc::containers
@@ -119,6 +119,20 @@ TEST(Tape, rewindAtTheTailFreesTheUnusedSpace)
   EXPECT_EQ(tape.size(), 5U);
 }
 
+TEST(Tape, clearHandsTheStorageOutAgain)
+{
+  auto tape = Tape<std::array<int, 8>>{};
+  const auto first = tape.claim(8);
+  ASSERT_EQ(first.size(), 8U);
+  EXPECT_TRUE(tape.full());
+
+  tape.clear();
+  EXPECT_TRUE(tape.empty());
+  const auto again = tape.claim(3);
+  ASSERT_EQ(again.size(), 3U);
+  EXPECT_EQ(again.data(), first.data());
+}
+
 TEST(Tape, rewindIsANoOpOnceALaterClaimStrandsTheTail)
 {
   auto tape = Tape<std::array<int, 8>>{};
@@ -220,6 +234,70 @@ TEST(Tape, shrinkToFitTrimsTheBackingFile)
   EXPECT_EQ(tape[0], std::byte{0xAB}); // the mapping stays, so written bytes are still readable
 }
 
+TEST(Tape, growsAReservedArrayGeometricallyOnDemand)
+{
+  const auto path = freshPath("tapeGrow");
+
+  auto tape = Tape<MmapArray<std::uint64_t>>{path, 4, WriteMode::Mapped, 100};
+  EXPECT_EQ(tape.capacity(), 4U);
+  EXPECT_EQ(tape.max_size(), 100U);
+  const auto* const data = tape.data();
+
+  for(auto value = std::uint64_t{0}; value < 5U; ++value)
+  {
+    ASSERT_NE(tape.emplace(value), nullptr);
+  }
+  EXPECT_EQ(tape.capacity(), 8U); // doubled, not grown by one
+  EXPECT_EQ(tape.data(), data);
+
+  EXPECT_EQ(tape.claim(50).size(), 50U); // more than doubling: grown to fit
+  EXPECT_EQ(tape.capacity(), 55U);
+  EXPECT_EQ(tape.claim(45).size(), 45U); // capped at the reservation
+  EXPECT_TRUE(tape.full());
+  EXPECT_TRUE(tape.claim(1).empty());
+
+  for(auto value = std::uint64_t{0}; value < 5U; ++value)
+  {
+    EXPECT_EQ(tape[value], value);
+  }
+}
+
+TEST(Tape, concurrentClaimsGrowAReservedArrayWithoutOverlap)
+{
+  constexpr std::size_t kThreads = 8;
+  constexpr std::size_t kPerThread = 2000;
+  constexpr std::size_t kCount = kThreads * kPerThread;
+
+  const auto path = freshPath("tapeGrowConcurrent");
+  auto tape = Tape<MmapArray<std::uint32_t>>{path, 16, WriteMode::Mapped, kCount};
+  auto gate = std::latch{kThreads};
+  {
+    auto workers = std::vector<std::jthread>{};
+    for(std::size_t thread = 0; thread < kThreads; ++thread)
+    {
+      workers.emplace_back(
+          [&]
+          {
+            gate.arrive_and_wait();
+            for(std::size_t i = 0; i < kPerThread; ++i)
+            {
+              const auto slot = tape.claim(1);
+              if(not slot.empty())
+              {
+                slot.front() = static_cast<std::uint32_t>(slot.data() - tape.data());
+              }
+            }
+          });
+    }
+  }
+
+  ASSERT_EQ(tape.size(), kCount);
+  for(auto index = std::size_t{0}; index < kCount; ++index)
+  {
+    EXPECT_EQ(tape[index], index); // each slot claimed once, and written where it was claimed
+  }
+}
+
 // Disjointness is an invariant, not a timing assertion: N concurrent single-slot claims into a
 // capacity-N tape must yield exactly the indices {0..N-1} — no duplicates, no gaps — whatever the
 // interleaving. (gtest ASSERT_* must not run inside the worker lambdas; record, then check after
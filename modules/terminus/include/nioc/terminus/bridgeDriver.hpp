@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "driver.hpp"
+#include "schemaId.hpp"
+#include <cstdint>
+#include <nioc/chronicle/bridgeReceiver.hpp>
+#include <nioc/chronicle/writer.hpp>
+#include <string>
+#include <string_view>
+
+namespace nioc::terminus
+{
+
+/// @brief A source Driver that takes in the topics another run forwards over a TCP bridge (see
+/// Port::forward), recording them on this run's chronicle and delivering them onto the Port.
+///
+/// Example:
+///
+///     auto bridge = BridgeDriver{"bridge", port, 7400};
+///     bridge.receive<ImuSchema>("imu");
+///     // The Runner now ticks `bridge`. On the sending run:
+///     //   port.forward<ImuSchema>("imu", host, 7400);
+///
+/// Each message is read off the socket straight into this run's chronicle under its own topic, then
+/// delivered to the topic's subscribers as if it had been published here. Messages of topics not
+/// received are dropped. One sending run is served at a time; once it hangs up, the next to connect
+/// takes its place.
+///
+/// @see chronicle::BridgeReceiver, Port::forward
+class BridgeDriver final: public Driver
+{
+public:
+  /// @brief Listen on TCP port @p listenPort of every interface for a run forwarding topics.
+  ///
+  /// @param name Identifying label, fixed for the driver's lifetime.
+  ///
+  /// @param port Borrowed; must outlive this driver.
+  ///
+  /// @param listenPort The port to listen on; zero picks a free one (see listenPort()).
+  ///
+  /// @throws std::logic_error If the run does not record a chronicle.
+  ///
+  /// @throws std::runtime_error If @p listenPort cannot be listened on.
+  BridgeDriver(std::string name, Port& port, std::uint16_t listenPort = 0U);
+
+  /// @brief Record and deliver @p topic's messages of @p Schema from now on.
+  ///
+  /// Call at wiring time, before the Runner ticks the driver.
+  ///
+  /// @tparam Schema The Cap'n Proto payload schema. Must be supplied explicitly.
+  template<typename Schema>
+  void receive(const std::string_view& topic)
+  {
+    mReceiver.accept(port().recordTopic<Schema>(topic));
+  }
+
+  /// The TCP port the driver listens on.
+  [[nodiscard]] std::uint16_t listenPort() const noexcept;
+
+private:
+  /// Takes in the forwarded messages, committing them on the run's chronicle.
+  chronicle::BridgeReceiver mReceiver;
+
+  /// @brief The chronicle Writer of @p port's run.
+  ///
+  /// @throws std::logic_error If the run does not record a chronicle.
+  [[nodiscard]] static chronicle::Writer& recordingWriter(Port& port);
+
+  /// @brief Deliver the next forwarded message, if one arrives within a short wait.
+  ///
+  /// @return State::Done once shutdown is requested, State::Continue after a delivery, otherwise
+  /// State::Waiting.
+  [[nodiscard]] State run() final;
+};
+
+} // namespace nioc::terminus
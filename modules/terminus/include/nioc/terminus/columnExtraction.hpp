@@ -0,0 +1,67 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace nioc::terminus
+{
+
+/// @brief Decode every message of one topic of a recording once, in parallel, and write the
+/// scalar fields at @p fieldPaths out as dense column files, one element per message in timeline
+/// order.
+///
+/// Each column is a headerless file of fixed-stride native-endian elements, ready to map with
+/// containers::MmapConstArray and scan without touching Cap'n Proto again. The file is named after
+/// the field path and an extension giving the element type:
+///
+/// - `<path>.i64` and `<path>.u64` hold Int64 and UInt64 fields exactly, as such fields are often
+///   nanosecond timestamps or counters a double cannot carry;
+/// - `<path>.f64` holds every other numeric field widened to double.
+///
+/// Alongside, `arrivalTimestamp.i64` holds each message's envelope arrival timestamp. A gap in the
+/// topic keeps its row, so the columns stay aligned: a NaN in double columns, and the lowest value
+/// of the type in integer ones.
+///
+/// Example:
+///
+///     nioc::terminus::extractColumns("/runs/rigA", "imu", {"rate.x", "rate.y"}, "/tmp/imu");
+///     const auto rateX = nioc::containers::MmapConstArray<double>{"/tmp/imu/rate.x.f64"};
+///
+/// @param recording Recording directory, holding a `chronicle` directory, `topics.json`, and
+/// `schemas.bin`.
+///
+/// @param topic Name of the topic to extract.
+///
+/// @param fieldPaths Dot-separated paths from the payload root to numeric leaf fields.
+///
+/// @param outputDir Directory to write the columns into; created if absent. Existing columns of
+/// the same names are overwritten.
+///
+/// @param workerCount Most workers to decode with; zero means one per hardware thread.
+///
+/// @return Number of rows written to each column.
+///
+/// @throws std::invalid_argument If the recording carries no topic @p topic, or a path does not
+/// name a numeric field of its schema.
+///
+/// @throws std::runtime_error If the recording ships no schema for the topic, or a column cannot be
+/// created or written.
+///
+/// @see dynamicFieldExtractor, chronicle::ParallelScan
+std::uint64_t extractColumns(
+    const std::filesystem::path& recording,
+    std::string_view topic,
+    const std::vector<std::string>& fieldPaths,
+    const std::filesystem::path& outputDir,
+    std::size_t workerCount = 0);
+
+} // namespace nioc::terminus
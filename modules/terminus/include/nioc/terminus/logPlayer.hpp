@@ -25,6 +25,12 @@ namespace nioc::terminus
 ///     LogPlayer player{"logPlayer", port, "/path/to/chronicleLog"};
 ///     // The Runner now ticks `player` until it reports State::Done.
 ///
+/// The reader prefetches upcoming roll bytes ahead of delivery, so a log larger than memory replays
+/// without stalling on page faults (see chronicle::Reader::setReadAhead).
+///
+/// A log recorded with checksums has each record checked before delivery; a corrupt record is
+/// logged and skipped (see chronicle::Reader::setChecksumVerification).
+///
 /// Single use: the underlying reader cannot rewind. Construct a fresh instance to replay again.
 ///
 /// @see Driver, chronicle::Reader
@@ -17,7 +17,10 @@
 #include <filesystem>
 #include <functional>
 #include <memory>
+#include <nioc/chronicle/bridgeSender.hpp>
+#include <nioc/chronicle/broker.hpp>
 #include <nioc/chronicle/defines.hpp>
+#include <nioc/chronicle/memoryWriter.hpp>
 #include <nioc/chronicle/writer.hpp>
 #include <nioc/common/exception.hpp>
 #include <nioc/common/locked.hpp>
@@ -48,6 +51,10 @@ class Publisher;
 /// tears the graph down in dependency order. Routines hold a reference to their Port and use it to
 /// publish, subscribe, acquire resources, and observe the shutdown/abort tokens.
 ///
+/// A run that does not record publishes through channels kept in memory instead (see
+/// chronicle::MemoryWriter): messages still reach their subscribers zero-copy, and the rolls they
+/// lie in are reused once the subscribers let go of them.
+///
 /// Neither copyable nor movable; pass by reference. One Port is shared across the run's worker
 /// threads. `addResource`/`acquireResource`, `deliver`, `shutdown`, and `abort` are thread-safe;
 /// `publisher` and `subscribe` are wiring-time operations and are not safe against concurrent
@@ -63,6 +70,9 @@ public:
   /// Subscriber invoked once per delivered consignment, synchronously on the publishing thread.
   using ConsignmentCallback = std::function<void(Consignment)>;
 
+  /// File name, inside the working directory, of the Unix socket @ref share offers topics on.
+  static constexpr auto kBrokerSocketName = "broker.sock";
+
   /// The run's data sources, torn down first.
   using Drivers = std::vector<std::shared_ptr<Driver>>;
 
@@ -182,7 +192,8 @@ public:
   [[nodiscard]] std::filesystem::path acquireResource(const std::filesystem::path& source) const;
 
   /// @brief Open a publisher for @p topic carrying messages of @p Schema, recording the topic to
-  /// the run's `topics.json` and the schema's closure to its `schemas.bin`.
+  /// the run's `topics.json` and the schema's closure to its `schemas.bin`. On a run that does not
+  /// record, its messages go to a channel kept in memory.
   ///
   /// A `(Schema, topic)` pair is one channel, and a channel takes a single publisher: chronicle
   /// channels are single-producer, so opening a second publisher for a channel already opened on
@@ -190,28 +201,54 @@ public:
   ///
   /// @tparam Schema The Cap'n Proto payload schema. Must be supplied explicitly.
   ///
-  /// @throws std::logic_error if this run does not record a chronicle.
-  ///
   /// @throws std::runtime_error if a publisher is already open for this channel.
   template<typename Schema>
   [[nodiscard]] Publisher<Schema> publisher(const std::string_view& topic)
   {
-    if(mWriter == nullptr)
-    {
-      common::throwException<std::logic_error>(
-          "Port::publisher requires a recording run; this run does not record");
-    }
+    const auto channelId = recordTopic<Schema>(topic);
+    return Publisher<Schema>{
+        *this,
+        mWriter ? mWriter->channel(channelId) : mMemoryWriter->channel(channelId)};
+  }
 
-    const auto channelId = chronicle::makeChannelId(kSchemaId<Schema>, topic);
-    mActiveTopicRegistry.record(
-        channelId,
-        std::string{topic},
-        kSchemaId<Schema>,
-        std::string{common::prettyName<Schema>()});
-    mActiveSchemaRegistry.record<Schema>();
-    return Publisher<Schema>{*this, mWriter->channel(channelId)};
+  /// @brief Share @p topic's messages of @p Schema with RemotePorts in other processes, which read
+  /// them in place from this run's chronicle rather than receiving copies.
+  ///
+  /// The first call starts the run's chronicle::Broker on @ref brokerPath. Call at wiring time,
+  /// before the topic's first publish; sharing a topic twice has no effect.
+  ///
+  /// @tparam Schema The Cap'n Proto payload schema. Must be supplied explicitly.
+  ///
+  /// @throws std::logic_error if this run does not record a chronicle.
+  ///
+  /// @throws std::invalid_argument if the working directory's path is too long for a Unix socket.
+  template<typename Schema>
+  void share(const std::string_view& topic)
+  {
+    shareChannel(chronicle::makeChannelId(kSchemaId<Schema>, topic));
+  }
+
+  /// @brief Stream @p topic's messages of @p Schema to the BridgeDriver listening on @p host at
+  /// @p port, another run typically on another host.
+  ///
+  /// Each message is sent straight from its chronicle roll to the socket (see
+  /// chronicle::BridgeSender). The first call for an endpoint connects to it; every topic forwarded
+  /// to one endpoint shares its connection. Call at wiring time, before the topic's first publish.
+  ///
+  /// @tparam Schema The Cap'n Proto payload schema. Must be supplied explicitly.
+  ///
+  /// @throws std::logic_error if this run does not record a chronicle.
+  ///
+  /// @throws std::runtime_error if the endpoint cannot be connected to.
+  template<typename Schema>
+  void forward(const std::string_view& topic, const std::string& host, const std::uint16_t port)
+  {
+    forwardChannel(chronicle::makeChannelId(kSchemaId<Schema>, topic), host, port);
   }
 
+  /// Path of the Unix socket RemotePorts connect to; nothing listens there until @ref share.
+  [[nodiscard]] std::filesystem::path brokerPath() const;
+
   /// @brief Register @p callback to receive every crate delivered on @p channelId.
   ///
   /// Multiple callbacks may subscribe to one channel; each is invoked in registration order. Call
@@ -286,6 +323,17 @@ private:
   /// The chronicle writer for a recording run; null when the run does not record.
   const std::unique_ptr<chronicle::Writer> mWriter;
 
+  /// The channels a run that does not record publishes through; null when the run records.
+  const std::unique_ptr<chronicle::MemoryWriter> mMemoryWriter;
+
+  /// Shares the chronicle's shared topics with RemotePorts; null until the first @ref share.
+  /// Declared after @ref mWriter so it stops before the writer closes.
+  std::unique_ptr<chronicle::Broker> mBroker;
+
+  /// The bridges @ref forward streams topics over, keyed by `host:port`. Declared after
+  /// @ref mWriter so they drain before the writer closes.
+  std::unordered_map<std::string, std::unique_ptr<chronicle::BridgeSender>> mBridges;
+
   /// The added resources, guarded for concurrent @ref addResource and @ref acquireResource.
   common::Locked<ResourceMap> mLockedResourceMap;
 
@@ -323,6 +371,30 @@ private:
   Runners mRunners;
   Components mComponents;
   Drivers mDrivers;
+
+  /// @brief Offer @p channelId through the run's Broker, starting it on first use.
+  void shareChannel(ChannelId channelId);
+
+  /// @brief Stream @p channelId over the bridge to @p host at @p port, connecting on first use.
+  void forwardChannel(ChannelId channelId, const std::string& host, std::uint16_t port);
+
+  /// @brief Record @p topic of @p Schema to the run's topic and schema registries, returning its
+  /// channel.
+  template<typename Schema>
+  ChannelId recordTopic(const std::string_view& topic)
+  {
+    const auto channelId = chronicle::makeChannelId(kSchemaId<Schema>, topic);
+    mActiveTopicRegistry.record(
+        channelId,
+        std::string{topic},
+        kSchemaId<Schema>,
+        std::string{common::prettyName<Schema>()});
+    mActiveSchemaRegistry.record<Schema>();
+    return channelId;
+  }
+
+  // A BridgeDriver records what it receives on the run's chronicle, under the topics it declares.
+  friend class BridgeDriver;
 };
 
 } // namespace nioc::terminus
@@ -8,8 +8,10 @@
 #include "draft.hpp"
 #include "message.hpp"
 #include "port.hpp"
+#include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <nioc/chronicle/channel.hpp>
 #include <utility>
 
@@ -32,8 +34,12 @@ namespace nioc::terminus
 ///     publisher.publish(msg);
 ///
 /// Get one from `Port::publisher`; the constructor is private. Holds its `Port` and channel by
-/// reference, so it must not outlive either. Single-threaded: do not share a Publisher across
-/// threads.
+/// reference, so it must not outlive either.
+///
+/// Thread-safe: a pool of workers may draft and publish through one Publisher at once. Sequence
+/// numbers are drawn atomically, so the messages drafted across all threads are numbered
+/// 1, 2, 3, ... without a gap or a repeat; each thread's are increasing, but threads committing
+/// concurrently may record theirs interleaved out of numeric order. Not copyable or movable.
 ///
 /// @tparam Schema_ The Cap'n Proto schema of the published payload.
 ///
@@ -44,6 +50,16 @@ class Publisher
 public:
   using Schema = Schema_;
 
+  Publisher(const Publisher&) = delete;
+
+  Publisher(Publisher&&) noexcept = delete;
+
+  ~Publisher() = default;
+
+  Publisher& operator=(const Publisher&) = delete;
+
+  Publisher& operator=(Publisher&&) noexcept = delete;
+
   /// @brief Begin a new outgoing message, returning a `Draft` to populate then seal.
   ///
   /// The draft comes pre-stamped with the next sequence number and the current steady-clock arrival
@@ -54,13 +70,16 @@ public:
   /// running estimate; any non-zero value requests exactly that many bytes, which the channel
   /// rounds up to a word boundary.
   ///
+  /// Thread-safe.
+  ///
   /// @see Draft
   [[nodiscard]] Draft<Schema> draft(const std::size_t reservationOverride = 0U)
   {
     const auto arrivalTimestamp = std::chrono::steady_clock::now();
-    const auto sequenceNumber = ++mSequenceNumber;
+    const auto sequenceNumber = mSequenceNumber.fetch_add(1U, std::memory_order_relaxed) + 1U;
+    const auto estimate = mSizeEstimate.load(std::memory_order_relaxed);
     const auto size = reservationOverride == 0U
-                          ? static_cast<std::size_t>(mSizeEstimate * kHysteresis) + 1
+                          ? static_cast<std::size_t>(estimate * kHysteresis) + 1
                           : reservationOverride;
 
     return Draft<Schema>{mChannel.reserve(size), arrivalTimestamp, sequenceNumber};
@@ -71,7 +90,7 @@ public:
   ///
   /// The message's bytes were already recorded to the channel when its draft was sealed; this only
   /// delivers to subscribers and folds the message size into the estimate that future `draft` calls
-  /// use to size reservations.
+  /// use to size reservations. Thread-safe.
   ///
   /// @param message Must have been built by this Publisher's `draft`, so its sequence numbering
   /// stays consistent.
@@ -102,10 +121,10 @@ private:
 
   /// The largest payload size seen so far, in bytes, used to auto-size the next draft's
   /// reservation.
-  std::size_t mSizeEstimate{kInitialReservationSize};
+  std::atomic<std::size_t> mSizeEstimate{kInitialReservationSize};
 
-  /// The sequence number of the most recently drafted message; pre-incremented per draft.
-  std::uint64_t mSequenceNumber{0U};
+  /// The sequence number of the most recently drafted message; incremented atomically per draft.
+  std::atomic<std::uint64_t> mSequenceNumber{0U};
 
   /// @brief Construct a Publisher bound to a port and channel; called only by `Port::publisher`.
   ///
@@ -122,7 +141,12 @@ private:
   /// @param size A published payload size in bytes.
   void updateSizeEstimate(const std::size_t size) noexcept
   {
-    mSizeEstimate = std::max(mSizeEstimate, size);
+    auto estimate = mSizeEstimate.load(std::memory_order_relaxed);
+    while(size > estimate and
+          not mSizeEstimate.compare_exchange_weak(estimate, size, std::memory_order_relaxed))
+    {
+      // Another thread moved the estimate; estimate now holds its value, so compare again.
+    }
   }
 };
 
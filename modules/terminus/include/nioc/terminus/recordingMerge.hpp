@@ -0,0 +1,45 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <filesystem>
+#include <vector>
+
+namespace nioc::terminus
+{
+
+/// @brief Combine the recordings at @p recordings, such as those of one stack run on several hosts
+/// or in several processes, into one recording at @p destination.
+///
+/// The chronicles are merged by each message's envelope arrival timestamp (see chronicle::merge),
+/// so a replay of the combined recording delivers every message in the order it arrived. Arrival
+/// timestamps are read on each process's own steady clock, so they are first aligned to the wall
+/// clock each recording's Writer stamped its commits with. The payload rolls are linked, not
+/// copied. The `topics.json` and `schemas.bin` of the recordings are unioned.
+///
+/// The other run artifacts, such as configs, resources, and console logs, stay with the sources.
+///
+/// Example:
+///
+///     nioc::terminus::mergeRecordings({"/runs/rigA", "/runs/rigB"}, "/runs/rigAB");
+///     // ... then play back /runs/rigAB like any other recording.
+///
+/// @param recordings Recording directories, each holding a `chronicle` directory.
+///
+/// @param destination Directory to create the combined recording in; must be absent or empty.
+///
+/// @throws std::invalid_argument If a recording does not exist or is not a directory, or
+/// @p destination holds anything.
+///
+/// @throws std::runtime_error If two recordings carry different topics on one channel, or a file
+/// cannot be mapped, created, or written.
+///
+/// @see chronicle::merge, TopicRegistry::merge, SchemaRegistry::adopt
+void mergeRecordings(
+    const std::vector<std::filesystem::path>& recordings,
+    const std::filesystem::path& destination);
+
+} // namespace nioc::terminus
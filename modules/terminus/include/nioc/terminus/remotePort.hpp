@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "message.hpp"
+#include "schemaId.hpp"
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <nioc/chronicle/crate.hpp>
+#include <nioc/chronicle/defines.hpp>
+#include <nioc/chronicle/subscriber.hpp>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace nioc::terminus
+{
+
+/// @brief The read end of topics a Port in another process shares: hands each of their messages to
+/// callbacks on the thread that polls, zero-copy.
+///
+/// Example:
+///
+///     auto remote = RemotePort{"/data/run42/broker.sock"}; // the other run's Port::brokerPath
+///     remote.subscribe<MySchema>("my/topic", [](const Message<MySchema>& msg) { use(msg); });
+///     while(not remote.closed())
+///     {
+///       remote.poll(std::chrono::milliseconds{100});
+///     }
+///
+/// Each message is read in place from the publishing run's chronicle roll, which the other process
+/// passes over once per roll and this one maps read-only (see chronicle::Broker). Only messages
+/// published after a subscription reaches the other process arrive; a RemotePort that polls too
+/// rarely misses some.
+///
+/// Not copyable or movable. Not thread-safe: subscribe and poll from one thread.
+///
+/// @see Port::share, chronicle::Subscriber
+class RemotePort
+{
+public:
+  /// Callback invoked once per received message of @p Schema, on the polling thread.
+  template<typename Schema>
+  using MessageCallback = std::function<void(const Message<Schema>&)>;
+
+  /// @brief Connect to the Port sharing topics on the Unix socket at @p socketPath.
+  ///
+  /// @throws std::runtime_error if nothing shares topics there.
+  explicit RemotePort(std::filesystem::path socketPath);
+
+  RemotePort(const RemotePort&) = delete;
+
+  RemotePort(RemotePort&&) noexcept = delete;
+
+  ~RemotePort() = default;
+
+  RemotePort& operator=(const RemotePort&) = delete;
+
+  RemotePort& operator=(RemotePort&&) noexcept = delete;
+
+  /// @brief Register @p callback to receive every message of @p Schema published on @p topic from
+  /// now on. Multiple callbacks on one topic are invoked in registration order.
+  ///
+  /// @tparam Schema The Cap'n Proto payload schema. Must be supplied explicitly.
+  ///
+  /// @throws std::runtime_error if the other process cannot be reached.
+  template<typename Schema>
+  void subscribe(const std::string_view& topic, MessageCallback<Schema> callback)
+  {
+    const auto channelId = chronicle::makeChannelId(kSchemaId<Schema>, topic);
+    auto& callbacks = mCallbackMap[channelId];
+    if(callbacks.empty())
+    {
+      mSubscriber.subscribe(channelId);
+    }
+    callbacks.emplace_back(
+        [callback = std::move(callback)](const chronicle::Crate& crate)
+        { std::invoke(callback, Message<Schema>{crate}); });
+  }
+
+  /// @brief Deliver the messages received, waiting up to @p timeout for the first one.
+  ///
+  /// @return The number of messages delivered.
+  ///
+  /// @throws std::runtime_error if a notice from the other process is malformed.
+  std::size_t poll(std::chrono::nanoseconds timeout);
+
+  /// @brief Whether the other process stopped sharing; poll delivers nothing more.
+  [[nodiscard]] bool closed() const noexcept;
+
+private:
+  /// Delivers the crate of one received message to one typed callback.
+  using CrateCallback = std::function<void(const chronicle::Crate&)>;
+
+  /// Maps each subscribed channel to its callbacks, in registration order.
+  using CallbackMap = std::unordered_map<chronicle::ChannelId, std::vector<CrateCallback>>;
+
+  /// The connection to the other process's chronicle::Broker.
+  chronicle::Subscriber mSubscriber;
+
+  /// The callbacks registered per channel, consulted by @ref poll.
+  CallbackMap mCallbackMap;
+};
+
+} // namespace nioc::terminus
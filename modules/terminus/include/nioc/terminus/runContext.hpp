@@ -40,18 +40,19 @@ public:
   /// @brief Return the Boost.ProgramOptions description for the flags this class understands, so a
   /// caller can merge them into its own option set before parsing the command line.
   ///
-  /// Defines `--log-root`, `--record-chronicle`, `--append-resource`, `--append-config`, and
-  /// `--config-override` (each with a default), plus the optional `--playback`. Feed the parsed
+  /// Defines `--log-root`, `--record-chronicle`, `--direct-io`, `--append-resource`,
+  /// `--append-config`, and `--config-override` (each with a default), plus the optional
+  /// `--playback`. Feed the parsed
   /// result into the @ref RunContext constructor that takes a variables_map.
   [[nodiscard]] static boost::program_options::options_description cliOptions();
 
   /// @brief Construct from a parsed option map produced against @ref cliOptions, minting and
   /// creating a fresh working directory under `--log-root`.
   ///
-  /// @param variableMap Must contain `log-root`, `record-chronicle`, `append-resource`,
-  /// `append-config`, and `config-override` (the @ref cliOptions defaults guarantee this when
-  /// parsed normally). The optional `playback` and `commandLine` entries are read only when
-  /// present.
+  /// @param variableMap Must contain `log-root`, `record-chronicle`, `direct-io`,
+  /// `append-resource`, `append-config`, and `config-override` (the @ref cliOptions defaults
+  /// guarantee this when parsed normally). The optional `playback` and `commandLine` entries are
+  /// read only when present.
   ///
   /// @throws std::out_of_range If a required entry is missing.
   ///
@@ -77,6 +78,9 @@ public:
   /// none.
   ///
   /// @param configOverrides `path.to.key=value` entries applied after the files. Defaults to none.
+  ///
+  /// @param directIo Whether the chronicle writes its rolls with direct I/O rather than through the
+  /// page cache (see chronicle::Writeback). Defaults to false.
   RunContext(
       std::filesystem::path workingDir,
       std::vector<std::filesystem::path> resourcePaths,
@@ -84,7 +88,8 @@ public:
       std::string commandLine,
       std::filesystem::path inputLog = {},
       std::vector<std::filesystem::path> appendConfigPaths = {},
-      std::vector<std::string> configOverrides = {});
+      std::vector<std::string> configOverrides = {},
+      bool directIo = false);
 
   RunContext(const RunContext&) = delete;
 
@@ -105,6 +110,10 @@ public:
   /// @brief Whether to record the chronicle time-series data stream.
   [[nodiscard]] bool recordChronicle() const noexcept;
 
+  /// @brief Whether the chronicle writes its rolls with direct I/O rather than through the page
+  /// cache.
+  [[nodiscard]] bool directIo() const noexcept;
+
   /// @brief The invocation arguments joined into one string; empty if none was supplied.
   [[nodiscard]] const std::string& commandLine() const noexcept;
 
@@ -148,6 +157,9 @@ private:
   /// Whether to record the chronicle time-series data stream.
   bool mRecordChronicle;
 
+  /// Whether the chronicle writes its rolls with direct I/O.
+  bool mDirectIo;
+
   /// This run's assembled overrides. Declared last so it is built from the config-layer members
   /// above, which are already initialized by the time its construction assembles and validates it.
   ConfigOverlay mConfigOverlay;
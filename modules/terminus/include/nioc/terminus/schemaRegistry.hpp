@@ -81,6 +81,15 @@ public:
     mLoader.loadCompiledTypeAndDependencies<Schema>();
   }
 
+  /// @brief Load the schemas of the recording at @p recording on top of those already recorded, as
+  /// merging two recordings unions their schemas.
+  ///
+  /// Behaves as the loading constructor does, and arbitrates a schema recorded in both the same way
+  /// (see the class doc).
+  ///
+  /// @param recording Path to a recording directory, or an empty path.
+  void adopt(const std::filesystem::path& recording);
+
   /// @brief Write the recorded closure to `schemas.bin` under @p directory.
   ///
   /// @param directory An existing directory to write into.
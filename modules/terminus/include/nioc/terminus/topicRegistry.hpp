@@ -133,6 +133,16 @@ public:
       std::uint64_t schemaId,
       std::string schemaName);
 
+  /// @brief Enter every topic of @p other not already recorded, as merging two recordings unions
+  /// their topics.
+  ///
+  /// A topic recorded in both is entered once. Unlike @ref record, the same topic on the same
+  /// channel is expected here: recordings of one stack carry the same topics.
+  ///
+  /// @throws std::runtime_error If a channel of @p other carries a different topic here; nothing
+  /// is entered then.
+  void merge(const TopicRegistry& other);
+
   /// @brief Write the record to `topics.json` under @p directory, ordered by topic name so the file
   /// is stable across runs.
   ///
@@ -0,0 +1,62 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <nioc/common/exception.hpp>
+#include <nioc/terminus/bridgeDriver.hpp>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace nioc::terminus
+{
+namespace
+{
+
+/// How long one tick waits for a message; short, so shutdown is noticed promptly.
+constexpr auto kPollInterval = std::chrono::milliseconds{50};
+
+} // namespace
+
+BridgeDriver::BridgeDriver(std::string name, Port& port, const std::uint16_t listenPort):
+  Driver{std::move(name), port},
+  mReceiver{recordingWriter(port), listenPort}
+{
+}
+
+std::uint16_t BridgeDriver::listenPort() const noexcept
+{
+  return mReceiver.port();
+}
+
+chronicle::Writer& BridgeDriver::recordingWriter(Port& port)
+{
+  if(port.mWriter == nullptr)
+  {
+    common::throwException<std::logic_error>(
+        "BridgeDriver requires a recording run; this run does not record");
+  }
+  return *port.mWriter;
+}
+
+BridgeDriver::State BridgeDriver::run()
+{
+  if(shutdownToken().stop_requested())
+  {
+    return State::Done;
+  }
+
+  const auto entry = mReceiver.next(kPollInterval);
+  if(not entry)
+  {
+    return State::Waiting;
+  }
+
+  port().deliver(entry->mChannelId, entry->mCrate);
+  return State::Continue;
+}
+
+} // namespace nioc::terminus
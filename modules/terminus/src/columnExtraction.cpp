@@ -0,0 +1,266 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <capnp/schema.h>
+#include <capnp/serialize.h>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <nioc/chronicle/parallelScan.hpp>
+#include <nioc/common/exception.hpp>
+#include <nioc/common/filesystem.hpp>
+#include <nioc/containers/mmapArray.hpp>
+#include <nioc/terminus/arenaMessageBuilder.hpp>
+#include <nioc/terminus/columnExtraction.hpp>
+#include <nioc/terminus/idl/envelope.capnp.h>
+#include <nioc/terminus/schemaRegistry.hpp>
+#include <nioc/terminus/topicRegistry.hpp>
+#include <nioc/terminus/utils.hpp>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace nioc::terminus
+{
+namespace fs = std::filesystem;
+
+namespace
+{
+
+/// The directory a recording keeps its chronicle in.
+constexpr auto kChronicleDirName = "chronicle";
+
+/// The column the envelope arrival timestamps are written to.
+constexpr auto kArrivalTimestampFileName = "arrivalTimestamp.i64";
+
+/// The element type a field's column is written in.
+enum class ColumnType
+{
+  Float64,
+  Int64,
+  UInt64
+};
+
+/// The value a gap in the topic leaves in a column of @p Value: NaN where there is one, else the
+/// lowest value, which no real reading of a sensor or clock takes.
+template<typename Value>
+constexpr auto kGapValue = std::numeric_limits<Value>::has_quiet_NaN
+                               ? std::numeric_limits<Value>::quiet_NaN()
+                               : std::numeric_limits<Value>::lowest();
+
+/// One field's column and the extractor that reads the field off a payload.
+template<typename Value>
+struct TypedColumn
+{
+  containers::MmapArray<Value> mValues;
+  std::function<Value(capnp::AnyPointer::Reader)> mExtract;
+
+  /// Write the field of the message in @p envelope to @p row, or the gap value if it has none.
+  void fill(const std::uint64_t row, const Envelope<>::Reader envelope)
+  {
+    mValues[row] = envelope.hasMessage() ? mExtract(envelope.getMessage()) : kGapValue<Value>;
+  }
+};
+
+using Column =
+    std::variant<TypedColumn<double>, TypedColumn<std::int64_t>, TypedColumn<std::uint64_t>>;
+
+/// The column type the leaf of @p fieldPath through @p schema is written in.
+///
+/// @throws std::invalid_argument If the path names no field, or a field that is not numeric.
+ColumnType columnTypeOf(const capnp::StructSchema schema, const std::string_view fieldPath)
+{
+  const auto chain = buildFieldNodeChain(schema, fieldPath);
+  if(not chain.has_value())
+  {
+    common::throwException<std::invalid_argument>(
+        "Schema '{}' carries no field '{}'.",
+        schema.getShortDisplayName().cStr(),
+        fieldPath);
+  }
+
+  switch(chain->back().getType().which())
+  {
+    case capnp::schema::Type::INT64:
+      return ColumnType::Int64;
+    case capnp::schema::Type::UINT64:
+      return ColumnType::UInt64;
+    case capnp::schema::Type::INT8:
+    case capnp::schema::Type::INT16:
+    case capnp::schema::Type::INT32:
+    case capnp::schema::Type::UINT8:
+    case capnp::schema::Type::UINT16:
+    case capnp::schema::Type::UINT32:
+    case capnp::schema::Type::FLOAT32:
+    case capnp::schema::Type::FLOAT64:
+      return ColumnType::Float64;
+    default:
+      break;
+  }
+  common::throwException<std::invalid_argument>(
+      "Field '{}' of schema '{}' is not numeric, so it cannot be written to a column.",
+      fieldPath,
+      schema.getShortDisplayName().cStr());
+}
+
+/// The file name of the column holding @p fieldPath as @p type.
+std::string columnFileName(const std::string_view fieldPath, const ColumnType type)
+{
+  switch(type)
+  {
+    case ColumnType::Int64:
+      return std::string{fieldPath} + ".i64";
+    case ColumnType::UInt64:
+      return std::string{fieldPath} + ".u64";
+    case ColumnType::Float64:
+      break;
+  }
+  return std::string{fieldPath} + ".f64";
+}
+
+template<typename Value>
+TypedColumn<Value> makeColumn(
+    const fs::path& file,
+    const std::uint64_t rowCount,
+    const capnp::StructSchema schema,
+    const std::string_view fieldPath)
+{
+  // The path was resolved by columnTypeOf already, so the extractor is there.
+  return TypedColumn<Value>{
+      containers::MmapArray<Value>{file, rowCount},
+      std::move(*dynamicFieldExtractor<Value>(schema, fieldPath))};
+}
+
+Column openColumn(
+    const fs::path& file,
+    const std::uint64_t rowCount,
+    const ColumnType type,
+    const capnp::StructSchema schema,
+    const std::string_view fieldPath)
+{
+  switch(type)
+  {
+    case ColumnType::Int64:
+      return makeColumn<std::int64_t>(file, rowCount, schema, fieldPath);
+    case ColumnType::UInt64:
+      return makeColumn<std::uint64_t>(file, rowCount, schema, fieldPath);
+    case ColumnType::Float64:
+      break;
+  }
+  return makeColumn<double>(file, rowCount, schema, fieldPath);
+}
+
+/// Create @p file empty, as a column of no rows; a mapping cannot be zero bytes long.
+void createEmptyColumn(const fs::path& file)
+{
+  auto stream = std::ofstream{file, std::ios::binary | std::ios::trunc};
+  if(not stream)
+  {
+    common::throwException<std::runtime_error>("Could not create column '{}'.", file.string());
+  }
+}
+
+} // namespace
+
+std::uint64_t extractColumns(
+    const fs::path& recording,
+    const std::string_view topic,
+    const std::vector<std::string>& fieldPaths,
+    const fs::path& outputDir,
+    const std::size_t workerCount)
+{
+  const auto root = common::requireExistingDirectory(recording);
+  const auto topics = TopicRegistry{root};
+  const auto match = std::ranges::find(topics, topic, &Topic::mName);
+  if(match == topics.end())
+  {
+    common::throwException<std::invalid_argument>(
+        "Recording '{}' carries no topic '{}'.",
+        root.string(),
+        topic);
+  }
+
+  const auto schemas = SchemaRegistry{root};
+  if(not schemas.contains(match->mSchemaId))
+  {
+    common::throwException<std::runtime_error>(
+        "Recording '{}' ships no schema '{}' for topic '{}'.",
+        root.string(),
+        match->mSchemaName,
+        topic);
+  }
+  const auto schema = schemas.at(match->mSchemaId);
+
+  // Every path is resolved before anything is written, so a typo leaves no partial output.
+  auto types = std::vector<ColumnType>{};
+  for(const auto& fieldPath: fieldPaths)
+  {
+    types.push_back(columnTypeOf(schema, fieldPath));
+  }
+
+  const auto scan =
+      chronicle::ParallelScan{root / kChronicleDirName, {match->mChannelId}, workerCount};
+  const auto rowCount = scan.size();
+  fs::create_directories(outputDir);
+  if(rowCount == 0ULL)
+  {
+    createEmptyColumn(outputDir / kArrivalTimestampFileName);
+    for(auto index = std::size_t{0}; index < fieldPaths.size(); ++index)
+    {
+      createEmptyColumn(outputDir / columnFileName(fieldPaths.at(index), types.at(index)));
+    }
+    return 0ULL;
+  }
+
+  auto arrivals =
+      containers::MmapArray<std::int64_t>{outputDir / kArrivalTimestampFileName, rowCount};
+  auto columns = std::vector<Column>{};
+  columns.reserve(fieldPaths.size());
+  for(auto index = std::size_t{0}; index < fieldPaths.size(); ++index)
+  {
+    const auto& fieldPath = fieldPaths.at(index);
+    const auto type = types.at(index);
+    columns.push_back(
+        openColumn(outputDir / columnFileName(fieldPath, type), rowCount, type, schema, fieldPath));
+  }
+
+  // Shards cover consecutive rows, so each worker writes its own stretch of every column and none
+  // needs a lock.
+  const auto fillShard = [&scan, &arrivals, &columns](
+                             const std::size_t shardIndex,
+                             const chronicle::ParallelScan::Shard shard)
+  {
+    auto row = scan.shardBegin(shardIndex);
+    for(const auto& entry: shard)
+    {
+      auto reader = capnp::FlatArrayMessageReader{asWords(entry.mCrate.span())};
+      const auto envelope = reader.getRoot<Envelope<>>();
+      arrivals[row] = envelope.getArrivalTimestamp();
+      for(auto& column: columns)
+      {
+        std::visit([row, envelope](auto& typed) { typed.fill(row, envelope); }, column);
+      }
+      ++row;
+    }
+  };
+  scan.forEachShard(fillShard);
+
+  arrivals.sync();
+  for(const auto& column: columns)
+  {
+    std::visit([](const auto& typed) { typed.mValues.sync(); }, column);
+  }
+  return rowCount;
+}
+
+} // namespace nioc::terminus
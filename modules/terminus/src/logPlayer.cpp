@@ -11,11 +11,24 @@
 
 namespace nioc::terminus
 {
+namespace
+{
+
+/// Configure @p reader for replay before its cursor reads the first record: prefetch ahead, and
+/// drop records that fail their checksum rather than deliver corrupt frames downstream.
+chronicle::Reader::Iterator startReplay(chronicle::Reader& reader)
+{
+  reader.setReadAhead(chronicle::Reader::kDefaultReadAhead);
+  reader.setChecksumVerification(true);
+  return reader.begin();
+}
+
+} // namespace
 
 LogPlayer::LogPlayer(std::string name, Port& port, std::filesystem::path inputLog):
   Driver{std::move(name), port},
   mReader{std::move(inputLog)},
-  mCursor{mReader.begin()}
+  mCursor{startReplay(mReader)}
 {
 }
 
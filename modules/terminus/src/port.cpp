@@ -6,9 +6,14 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <format>
 #include <functional>
 #include <memory>
+#include <nioc/chronicle/bridgeSender.hpp>
+#include <nioc/chronicle/broker.hpp>
+#include <nioc/chronicle/memoryWriter.hpp>
 #include <nioc/chronicle/writer.hpp>
 #include <nioc/common/exception.hpp>
 #include <nioc/common/sleep.hpp>
@@ -33,15 +38,36 @@ namespace fs = std::filesystem;
 namespace
 {
 
-std::unique_ptr<chronicle::Writer> makeWriter(const fs::path& workingDir, const bool record)
+/// Roll capacity of a chronicle written with direct I/O, whose active rolls are staged in memory
+/// until sealed: far below the default, which suits mapped rolls.
+constexpr auto kDirectRollCapacity = std::size_t{256} << 20U;
+
+std::unique_ptr<chronicle::Writer> makeWriter(const RunContext& runContext)
 {
-  if(not record)
+  if(not runContext.recordChronicle())
   {
     return nullptr;
   }
-  const auto dir = workingDir / "chronicle";
+  const auto dir = runContext.workingDir() / "chronicle";
   fs::create_directories(dir);
-  return std::make_unique<chronicle::Writer>(dir);
+  if(not runContext.directIo())
+  {
+    return std::make_unique<chronicle::Writer>(dir);
+  }
+  return std::make_unique<chronicle::Writer>(
+      dir,
+      chronicle::WriterOptions{
+          .mRollCapacity = kDirectRollCapacity,
+          .mWriteback = {.mMode = containers::WriteMode::Direct}});
+}
+
+std::unique_ptr<chronicle::MemoryWriter> makeMemoryWriter(const RunContext& runContext)
+{
+  if(runContext.recordChronicle())
+  {
+    return nullptr;
+  }
+  return std::make_unique<chronicle::MemoryWriter>();
 }
 
 spdlog::sink_ptr attachLogFileSink(
@@ -118,7 +144,8 @@ void writeResources(
 Port::Port(RunContext runContext, const Setup& setup):
   mRunContext{std::move(runContext)},
   mConsoleLogSink{attachLogFileSink(mRunContext.workingDir() / "console.log")},
-  mWriter{makeWriter(mRunContext.workingDir(), mRunContext.recordChronicle())},
+  mWriter{makeWriter(mRunContext)},
+  mMemoryWriter{makeMemoryWriter(mRunContext)},
   mLockedResourceMap{copyResources(mRunContext.resourcePaths(), mRunContext.workingDir())},
   mPlaybackTopicRegistry{mRunContext.inputLog()},
   mPlaybackSchemaRegistry{mRunContext.inputLog()}
@@ -218,6 +245,11 @@ fs::path Port::acquireResource(const fs::path& source) const
       { return mRunContext.workingDir() / resourceMap.at(source.string()); });
 }
 
+std::filesystem::path Port::brokerPath() const
+{
+  return mRunContext.workingDir() / kBrokerSocketName;
+}
+
 void Port::subscribe(const ChannelId channelId, ConsignmentCallback callback)
 {
   mSubscriptionMap[channelId].push_back(std::move(callback));
@@ -297,4 +329,40 @@ void Port::deliver(const ChannelId channelId, const chronicle::Crate& crate) con
   }
 }
 
+void Port::shareChannel(const ChannelId channelId)
+{
+  if(mWriter == nullptr)
+  {
+    common::throwException<std::logic_error>(
+        "Port::share requires a recording run; this run does not record");
+  }
+
+  if(mBroker == nullptr)
+  {
+    mBroker = std::make_unique<chronicle::Broker>(*mWriter, brokerPath());
+    logger::info("Sharing topics on {}.", mBroker->path().string());
+  }
+  mBroker->share(channelId);
+}
+
+void Port::forwardChannel(
+    const ChannelId channelId,
+    const std::string& host,
+    const std::uint16_t port)
+{
+  if(mWriter == nullptr)
+  {
+    common::throwException<std::logic_error>(
+        "Port::forward requires a recording run; this run does not record");
+  }
+
+  auto& bridge = mBridges[std::format("{}:{}", host, port)];
+  if(bridge == nullptr)
+  {
+    bridge = std::make_unique<chronicle::BridgeSender>(*mWriter, host, port);
+    logger::info("Forwarding topics to {}:{}.", host, port);
+  }
+  bridge->forward(channelId);
+}
+
 } // namespace nioc::terminus
@@ -0,0 +1,63 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <capnp/serialize.h>
+#include <cstdint>
+#include <filesystem>
+#include <nioc/chronicle/merge.hpp>
+#include <nioc/common/filesystem.hpp>
+#include <nioc/terminus/arenaMessageBuilder.hpp>
+#include <nioc/terminus/idl/envelope.capnp.h>
+#include <nioc/terminus/recordingMerge.hpp>
+#include <nioc/terminus/schemaRegistry.hpp>
+#include <nioc/terminus/topicRegistry.hpp>
+#include <vector>
+
+namespace nioc::terminus
+{
+namespace fs = std::filesystem;
+
+namespace
+{
+
+/// The directory a recording keeps its chronicle in.
+constexpr auto kChronicleDirName = "chronicle";
+
+/// The steady-clock instant the message in @p entry arrived at, read off its envelope.
+std::int64_t arrivalTimestamp(const chronicle::Entry& entry)
+{
+  auto reader = capnp::FlatArrayMessageReader{asWords(entry.mCrate.span())};
+  return reader.getRoot<Envelope<>>().getArrivalTimestamp();
+}
+
+} // namespace
+
+void mergeRecordings(const std::vector<fs::path>& recordings, const fs::path& destination)
+{
+  if(fs::exists(destination))
+  {
+    static_cast<void>(common::requireEmptyDirectory(destination));
+  }
+
+  // The topics are checked first: recordings that disagree on a channel cannot be merged, and
+  // finding out costs nothing next to the chronicles.
+  auto topics = TopicRegistry{};
+  auto schemas = SchemaRegistry{};
+  auto chronicles = std::vector<fs::path>{};
+  for(const auto& recording: recordings)
+  {
+    const auto root = common::requireExistingDirectory(recording);
+    topics.merge(TopicRegistry{root});
+    schemas.adopt(root);
+    chronicles.push_back(root / kChronicleDirName);
+  }
+
+  chronicle::merge(chronicles, destination / kChronicleDirName, arrivalTimestamp);
+  topics.write(destination);
+  schemas.write(destination);
+}
+
+} // namespace nioc::terminus
@@ -0,0 +1,47 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <functional>
+#include <nioc/terminus/remotePort.hpp>
+#include <utility>
+
+namespace nioc::terminus
+{
+
+RemotePort::RemotePort(std::filesystem::path socketPath): mSubscriber{std::move(socketPath)}
+{
+}
+
+std::size_t RemotePort::poll(const std::chrono::nanoseconds timeout)
+{
+  auto delivered = std::size_t{0};
+  auto wait = timeout;
+  while(const auto entry = mSubscriber.next(wait))
+  {
+    // Whatever else is already in is delivered too, without waiting for more.
+    wait = std::chrono::nanoseconds::zero();
+    const auto callbacks = mCallbackMap.find(entry->mChannelId);
+    if(callbacks == mCallbackMap.end())
+    {
+      continue;
+    }
+
+    for(const auto& callback: callbacks->second)
+    {
+      std::invoke(callback, entry->mCrate);
+    }
+    ++delivered;
+  }
+  return delivered;
+}
+
+bool RemotePort::closed() const noexcept
+{
+  return mSubscriber.closed();
+}
+
+} // namespace nioc::terminus
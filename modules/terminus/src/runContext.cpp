@@ -93,6 +93,12 @@ po::options_description RunContext::cliOptions()
     po::value<bool>()->default_value(true),
     "Whether to record the chronicle time-series data stream. Pass false to skip it"
   )
+  (
+    "direct-io",
+    po::value<bool>()->default_value(false),
+    "Whether to write the chronicle's rolls with direct I/O, bypassing the page cache. Suits large "
+    "sequential writes to fast storage; the chronicle cannot be tailed while it is recorded"
+  )
   (
     "append-resource",
     po::value<std::vector<std::string>>()->composing()->default_value({}, ""),
@@ -130,7 +136,8 @@ RunContext::RunContext(const po::variables_map& variableMap):
       commandLineFromOption(variableMap),
       pathFromOption(variableMap, "playback"),
       pathsFromOption(variableMap, "append-config"),
-      variableMap.at("config-override").as<std::vector<std::string>>()}
+      variableMap.at("config-override").as<std::vector<std::string>>(),
+      variableMap.at("direct-io").as<bool>()}
 {
 }
 
@@ -141,7 +148,8 @@ RunContext::RunContext(
     std::string commandLine,
     fs::path inputLog,
     std::vector<fs::path> appendConfigPaths,
-    std::vector<std::string> configOverrides):
+    std::vector<std::string> configOverrides,
+    const bool directIo):
   mWorkingDir{std::move(workingDir)},
   mResourcePaths{std::move(resourcePaths)},
   mCommandLine{std::move(commandLine)},
@@ -149,6 +157,7 @@ RunContext::RunContext(
   mAppendConfigPaths{std::move(appendConfigPaths)},
   mConfigOverrides{std::move(configOverrides)},
   mRecordChronicle{recordChronicle},
+  mDirectIo{directIo},
   mConfigOverlay{mInputLog, mAppendConfigPaths, mConfigOverrides}
 {
   fs::create_directories(mWorkingDir);
@@ -171,6 +180,11 @@ bool RunContext::recordChronicle() const noexcept
   return mRecordChronicle;
 }
 
+bool RunContext::directIo() const noexcept
+{
+  return mDirectIo;
+}
+
 const std::string& RunContext::commandLine() const noexcept
 {
   return mCommandLine;
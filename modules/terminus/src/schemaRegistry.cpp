@@ -38,6 +38,11 @@ constexpr auto kFileName = "schemas.bin";
 } // namespace
 
 SchemaRegistry::SchemaRegistry(const fs::path& recording)
+{
+  adopt(recording);
+}
+
+void SchemaRegistry::adopt(const fs::path& recording)
 {
   // A live run names no input log; there is nothing to adopt.
   if(recording.empty())
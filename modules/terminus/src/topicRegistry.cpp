@@ -127,6 +127,26 @@ void TopicRegistry::record(
           .mSchemaName = std::move(schemaName)});
 }
 
+void TopicRegistry::merge(const TopicRegistry& other)
+{
+  for(const auto& topic: other)
+  {
+    if(const auto entry = std::ranges::find(*this, topic.mChannelId, &Topic::mChannelId);
+       entry != end() and *entry != topic)
+    {
+      common::throwException<std::runtime_error>(
+          "Channel {} carries topic '{}' of schema {} in one recording and '{}' of schema {} in "
+          "another.",
+          common::hexString(topic.mChannelId.mValue),
+          entry->mName,
+          entry->mSchemaName,
+          topic.mName,
+          topic.mSchemaName);
+    }
+  }
+  insert(other.begin(), other.end());
+}
+
 void TopicRegistry::write(const fs::path& directory) const
 {
   auto entries = nlohmann::json::array();
@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <nioc/chronicle/defines.hpp>
+#include <nioc/concurrent/routine.hpp>
+#include <nioc/terminus/bridgeDriver.hpp>
+#include <nioc/terminus/consignment.hpp>
+#include <nioc/terminus/idl/testSchema.capnp.h>
+#include <nioc/terminus/message.hpp>
+#include <nioc/terminus/port.hpp>
+#include <nioc/terminus/publisher.hpp>
+#include <nioc/terminus/runContext.hpp>
+#include <nioc/terminus/schemaId.hpp>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace nioc::terminus
+{
+namespace fs = std::filesystem;
+
+namespace
+{
+
+using State = concurrent::Routine::State;
+
+constexpr auto kLoopback = "127.0.0.1";
+constexpr auto kPatience = std::chrono::seconds{10};
+
+Port makePort(const std::string_view name, const bool recordChronicle = true)
+{
+  auto workingDir = fs::temp_directory_path() / "nioc-bridgeDriverTest" / name;
+  fs::remove_all(workingDir);
+  return Port{
+      RunContext{std::move(workingDir), {}, recordChronicle, ""},
+      [](Port&, Port::Drivers&, Port::Components&, Port::Runners&) {}};
+}
+
+void publishValue(Publisher<TestSchema>& publisher, const std::int64_t value)
+{
+  auto draft = publisher.draft();
+  draft.builder().setValue(value);
+  publisher.publish(std::move(draft));
+}
+
+} // namespace
+
+TEST(BridgeDriver, deliversTheMessagesAnotherRunForwards)
+{
+  auto receivingPort = makePort("receiving");
+  auto driver = BridgeDriver{"bridge", receivingPort};
+  driver.receive<TestSchema>("forwarded");
+  auto received = std::vector<std::int64_t>{};
+  receivingPort.subscribe(
+      chronicle::makeChannelId(kSchemaId<TestSchema>, "forwarded"),
+      [&received](Consignment consignment)
+      { received.push_back(Message<TestSchema>{consignment.crate()}.reader().getValue()); });
+
+  auto sendingPort = makePort("sending");
+  sendingPort.forward<TestSchema>("forwarded", kLoopback, driver.listenPort());
+  auto publisher = sendingPort.publisher<TestSchema>("forwarded");
+  publishValue(publisher, 21);
+  publishValue(publisher, 34);
+
+  const auto deadline = std::chrono::steady_clock::now() + kPatience;
+  while(received.size() < 2U and std::chrono::steady_clock::now() < deadline)
+  {
+    static_cast<void>(driver.tick());
+  }
+  EXPECT_EQ(received, (std::vector<std::int64_t>{21, 34}));
+}
+
+TEST(BridgeDriver, requiresARecordingRun)
+{
+  auto port = makePort("online", false);
+  EXPECT_THROW((BridgeDriver{"bridge", port}), std::logic_error);
+}
+
+TEST(BridgeDriver, forwardingRequiresARecordingRun)
+{
+  auto receivingPort = makePort("listening");
+  auto driver = BridgeDriver{"bridge", receivingPort};
+  auto port = makePort("onlineSending", false);
+  EXPECT_THROW(
+      port.forward<TestSchema>("forwarded", kLoopback, driver.listenPort()),
+      std::logic_error);
+}
+
+} // namespace nioc::terminus
@@ -0,0 +1,120 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <nioc/chronicle/defines.hpp>
+#include <nioc/containers/mmapConstArray.hpp>
+#include <nioc/terminus/columnExtraction.hpp>
+#include <nioc/terminus/idl/testSchema.capnp.h>
+#include <nioc/terminus/port.hpp>
+#include <nioc/terminus/publisher.hpp>
+#include <nioc/terminus/runContext.hpp>
+#include <nioc/terminus/schemaId.hpp>
+#include <nioc/terminus/schemaRegistry.hpp>
+#include <nioc/terminus/topicRegistry.hpp>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace nioc::terminus
+{
+namespace fs = std::filesystem;
+
+namespace
+{
+
+fs::path testRoot()
+{
+  return fs::temp_directory_path() / "nioc-columnExtractionTest";
+}
+
+/// Record @p count TestSchema messages on "imu", valued 0, 10, 20, ..., and describe the recording.
+fs::path recordValues(const std::string_view name, const std::int64_t count)
+{
+  auto workingDir = testRoot() / name;
+  fs::remove_all(workingDir);
+  const auto recording = [&workingDir, count]
+  {
+    auto port = Port{
+        RunContext{std::move(workingDir), {}, true, ""},
+        [](Port&, Port::Drivers&, Port::Components&, Port::Runners&) {}};
+    auto publisher = port.publisher<TestSchema>("imu");
+    for(auto index = std::int64_t{0}; index < count; ++index)
+    {
+      auto draft = publisher.draft();
+      draft.builder().setValue(index * 10);
+      publisher.publish(std::move(draft));
+    }
+    return port.workingDir();
+  }();
+
+  // Stand in for the topic and schema records a run wires its publishers into.
+  auto topics = TopicRegistry{};
+  topics.record(
+      chronicle::makeChannelId(kSchemaId<TestSchema>, "imu"),
+      "imu",
+      kSchemaId<TestSchema>,
+      "TestSchema");
+  topics.write(recording);
+  auto schemas = SchemaRegistry{};
+  schemas.record<TestSchema>();
+  schemas.write(recording);
+  return recording;
+}
+
+} // namespace
+
+TEST(ColumnExtraction, writesEveryMessageToItsRowInTimelineOrder)
+{
+  const auto recording = recordValues("ordered", 1000);
+  const auto output = testRoot() / "orderedColumns";
+  fs::remove_all(output);
+
+  EXPECT_EQ(extractColumns(recording, "imu", {"value"}, output, 4), 1000U);
+
+  const auto values = containers::MmapConstArray<std::int64_t>{output / "value.i64"};
+  ASSERT_EQ(values.size(), 1000U);
+  for(auto index = std::size_t{0}; index < values.size(); ++index)
+  {
+    EXPECT_EQ(values.at(index), static_cast<std::int64_t>(index) * 10);
+  }
+
+  const auto arrivals = containers::MmapConstArray<std::int64_t>{output / "arrivalTimestamp.i64"};
+  ASSERT_EQ(arrivals.size(), 1000U);
+  for(auto index = std::size_t{1}; index < arrivals.size(); ++index)
+  {
+    EXPECT_LE(arrivals.at(index - 1U), arrivals.at(index));
+  }
+}
+
+TEST(ColumnExtraction, writesEmptyColumnsForAnEmptyTopic)
+{
+  const auto recording = recordValues("empty", 0);
+  const auto output = testRoot() / "emptyColumns";
+  fs::remove_all(output);
+
+  EXPECT_EQ(extractColumns(recording, "imu", {"value"}, output), 0U);
+  EXPECT_EQ(fs::file_size(output / "value.i64"), 0U);
+  EXPECT_EQ(fs::file_size(output / "arrivalTimestamp.i64"), 0U);
+}
+
+TEST(ColumnExtraction, rejectsAnUnknownTopicOrField)
+{
+  const auto recording = recordValues("rejected", 3);
+  const auto output = testRoot() / "rejectedColumns";
+  fs::remove_all(output);
+
+  EXPECT_THROW(extractColumns(recording, "gnss", {"value"}, output), std::invalid_argument);
+  EXPECT_THROW(extractColumns(recording, "imu", {"absent"}, output), std::invalid_argument);
+  EXPECT_THROW(extractColumns(recording, "imu", {"text"}, output), std::invalid_argument);
+  EXPECT_FALSE(fs::exists(output));
+}
+
+} // namespace nioc::terminus
@@ -4,10 +4,13 @@
 // Author   : Anurag Jakhotia
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <boost/program_options.hpp>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <gtest/gtest.h>
@@ -249,7 +252,7 @@ TEST(PortTest, constructionCreatesTheWorkingDirectory)
 
 TEST(PortTest, recordChronicleFalseOmitsChronicleDir)
 {
-  // Without recording there is no chronicle writer; producers build messages on the heap instead.
+  // Without recording there is no chronicle writer; producers publish through channels in memory.
   const auto workingDir = [&]
   {
     auto port = Port{testRunContext("", false), emptySetup};
@@ -263,6 +266,38 @@ TEST(PortTest, recordChronicleFalseOmitsChronicleDir)
   EXPECT_TRUE(fs::is_regular_file(workingDir / "resources.json"));
 }
 
+TEST(PortTest, aRunThatDoesNotRecordStillDeliversEveryMessage)
+{
+  constexpr auto kMessageCount = std::int64_t{64};
+  constexpr auto kTopic = std::string_view{"inMemory"};
+
+  const auto workingDir = [&]
+  {
+    auto port = Port{testRunContext("", false), emptySetup};
+    auto received = std::vector<std::int64_t>{};
+    port.subscribe(
+        chronicle::makeChannelId(kSchemaId<TestSchema>, kTopic),
+        [&received](const Consignment& consignment)
+        { received.push_back(Message<TestSchema>{consignment.crate()}.reader().getValue()); });
+
+    auto publisher = port.publisher<TestSchema>(kTopic);
+    for(auto value = std::int64_t{0}; value < kMessageCount; ++value)
+    {
+      auto draft = publisher.draft();
+      draft.builder().setValue(value);
+      publisher.publish(std::move(draft));
+    }
+
+    EXPECT_EQ(received.size(), static_cast<std::size_t>(kMessageCount));
+    for(auto index = std::size_t{0}; index < received.size(); ++index)
+    {
+      EXPECT_EQ(received.at(index), static_cast<std::int64_t>(index));
+    }
+    return port.workingDir();
+  }();
+  EXPECT_FALSE(fs::exists(workingDir / "chronicle"));
+}
+
 TEST(PortTest, constructionAddsListedResources)
 {
   auto port = Port{testRunContext("", true, {resource()}), emptySetup};
@@ -469,6 +504,63 @@ TEST(PortTest, everyPublishedMessageIsRecordedInOrder)
   EXPECT_EQ(kMessageCount, nextValue);
 }
 
+TEST(PortTest, concurrentPublishersNumberEveryMessageOnce)
+{
+  constexpr auto kThreads = 4;
+  constexpr auto kMessagesPerThread = std::int64_t{256};
+  constexpr auto kTopic = std::string_view{"sharedTopic"};
+
+  // Several workers publish through one Publisher; the recording must hold every message, each
+  // with its own sequence number, and together they must number 1..N without a gap.
+  const auto workingDir = [&]
+  {
+    auto port = Port{testRunContext(), emptySetup};
+    auto publisher = port.publisher<TestSchema>(kTopic);
+    {
+      auto workers = std::vector<std::jthread>{};
+      for(auto worker = 0; worker < kThreads; ++worker)
+      {
+        workers.emplace_back(
+            [&publisher, worker]
+            {
+              for(auto index = std::int64_t{0}; index < kMessagesPerThread; ++index)
+              {
+                auto draft = publisher.draft();
+                draft.builder().setValue((worker * kMessagesPerThread) + index);
+                publisher.publish(std::move(draft));
+              }
+            });
+      }
+    }
+    return port.workingDir();
+  }();
+
+  auto reader = chronicle::Reader{workingDir / "chronicle"};
+  const auto channelId = chronicle::makeChannelId(kSchemaId<TestSchema>, kTopic);
+
+  auto sequenceNumbers = std::vector<std::uint64_t>{};
+  auto values = std::vector<std::int64_t>{};
+  for(const auto& entry: reader)
+  {
+    if(entry.mChannelId == channelId)
+    {
+      const auto loaded = Message<TestSchema>{entry.mCrate};
+      sequenceNumbers.push_back(loaded.sequenceNumber());
+      values.push_back(loaded.reader().getValue());
+    }
+  }
+
+  constexpr auto kMessageCount = static_cast<std::size_t>(kThreads * kMessagesPerThread);
+  ASSERT_EQ(sequenceNumbers.size(), kMessageCount);
+  std::ranges::sort(sequenceNumbers);
+  std::ranges::sort(values);
+  for(auto index = std::size_t{0}; index < kMessageCount; ++index)
+  {
+    EXPECT_EQ(sequenceNumbers.at(index), index + 1U);
+    EXPECT_EQ(values.at(index), static_cast<std::int64_t>(index));
+  }
+}
+
 TEST(PortTest, waitReturnsFalseOnceEveryDriverIsDone)
 {
   class ScriptedDriver final: public Driver
@@ -0,0 +1,135 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <nioc/chronicle/defines.hpp>
+#include <nioc/chronicle/reader.hpp>
+#include <nioc/terminus/idl/testSchema.capnp.h>
+#include <nioc/terminus/message.hpp>
+#include <nioc/terminus/port.hpp>
+#include <nioc/terminus/publisher.hpp>
+#include <nioc/terminus/recordingMerge.hpp>
+#include <nioc/terminus/runContext.hpp>
+#include <nioc/terminus/schemaId.hpp>
+#include <nioc/terminus/schemaRegistry.hpp>
+#include <nioc/terminus/topicRegistry.hpp>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace nioc::terminus
+{
+namespace fs = std::filesystem;
+
+namespace
+{
+
+fs::path testRoot()
+{
+  return fs::temp_directory_path() / "nioc-recordingMergeTest";
+}
+
+chronicle::ChannelId channelFor(const std::string_view topic)
+{
+  return chronicle::makeChannelId(kSchemaId<TestSchema>, topic);
+}
+
+Port makePort(const std::string_view name)
+{
+  auto workingDir = testRoot() / name;
+  fs::remove_all(workingDir);
+  return Port{
+      RunContext{std::move(workingDir), {}, true, ""},
+      [](Port&, Port::Drivers&, Port::Components&, Port::Runners&) {}};
+}
+
+void publishValue(Publisher<TestSchema>& publisher, const std::int64_t value)
+{
+  auto draft = publisher.draft();
+  draft.builder().setValue(value);
+  publisher.publish(std::move(draft));
+}
+
+/// Stand in for the topic and schema records a run wires its publishers into.
+void describe(const fs::path& recording, const std::string_view topic)
+{
+  auto topics = TopicRegistry{};
+  topics.record(channelFor(topic), std::string{topic}, kSchemaId<TestSchema>, "TestSchema");
+  topics.write(recording);
+
+  auto schemas = SchemaRegistry{};
+  schemas.record<TestSchema>();
+  schemas.write(recording);
+}
+
+} // namespace
+
+TEST(RecordingMerge, deliversTheMessagesOfEveryRecordingInArrivalOrder)
+{
+  // Two runs record side by side, publishing in turn.
+  const auto [alphaDir, betaDir] = []
+  {
+    auto alphaPort = makePort("alpha");
+    auto betaPort = makePort("beta");
+    auto alpha = alphaPort.publisher<TestSchema>("alpha");
+    auto beta = betaPort.publisher<TestSchema>("beta");
+    for(auto value = std::int64_t{0}; value < 6; ++value)
+    {
+      publishValue(value % 2 == 0 ? alpha : beta, value);
+      std::this_thread::sleep_for(std::chrono::milliseconds{2});
+    }
+    return std::pair{alphaPort.workingDir(), betaPort.workingDir()};
+  }();
+  describe(alphaDir, "alpha");
+  describe(betaDir, "beta");
+
+  const auto merged = testRoot() / "merged";
+  fs::remove_all(merged);
+  mergeRecordings({alphaDir, betaDir}, merged);
+
+  auto value = std::int64_t{0};
+  for(const auto& entry: chronicle::Reader{merged / "chronicle"})
+  {
+    EXPECT_EQ(entry.mChannelId, channelFor(value % 2 == 0 ? "alpha" : "beta"));
+    EXPECT_EQ(Message<TestSchema>{entry.mCrate}.reader().getValue(), value);
+    ++value;
+  }
+  EXPECT_EQ(value, 6);
+
+  const auto topics = TopicRegistry{merged};
+  EXPECT_EQ(topics.size(), 2U);
+  EXPECT_TRUE(SchemaRegistry{merged}.contains(kSchemaId<TestSchema>));
+}
+
+TEST(RecordingMerge, refusesRecordingsThatDisagreeOnAChannel)
+{
+  const auto first = testRoot() / "disagreeFirst";
+  const auto second = testRoot() / "disagreeSecond";
+  for(const auto& recording: {first, second})
+  {
+    fs::remove_all(recording);
+    fs::create_directories(recording);
+  }
+
+  auto topics = TopicRegistry{};
+  topics.record(channelFor("alpha"), "alpha", kSchemaId<TestSchema>, "TestSchema");
+  topics.write(first);
+  auto renamed = TopicRegistry{};
+  renamed.record(channelFor("alpha"), "renamed", kSchemaId<TestSchema>, "TestSchema");
+  renamed.write(second);
+
+  const auto merged = testRoot() / "disagreeMerged";
+  fs::remove_all(merged);
+  EXPECT_THROW(mergeRecordings({first, second}, merged), std::runtime_error);
+}
+
+} // namespace nioc::terminus
@@ -0,0 +1,128 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <nioc/terminus/idl/testSchema.capnp.h>
+#include <nioc/terminus/message.hpp>
+#include <nioc/terminus/port.hpp>
+#include <nioc/terminus/publisher.hpp>
+#include <nioc/terminus/remotePort.hpp>
+#include <nioc/terminus/runContext.hpp>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace nioc::terminus
+{
+namespace fs = std::filesystem;
+
+namespace
+{
+
+constexpr auto kPatience = std::chrono::seconds{10};
+
+Port makePort(const std::string_view name, const bool recordChronicle = true)
+{
+  auto workingDir = fs::temp_directory_path() / "nioc-remotePortTest" / name;
+  fs::remove_all(workingDir);
+  return Port{
+      RunContext{std::move(workingDir), {}, recordChronicle, ""},
+      [](Port&, Port::Drivers&, Port::Components&, Port::Runners&) {}};
+}
+
+void publishValue(Publisher<TestSchema>& publisher, const std::int64_t value)
+{
+  auto draft = publisher.draft();
+  draft.builder().setValue(value);
+  publisher.publish(std::move(draft));
+}
+
+/// Publish probes until the subscription has reached the sharing Port, then drop them. Probes are
+/// handed to the socket as they are published, so one drain takes every probe in flight.
+void settle(Publisher<TestSchema>& publisher, RemotePort& remote)
+{
+  const auto deadline = std::chrono::steady_clock::now() + kPatience;
+  while(std::chrono::steady_clock::now() < deadline)
+  {
+    publishValue(publisher, -1);
+    if(remote.poll(std::chrono::milliseconds{1}) > 0U)
+    {
+      break;
+    }
+  }
+  static_cast<void>(remote.poll(std::chrono::nanoseconds::zero()));
+}
+
+} // namespace
+
+TEST(RemotePort, receivesASharedTopicsMessagesInPlace)
+{
+  auto port = makePort("shared");
+  port.share<TestSchema>("shared");
+  auto publisher = port.publisher<TestSchema>("shared");
+
+  auto remote = RemotePort{port.brokerPath()};
+  auto received = std::vector<std::int64_t>{};
+  remote.subscribe<TestSchema>(
+      "shared",
+      [&received](const Message<TestSchema>& message)
+      { received.push_back(message.reader().getValue()); });
+  settle(publisher, remote);
+  received.clear();
+
+  constexpr auto kCount = std::int64_t{100};
+  for(auto value = std::int64_t{0}; value < kCount; ++value)
+  {
+    publishValue(publisher, value);
+  }
+  while(std::ssize(received) < kCount and remote.poll(kPatience) > 0U)
+  {
+  }
+
+  ASSERT_EQ(std::ssize(received), kCount);
+  for(auto value = std::int64_t{0}; value < kCount; ++value)
+  {
+    EXPECT_EQ(received.at(static_cast<std::size_t>(value)), value);
+  }
+}
+
+TEST(RemotePort, unsharedTopicsStayLocal)
+{
+  auto port = makePort("unshared");
+  port.share<TestSchema>("shared");
+  auto sharedPublisher = port.publisher<TestSchema>("shared");
+  auto localPublisher = port.publisher<TestSchema>("local");
+
+  auto remote = RemotePort{port.brokerPath()};
+  auto localCount = 0;
+  remote.subscribe<TestSchema>("local", [&localCount](const auto&) { ++localCount; });
+  remote.subscribe<TestSchema>("shared", [](const auto&) {});
+  settle(sharedPublisher, remote);
+
+  publishValue(localPublisher, 1);
+  EXPECT_EQ(remote.poll(std::chrono::milliseconds{20}), 0U);
+  EXPECT_EQ(localCount, 0);
+}
+
+TEST(RemotePort, sharingRequiresARecordingRun)
+{
+  auto port = makePort("notRecording", false);
+  EXPECT_THROW(port.share<TestSchema>("shared"), std::logic_error);
+}
+
+TEST(RemotePort, connectingWhereNothingIsSharedThrows)
+{
+  const auto port = makePort("nothingShared");
+  EXPECT_THROW((RemotePort{port.brokerPath()}), std::runtime_error);
+}
+
+} // namespace nioc::terminus
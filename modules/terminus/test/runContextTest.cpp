@@ -64,6 +64,15 @@ TEST(RunContextTest, readsRecordChronicleAndCommandLine)
   EXPECT_FALSE(context.commandLine().empty());
 }
 
+TEST(RunContextTest, directIoIsOptIn)
+{
+  const auto root = testDirectory("directIoRoot");
+  const auto rootArg = root.string();
+  EXPECT_FALSE(RunContext{parse({"--log-root", rootArg.c_str()})}.directIo());
+  EXPECT_TRUE(
+      RunContext{parse({"--log-root", rootArg.c_str(), "--direct-io", "true"})}.directIo());
+}
+
 TEST(RunContextTest, constructionEstablishesTheRunOnDisk)
 {
   // Constructing a context creates the working directory and writes both the assembled overlay and
@@ -109,6 +109,33 @@ TEST(TopicRegistry, reusingAChannelForADifferentTopicThrows)
       std::runtime_error);
 }
 
+TEST(TopicRegistry, mergingUnionsTheTopicsAndKeepsSharedOnesOnce)
+{
+  auto registry = TopicRegistry{};
+  registry.record(channel(kImuChannel), "/imu", kImuSchemaId, "nioc::sensors::Imu");
+  auto other = TopicRegistry{};
+  other.record(channel(kImuChannel), "/imu", kImuSchemaId, "nioc::sensors::Imu");
+  other.record(channel(kGnssChannel), "/gnss", kGnssSchemaId, "nioc::sensors::Gnss");
+
+  registry.merge(other);
+
+  EXPECT_EQ(registry.size(), 2U);
+  ASSERT_NE(find(registry, channel(kGnssChannel)), nullptr);
+  EXPECT_EQ(find(registry, channel(kGnssChannel))->mName, "/gnss");
+}
+
+TEST(TopicRegistry, mergingADifferentTopicOnAChannelThrows)
+{
+  auto registry = TopicRegistry{};
+  registry.record(channel(kImuChannel), "/imu", kImuSchemaId, "nioc::sensors::Imu");
+  auto other = TopicRegistry{};
+  other.record(channel(kImuChannel), "/imuRaw", kImuSchemaId, "nioc::sensors::Imu");
+  other.record(channel(kGnssChannel), "/gnss", kGnssSchemaId, "nioc::sensors::Gnss");
+
+  EXPECT_THROW(registry.merge(other), std::runtime_error);
+  EXPECT_EQ(registry.size(), 1U);
+}
+
 TEST(TopicRegistry, anEmptyPathAdoptsNothing)
 {
   const auto registry = TopicRegistry{fs::path{}};
@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026.
+// Project  : nioc
+// Author   : Anurag Jakhotia
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/program_options.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <nioc/common/exception.hpp>
+#include <nioc/common/utils.hpp>
+#include <nioc/logger/logger.hpp>
+#include <nioc/terminus/programOption.hpp>
+#include <nioc/terminus/recordingMerge.hpp>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+int main(const int argC, const char* const* const argV)
+{
+  try
+  {
+    const auto programName = nioc::common::programName(argC, argV);
+    nioc::logger::setupDefaultLogger(programName);
+
+    // clang-format off
+    auto options = boost::program_options::options_description{"Options"};
+    options.add_options()
+    (
+      "recording",
+      boost::program_options::value<std::vector<std::string>>()->multitoken()->composing(),
+      "A recording to merge; pass once per recording, at least twice"
+    )
+    (
+      "output",
+      boost::program_options::value<std::string>(),
+      "Directory to write the merged recording into; must be absent or empty"
+    );
+    // clang-format on
+
+    const auto variableMap = nioc::terminus::parseCommandLine(argC, argV, std::move(options));
+    if(not variableMap.contains("recording") or not variableMap.contains("output"))
+    {
+      nioc::common::throwException<std::invalid_argument>(
+          "Name the recordings to merge with --recording and the destination with --output.");
+    }
+
+    auto recordings = std::vector<std::filesystem::path>{};
+    for(const auto& recording: variableMap.at("recording").as<std::vector<std::string>>())
+    {
+      recordings.emplace_back(recording);
+    }
+    const auto output = std::filesystem::path{variableMap.at("output").as<std::string>()};
+
+    nioc::logger::info("Merging {} recordings into {}.", recordings.size(), output.string());
+    nioc::terminus::mergeRecordings(recordings, output);
+  }
+  catch(const std::exception& error)
+  {
+    // An exception may escape before setupDefaultLogger runs, so report through stderr rather than
+    // the logger.
+    static_cast<void>(std::fputs("Terminated by an unhandled exception: ", stderr));
+    static_cast<void>(std::fputs(error.what(), stderr));
+    static_cast<void>(std::fputs("\n", stderr));
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}